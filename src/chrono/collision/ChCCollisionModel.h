@@ -44,7 +44,8 @@ enum ShapeType {
     ROUNDEDCYL,   // Currently implemented in parallel only
     ROUNDEDCONE,  // Currently implemented in parallel only
     CONVEX,       // Currently implemented in parallel only
-    FLUID         // Currently implemented in parallel only
+    FLUID,        // Currently implemented in parallel only
+    TRIANGLEMESH_BVH  // Currently implemented in parallel only
 };
 
 ///
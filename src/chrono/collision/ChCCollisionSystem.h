@@ -28,9 +28,12 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <vector>
+
 #include "collision/ChCCollisionInfo.h"
 #include "core/ChFrame.h"
 #include "core/ChApiCE.h"
+#include "core/ChStepProfiler.h"
 
 namespace chrono {
 
@@ -92,6 +95,7 @@ class ChApi ChCollisionSystem {
     ChCollisionSystem(unsigned int max_objects = 16000, double scene_size = 500) {
         narrow_callback = 0;
         broad_callback = 0;
+        profiler = 0;
     };
 
     virtual ~ChCollisionSystem(){};
@@ -108,6 +112,15 @@ class ChApi ChCollisionSystem {
     /// engine (custom data may be deallocated).
     virtual void Remove(ChCollisionModel* model) = 0;
 
+    /// Removes many collision models at once from the collision
+    /// engine. Children classes can override this to do the removal
+    /// in bulk, faster than removing the models one by one.
+    /// Calling Remove() later on the removed models must do nothing.
+    virtual void RemoveBatch(const std::vector<ChCollisionModel*>& models) {
+        for (size_t i = 0; i < models.size(); ++i)
+            Remove(models[i]);
+    }
+
     /// Removes all collision models from the collision
     /// engine (custom data may be deallocated).
     // virtual void RemoveAll() = 0;
@@ -168,6 +181,19 @@ class ChApi ChCollisionSystem {
     /// Perform a ray-hit test with the collision models.
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) = 0;
 
+    /// Perform a batch of ray-hit tests with parallel rays, each going from one of the
+    /// points in 'from' to the point from[i]+dir (for example, a grid of vertical rays
+    /// under a terrain). The results are stored in 'results', resized to the number of rays,
+    /// and are the same as those of RayHit() for each ray. The default implementation
+    /// just calls RayHit() for each ray; children classes can cull and parallelize the tests.
+    virtual void RayHitBatch(const std::vector<ChVector<> >& from,
+                             const ChVector<>& dir,
+                             std::vector<ChRayhitResult>& results) {
+        results.resize(from.size());
+        for (size_t i = 0; i < from.size(); i++)
+            RayHit(from[i], from[i] + dir, results[i]);
+    }
+
     // SERIALIZATION
 
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
@@ -179,9 +205,14 @@ class ChApi ChCollisionSystem {
         int version = marchive.VersionRead();
     }
 
+    /// Set the profiler used to time the broad and narrow phases of Run() and
+    /// ReportContacts(), if the implementation supports it (set by ChSystem).
+    void SetProfiler(ChStepProfiler* mprofiler) { profiler = mprofiler; }
+
   protected:
     ChBroadPhaseCallback* broad_callback;    // user callback for each near-enough pair of shapes
     ChNarrowPhaseCallback* narrow_callback;  // user callback for each contact
+    ChStepProfiler* profiler;                // profiler of the system steps, if any
 };
 
 }  // END_OF_NAMESPACE____
@@ -18,6 +18,11 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
 #include "collision/ChCCollisionSystemBullet.h"
 #include "collision/ChCModelBullet.h"
 #include "collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -31,8 +36,10 @@
 #include "BulletCollision/CollisionShapes/bt2DShape.h"
 #include "BulletCollision/CollisionShapes/btCEtriangleShape.h"
 #include "BulletCollision/CollisionDispatch/btEmptyCollisionAlgorithm.h"
+#include "parallel/ChOpenMP.h"
 
 extern btScalar gContactBreakingThreshold;
+extern int gNumManifold;
 
 namespace chrono {
 namespace collision {
@@ -1168,6 +1175,216 @@ private:
 };
 
 
+////////////////////////////////////
+////////////////////////////////////
+
+// Collision dispatcher that can run the narrow phase over the overlapping pairs
+// using multiple threads. The creation and release of persistent manifolds requested
+// while processing a pair is logged per thread, with manifolds allocated from a pool
+// owned by the thread. After all pairs are processed, the logs are sorted by pair and
+// replayed on the manifold array, so that the array (hence the order of the reported
+// contacts) is exactly the same as the one obtained by a serial dispatch.
+// Compound and concave collision algorithms temporarily change the shape and transform
+// of their collision object, so all pairs that involve such objects are processed by a
+// single thread, while the pairs of convex objects are shared among all threads.
+class btCollisionDispatcherMt : public btCollisionDispatcher {
+  public:
+    btCollisionDispatcherMt(btCollisionConfiguration* collisionConfiguration)
+        : btCollisionDispatcher(collisionConfiguration), m_numThreads(1), m_parallel(false) {}
+
+    virtual ~btCollisionDispatcherMt() {
+        for (size_t i = 0; i < m_threadPools.size(); i++) {
+            m_threadPools[i]->~btPoolAllocator();
+            btAlignedFree(m_threadPools[i]);
+        }
+    }
+
+    void setNumThreads(int nthreads) {
+        m_numThreads = btMax(nthreads, 1);
+        // Pools are never deleted here, since they may still hold live manifolds.
+        while ((int)m_threadPools.size() < m_numThreads) {
+            void* mem = btAlignedAlloc(sizeof(btPoolAllocator), 16);
+            m_threadPools.push_back(new (mem) btPoolAllocator(sizeof(btPersistentManifold), 1024));
+        }
+        m_threadLogs.resize(m_numThreads);
+        m_threadPair.resize(m_numThreads);
+    }
+
+    int getNumThreads() const { return m_numThreads; }
+
+    virtual btPersistentManifold* getNewManifold(void* b0, void* b1) {
+        if (!m_parallel)
+            return btCollisionDispatcher::getNewManifold(b0, b1);
+
+        btCollisionObject* body0 = (btCollisionObject*)b0;
+        btCollisionObject* body1 = (btCollisionObject*)b1;
+
+        btScalar contactBreakingThreshold =
+            (m_dispatcherFlags & btCollisionDispatcher::CD_USE_RELATIVE_CONTACT_BREAKING_THRESHOLD)
+                ? btMin(body0->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold),
+                        body1->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold))
+                : gContactBreakingThreshold;
+
+        btScalar contactProcessingThreshold =
+            btMin(body0->getContactProcessingThreshold(), body1->getContactProcessingThreshold());
+
+        int tid = CHOMPfunctions::GetThreadNum();
+        btPoolAllocator* pool = m_threadPools[tid];
+        void* mem = pool->getFreeCount() ? pool->allocate(sizeof(btPersistentManifold))
+                                         : btAlignedAlloc(sizeof(btPersistentManifold), 16);
+        btPersistentManifold* manifold =
+            new (mem) btPersistentManifold(body0, body1, 0, contactBreakingThreshold, contactProcessingThreshold);
+
+        // The manifold is added to the manifold array later, when replaying the logs.
+        m_threadLogs[tid].push_back(ManifoldOp(m_threadPair[tid], manifold, true));
+
+        return manifold;
+    }
+
+    virtual void releaseManifold(btPersistentManifold* manifold) {
+        if (m_parallel) {
+            // Defer the removal from the manifold array to the replay of the logs.
+            int tid = CHOMPfunctions::GetThreadNum();
+            m_threadLogs[tid].push_back(ManifoldOp(m_threadPair[tid], manifold, false));
+            return;
+        }
+
+        gNumManifold--;
+
+        clearManifold(manifold);
+
+        int findIndex = manifold->m_index1a;
+        btAssert(findIndex < m_manifoldsPtr.size());
+        m_manifoldsPtr.swap(findIndex, m_manifoldsPtr.size() - 1);
+        m_manifoldsPtr[findIndex]->m_index1a = findIndex;
+        m_manifoldsPtr.pop_back();
+
+        manifold->~btPersistentManifold();
+        if (m_persistentManifoldPoolAllocator->validPtr(manifold)) {
+            m_persistentManifoldPoolAllocator->freeMemory(manifold);
+            return;
+        }
+        for (size_t i = 0; i < m_threadPools.size(); i++) {
+            if (m_threadPools[i]->validPtr(manifold)) {
+                m_threadPools[i]->freeMemory(manifold);
+                return;
+            }
+        }
+        btAlignedFree(manifold);
+    }
+
+    virtual void* allocateCollisionAlgorithm(int size) {
+        if (!m_parallel)
+            return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        CHOMPscopedLock lock(m_mutex);
+        return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+    }
+
+    virtual void freeCollisionAlgorithm(void* ptr) {
+        if (!m_parallel) {
+            btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+            return;
+        }
+        CHOMPscopedLock lock(m_mutex);
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+    }
+
+    virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,
+                                           const btDispatcherInfo& dispatchInfo,
+                                           btDispatcher* dispatcher) {
+        int numPairs = pairCache->getNumOverlappingPairs();
+        if (m_numThreads < 2 || numPairs < m_numThreads * chunk_size) {
+            btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+            return;
+        }
+
+        // Split the pairs between convex pairs and pairs that need a single thread.
+        btBroadphasePair* pairs = pairCache->getOverlappingPairArrayPtr();
+        m_convexPairs.clear();
+        m_otherPairs.clear();
+        for (int ip = 0; ip < numPairs; ip++) {
+            if (isConvexPair(pairs[ip]))
+                m_convexPairs.push_back(ip);
+            else
+                m_otherPairs.push_back(ip);
+        }
+        int numConvexPairs = (int)m_convexPairs.size();
+        int numOtherPairs = (int)m_otherPairs.size();
+
+        for (int it = 0; it < m_numThreads; it++)
+            m_threadLogs[it].clear();
+
+        m_parallel = true;
+
+#pragma omp parallel num_threads(m_numThreads)
+        {
+            int tid = CHOMPfunctions::GetThreadNum();
+
+#pragma omp single nowait
+            for (int k = 0; k < numOtherPairs; k++) {
+                m_threadPair[tid] = m_otherPairs[k];
+                (*getNearCallback())(pairs[m_otherPairs[k]], *this, dispatchInfo);
+            }
+
+#pragma omp for schedule(dynamic, chunk_size) nowait
+            for (int k = 0; k < numConvexPairs; k++) {
+                m_threadPair[tid] = m_convexPairs[k];
+                (*getNearCallback())(pairs[m_convexPairs[k]], *this, dispatchInfo);
+            }
+        }
+
+        m_parallel = false;
+
+        // Merge the logs in pair order (the operations of one pair are all done by one
+        // thread, so the stable sort keeps them in the order they were requested).
+        m_mergedLog.clear();
+        for (int it = 0; it < m_numThreads; it++)
+            m_mergedLog.insert(m_mergedLog.end(), m_threadLogs[it].begin(), m_threadLogs[it].end());
+        std::stable_sort(m_mergedLog.begin(), m_mergedLog.end());
+
+        // Replay the manifold creations and releases in the same order as a serial dispatch.
+        for (size_t k = 0; k < m_mergedLog.size(); k++) {
+            btPersistentManifold* manifold = m_mergedLog[k].manifold;
+            if (m_mergedLog[k].created) {
+                gNumManifold++;
+                manifold->m_index1a = m_manifoldsPtr.size();
+                m_manifoldsPtr.push_back(manifold);
+            } else {
+                releaseManifold(manifold);
+            }
+        }
+    }
+
+  private:
+    struct ManifoldOp {
+        ManifoldOp(int mpair, btPersistentManifold* mmanifold, bool mcreated)
+            : pair(mpair), manifold(mmanifold), created(mcreated) {}
+        bool operator<(const ManifoldOp& other) const { return pair < other.pair; }
+
+        int pair;                         // index of the overlapping pair that requested the operation
+        btPersistentManifold* manifold;   // created or released manifold
+        bool created;                     // true if created, false if released
+    };
+
+    static const int chunk_size = 16;
+
+    static bool isConvexPair(const btBroadphasePair& pair) {
+        int type0 = static_cast<btCollisionObject*>(pair.m_pProxy0->m_clientObject)->getCollisionShape()->getShapeType();
+        int type1 = static_cast<btCollisionObject*>(pair.m_pProxy1->m_clientObject)->getCollisionShape()->getShapeType();
+        return btBroadphaseProxy::isConvex(type0) && btBroadphaseProxy::isConvex(type1);
+    }
+
+    int m_numThreads;
+    bool m_parallel;
+    CHOMPmutex m_mutex;
+    std::vector<btPoolAllocator*> m_threadPools;          // per-thread manifold pools
+    std::vector<std::vector<ManifoldOp> > m_threadLogs;   // per-thread logs of manifold operations
+    std::vector<int> m_threadPair;                        // per-thread index of the pair being processed
+    std::vector<int> m_convexPairs;
+    std::vector<int> m_otherPairs;
+    std::vector<ManifoldOp> m_mergedLog;
+};
+
 
 ////////////////////////////////////
 ////////////////////////////////////
@@ -1177,7 +1394,7 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new btCollisionDispatcherMt(bt_collision_configuration);
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1261,29 +1478,85 @@ void ChCollisionSystemBullet::Add(ChCollisionModel* model) {
 }
 
 void ChCollisionSystemBullet::Remove(ChCollisionModel* model) {
-    if (((ChModelBullet*)model)->GetBulletModel()->getCollisionShape()) {
+    // (a model without broadphase handle is not in the collision world, ex. already removed)
+    if (((ChModelBullet*)model)->GetBulletModel()->getCollisionShape() &&
+        ((ChModelBullet*)model)->GetBulletModel()->getBroadphaseHandle()) {
         bt_collision_world->removeCollisionObject(((ChModelBullet*)model)->GetBulletModel());
     }
 }
 
+void ChCollisionSystemBullet::RemoveBatch(const std::vector<ChCollisionModel*>& models) {
+    btAlignedObjectArray<btCollisionObject*> objects;
+    for (size_t i = 0; i < models.size(); ++i) {
+        btCollisionObject* object = ((ChModelBullet*)models[i])->GetBulletModel();
+        if (object->getCollisionShape() && object->getBroadphaseHandle())
+            objects.push_back(object);
+    }
+    if (objects.size())
+        bt_collision_world->removeCollisionObjects(&objects[0], objects.size());
+}
+
+void ChCollisionSystemBullet::SetNumThreads(int nthreads) {
+    static_cast<btCollisionDispatcherMt*>(bt_dispatcher)->setNumThreads(nthreads);
+}
+
+int ChCollisionSystemBullet::GetNumThreads() const {
+    return static_cast<btCollisionDispatcherMt*>(bt_dispatcher)->getNumThreads();
+}
+
 void ChCollisionSystemBullet::Run() {
-    if (bt_collision_world) {
+    if (!bt_collision_world)
+        return;
+
+    if (!profiler || !profiler->IsEnabled()) {
         bt_collision_world->performDiscreteCollisionDetection();
+        return;
+    }
+
+    // Same as btCollisionWorld::performDiscreteCollisionDetection, timing the two phases
+    {
+        ChStepProfiler::Scope scope(profiler, ChStepProfiler::PHASE_COLLISION_BROAD);
+        bt_collision_world->updateAabbs();
+        bt_collision_world->getBroadphase()->calculateOverlappingPairs(bt_collision_world->getDispatcher());
+    }
+    {
+        ChStepProfiler::Scope scope(profiler, ChStepProfiler::PHASE_COLLISION_NARROW);
+        bt_collision_world->getDispatcher()->dispatchAllCollisionPairs(
+            bt_collision_world->getBroadphase()->getOverlappingPairCache(), bt_collision_world->getDispatchInfo(),
+            bt_collision_world->getDispatcher());
     }
 }
 
 void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcontainer) {
+    ChStepProfiler::Scope scope(profiler, ChStepProfiler::PHASE_COLLISION_NARROW);
+
     // This should remove all old contacts (or at least rewind the index)
     mcontactcontainer->BeginAddContact();
 
     ChCollisionInfo icontact;
 
     int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
+    int numThreads = GetNumThreads();
+
+    // Refreshing the contact points only touches each manifold, so it can be done
+    // in parallel; contacts are then merged serially in the order of the manifold
+    // array, which is the same as with a serial dispatch.
+    if (numThreads > 1) {
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+        for (int i = 0; i < numManifolds; i++) {
+            btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
+            btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+            btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+            contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
+        }
+    }
+
     for (int i = 0; i < numManifolds; i++) {
         btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
         btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
         btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
-        contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
+        if (numThreads < 2)
+            contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
         icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
         icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
@@ -1401,6 +1674,212 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from, const ChVector<>& t
     return false;
 }
 
+// Collision object tested by RayHitBatch: bounding box projected on the plane orthogonal
+// to the rays (u, v coordinates) and extent along the rays (w coordinate).
+struct RayBatchObject {
+    btCollisionObject* object;
+    double umin, umax, vmin, vmax, wmin, wmax;
+    std::vector<int> rays;  // rays that cross the bounding box
+};
+
+// Group of rays tested against one collision object by one thread.
+struct RayBatchTask {
+    int object;
+    int first;
+    int last;
+};
+
+// Hit of a ray with a collision object.
+struct RayBatchHit {
+    int ray;
+    btScalar fraction;
+    btVector3 point;
+    btVector3 normal;
+    const btCollisionObject* object;
+};
+
+void ChCollisionSystemBullet::RayHitBatch(const std::vector<ChVector<> >& from,
+                                          const ChVector<>& dir,
+                                          std::vector<ChRayhitResult>& results) {
+    static const int rays_per_cell = 16;
+    static const int rays_per_task = 256;
+
+    int num_rays = (int)from.size();
+    results.resize(num_rays);
+    for (int i = 0; i < num_rays; i++) {
+        results[i].hit = false;
+        results[i].hitModel = 0;
+        results[i].dist_factor = 1;
+    }
+
+    double length = dir.Length();
+    if (num_rays == 0 || length == 0)
+        return;
+
+    // Frame of the rays: w along the rays, u and v on the orthogonal plane.
+    ChVector<> w, u, v;
+    dir.DirToDxDyDz(w, u, v);
+
+    // Bin the rays on a uniform grid on the u-v plane (counting sort).
+    std::vector<double> ray_u(num_rays), ray_v(num_rays), ray_w(num_rays);
+    double umin = DBL_MAX, umax = -DBL_MAX, vmin = DBL_MAX, vmax = -DBL_MAX;
+    for (int i = 0; i < num_rays; i++) {
+        ray_u[i] = Vdot(from[i], u);
+        ray_v[i] = Vdot(from[i], v);
+        ray_w[i] = Vdot(from[i], w);
+        umin = std::min(umin, ray_u[i]);
+        umax = std::max(umax, ray_u[i]);
+        vmin = std::min(vmin, ray_v[i]);
+        vmax = std::max(vmax, ray_v[i]);
+    }
+
+    int num_cells_target = std::max(num_rays / rays_per_cell, 1);
+    double area = (umax - umin) * (vmax - vmin);
+    double cell = area > 0 ? std::sqrt(area / num_cells_target) : std::max(umax - umin, vmax - vmin) / num_cells_target;
+    if (cell <= 0)
+        cell = 1;
+    int nu = std::min((int)((umax - umin) / cell), num_cells_target) + 1;
+    int nv = std::min((int)((vmax - vmin) / cell), num_cells_target) + 1;
+
+    std::vector<int> cell_start(nu * nv + 1, 0);
+    std::vector<int> ray_cell(num_rays);
+    for (int i = 0; i < num_rays; i++) {
+        int iu = std::min((int)((ray_u[i] - umin) / cell), nu - 1);
+        int iv = std::min((int)((ray_v[i] - vmin) / cell), nv - 1);
+        ray_cell[i] = iu + nu * iv;
+        cell_start[ray_cell[i] + 1]++;
+    }
+    for (int c = 0; c < nu * nv; c++)
+        cell_start[c + 1] += cell_start[c];
+    std::vector<int> cell_rays(num_rays);
+    std::vector<int> cell_fill(cell_start.begin(), cell_start.end() - 1);
+    for (int i = 0; i < num_rays; i++)
+        cell_rays[cell_fill[ray_cell[i]]++] = i;
+
+    // Project the bounding boxes of the collision objects, with the same filter used by RayHit.
+    btCollisionWorld::ClosestRayResultCallback filter(btVector3(0, 0, 0), btVector3(0, 0, 0));
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    std::vector<RayBatchObject> candidates;
+    for (int io = 0; io < objects.size(); io++) {
+        btCollisionObject* object = objects[io];
+        btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+        if (!proxy || !object->getCollisionShape() || !filter.needsCollision(proxy))
+            continue;
+
+        RayBatchObject candidate;
+        candidate.object = object;
+        candidate.umin = candidate.vmin = candidate.wmin = DBL_MAX;
+        candidate.umax = candidate.vmax = candidate.wmax = -DBL_MAX;
+        for (int corner = 0; corner < 8; corner++) {
+            ChVector<> p((corner & 1) ? proxy->m_aabbMax.x() : proxy->m_aabbMin.x(),
+                         (corner & 2) ? proxy->m_aabbMax.y() : proxy->m_aabbMin.y(),
+                         (corner & 4) ? proxy->m_aabbMax.z() : proxy->m_aabbMin.z());
+            double pu = Vdot(p, u), pv = Vdot(p, v), pw = Vdot(p, w);
+            candidate.umin = std::min(candidate.umin, pu);
+            candidate.umax = std::max(candidate.umax, pu);
+            candidate.vmin = std::min(candidate.vmin, pv);
+            candidate.vmax = std::max(candidate.vmax, pv);
+            candidate.wmin = std::min(candidate.wmin, pw);
+            candidate.wmax = std::max(candidate.wmax, pw);
+        }
+        if (candidate.umax < umin || candidate.umin > umax || candidate.vmax < vmin || candidate.vmin > vmax)
+            continue;
+        candidates.push_back(candidate);
+    }
+    int num_objects = (int)candidates.size();
+
+    int numThreads = GetNumThreads();
+
+    // Find the rays that cross the bounding box of each object.
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (int io = 0; io < num_objects; io++) {
+        RayBatchObject& candidate = candidates[io];
+        int iu0 = std::max((int)std::floor((candidate.umin - umin) / cell), 0);
+        int iu1 = std::min((int)std::floor((candidate.umax - umin) / cell), nu - 1);
+        int iv0 = std::max((int)std::floor((candidate.vmin - vmin) / cell), 0);
+        int iv1 = std::min((int)std::floor((candidate.vmax - vmin) / cell), nv - 1);
+        for (int iv = iv0; iv <= iv1; iv++) {
+            for (int iu = iu0; iu <= iu1; iu++) {
+                int c = iu + nu * iv;
+                for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                    int i = cell_rays[k];
+                    if (ray_u[i] >= candidate.umin && ray_u[i] <= candidate.umax && ray_v[i] >= candidate.vmin &&
+                        ray_v[i] <= candidate.vmax && ray_w[i] <= candidate.wmax && ray_w[i] + length >= candidate.wmin)
+                        candidate.rays.push_back(i);
+                }
+            }
+        }
+        // Keep the order of the rays, as in a serial loop.
+        std::sort(candidate.rays.begin(), candidate.rays.end());
+    }
+
+    // Split the tests in tasks. Compound and GImpact shapes temporarily change the collision
+    // object (or the shape) while tested, so each of them is tested by a single thread.
+    std::vector<RayBatchTask> tasks;
+    for (int io = 0; io < num_objects; io++) {
+        const btCollisionShape* shape = candidates[io].object->getCollisionShape();
+        int num_object_rays = (int)candidates[io].rays.size();
+        int chunk = (shape->isCompound() || shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE) ? num_object_rays
+                                                                                              : rays_per_task;
+        for (int first = 0; first < num_object_rays; first += chunk) {
+            RayBatchTask task = {io, first, std::min(first + chunk, num_object_rays)};
+            tasks.push_back(task);
+        }
+    }
+    int num_tasks = (int)tasks.size();
+
+    // Ray tests, each task with its own list of hits.
+    std::vector<std::vector<RayBatchHit> > task_hits(num_tasks);
+    btVector3 btdir((btScalar)dir.x, (btScalar)dir.y, (btScalar)dir.z);
+
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (int it = 0; it < num_tasks; it++) {
+        const RayBatchTask& task = tasks[it];
+        btCollisionObject* object = candidates[task.object].object;
+        const std::vector<int>& rays = candidates[task.object].rays;
+        for (int k = task.first; k < task.last; k++) {
+            int i = rays[k];
+            btVector3 btfrom((btScalar)from[i].x, (btScalar)from[i].y, (btScalar)from[i].z);
+            btVector3 btto = btfrom + btdir;
+            btTransform from_trans(btMatrix3x3::getIdentity(), btfrom);
+            btTransform to_trans(btMatrix3x3::getIdentity(), btto);
+
+            btCollisionWorld::ClosestRayResultCallback rayCallback(btfrom, btto);
+            btCollisionWorld::rayTestSingle(from_trans, to_trans, object, object->getCollisionShape(),
+                                            object->getWorldTransform(), rayCallback);
+            if (rayCallback.hasHit()) {
+                RayBatchHit hit = {i, rayCallback.m_closestHitFraction, rayCallback.m_hitPointWorld,
+                                   rayCallback.m_hitNormalWorld, rayCallback.m_collisionObject};
+                task_hits[it].push_back(hit);
+            }
+        }
+    }
+
+    // Keep the closest hit of each ray.
+    std::vector<const RayBatchHit*> closest(num_rays, (const RayBatchHit*)0);
+    for (int it = 0; it < num_tasks; it++) {
+        for (size_t ih = 0; ih < task_hits[it].size(); ih++) {
+            const RayBatchHit& hit = task_hits[it][ih];
+            if (!closest[hit.ray] || hit.fraction < closest[hit.ray]->fraction)
+                closest[hit.ray] = &hit;
+        }
+    }
+
+    for (int i = 0; i < num_rays; i++) {
+        if (!closest[i])
+            continue;
+        ChRayhitResult& mresult = results[i];
+        mresult.hitModel = (ChCollisionModel*)(closest[i]->object->getUserPointer());
+        if (!mresult.hitModel)
+            continue;
+        mresult.hit = true;
+        mresult.abs_hitPoint.Set(closest[i]->point.x(), closest[i]->point.y(), closest[i]->point.z());
+        mresult.abs_hitNormal.Set(closest[i]->normal.x(), closest[i]->normal.y(), closest[i]->normal.z());
+        mresult.abs_hitNormal.Normalize();
+        mresult.dist_factor = closest[i]->fraction;
+    }
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
@@ -61,10 +61,23 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// engine (custom data may be deallocated).
     virtual void Remove(ChCollisionModel* model);
 
+    /// Removes many collision models at once: the overlapping pairs
+    /// and the list of collision objects are swept only once.
+    virtual void RemoveBatch(const std::vector<ChCollisionModel*>& models);
+
     /// Removes all collision models from the collision
     /// engine (custom data may be deallocated).
     // virtual void RemoveAll();
 
+    /// Set the number of threads used for the narrow phase (default: 1, serial).
+    /// With more threads, the overlapping pairs found by the broad phase are processed
+    /// concurrently; the reported contacts are the same, and in the same order, as in
+    /// the serial case.
+    void SetNumThreads(int nthreads);
+
+    /// Get the number of threads used for the narrow phase.
+    int GetNumThreads() const;
+
     /// Run the algorithm and finds all the contacts.
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run();
@@ -90,6 +103,16 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// Perform a raycast (ray-hit test with the collision models).
     virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult);
 
+    /// Perform a batch of raycasts with parallel rays, from the points in 'from' to from[i]+dir.
+    /// Instead of walking the broadphase for each ray, the rays are binned on a grid on the
+    /// plane orthogonal to 'dir', and each collision object is only tested against the rays
+    /// that cross the projection of its bounding box. The tests use the threads set with
+    /// SetNumThreads(); compound and GImpact shapes, which are modified while tested, are
+    /// processed by a single thread each.
+    virtual void RayHitBatch(const std::vector<ChVector<> >& from,
+                             const ChVector<>& dir,
+                             std::vector<ChRayhitResult>& results);
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
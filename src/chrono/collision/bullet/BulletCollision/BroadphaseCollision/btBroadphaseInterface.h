@@ -55,6 +55,12 @@ public:
 
 	virtual btBroadphaseProxy*	createProxy(  const btVector3& aabbMin,  const btVector3& aabbMax,int shapeType,void* userPtr, short int collisionFilterGroup,short int collisionFilterMask, btDispatcher* dispatcher,void* multiSapProxy) =0;
 	virtual void	destroyProxy(btBroadphaseProxy* proxy,btDispatcher* dispatcher)=0;
+	///destroyProxies destroys many proxies at once. Broadphases can override it, to remove the overlapping pairs of all the proxies in a single sweep of the pair cache.
+	virtual void	destroyProxies(btBroadphaseProxy** proxies,int numProxies,btDispatcher* dispatcher)
+	{
+		for (int i=0;i<numProxies;i++)
+			destroyProxy(proxies[i],dispatcher);
+	}
 	virtual void	setAabb(btBroadphaseProxy* proxy,const btVector3& aabbMin,const btVector3& aabbMax, btDispatcher* dispatcher)=0;
 	virtual void	getAabb(btBroadphaseProxy* proxy,btVector3& aabbMin, btVector3& aabbMax ) const =0;
 
@@ -203,6 +203,42 @@ void							btDbvtBroadphase::destroyProxy(	btBroadphaseProxy* absproxy,
 	m_needcleanup=true;
 }
 
+//
+struct	btDbvtRemovedPairCallback : btOverlapCallback
+{
+	virtual bool	processOverlap(btBroadphasePair& pair)
+	{
+		return	((btDbvtProxy*)pair.m_pProxy0)->leaf==0 ||
+				((btDbvtProxy*)pair.m_pProxy1)->leaf==0;
+	}
+};
+
+//
+void							btDbvtBroadphase::destroyProxies(	btBroadphaseProxy** absproxies,
+																int numProxies,
+																btDispatcher* dispatcher)
+{
+	// Take the proxies out of the trees, marking them with a null leaf
+	for(int i=0;i<numProxies;++i)
+	{
+		btDbvtProxy*	proxy=(btDbvtProxy*)absproxies[i];
+		if(proxy->stage==STAGECOUNT)
+			m_sets[1].remove(proxy->leaf);
+		else
+			m_sets[0].remove(proxy->leaf);
+		listremove(proxy,m_stageRoots[proxy->stage]);
+		proxy->leaf=0;
+	}
+	// Remove the pairs of all the marked proxies in a single sweep
+	btDbvtRemovedPairCallback	callback;
+	m_paircache->processAllOverlappingPairs(&callback,dispatcher);
+	for(int i=0;i<numProxies;++i)
+	{
+		btAlignedFree(absproxies[i]);
+	}
+	m_needcleanup=true;
+}
+
 void	btDbvtBroadphase::getAabb(btBroadphaseProxy* absproxy,btVector3& aabbMin, btVector3& aabbMax ) const
 {
 	btDbvtProxy*						proxy=(btDbvtProxy*)absproxy;
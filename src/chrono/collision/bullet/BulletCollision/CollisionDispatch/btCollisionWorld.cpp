@@ -245,6 +245,34 @@ void	btCollisionWorld::removeCollisionObject(btCollisionObject* collisionObject)
 
 }
 
+void	btCollisionWorld::removeCollisionObjects(btCollisionObject** collisionObjects,int numObjects)
+{
+	btAlignedObjectArray<btBroadphaseProxy*> proxies;
+	int i;
+	for (i=0;i<numObjects;i++)
+	{
+		btBroadphaseProxy* bp = collisionObjects[i]->getBroadphaseHandle();
+		if (bp)
+		{
+			proxies.push_back(bp);
+			collisionObjects[i]->setBroadphaseHandle(0);
+		}
+	}
+	if (proxies.size()==0)
+		return;
+
+	getBroadphase()->destroyProxies(&proxies[0],proxies.size(),m_dispatcher1);
+
+	//the removed objects are the ones left without broadphase handle: compact the array, keeping the order
+	int numKept = 0;
+	for (i=0;i<m_collisionObjects.size();i++)
+	{
+		if (m_collisionObjects[i]->getBroadphaseHandle())
+			m_collisionObjects[numKept++] = m_collisionObjects[i];
+	}
+	m_collisionObjects.resize(numKept);
+}
+
 
 
 void	btCollisionWorld::rayTestSingle(const btTransform& rayFromTrans,const btTransform& rayToTrans,
@@ -479,6 +479,9 @@ public:
 
 	virtual void	removeCollisionObject(btCollisionObject* collisionObject);
 
+	///removeCollisionObjects removes many objects at once: the overlapping pairs are swept and the object array is compacted once, instead of once per object
+	virtual void	removeCollisionObjects(btCollisionObject** collisionObjects,int numObjects);
+
 	virtual void	performDiscreteCollisionDetection();
 
 	btDispatcherInfo& getDispatchInfo()
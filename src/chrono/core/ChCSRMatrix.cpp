@@ -0,0 +1,277 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Sparse matrix in compressed sparse row (CSR) format, with a sparsity pattern
+// that is computed once and reused by subsequent assemblies.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/core/ChCSRMatrix.h"
+
+namespace chrono {
+
+ChCSRMatrix::ChCSRMatrix(int nrows, int ncols, int nonzeros)
+    : has_pattern(false), pattern_lock(true), num_symbolic(0), num_numeric(0) {
+    Reset(nrows, ncols, nonzeros);
+}
+
+int ChCSRMatrix::FindElement(int row, int col) const {
+    const int* first = colIndex.data() + rowIndex[row];
+    const int* last = colIndex.data() + rowIndex[row + 1];
+    const int* it = std::lower_bound(first, last, col);
+    if (it == last || *it != col)
+        return -1;
+    return static_cast<int>(it - colIndex.data());
+}
+
+void ChCSRMatrix::SetElement(int insrow, int inscol, double insval, bool overwrite) {
+    assert(insrow >= 0 && insrow < rows && inscol >= 0 && inscol < columns);
+
+    if (has_pattern) {
+        int pos = FindElement(insrow, inscol);
+        if (pos >= 0) {
+            if (overwrite)
+                values[pos] = insval;
+            else
+                values[pos] += insval;
+            return;
+        }
+    }
+
+    // Outside the pattern (or symbolic pass): a zero needs to be recorded only if it may
+    // overwrite an element recorded earlier in this pass.
+    if (insval == 0 && (!overwrite || pending.empty()))
+        return;
+
+    Triplet t = {insrow, inscol, insval, overwrite};
+    pending.push_back(t);
+}
+
+double ChCSRMatrix::GetElement(int row, int col) {
+    assert(row >= 0 && row < rows && col >= 0 && col < columns);
+
+    if (!IsFinalized())
+        Finalize();
+    int pos = FindElement(row, col);
+    return (pos >= 0) ? values[pos] : 0.0;
+}
+
+double& ChCSRMatrix::Element(int row, int col) {
+    assert(row >= 0 && row < rows && col >= 0 && col < columns);
+
+    if (!IsFinalized())
+        Finalize();
+    int pos = FindElement(row, col);
+    if (pos >= 0)
+        return values[pos];
+
+    // Insert a new element in the pattern, keeping the columns of the row sorted.
+    pos = static_cast<int>(std::lower_bound(colIndex.begin() + rowIndex[row], colIndex.begin() + rowIndex[row + 1], col) -
+                           colIndex.begin());
+    colIndex.insert(colIndex.begin() + pos, col);
+    values.insert(values.begin() + pos, 0.0);
+    for (int r = row + 1; r <= rows; r++)
+        rowIndex[r]++;
+    num_symbolic++;
+
+    return values[pos];
+}
+
+void ChCSRMatrix::PasteMatrix(ChMatrix<>* matra, int insrow, int inscol, bool overwrite, bool transp) {
+    int maxrows = matra->GetRows();
+    int maxcols = matra->GetColumns();
+
+    if (transp) {
+        for (int i = 0; i < maxcols; i++)
+            for (int j = 0; j < maxrows; j++)
+                SetElement(insrow + i, inscol + j, matra->GetElement(j, i), overwrite);
+    } else {
+        for (int i = 0; i < maxrows; i++)
+            for (int j = 0; j < maxcols; j++)
+                SetElement(insrow + i, inscol + j, matra->GetElement(i, j), overwrite);
+    }
+}
+
+void ChCSRMatrix::PasteMatrixFloat(ChMatrix<float>* matra, int insrow, int inscol, bool overwrite, bool transp) {
+    int maxrows = matra->GetRows();
+    int maxcols = matra->GetColumns();
+
+    if (transp) {
+        for (int i = 0; i < maxcols; i++)
+            for (int j = 0; j < maxrows; j++)
+                SetElement(insrow + i, inscol + j, matra->GetElement(j, i), overwrite);
+    } else {
+        for (int i = 0; i < maxrows; i++)
+            for (int j = 0; j < maxcols; j++)
+                SetElement(insrow + i, inscol + j, matra->GetElement(i, j), overwrite);
+    }
+}
+
+void ChCSRMatrix::PasteClippedMatrix(ChMatrix<>* matra,
+                                     int cliprow,
+                                     int clipcol,
+                                     int nrows,
+                                     int ncolumns,
+                                     int insrow,
+                                     int inscol,
+                                     bool overwrite) {
+    for (int i = 0; i < nrows; i++)
+        for (int j = 0; j < ncolumns; j++)
+            SetElement(insrow + i, inscol + j, matra->GetElement(i + cliprow, j + clipcol), overwrite);
+}
+
+void ChCSRMatrix::Reset(int nrows, int ncols, int nonzeros) {
+    pending.clear();
+
+    // Numeric pass: keep the sparsity pattern, zero the values.
+    if (pattern_lock && has_pattern && nrows == rows && ncols == columns) {
+        std::fill(values.begin(), values.end(), 0.0);
+        num_numeric++;
+        return;
+    }
+
+    // Symbolic pass: discard the sparsity pattern.
+    rows = nrows;
+    columns = ncols;
+    has_pattern = false;
+    rowIndex.assign(rows + 1, 0);
+    colIndex.clear();
+    values.clear();
+    if (nonzeros > 0)
+        pending.reserve(nonzeros);
+}
+
+bool ChCSRMatrix::Resize(int nrows, int ncols, int nonzeros) {
+    Reset(nrows, ncols, nonzeros);
+    return true;
+}
+
+void ChCSRMatrix::ResetSparsityPattern() {
+    has_pattern = false;
+    Reset(rows, columns, GetNNZ());
+}
+
+void ChCSRMatrix::ResolvePending(std::vector<Triplet>& resolved) {
+    // A stable sort preserves the insertion order of duplicates, so that the result of
+    // mixed overwrite/accumulate operations on the same element is the same as if
+    // they had been applied directly.
+    std::stable_sort(pending.begin(), pending.end(), [](const Triplet& a, const Triplet& b) {
+        return a.row < b.row || (a.row == b.row && a.col < b.col);
+    });
+
+    resolved.clear();
+    resolved.reserve(pending.size());
+    size_t i = 0;
+    while (i < pending.size()) {
+        Triplet t = pending[i];
+        double val = 0;
+        for (; i < pending.size() && pending[i].row == t.row && pending[i].col == t.col; i++)
+            val = pending[i].overwrite ? pending[i].val : val + pending[i].val;
+        if (val != 0) {
+            t.val = val;
+            resolved.push_back(t);
+        }
+    }
+    pending.clear();
+}
+
+void ChCSRMatrix::Finalize() {
+    if (IsFinalized())
+        return;
+
+    std::vector<Triplet> resolved;
+    ResolvePending(resolved);
+
+    if (!has_pattern) {
+        // Symbolic pass: build the pattern from the sorted elements.
+        rowIndex.assign(rows + 1, 0);
+        colIndex.resize(resolved.size());
+        values.resize(resolved.size());
+        for (size_t k = 0; k < resolved.size(); k++) {
+            rowIndex[resolved[k].row + 1]++;
+            colIndex[k] = resolved[k].col;
+            values[k] = resolved[k].val;
+        }
+        for (int r = 0; r < rows; r++)
+            rowIndex[r + 1] += rowIndex[r];
+        has_pattern = true;
+        num_symbolic++;
+        return;
+    }
+
+    if (resolved.empty())
+        return;
+
+    // Merge the new elements into the existing pattern, row by row.
+    int nnz = GetNNZ();
+    std::vector<int> new_rowIndex(rows + 1, 0);
+    std::vector<int> new_colIndex(nnz + resolved.size());
+    std::vector<double> new_values(nnz + resolved.size());
+
+    size_t k = 0;
+    int pos = 0;
+    for (int r = 0; r < rows; r++) {
+        int j = rowIndex[r];
+        int jend = rowIndex[r + 1];
+        while (j < jend || (k < resolved.size() && resolved[k].row == r)) {
+            if (k < resolved.size() && resolved[k].row == r && (j == jend || resolved[k].col < colIndex[j])) {
+                new_colIndex[pos] = resolved[k].col;
+                new_values[pos] = resolved[k].val;
+                k++;
+            } else {
+                new_colIndex[pos] = colIndex[j];
+                new_values[pos] = values[j];
+                j++;
+            }
+            pos++;
+        }
+        new_rowIndex[r + 1] = pos;
+    }
+
+    rowIndex.swap(new_rowIndex);
+    colIndex.swap(new_colIndex);
+    values.swap(new_values);
+    num_symbolic++;
+}
+
+void ChCSRMatrix::CopyToMatrix(ChMatrix<>* matra) {
+    if (!IsFinalized())
+        Finalize();
+
+    matra->Reset(rows, columns);
+    for (int r = 0; r < rows; r++)
+        for (int j = rowIndex[r]; j < rowIndex[r + 1]; j++)
+            matra->SetElement(r, colIndex[j], values[j]);
+}
+
+void ChCSRMatrix::StreamOUTsparseMatlabFormat(ChStreamOutAscii& mstream) {
+    if (!IsFinalized())
+        Finalize();
+
+    // As in ChLinkedListMatrix, the last element is always written so that the size can be recovered.
+    bool last_written = false;
+    for (int r = 0; r < rows; r++) {
+        for (int j = rowIndex[r]; j < rowIndex[r + 1]; j++) {
+            bool last = (r + 1 == rows && colIndex[j] + 1 == columns);
+            if (values[j] || last) {
+                mstream << r + 1 << " " << colIndex[j] + 1 << " " << values[j] << "\n";
+                last_written |= last;
+            }
+        }
+    }
+    if (!last_written && rows > 0 && columns > 0)
+        mstream << rows << " " << columns << " " << 0.0 << "\n";
+}
+
+}  // end namespace chrono
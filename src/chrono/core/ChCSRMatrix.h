@@ -0,0 +1,141 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Sparse matrix in compressed sparse row (CSR) format, with a sparsity pattern
+// that is computed once and reused by subsequent assemblies.
+//
+// =============================================================================
+
+#ifndef CHCSRMATRIX_H
+#define CHCSRMATRIX_H
+
+#include <vector>
+
+#include "chrono/core/ChSparseMatrix.h"
+#include "chrono/core/ChStream.h"
+
+namespace chrono {
+
+/// Sparse matrix in compressed sparse row (CSR) format, with 0-based indexing.
+/// The matrix is assembled in two passes:
+/// - symbolic pass: the first time the matrix is filled after a Reset() to a new size,
+///   the elements are only recorded as (row, column, value) triplets; Finalize() sorts them,
+///   merges the duplicates and builds the row index / column index arrays (the sparsity pattern).
+/// - numeric pass: when the matrix is Reset() to the same size, the sparsity pattern is kept
+///   and only the values are zeroed; SetElement() and the Paste functions then just locate the
+///   element in its row (binary search) and overwrite or accumulate its value.
+/// Nonzero elements that fall outside the current pattern during a numeric pass are
+/// buffered and merged into the pattern by Finalize(), which counts as a new symbolic pass.
+/// Elements of the pattern that are not set in a numeric pass are kept as explicit zeros.
+/// Finalize() is called by ChSystemDescriptor::ConvertToMatrixForm(); when filling the
+/// matrix by hand, call it before accessing the CSR arrays.
+class ChApi ChCSRMatrix : public ChSparseMatrix {
+  public:
+    /// Create a sparse matrix with given size; the nonzeros argument is an estimate
+    /// of the number of nonzero elements, used to reserve memory for the symbolic pass.
+    ChCSRMatrix(int nrows = 3, int ncols = 3, int nonzeros = 0);
+    virtual ~ChCSRMatrix() {}
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override;
+    virtual double GetElement(int row, int col) override;
+
+    /// Access an element by reference; if the element is not in the sparsity pattern, it is
+    /// inserted (slow, since the CSR arrays must be shifted).
+    virtual double& Element(int row, int col) override;
+
+    virtual void PasteMatrix(ChMatrix<>* matra, int insrow, int inscol, bool overwrite = true, bool transp = false) override;
+    virtual void PasteMatrixFloat(ChMatrix<float>* matra,
+                                  int insrow,
+                                  int inscol,
+                                  bool overwrite = true,
+                                  bool transp = false) override;
+    virtual void PasteClippedMatrix(ChMatrix<>* matra,
+                                    int cliprow,
+                                    int clipcol,
+                                    int nrows,
+                                    int ncolumns,
+                                    int insrow,
+                                    int inscol,
+                                    bool overwrite = true) override;
+
+    /// Reset to null matrix. If the size is unchanged and the sparsity pattern is locked,
+    /// the pattern is kept and the next assembly is a numeric pass only.
+    virtual void Reset(int nrows, int ncols, int nonzeros = 0) override;
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override;
+
+    /// Complete the assembly: build the sparsity pattern from the elements recorded in the
+    /// symbolic pass, or merge into it the elements that did not fit during a numeric pass.
+    virtual void Finalize() override;
+
+    /// Discard the sparsity pattern; the next assembly will be a symbolic pass.
+    /// Useful to prune explicit zeros left by elements that are no longer set.
+    void ResetSparsityPattern();
+
+    /// Enable/disable reuse of the sparsity pattern across Reset() calls (default: enabled).
+    /// If disabled, every assembly is a symbolic pass.
+    void SetSparsityPatternLock(bool val) { pattern_lock = val; }
+    bool GetSparsityPatternLock() const { return pattern_lock; }
+
+    /// Return true if the sparsity pattern is built and no element is waiting for Finalize().
+    bool IsFinalized() const { return has_pattern && pending.empty(); }
+
+    /// Number of elements in the sparsity pattern.
+    int GetNNZ() const { return rowIndex.empty() ? 0 : rowIndex.back(); }
+
+    /// Number of times the sparsity pattern was (re)built.
+    int GetNumSymbolicPasses() const { return num_symbolic; }
+    /// Number of assemblies that reused an existing sparsity pattern.
+    int GetNumNumericPasses() const { return num_numeric; }
+
+    /// Access the CSR arrays (valid only after Finalize()).
+    const int* GetRowIndexAddress() const { return rowIndex.data(); }
+    const int* GetColIndexAddress() const { return colIndex.data(); }
+    double* GetValuesAddress() { return values.data(); }
+    const double* GetValuesAddress() const { return values.data(); }
+
+    /// Copy to a dense matrix, resizing it if needed.
+    void CopyToMatrix(ChMatrix<>* matra);
+
+    /// Method to allow serializing transient data into in ascii
+    /// as a 'sparse' matrix format (row, column, value), 1-based indexing,
+    /// as in Matlab.
+    void StreamOUTsparseMatlabFormat(ChStreamOutAscii& mstream);
+
+  private:
+    struct Triplet {
+        int row;
+        int col;
+        double val;
+        bool overwrite;
+    };
+
+    /// Position of element (row, col) in the CSR arrays, or -1 if not in the pattern.
+    int FindElement(int row, int col) const;
+
+    /// Sort the pending triplets and merge duplicates in insertion order.
+    /// Elements that resolve to zero are discarded.
+    void ResolvePending(std::vector<Triplet>& resolved);
+
+    std::vector<int> rowIndex;     ///< start of each row in colIndex and values (size rows+1)
+    std::vector<int> colIndex;     ///< column of each element, sorted within each row
+    std::vector<double> values;    ///< value of each element
+    std::vector<Triplet> pending;  ///< elements set outside the sparsity pattern, in insertion order
+
+    bool has_pattern;   ///< the sparsity pattern has been built for the current size
+    bool pattern_lock;  ///< keep the sparsity pattern across Reset() calls
+    int num_symbolic;
+    int num_numeric;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -40,9 +40,16 @@ namespace chrono {
 
 static ChLog* GlobalLog = NULL;
 
+// The pointer to the logger of the calling thread, if any (it has priority
+// over the global logger)
+
+static thread_local ChLog* ThreadLog = NULL;
+
 // Functions to set/get the global logger
 
 ChLog& GetLog() {
+    if (ThreadLog != NULL)
+        return (*ThreadLog);
     if (GlobalLog != NULL)
         return (*GlobalLog);
     else {
@@ -59,6 +66,14 @@ void SetLogDefault() {
     GlobalLog = NULL;
 }
 
+void SetThreadLog(ChLog& new_logobject) {
+    ThreadLog = &new_logobject;
+}
+
+void SetThreadLogDefault() {
+    ThreadLog = NULL;
+}
+
 //
 // Logger class
 //
@@ -129,6 +129,14 @@ ChApi void SetLog(ChLog& new_logobject);
 /// Global function to set the default ChLogConsole output to std::output.
 ChApi void SetLogDefault();
 
+/// Set a ChLog object to be returned by GetLog() in the calling thread only,
+/// instead of the global one. This keeps the messages of independent
+/// simulations run in different threads apart (see ChBatchRunner).
+ChApi void SetThreadLog(ChLog& new_logobject);
+
+/// Go back to the global ChLog object in the calling thread.
+ChApi void SetThreadLogDefault();
+
 }  // END_OF_NAMESPACE____
 
 #endif  // END of header
@@ -19,6 +19,7 @@
 //
 //   Base matrix class for all sparse matrices:
 //		- ChLinkedListMatrix
+//      - ChCSRMatrix
 //      - ChCSR3Matrix
 //
 //   HEADER file for CHRONO,
@@ -61,6 +62,10 @@ namespace chrono {
 		virtual void Reset(int row, int col, int nonzeros = 0){ assert(0); };
 		virtual bool Resize(int nrows, int ncols, int nonzeros = 0){ assert(0); return 1; };
 
+		/// Complete the assembly of the matrix; called by ChSystemDescriptor::ConvertToMatrixForm()
+		/// after all the elements have been set. By default it does nothing.
+		virtual void Finalize(){};
+
 		// Redirected functions
 		virtual void PasteTranspMatrix(ChMatrix<>* matra, int insrow, int inscol){ PasteMatrix(matra, insrow, inscol, true, true); };
 		virtual void PasteSumMatrix(ChMatrix<>* matra, int insrow, int inscol){ PasteMatrix(matra, insrow, inscol, false, false); };
@@ -0,0 +1,142 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Per-phase profiler of the simulation steps, with a history of the last steps
+// that can be exported in CSV or JSON format.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/core/ChStepProfiler.h"
+
+namespace chrono {
+
+static const char* phase_names[ChStepProfiler::NUM_PHASES] = {
+    "step", "collision_broad", "collision_narrow", "setup", "update", "descriptor", "krm_load", "solve", "contact_forces"};
+
+ChStepProfiler::ChStepProfiler(int history_length) : m_enabled(false), m_in_step(false) {
+    SetHistoryLength(history_length);
+}
+
+void ChStepProfiler::Enable(bool val) {
+    m_enabled = val;
+    m_in_step = false;
+    // The history is allocated only when the profiler is first enabled.
+    if (m_enabled && (int)m_history.size() != m_history_length)
+        m_history.resize(m_history_length);
+}
+
+void ChStepProfiler::SetHistoryLength(int length) {
+    m_history_length = std::max(length, 1);
+    std::vector<StepRecord>().swap(m_history);
+    if (m_enabled)
+        m_history.resize(m_history_length);
+    Reset();
+}
+
+void ChStepProfiler::Reset() {
+    m_in_step = false;
+    m_next = 0;
+    m_count = 0;
+    m_num_steps = 0;
+    std::fill(m_total_time, m_total_time + NUM_PHASES, 0.0);
+    std::fill(m_total_calls, m_total_calls + NUM_PHASES, 0LL);
+}
+
+void ChStepProfiler::BeginStepRecord(long long step, double time) {
+    m_current.step = step;
+    m_current.time = time;
+    std::fill(m_current.phase_time, m_current.phase_time + NUM_PHASES, 0.0);
+    std::fill(m_current.phase_calls, m_current.phase_calls + NUM_PHASES, 0);
+    std::fill(m_depth, m_depth + NUM_PHASES, 0);
+    m_in_step = true;
+}
+
+void ChStepProfiler::EndStepRecord() {
+    if (!m_in_step)
+        return;
+    m_in_step = false;
+
+    m_history[m_next] = m_current;
+    m_next = (m_next + 1) % (int)m_history.size();
+    m_count = std::min(m_count + 1, (int)m_history.size());
+
+    m_num_steps++;
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_total_time[i] += m_current.phase_time[i];
+        m_total_calls[i] += m_current.phase_calls[i];
+    }
+}
+
+const ChStepProfiler::StepRecord& ChStepProfiler::GetRecord(int i) const {
+    int first = (m_next - m_count + (int)m_history.size()) % (int)m_history.size();
+    return m_history[(first + i) % m_history.size()];
+}
+
+const char* ChStepProfiler::GetPhaseName(Phase phase) {
+    return phase_names[phase];
+}
+
+void ChStepProfiler::WriteCSV(std::ostream& stream, char separator) const {
+    std::streamsize old_precision = stream.precision(9);
+
+    stream << "step" << separator << "time";
+    for (int i = 0; i < NUM_PHASES; i++)
+        stream << separator << phase_names[i] << separator << phase_names[i] << "_calls";
+    stream << "\n";
+
+    for (int r = 0; r < m_count; r++) {
+        const StepRecord& rec = GetRecord(r);
+        stream << rec.step << separator << rec.time;
+        for (int i = 0; i < NUM_PHASES; i++)
+            stream << separator << rec.phase_time[i] << separator << rec.phase_calls[i];
+        stream << "\n";
+    }
+
+    stream.precision(old_precision);
+}
+
+void ChStepProfiler::WriteJSON(std::ostream& stream) const {
+    std::streamsize old_precision = stream.precision(9);
+
+    stream << "{\n  \"phases\": [";
+    for (int i = 0; i < NUM_PHASES; i++)
+        stream << (i ? ", " : "") << "\"" << phase_names[i] << "\"";
+    stream << "],\n";
+
+    stream << "  \"num_steps\": " << m_num_steps << ",\n";
+    stream << "  \"totals\": {";
+    for (int i = 0; i < NUM_PHASES; i++) {
+        stream << (i ? ", " : "") << "\"" << phase_names[i] << "\": {\"time\": " << m_total_time[i]
+               << ", \"calls\": " << m_total_calls[i] << "}";
+    }
+    stream << "},\n";
+
+    stream << "  \"steps\": [";
+    for (int r = 0; r < m_count; r++) {
+        const StepRecord& rec = GetRecord(r);
+        stream << (r ? ",\n" : "\n") << "    {\"step\": " << rec.step << ", \"time\": " << rec.time
+               << ", \"phase_time\": [";
+        for (int i = 0; i < NUM_PHASES; i++)
+            stream << (i ? ", " : "") << rec.phase_time[i];
+        stream << "], \"phase_calls\": [";
+        for (int i = 0; i < NUM_PHASES; i++)
+            stream << (i ? ", " : "") << rec.phase_calls[i];
+        stream << "]}";
+    }
+    stream << (m_count ? "\n  ]\n" : "]\n") << "}\n";
+
+    stream.precision(old_precision);
+}
+
+}  // end namespace chrono
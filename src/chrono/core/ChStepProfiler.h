@@ -0,0 +1,184 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Per-phase profiler of the simulation steps, with a history of the last steps
+// that can be exported in CSV or JSON format.
+//
+// =============================================================================
+
+#ifndef CHSTEPPROFILER_H
+#define CHSTEPPROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Profiler of the phases of the simulation steps of a ChSystem.
+/// For each step, the time spent in each phase and the number of times the phase was
+/// entered are recorded in a ring buffer that keeps the last steps (see SetHistoryLength()),
+/// and accumulated in totals since the last Reset(). The history can be written in CSV
+/// or JSON format.
+/// The profiler is disabled by default: then the scoped timers only test a flag, so the
+/// profiling points can stay in the code at (almost) no cost.
+/// The time of a phase includes the time of the phases nested in it (for example, the
+/// step includes all other phases).
+class ChApi ChStepProfiler {
+  public:
+    /// Profiled phases of a step.
+    enum Phase {
+        PHASE_STEP,              ///< whole step
+        PHASE_COLLISION_BROAD,   ///< collision detection: model synchronization and broad phase
+        PHASE_COLLISION_NARROW,  ///< collision detection: narrow phase and contact reporting
+        PHASE_SETUP,             ///< counting of coordinates and constraints (Setup)
+        PHASE_UPDATE,            ///< update of the physics items (Update)
+        PHASE_DESCRIPTOR,        ///< injection of variables and constraints, loads to/from the descriptor
+        PHASE_KRM_LOAD,          ///< loading of the K, R, M matrix blocks
+        PHASE_SOLVE,             ///< solver
+        PHASE_CONTACT_FORCES,    ///< gathering of the contact forces on the bodies
+        NUM_PHASES
+    };
+
+    /// Timing of a step.
+    struct StepRecord {
+        long long step;                 ///< index of the step
+        double time;                    ///< simulation time at the beginning of the step
+        double phase_time[NUM_PHASES];  ///< time (in seconds) spent in each phase
+        int phase_calls[NUM_PHASES];    ///< number of times each phase was entered
+    };
+
+    /// Scoped timer: measures the given phase during its lifetime, if the profiler is enabled.
+    class Scope {
+      public:
+        Scope(ChStepProfiler& profiler, Phase phase) : m_profiler(profiler.m_enabled ? &profiler : 0), m_phase(phase) {
+            if (m_profiler)
+                m_profiler->Start(m_phase);
+        }
+        /// Same as above, doing nothing if the profiler is NULL.
+        Scope(ChStepProfiler* profiler, Phase phase)
+            : m_profiler(profiler && profiler->m_enabled ? profiler : 0), m_phase(phase) {
+            if (m_profiler)
+                m_profiler->Start(m_phase);
+        }
+        ~Scope() {
+            if (m_profiler)
+                m_profiler->Stop(m_phase);
+        }
+
+      private:
+        ChStepProfiler* m_profiler;
+        Phase m_phase;
+    };
+
+    ChStepProfiler(int history_length = 1000);
+
+    /// Enable or disable the profiler (disabled by default).
+    void Enable(bool val);
+
+    /// Return true if the profiler is enabled.
+    bool IsEnabled() const { return m_enabled; }
+
+    /// Set the number of steps kept in the history (default 1000). The history is cleared.
+    /// The memory of the history is allocated when the profiler is enabled.
+    void SetHistoryLength(int length);
+
+    /// Get the number of steps kept in the history.
+    int GetHistoryLength() const { return m_history_length; }
+
+    /// Clear the history and the totals.
+    void Reset();
+
+    /// Start a new step (called by ChSystem). Phases measured outside a step are ignored.
+    void BeginStep(long long step, double time) {
+        if (!m_enabled)
+            return;
+        BeginStepRecord(step, time);
+    }
+
+    /// End the current step and store it in the history (called by ChSystem).
+    void EndStep() {
+        if (!m_enabled)
+            return;
+        EndStepRecord();
+    }
+
+    /// Start measuring a phase (prefer the Scope class).
+    void Start(Phase phase) {
+        if (!m_enabled || !m_in_step)
+            return;
+        if (m_depth[phase]++ == 0)
+            m_start[phase] = Clock::now();
+        m_current.phase_calls[phase]++;
+    }
+
+    /// Stop measuring a phase (prefer the Scope class).
+    void Stop(Phase phase) {
+        if (!m_enabled || !m_in_step || m_depth[phase] == 0)
+            return;
+        if (--m_depth[phase] == 0)
+            m_current.phase_time[phase] += std::chrono::duration<double>(Clock::now() - m_start[phase]).count();
+    }
+
+    /// Number of steps in the history (at most the history length).
+    int GetNumRecords() const { return m_count; }
+
+    /// Get a step of the history: 0 is the oldest, GetNumRecords()-1 the last step.
+    const StepRecord& GetRecord(int i) const;
+
+    /// Get the number of steps recorded since the last Reset().
+    long long GetNumSteps() const { return m_num_steps; }
+
+    /// Get the total time (in seconds) spent in a phase since the last Reset().
+    double GetTotalTime(Phase phase) const { return m_total_time[phase]; }
+
+    /// Get the total number of calls of a phase since the last Reset().
+    long long GetTotalCalls(Phase phase) const { return m_total_calls[phase]; }
+
+    /// Get the name of a phase, as used in the CSV and JSON output.
+    static const char* GetPhaseName(Phase phase);
+
+    /// Write the history in CSV format: one line per step, with the step index, the
+    /// simulation time, and the time (in seconds) and number of calls of each phase.
+    void WriteCSV(std::ostream& stream, char separator = ',') const;
+
+    /// Write the history and the totals in JSON format.
+    void WriteJSON(std::ostream& stream) const;
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    void BeginStepRecord(long long step, double time);
+    void EndStepRecord();
+
+    bool m_enabled;
+    bool m_in_step;
+
+    StepRecord m_current;                   ///< step being measured
+    Clock::time_point m_start[NUM_PHASES];  ///< start time of the phases being measured
+    int m_depth[NUM_PHASES];                ///< nesting level of the phases being measured
+
+    std::vector<StepRecord> m_history;  ///< ring buffer of the last steps (allocated by Enable())
+    int m_history_length;               ///< number of steps kept in the history
+    int m_next;                         ///< position of the next record in the ring buffer
+    int m_count;                        ///< number of records in the ring buffer
+
+    long long m_num_steps;
+    double m_total_time[NUM_PHASES];
+    long long m_total_calls[NUM_PHASES];
+};
+
+}  // end namespace chrono
+
+#endif
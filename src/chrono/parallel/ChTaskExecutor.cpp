@@ -0,0 +1,188 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Task executor with work-stealing queues.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/parallel/ChTaskExecutor.h"
+
+namespace chrono {
+
+// Executor and thread index of the current thread, used by Submit() to push tasks
+// created inside other tasks into the queue of the executing thread.
+static thread_local ChTaskExecutor* tls_executor = nullptr;
+static thread_local int tls_thread = 0;
+
+ChTaskExecutor::ChTaskExecutor(int nthreads) : num_queued(0), num_pending(0), next_queue(0), stop(false) {
+    Start(nthreads);
+}
+
+ChTaskExecutor::~ChTaskExecutor() {
+    Stop();
+}
+
+void ChTaskExecutor::SetNumThreads(int nthreads) {
+    if (nthreads < 1)
+        nthreads = 1;
+    if (nthreads == GetNumThreads())
+        return;
+    Stop();
+    Start(nthreads);
+}
+
+void ChTaskExecutor::Start(int nthreads) {
+    if (nthreads < 1)
+        nthreads = 1;
+
+    stop = false;
+    queues.clear();
+    for (int i = 0; i < nthreads; i++)
+        queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+    for (int i = 1; i < nthreads; i++)
+        workers.push_back(std::thread(&ChTaskExecutor::WorkerLoop, this, i));
+}
+
+void ChTaskExecutor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stop = true;
+    }
+    wake_cv.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    workers.clear();
+}
+
+void ChTaskExecutor::Push(int queue, const Task& task) {
+    num_pending++;
+    {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        queues[queue]->tasks.push_back(task);
+    }
+    num_queued++;
+}
+
+void ChTaskExecutor::Submit(const Task& task) {
+    int queue;
+    if (tls_executor == this)
+        queue = tls_thread;
+    else
+        queue = (int)(next_queue++ % queues.size());
+    Push(queue, task);
+
+    // Taking the lock guarantees that a worker checking for queued tasks either sees
+    // this one or is already waiting for the notification.
+    { std::lock_guard<std::mutex> lock(wake_mutex); }
+    wake_cv.notify_one();
+}
+
+bool ChTaskExecutor::TakeTask(int thread, Task& task) {
+    int n = (int)queues.size();
+
+    // Own queue, newest task first.
+    {
+        TaskQueue& q = *queues[thread];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            num_queued--;
+            return true;
+        }
+    }
+
+    // Steal the oldest task from the other queues.
+    for (int k = 1; k < n; k++) {
+        TaskQueue& q = *queues[(thread + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            num_queued--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ChTaskExecutor::WorkerLoop(int thread) {
+    tls_executor = this;
+    tls_thread = thread;
+
+    Task task;
+    while (true) {
+        if (TakeTask(thread, task)) {
+            task(thread);
+            task = nullptr;
+            num_pending--;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        wake_cv.wait(lock, [this]() { return stop || num_queued > 0; });
+        if (stop && num_queued == 0)
+            return;
+    }
+}
+
+void ChTaskExecutor::Wait() {
+    ChTaskExecutor* old_executor = tls_executor;
+    int old_thread = tls_thread;
+    tls_executor = this;
+    tls_thread = 0;
+
+    Task task;
+    while (num_pending > 0) {
+        if (TakeTask(0, task)) {
+            task(0);
+            task = nullptr;
+            num_pending--;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    tls_executor = old_executor;
+    tls_thread = old_thread;
+}
+
+void ChTaskExecutor::ParallelFor(int begin, int end, int grain, const RangeFunction& func) {
+    if (end <= begin)
+        return;
+
+    int nthreads = GetNumThreads();
+    if (grain <= 0)
+        grain = std::max(1, (end - begin) / (8 * nthreads));
+
+    if (nthreads == 1 || end - begin <= grain) {
+        func(begin, end, 0);
+        return;
+    }
+
+    // Spread the chunks over all queues, then wake up all workers.
+    int queue = 0;
+    for (int from = begin; from < end; from += grain) {
+        int to = std::min(end, from + grain);
+        Push(queue, [&func, from, to](int thread) { func(from, to, thread); });
+        queue = (queue + 1) % nthreads;
+    }
+    { std::lock_guard<std::mutex> lock(wake_mutex); }
+    wake_cv.notify_all();
+
+    Wait();
+}
+
+}  // end namespace chrono
@@ -0,0 +1,104 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Task executor with work-stealing queues.
+//
+// =============================================================================
+
+#ifndef CHTASKEXECUTOR_H
+#define CHTASKEXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Pool of worker threads executing tasks from work-stealing queues.
+/// Each thread owns a queue: it takes its own tasks in LIFO order and, when its queue
+/// is empty, steals the oldest tasks from the queues of the other threads, so that the
+/// load is balanced even if the tasks have very different costs.
+/// The thread that calls Wait() or ParallelFor() takes part in the execution as thread 0;
+/// an executor with N threads thus starts N-1 workers.
+/// Tasks receive the index (0..N-1) of the thread that runs them, which can be used to
+/// address per-thread data without locks. Tasks must not throw exceptions.
+/// Wait() and ParallelFor() must be called by the thread that owns the executor, not
+/// from inside a task; Submit() can also be called from inside a task.
+class ChApi ChTaskExecutor {
+  public:
+    /// Task to be executed; the argument is the index of the executing thread.
+    typedef std::function<void(int)> Task;
+
+    /// Function executed on a range [from, to) of a ParallelFor(); the last argument
+    /// is the index of the executing thread.
+    typedef std::function<void(int, int, int)> RangeFunction;
+
+    ChTaskExecutor(int nthreads = 1);
+    ~ChTaskExecutor();
+
+    /// Change the number of threads (including the calling thread). Must not be called
+    /// while tasks are pending.
+    void SetNumThreads(int nthreads);
+
+    /// Get the number of threads (including the calling thread).
+    int GetNumThreads() const { return (int)queues.size(); }
+
+    /// Add a task to the queue of the calling thread (or, if the caller is not a thread
+    /// of this executor, to the queues of the workers in round-robin order).
+    void Submit(const Task& task);
+
+    /// Execute tasks until all the submitted tasks are completed.
+    void Wait();
+
+    /// Split the range [begin, end) in chunks of at most 'grain' elements and execute
+    /// func on all of them; return when all chunks are completed. If grain <= 0, a grain
+    /// is chosen so that there are a few chunks per thread. With one thread, or a single
+    /// chunk, func is called directly by the calling thread.
+    void ParallelFor(int begin, int end, int grain, const RangeFunction& func);
+
+  private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    ChTaskExecutor(const ChTaskExecutor&);
+    ChTaskExecutor& operator=(const ChTaskExecutor&);
+
+    void Start(int nthreads);
+    void Stop();
+    void Push(int queue, const Task& task);
+    bool TakeTask(int thread, Task& task);
+    void WorkerLoop(int thread);
+
+    std::vector<std::unique_ptr<TaskQueue> > queues;  ///< one queue per thread (0: calling thread)
+    std::vector<std::thread> workers;                 ///< worker threads 1..N-1
+
+    std::atomic<int> num_queued;   ///< tasks waiting in the queues
+    std::atomic<int> num_pending;  ///< tasks submitted and not yet completed
+    std::atomic<unsigned int> next_queue;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool stop;
+};
+
+}  // end namespace chrono
+
+#endif
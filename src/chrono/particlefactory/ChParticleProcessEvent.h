@@ -69,12 +69,14 @@ class ChParticleProcessEventRemove : public ChParticleProcessEvent {
 
     virtual void SetupPreProcess(ChSystem& msystem) { to_delete.clear(); }
 
+    /// Remove all the processed particles at once (see ChAssembly::RemoveBatch()).
     virtual void SetupPostProcess(ChSystem& msystem) {
         std::list<std::shared_ptr<ChBody> >::iterator ibody = to_delete.begin();
         while (ibody != to_delete.end()) {
-            msystem.Remove((*ibody));
+            msystem.RemoveBatch((*ibody));
             ++ibody;
         }
+        msystem.FlushBatch();
     }
 };
 
@@ -14,6 +14,8 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <typeinfo>
+#include <unordered_set>
 
 #include "chrono/core/ChLinearAlgebra.h"
 #include "chrono/core/ChTransform.h"
@@ -174,7 +176,62 @@ void ChAssembly::AddBatch(std::shared_ptr<ChPhysicsItem> newitem) {
     this->batch_to_insert.push_back(newitem);
 }
 
+void ChAssembly::RemoveBatch(std::shared_ptr<ChPhysicsItem> olditem) {
+    this->batch_to_remove.push_back(olditem);
+}
+
+// Move the items of 'list' that are in the set 'marked' to 'removed', keeping the order of the
+// other items. Linear time, whatever the number of removed items.
+template <class T>
+static void CompactList(std::vector<std::shared_ptr<T>>& list,
+                        const std::unordered_set<ChPhysicsItem*>& marked,
+                        std::vector<std::shared_ptr<T>>& removed) {
+    size_t nkept = 0;
+    for (size_t ip = 0; ip < list.size(); ++ip) {
+        if (marked.count(list[ip].get()))
+            removed.push_back(list[ip]);
+        else
+            list[nkept++] = list[ip];
+    }
+    list.resize(nkept);
+}
+
 void ChAssembly::FlushBatch() {
+    if (!batch_to_remove.empty()) {
+        std::unordered_set<ChPhysicsItem*> marked;
+        for (size_t i = 0; i < batch_to_remove.size(); ++i)
+            marked.insert(batch_to_remove[i].get());
+
+        std::vector<std::shared_ptr<ChBody>> removed_bodies;
+        std::vector<std::shared_ptr<ChLink>> removed_links;
+        std::vector<std::shared_ptr<ChPhysicsItem>> removed_items;
+        CompactList(bodylist, marked, removed_bodies);
+        CompactList(linklist, marked, removed_links);
+        CompactList(otherphysicslist, marked, removed_items);
+
+        // remove the collision models of the bodies all together; then SetSystem(0) will not
+        // find them in the collision system anymore
+        if (GetSystem() && GetSystem()->GetCollisionSystem()) {
+            std::vector<ChCollisionModel*> models;
+            for (size_t i = 0; i < removed_bodies.size(); ++i) {
+                if (removed_bodies[i]->GetCollide() && removed_bodies[i]->GetCollisionModel())
+                    models.push_back(removed_bodies[i]->GetCollisionModel());
+            }
+            if (!models.empty())
+                GetSystem()->GetCollisionSystem()->RemoveBatch(models);
+        }
+
+        // nullify backward link to system
+        for (size_t i = 0; i < removed_bodies.size(); ++i)
+            removed_bodies[i]->SetSystem(0);
+        for (size_t i = 0; i < removed_links.size(); ++i)
+            removed_links[i]->SetSystem(0);
+        for (size_t i = 0; i < removed_items.size(); ++i)
+            removed_items[i]->SetSystem(0);
+
+        batch_to_remove.clear();
+    }
+
     for (int i = 0; i < this->batch_to_insert.size(); ++i) {
         this->Add(batch_to_insert[i]);
     }
@@ -522,6 +579,14 @@ void ChAssembly::SyncCollisionModels() {
 // -----------------------------------------------------------------------------
 // UPDATING ROUTINES
 
+// Number of threads for the loops over bodies and links in the updating routines below.
+// Each body (or link) only writes its own data and the state/residual entries at its own
+// offsets, so these loops need no locks. Loops over other physics items stay serial,
+// because such items may write to entries of other items (e.g. loads acting on bodies).
+static int UpdateThreadNumber(ChSystem* msystem) {
+    return msystem ? msystem->GetParallelUpdateThreadNumber() : 1;
+}
+
 // COUNT ALL BODIES AND LINKS, ETC, COMPUTE &SET DOF FOR STATISTICS,
 // ALLOCATES OR REALLOCATE BOOKKEEPING DATA/VECTORS, IF ANY
 void ChAssembly::Setup() {
@@ -621,13 +686,17 @@ void ChAssembly::Setup() {
 // - UPDATES ALL FORCES  (AUTOMATIC, AS CHILDREN OF BODIES)
 // - UPDATES ALL MARKERS (AUTOMATIC, AS CHILDREN OF BODIES).
 void ChAssembly::Update(bool update_assets) {
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
+    int nthreads = UpdateThreadNumber(system);
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
         bodylist[ip]->Update(ChTime, update_assets);
     }
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->Update(ChTime, update_assets);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
         linklist[ip]->Update(ChTime, update_assets);
     }
 }
@@ -652,16 +721,24 @@ void ChAssembly::IntStateGather(const unsigned int off_x,  ///< offset in x stat
 {
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
+    int nthreads = UpdateThreadNumber(system);
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+    // Items write their time in a private variable; T is set at the end anyway.
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
+        double T_item;
         if (Bpointer->IsActive())
-            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
+            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v,
+                                     T_item);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
+        double T_item;
         if (Lpointer->IsActive())
-            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v, T);
+            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v,
+                                     T_item);
     }
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
@@ -678,14 +755,17 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,  ///< offset in x sta
 {
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
+    int nthreads = UpdateThreadNumber(system);
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntStateScatter(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
         if (Lpointer->IsActive())
             Lpointer->IntStateScatter(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v, T);
     }
@@ -809,12 +889,15 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
                                    const double c)          ///< a scaling factor
 {
     unsigned int displ_v = off - this->offset_w;
+    int nthreads = UpdateThreadNumber(system);
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_F(displ_v + Bpointer->GetOffset_w(), R, c);
     }
+    // Links may apply forces to the bodies they connect, so this loop is serial.
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
@@ -832,14 +915,17 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
                                     const double c               ///< a scaling factor
                                     ) {
     unsigned int displ_v = off - this->offset_w;
+    int nthreads = UpdateThreadNumber(system);
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        ChBody* Bpointer = bodylist[ip].get();
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_Mv(displ_v + Bpointer->GetOffset_w(), R, w, c);
     }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        std::shared_ptr<ChLink> Lpointer = linklist[ip];
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        ChLink* Lpointer = linklist[ip].get();
         if (Lpointer->IsActive())
             Lpointer->IntLoadResidual_Mv(displ_v + Lpointer->GetOffset_w(), R, w, c);
     }
@@ -975,8 +1061,25 @@ void ChAssembly::IntFromDescriptor(const unsigned int off_v,  ///< offset in v
 // -----------------------------------------------------------------------------
 
 void ChAssembly::InjectVariables(ChSystemDescriptor& mdescriptor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->InjectVariables(mdescriptor);
+    int nthreads = UpdateThreadNumber(system);
+
+    // Each body injects exactly its own ChVariables (see ChBody::InjectVariables), so the
+    // slots in the descriptor can be reserved in advance and filled concurrently. This bypasses
+    // InsertVariables(), hence it is done only if the descriptor does not override it.
+    if (nthreads > 1 && typeid(mdescriptor) == typeid(ChSystemDescriptor)) {
+        std::vector<ChVariables*>& vvariables = mdescriptor.GetVariablesList();
+        size_t offset = vvariables.size();
+        vvariables.resize(offset + bodylist.size());
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+        for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+            ChBody* Bpointer = bodylist[ip].get();
+            Bpointer->Variables().SetDisabled(!Bpointer->IsActive());
+            vvariables[offset + ip] = &Bpointer->Variables();
+        }
+    } else {
+        for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+            bodylist[ip]->InjectVariables(mdescriptor);
+        }
     }
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
         linklist[ip]->InjectVariables(mdescriptor);
@@ -74,8 +74,17 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// at the first Setup() call. This is thread safe.
     void AddBatch(std::shared_ptr<ChPhysicsItem> newitem);
 
-    /// If some items are queued for addition in system, using AddBatch(), this will
-    /// effectively add them and clean the batch. Called automatically at each Setup().
+    /// Items removed in this way are removed like in the Remove() method, but not instantly,
+    /// they are simply queued in a batch of 'to remove' items, that are removed all together
+    /// at the first Setup() call. The lists of bodies, links and other items are compacted with
+    /// a single pass, and the collision models of the bodies are removed from the collision
+    /// system in bulk, so this is much faster than Remove() when many items are removed at
+    /// each step (ex. particle removers). Items not in this assembly are ignored.
+    void RemoveBatch(std::shared_ptr<ChPhysicsItem> olditem);
+
+    /// If some items are queued for addition or removal in system, using AddBatch() or
+    /// RemoveBatch(), this will effectively add or remove them and clean the batches.
+    /// Removals are done before additions. Called automatically at each Setup().
     void FlushBatch();
 
     /// Remove a body from this system.
@@ -190,6 +199,7 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// remove or add items (use the appropriate Remove.. and Add..
     /// functions instead!)
     std::vector<std::shared_ptr<ChBody>>* Get_bodylist() { return &bodylist; }
+    const std::vector<std::shared_ptr<ChBody>>* Get_bodylist() const { return &bodylist; }
     /// Gets the list of children links -low level function-.
     /// NOTE! use this list only to enumerate etc., but NOT to
     /// remove or add items (use the appropriate Remove.. and Add..
@@ -374,6 +384,8 @@ class ChApi ChAssembly : public ChPhysicsItem {
         otherphysicslist;  ///< list of other physic objects that are not bodies or links
     std::vector<std::shared_ptr<ChPhysicsItem>>
         batch_to_insert;  ///< list of items to insert when doing Setup() or Flush.
+    std::vector<std::shared_ptr<ChPhysicsItem>>
+        batch_to_remove;  ///< list of items to remove when doing Setup() or Flush.
 
     // Statistics:
     int nbodies;        ///< number of bodies (currently active)
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch runner: simulation of many independent copies of a prototype system.
+//
+// =============================================================================
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "chrono/physics/ChBatchRunner.h"
+#include "chrono/physics/ChGlobal.h"
+
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btCollisionObject.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCompoundShape.h"
+
+namespace chrono {
+
+using namespace collision;
+
+// Log used by the instances that do not provide their own: all messages are discarded.
+class ChLogDiscard : public ChLog {
+  public:
+    virtual void Output(const char* data, size_t n) {}
+};
+
+// Check if a Bullet shape can be used at the same time by collision objects in different
+// threads. Concave GImpact meshes lock their mesh data with a (non-atomic) counter.
+static bool IsShareable(const btCollisionShape* shape) {
+    if (!shape)
+        return true;
+    if (shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE)
+        return false;
+    if (shape->isCompound()) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            if (!IsShareable(compound->getChildShape(i)))
+                return false;
+        }
+    }
+    return true;
+}
+
+ChBatchRunner::ChBatchRunner(const ChSystem& prototype, int nthreads)
+    : prototype(prototype), executor(nthreads), first_id(100000) {}
+
+ChSystem* ChBatchRunner::CloneSystem(const ChSystem& prototype) {
+    std::unique_ptr<ChSystem> system(prototype.Clone());
+
+    for (auto proto_body : *prototype.Get_bodylist()) {
+        ChModelBullet* proto_model = dynamic_cast<ChModelBullet*>(proto_body->GetCollisionModel());
+        if (!proto_model)
+            throw ChException("CloneSystem: only Bullet collision models can be cloned");
+        if (!IsShareable(proto_model->GetBulletModel()->getCollisionShape()))
+            throw ChException("CloneSystem: concave triangle meshes cannot be shared, use a convex decomposition");
+
+        // The copy constructor of ChBody creates an empty collision model: share the shapes
+        // of the prototype. The family is set before the body is added to the system, so
+        // that the model is inserted in the collision system with the right filter.
+        std::shared_ptr<ChBody> body(proto_body->Clone());
+        ChCollisionModel* model = body->GetCollisionModel();
+        model->AddCopyOfAnotherModel(proto_model);
+        model->SetFamilyGroup(proto_model->GetFamilyGroup());
+        model->SetFamilyMask(proto_model->GetFamilyMask());
+
+        system->AddBody(body);
+    }
+
+    return system.release();
+}
+
+int ChBatchRunner::Run(int num_instances, InstanceCallback* callback) {
+    std::atomic<int> num_failed(0);
+
+    executor.ParallelFor(0, num_instances, 1, [this, callback, &num_failed](int from, int to, int thread) {
+        for (int i = from; i < to; i++) {
+            if (!RunInstance(i, callback))
+                num_failed++;
+        }
+    });
+
+    return num_failed;
+}
+
+bool ChBatchRunner::RunInstance(int instance, InstanceCallback* callback) {
+    // Private log and object IDs of the instance, for all the lifetime of its system.
+    ChLogDiscard discard_log;
+    ChLog* log = callback->GetInstanceLog(instance);
+    SetThreadLog(log ? *log : discard_log);
+    SetThreadFirstIntID(first_id);
+
+    bool success = true;
+    try {
+        std::unique_ptr<ChSystem> system(CloneSystem(prototype));
+
+        // The instances already run in parallel: avoid nested multithreading.
+        system->SetParallelThreadNumber(1);
+        system->SetParallelUpdateThreadNumber(1);
+
+        callback->OnSetup(instance, *system);
+
+        while (system->GetChTime() < system->GetEndTime() - 0.5 * system->GetStep()) {
+            system->DoStepDynamics(system->GetStep());
+            if (!callback->OnStep(instance, *system))
+                break;
+        }
+
+        callback->OnFinish(instance, *system);
+    } catch (std::exception& e) {
+        callback->OnError(instance, e.what());
+        success = false;
+    } catch (...) {
+        callback->OnError(instance, "unknown exception");
+        success = false;
+    }
+
+    ResetThreadIntID();
+    SetThreadLogDefault();
+
+    return success;
+}
+
+}  // end namespace chrono
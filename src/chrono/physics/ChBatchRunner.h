@@ -0,0 +1,112 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch runner: simulation of many independent copies of a prototype system.
+//
+// =============================================================================
+
+#ifndef CHBATCHRUNNER_H
+#define CHBATCHRUNNER_H
+
+#include <string>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/parallel/ChTaskExecutor.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+/// Runs many independent simulations (instances) of copies of a prototype system, for
+/// example for parameter sweeps, concurrently on the threads of a ChTaskExecutor.
+/// Each instance clones the prototype (see CloneSystem()), so the collision shapes,
+/// materials and assets of the prototype bodies are set up only once and shared by all
+/// the copies. A callback sets up each instance (parameters, links, loads, ...), is
+/// called after each step, and collects the results.
+///
+/// The instances do not share global state: while an instance is set up, simulated and
+/// destroyed, its thread uses a private sequence of object IDs (so the IDs of the
+/// objects of an instance do not depend on the other instances) and its own log for
+/// GetLog(). The prototype must not be modified during Run(), and the callbacks of the
+/// prototype system (collision callbacks) are shared by all instances, so they must be
+/// thread-safe.
+class ChApi ChBatchRunner {
+  public:
+    /// Class to be inherited by the user to set up the instances and collect their results.
+    /// The functions are called by the threads of the runner, concurrently for different
+    /// instances: they must only access data of their own instance.
+    class ChApi InstanceCallback {
+      public:
+        virtual ~InstanceCallback() {}
+
+        /// Called after the system of the instance was cloned from the prototype, before
+        /// the first step. Set here the parameters of the instance, and add the items that
+        /// are not cloned (links, forces, markers, ...).
+        virtual void OnSetup(int instance, ChSystem& system) {}
+
+        /// Called after each step. Return false to stop the simulation of the instance.
+        virtual bool OnStep(int instance, ChSystem& system) { return true; }
+
+        /// Called when the simulation of the instance reached the end time of its system
+        /// (or was stopped by OnStep), to collect the results.
+        virtual void OnFinish(int instance, ChSystem& system) = 0;
+
+        /// Called instead of OnFinish if the set up or the simulation threw an exception.
+        virtual void OnError(int instance, const std::string& message) {}
+
+        /// Return the log used by GetLog() while the instance is processed. If NULL, as by
+        /// default, the messages of the instance are discarded.
+        virtual ChLog* GetInstanceLog(int instance) { return NULL; }
+    };
+
+    /// Create a runner for copies of the given prototype system, with the specified number
+    /// of threads (including the thread calling Run()).
+    ChBatchRunner(const ChSystem& prototype, int nthreads = 1);
+
+    ~ChBatchRunner() {}
+
+    /// Change the number of threads.
+    void SetNumThreads(int nthreads) { executor.SetNumThreads(nthreads); }
+
+    /// Get the number of threads.
+    int GetNumThreads() const { return executor.GetNumThreads(); }
+
+    /// Set the first value of the sequence of object IDs of each instance (default 100000,
+    /// as for the global sequence).
+    void SetFirstInstanceIntID(int val) { first_id = val; }
+
+    /// Simulate the instances 0..num_instances-1; return when all of them are completed.
+    /// Each instance is simulated with the step and up to the end time of its system (as
+    /// copied from the prototype, or as changed by InstanceCallback::OnSetup).
+    /// Return the number of instances that failed (see InstanceCallback::OnError).
+    int Run(int num_instances, InstanceCallback* callback);
+
+    /// Create a copy of a system: the settings of the system, its solver, timestepper and
+    /// contact container types (see ChSystem::ChSystem(const ChSystem&)) and its bodies.
+    /// The copies of the bodies share the collision shapes, material and assets of the
+    /// original bodies; their forces and markers are not copied (as in ChBody::ChBody(const
+    /// ChBody&)). Links and other physics items are not copied. Throws a ChException if a
+    /// body has collision shapes that cannot be shared between threads (concave triangle
+    /// meshes, which keep locking state: use a convex decomposition instead), or if the
+    /// system uses custom solvers (set them in InstanceCallback::OnSetup instead).
+    static ChSystem* CloneSystem(const ChSystem& prototype);
+
+  private:
+    bool RunInstance(int instance, InstanceCallback* callback);
+
+    const ChSystem& prototype;  ///< system cloned by all instances
+    ChTaskExecutor executor;    ///< threads running the instances
+    int first_id;               ///< first object ID of each instance
+};
+
+}  // end namespace chrono
+
+#endif
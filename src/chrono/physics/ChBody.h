@@ -293,7 +293,9 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
     virtual void VariablesQbIncrementPosition(double step) override;
 
     /// Tell to a system descriptor that there are variables of type
-    /// ChVariables in this object (for further passing it to a solver)
+    /// ChVariables in this object (for further passing it to a solver).
+    /// Note: with multiple threads, ChAssembly inserts the variables of its bodies
+    /// directly in a plain ChSystemDescriptor; overrides must not inject other items.
     virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
 
     /// Instantiate the collision model
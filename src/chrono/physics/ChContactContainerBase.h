@@ -142,8 +142,8 @@ class ChApi ChContactContainerBase : public ChPhysicsItem {
     ChAddContactCallback* add_contact_callback;
     ChReportContactCallback* report_contact_callback;
 
-    template <class Tcont>
-    void SumAllContactForces(std::list<Tcont*>& contactlist,
+    template <class Tlist>
+    void SumAllContactForces(Tlist& contactlist,
                              std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
         for (auto contact = contactlist.begin(); contact != contactlist.end(); ++contact) {
             // Extract information for current contact (expressed in global frame)
@@ -25,7 +25,15 @@ using namespace geometry;
 ChClassRegister<ChContactContainerDEM> a_registration_ChContactContainerDEM;
 
 ChContactContainerDEM::ChContactContainerDEM()
-    : n_added_6_6(0), n_added_6_3(0), n_added_3_3(0), n_added_333_6(0), n_added_333_3(0), n_added_333_333(0) {}
+    : n_added_6_6(0),
+      n_added_6_3(0),
+      n_added_3_3(0),
+      n_added_333_6(0),
+      n_added_333_3(0),
+      n_added_333_333(0),
+      history_stamp(0),
+      history_size(0),
+      history_tolerance(0.01) {}
 
 ChContactContainerDEM::ChContactContainerDEM(const ChContactContainerDEM& other) : ChContactContainerBase(other) {
     n_added_6_6 = 0;
@@ -34,6 +42,9 @@ ChContactContainerDEM::ChContactContainerDEM(const ChContactContainerDEM& other)
     n_added_333_6 = 0;
     n_added_333_3 = 0;
     n_added_333_333 = 0;
+    history_stamp = 0;
+    history_size = 0;
+    history_tolerance = other.history_tolerance;
 }
 
 ChContactContainerDEM::~ChContactContainerDEM() {
@@ -45,105 +56,141 @@ void ChContactContainerDEM::Update(double mytime, bool update_assets) {
     ChContactContainerBase::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
+template <class Tcont>
+void _RemoveAllContacts(ChContactPool<Tcont>& contactlist, int& n_added) {
+    contactlist.Clear();
     n_added = 0;
 }
 
 void ChContactContainerDEM::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
+    _RemoveAllContacts(contactlist_6_6, n_added_6_6);
+    _RemoveAllContacts(contactlist_6_3, n_added_6_3);
+    _RemoveAllContacts(contactlist_3_3, n_added_3_3);
+    _RemoveAllContacts(contactlist_333_6, n_added_333_6);
+    _RemoveAllContacts(contactlist_333_3, n_added_333_3);
+    _RemoveAllContacts(contactlist_333_333, n_added_333_333);
+    contact_history.clear();
+    history_size = 0;
     //**TODO*** cont. roll.
 }
 
 void ChContactContainerDEM::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
+    contactlist_6_6.Reset();
     n_added_6_6 = 0;
 
-    lastcontact_6_3 = contactlist_6_3.begin();
+    contactlist_6_3.Reset();
     n_added_6_3 = 0;
 
-    lastcontact_3_3 = contactlist_3_3.begin();
+    contactlist_3_3.Reset();
     n_added_3_3 = 0;
 
-    lastcontact_333_6 = contactlist_333_6.begin();
+    contactlist_333_6.Reset();
     n_added_333_6 = 0;
 
-    lastcontact_333_3 = contactlist_333_3.begin();
+    contactlist_333_3.Reset();
     n_added_333_3 = 0;
 
-    lastcontact_333_333 = contactlist_333_333.begin();
+    contactlist_333_333.Reset();
     n_added_333_333 = 0;
 
-    // lastcontact_roll = contactlist_roll.begin();
+    // contactlist_roll.Reset();
     // n_added_roll = 0;
+
+    ++history_stamp;
 }
 
 void ChContactContainerDEM::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
+    // Contacts beyond the last added one are not deleted: they stay in the pools
+    // and will be recycled by the next AddContact() calls. The memory of a pool is
+    // released only if most of it stays unused for many steps.
+    contactlist_6_6.TrimUnused();
+    contactlist_6_3.TrimUnused();
+    contactlist_3_3.TrimUnused();
+    contactlist_333_6.TrimUnused();
+    contactlist_333_3.TrimUnused();
+    contactlist_333_333.TrimUnused();
+
+    // Expire the contact history of points that are no longer in contact.
+    auto entry = contact_history.begin();
+    while (entry != contact_history.end()) {
+        std::list<ChContactHistory>& points = entry->second;
+        auto point = points.begin();
+        while (point != points.end()) {
+            if (point->stamp != history_stamp) {
+                point = points.erase(point);
+                --history_size;
+            } else
+                ++point;
+        }
+        if (points.empty())
+            entry = contact_history.erase(entry);
+        else
+            ++entry;
     }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
+}
+
+ChVector<>* ChContactContainerDEM::GetContactHistory(const collision::ChCollisionInfo& cinfo) {
+    if (static_cast<ChSystemDEM*>(GetSystem())->GetTangentialDisplacementModel() != ChSystemDEM::MultiStep)
+        return NULL;
+
+    // The key does not depend on the order in which the collision system reports the two models.
+    ChContactHistoryKey key;
+    key.modelA = std::min(cinfo.modelA, cinfo.modelB);
+    key.modelB = std::max(cinfo.modelA, cinfo.modelB);
+
+    // Contact point, in the frame of the first model of the key
+    ChVector<> point = 0.5 * (cinfo.vpA + cinfo.vpB);
+    ChContactable* contactable = key.modelA->GetContactable();
+    if (contactable)
+        point = contactable->GetCsysForCollisionModel().TransformPointParentToLocal(point);
+
+    // Several contact points may be reported for the same pair of models, in any order: take the
+    // nearest point of the previous pass that is not matched yet, within the tolerance.
+    std::list<ChContactHistory>& points = contact_history[key];
+    ChContactHistory* match = NULL;
+    double min_dist2 = history_tolerance * history_tolerance;
+    for (auto& history : points) {
+        if (history.stamp == history_stamp)
+            continue;
+        double dist2 = (history.point - point).Length2();
+        if (dist2 <= min_dist2) {
+            min_dist2 = dist2;
+            match = &history;
+        }
     }
 
-    // while (lastcontact_roll != contactlist_roll.end()) {
-    //    delete (*lastcontact_roll);
-    //    lastcontact_roll = contactlist_roll.erase(lastcontact_roll);
-    //}
+    if (!match) {
+        points.push_back(ChContactHistory());
+        ++history_size;
+        match = &points.back();
+        match->shear_disp = VNULL;
+        match->modelA = cinfo.modelA;
+    } else if (match->modelA != cinfo.modelA) {
+        // Express the displacement for the current ordering of the pair.
+        match->shear_disp = -match->shear_disp;
+        match->modelA = cinfo.modelA;
+    }
+    match->point = point;
+    match->stamp = history_stamp;
+    return &match->shear_disp;
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,
-                           Titer& lastcontact,
+template <class Tcont, class Ta, class Tb>
+void _OptimalContactInsert(ChContactPool<Tcont>& contactlist,
                            int& n_added,
-                           ChContactContainerBase* mcontainer,
+                           ChContactContainerDEM* mcontainer,
                            Ta* objA,  ///< collidable object A
                            Tb* objB,  ///< collidable object B
                            const collision::ChCollisionInfo& cinfo) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
-
-        lastcontact++;
+    // slot in the contact history (NULL if not using the MultiStep tangential displacement model)
+    ChVector<>* shear_disp = mcontainer->GetContactHistory(cinfo);
 
+    if (Tcont* mc = contactlist.Recycle()) {
+        // reuse old contacts
+        mc->Reset(objA, objB, cinfo, shear_disp);
     } else {
         // add new contact
-        Tcont* mc = new Tcont(mcontainer, objA, objB, cinfo);
-
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
+        contactlist.Create(mcontainer, objA, objB, cinfo, shear_disp);
     }
     n_added++;
 }
@@ -187,18 +234,17 @@ void ChContactContainerDEM::AddContact(const collision::ChCollisionInfo& mcontac
     if (ChContactable_1vars<6>* mmboA = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelA->GetContactable())) {
         // 6_6
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
         }
         // 6_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
         }
         // 6_333 -> 333_6
         if (ChContactable_3vars<3, 3, 3>* mmboB =
                 dynamic_cast<ChContactable_3vars<3, 3, 3>*>(mcontact.modelB->GetContactable())) {
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            _OptimalContactInsert(contactlist_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact);
         }
     }
 
@@ -206,18 +252,17 @@ void ChContactContainerDEM::AddContact(const collision::ChCollisionInfo& mcontac
         // 3_6 -> 6_3
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
         }
         // 3_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
         }
         // 3_333 -> 333_3
         if (ChContactable_3vars<3, 3, 3>* mmboB =
                 dynamic_cast<ChContactable_3vars<3, 3, 3>*>(mcontact.modelB->GetContactable())) {
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            _OptimalContactInsert(contactlist_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact);
         }
     }
 
@@ -225,17 +270,16 @@ void ChContactContainerDEM::AddContact(const collision::ChCollisionInfo& mcontac
             dynamic_cast<ChContactable_3vars<3, 3, 3>*>(mcontact.modelA->GetContactable())) {
         // 333_6
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
         }
         // 333_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
         }
         // 333_3
         if (ChContactable_3vars<3, 3, 3>* mmboB =
                 dynamic_cast<ChContactable_3vars<3, 3, 3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB,
-                                  mcontact);
+            _OptimalContactInsert(contactlist_333_333, n_added_333_333, this, mmboA, mmboB, mcontact);
         }
     }
 
@@ -250,8 +294,8 @@ void ChContactContainerDEM::ComputeContactForces() {
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChReportContactCallback* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->ReportContactCallback(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), *(*itercontact)->GetContactPlane(),
@@ -277,8 +321,8 @@ void ChContactContainerDEM::ReportAllContacts(ChReportContactCallback* mcallback
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
-void _IntLoadResidual_F(std::list<Tcont*>& contactlist, ChVectorDynamic<>& R, const double c) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _IntLoadResidual_F(ChContactPool<Tcont>& contactlist, ChVectorDynamic<>& R, const double c) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntLoadResidual_F(R, c);
         ++itercontact;
@@ -295,8 +339,8 @@ void ChContactContainerDEM::IntLoadResidual_F(const unsigned int off, ChVectorDy
 }
 
 template <class Tcont>
-void _KRMmatricesLoad(std::list<Tcont*> contactlist, double Kfactor, double Rfactor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _KRMmatricesLoad(ChContactPool<Tcont>& contactlist, double Kfactor, double Rfactor) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContKRMmatricesLoad(Kfactor, Rfactor);
         ++itercontact;
@@ -313,8 +357,8 @@ void ChContactContainerDEM::KRMmatricesLoad(double Kfactor, double Rfactor, doub
 }
 
 template <class Tcont>
-void _InjectKRMmatrices(std::list<Tcont*> contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _InjectKRMmatrices(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContInjectKRMmatrices(mdescriptor);
         ++itercontact;
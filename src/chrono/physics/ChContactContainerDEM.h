@@ -18,16 +18,24 @@
 #include <algorithm>
 #include <cmath>
 #include <list>
+#include <unordered_map>
 
 #include "chrono/physics/ChContactContainerBase.h"
 #include "chrono/physics/ChContactDEM.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many penalty contacts.
-/// This is implemented as a typical linked list of ChContactDEM objects
+/// This is implemented as pooled, contiguous storage of ChContactDEM objects
 /// (that is, contacts between two ChContactable objects).
+/// With the MultiStep tangential displacement model, the container also keeps a contact
+/// history: the accumulated tangential displacement of each contact point is stored in a
+/// hash map of the pairs of collision shapes, persists across steps while the point stays
+/// in contact, and is discarded as soon as the contact is lost. As in the persistent
+/// manifolds of Bullet, the points of a pair are matched between steps by location, so
+/// that the history follows a point even if the collision system reorders the points.
 class ChApi ChContactContainerDEM : public ChContactContainerBase {
     CH_RTTI(ChContactContainerDEM, ChContactContainerBase);
 
@@ -40,12 +48,12 @@ class ChApi ChContactContainerDEM : public ChContactContainerBase {
     typedef ChContactDEM<ChContactable_3vars<3, 3, 3>, ChContactable_3vars<3, 3, 3> > ChContactDEM_333_333;
 
   protected:
-    std::list<ChContactDEM_6_6*> contactlist_6_6;
-    std::list<ChContactDEM_6_3*> contactlist_6_3;
-    std::list<ChContactDEM_3_3*> contactlist_3_3;
-    std::list<ChContactDEM_333_6*> contactlist_333_6;
-    std::list<ChContactDEM_333_3*> contactlist_333_3;
-    std::list<ChContactDEM_333_333*> contactlist_333_333;
+    ChContactPool<ChContactDEM_6_6> contactlist_6_6;
+    ChContactPool<ChContactDEM_6_3> contactlist_6_3;
+    ChContactPool<ChContactDEM_3_3> contactlist_3_3;
+    ChContactPool<ChContactDEM_333_6> contactlist_333_6;
+    ChContactPool<ChContactDEM_333_3> contactlist_333_3;
+    ChContactPool<ChContactDEM_333_333> contactlist_333_333;
 
     int n_added_6_6;
     int n_added_6_3;
@@ -54,12 +62,38 @@ class ChApi ChContactContainerDEM : public ChContactContainerBase {
     int n_added_333_3;
     int n_added_333_333;
 
-    std::list<ChContactDEM_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactDEM_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactDEM_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactDEM_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactDEM_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactDEM_333_333*>::iterator lastcontact_333_333;
+    /// Key of the contact history entries of a pair: the two collision models, in address order.
+    struct ChContactHistoryKey {
+        collision::ChCollisionModel* modelA;
+        collision::ChCollisionModel* modelB;
+
+        bool operator==(const ChContactHistoryKey& other) const {
+            return modelA == other.modelA && modelB == other.modelB;
+        }
+    };
+
+    struct ChContactHistoryKeyHash {
+        size_t operator()(const ChContactHistoryKey& key) const {
+            size_t h = std::hash<void*>()(key.modelA);
+            h ^= std::hash<void*>()(key.modelB) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    /// Contact history entry, one for each contact point of a pair.
+    struct ChContactHistory {
+        ChVector<> shear_disp;                ///< accumulated tangential displacement of B relative to A
+        ChVector<> point;                     ///< contact point, in the frame of the first model of the key
+        collision::ChCollisionModel* modelA;  ///< model playing the role of A for shear_disp
+        unsigned int stamp;                   ///< last collision pass in which the contact was found
+    };
+
+    // The entries of a pair are kept in a list, so that the slots handed to the contacts
+    // stay valid while other points of the same pair are added or expired.
+    std::unordered_map<ChContactHistoryKey, std::list<ChContactHistory>, ChContactHistoryKeyHash> contact_history;
+    unsigned int history_stamp;
+    size_t history_size;       ///< number of contact points in the history
+    double history_tolerance;  ///< largest distance between matched points of two passes
 
   public:
     ChContactContainerDEM();
@@ -79,19 +113,38 @@ class ChApi ChContactContainerDEM : public ChContactContainerBase {
 
     /// The collision system will call BeginAddContact() before adding
     /// all contacts (for example with AddContact() or similar). Instead of
-    /// simply deleting all list of the previous contacts, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous contact objects
+    /// simply deleting all the previous contacts, this optimized implementation
+    /// resets the contact pools in bulk and reuses previous contact objects
     /// until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two frames.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
-    /// The collision system will call BeginAddContact() after adding
-    /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
+    /// The collision system will call EndAddContact() after adding
+    /// all contacts (for example with AddContact() or similar). Contact objects that
+    /// were not reused (if any) are kept in the pools, to be recycled in later steps;
+    /// a pool is trimmed if most of it stays unused for many steps (see ChContactPool).
     virtual void EndAddContact() override;
 
+    /// Return the slot of the contact history for the given contact point.
+    /// The point is matched with the nearest point of the same pair found at the previous
+    /// collision pass (and not already matched in this pass), if closer than the tolerance
+    /// in the frame of the first model of the pair; otherwise a new slot is created, with
+    /// zero tangential displacement. The returned vector is expressed for cinfo.modelA playing
+    /// the role of A. Returns NULL if the system does not use the MultiStep tangential
+    /// displacement model.
+    ChVector<>* GetContactHistory(const collision::ChCollisionInfo& cinfo);
+
+    /// Get the number of contact points currently stored in the contact history.
+    size_t GetContactHistorySize() const { return history_size; }
+
+    /// Set the largest distance between two contact points of the same pair, at two
+    /// consecutive collision passes, for them to share the contact history.
+    /// It should be smaller than the distance between the points of a pair (default: 0.01).
+    void SetContactHistoryTolerance(double tol) { history_tolerance = tol; }
+    double GetContactHistoryTolerance() const { return history_tolerance; }
+
     /// Scans all the contacts and for each contact executes the ReportContactCallback()
     /// function of the user object inherited from ChReportContactCallback.
     virtual void ReportAllContacts(ChReportContactCallback* mcallback) override;
@@ -43,78 +43,56 @@ void ChContactContainerDVI::Update(double mytime, bool update_assets) {
     ChContactContainerBase::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
+template <class Tcont>
+void _RemoveAllContacts(ChContactPool<Tcont>& contactlist, int& n_added) {
+    contactlist.Clear();
     n_added = 0;
 }
 
 void ChContactContainerDVI::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+    _RemoveAllContacts(contactlist_6_6, n_added_6_6);
+    _RemoveAllContacts(contactlist_6_3, n_added_6_3);
+    _RemoveAllContacts(contactlist_3_3, n_added_3_3);
+    _RemoveAllContacts(contactlist_6_6_rolling, n_added_6_6_rolling);
 }
 
 void ChContactContainerDVI::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
+    contactlist_6_6.Reset();
     n_added_6_6 = 0;
 
-    lastcontact_6_3 = contactlist_6_3.begin();
+    contactlist_6_3.Reset();
     n_added_6_3 = 0;
 
-    lastcontact_3_3 = contactlist_3_3.begin();
+    contactlist_3_3.Reset();
     n_added_3_3 = 0;
 
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
+    contactlist_6_6_rolling.Reset();
     n_added_6_6_rolling = 0;
 }
 
 void ChContactContainerDVI::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
+    // Contacts beyond the last added one are not deleted: they stay in the pools
+    // and will be recycled by the next AddContact() calls. The memory of a pool is
+    // released only if most of it stays unused for many steps.
+    contactlist_6_6.TrimUnused();
+    contactlist_6_3.TrimUnused();
+    contactlist_3_3.TrimUnused();
+    contactlist_6_6_rolling.TrimUnused();
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,
-                           Titer& lastcontact,
+template <class Tcont, class Ta, class Tb>
+void _OptimalContactInsert(ChContactPool<Tcont>& contactlist,
                            int& n_added,
                            ChContactContainerBase* mcontainer,
                            Ta* objA,  ///< collidable object A
                            Tb* objB,  ///< collidable object B
                            const collision::ChCollisionInfo& cinfo) {
-    if (lastcontact != contactlist.end()) {
+    if (Tcont* mc = contactlist.Recycle()) {
         // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
-        lastcontact++;
-
+        mc->Reset(objA, objB, cinfo);
     } else {
         // add new contact
-        Tcont* mc = new Tcont(mcontainer, objA, objB, cinfo);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
+        contactlist.Create(mcontainer, objA, objB, cinfo);
     }
     n_added++;
 }
@@ -156,16 +134,15 @@ void ChContactContainerDVI::AddContact(const collision::ChCollisionInfo& mcontac
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
             if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                 (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this,
-                                      mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_6_6_rolling, n_added_6_6_rolling, this, mmboA, mmboB, mcontact);
             } else {
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
             }
             return;
         }
         // 6_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
             return;
         }
     }
@@ -174,12 +151,12 @@ void ChContactContainerDVI::AddContact(const collision::ChCollisionInfo& mcontac
         // 3_6 -> 6_3
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
             return;
         }
         // 3_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            _OptimalContactInsert(contactlist_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
             return;
         }
     }
@@ -194,8 +171,8 @@ void ChContactContainerDVI::ComputeContactForces() {
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChReportContactCallback* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->ReportContactCallback(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), *(*itercontact)->GetContactPlane(),
@@ -209,8 +186,8 @@ void _ReportAllContacts(std::list<Tcont*>& contactlist, ChReportContactCallback*
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contactlist, ChReportContactCallback* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->ReportContactCallback(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), *(*itercontact)->GetContactPlane(),
@@ -233,11 +210,11 @@ void ChContactContainerDVI::ReportAllContacts(ChReportContactCallback* mcallback
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contactlist,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
@@ -255,11 +232,11 @@ void ChContactContainerDVI::IntStateGatherReactions(const unsigned int off_L, Ch
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contactlist,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
@@ -277,13 +254,13 @@ void ChContactContainerDVI::IntStateScatterReactions(const unsigned int off_L, c
 
 template <class Tcont>
 void _IntLoadResidual_CqL(unsigned int& coffset,
-                          std::list<Tcont*>& contactlist,
+                          ChContactPool<Tcont>& contactlist,
                           const unsigned int off_L,    ///< offset in L multipliers
                           ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
                           const ChVectorDynamic<>& L,  ///< the L vector
                           const double c,              ///< a scaling factor
                           const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
@@ -305,14 +282,14 @@ void ChContactContainerDVI::IntLoadResidual_CqL(const unsigned int off_L,    ///
 
 template <class Tcont>
 void _IntLoadConstraint_C(unsigned int& coffset,
-                          std::list<Tcont*>& contactlist,
+                          ChContactPool<Tcont>& contactlist,
                           const unsigned int off,  ///< offset in Qc residual
                           ChVectorDynamic<>& Qc,   ///< result: the Qc residual, Qc += c*C
                           const double c,          ///< a scaling factor
                           bool do_clamp,           ///< apply clamping to c*C?
                           double recovery_clamp,   ///< value for min/max clamping of c*C
                           const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
@@ -335,7 +312,7 @@ void ChContactContainerDVI::IntLoadConstraint_C(const unsigned int off,  ///< of
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contactlist,
                       const unsigned int off_v,  ///< offset in v, R
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -343,7 +320,7 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
@@ -366,13 +343,13 @@ void ChContactContainerDVI::IntToDescriptor(const unsigned int off_v,  ///< offs
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contactlist,
                         const unsigned int off_v,  ///< offset in v
                         ChStateDelta& v,
                         const unsigned int off_L,  ///< offset in L
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
@@ -394,8 +371,8 @@ void ChContactContainerDVI::IntFromDescriptor(const unsigned int off_v,  ///< of
 // SOLVER INTERFACES
 
 template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _InjectConstraints(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->InjectConstraints(mdescriptor);
         ++itercontact;
@@ -410,8 +387,8 @@ void ChContactContainerDVI::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ConstraintsBiReset(ChContactPool<Tcont>& contactlist) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsBiReset();
         ++itercontact;
@@ -426,8 +403,8 @@ void ChContactContainerDVI::ConstraintsBiReset() {
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
         ++itercontact;
@@ -446,9 +423,9 @@ void ChContactContainerDVI::ConstraintsLoadJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contactlist, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsFetch_react(factor);
         ++itercontact;
@@ -15,17 +15,16 @@
 #ifndef CHCONTACTCONTAINERDVI_H
 #define CHCONTACTCONTAINERDVI_H
 
-#include <list>
-
 #include "chrono/physics/ChContactContainerBase.h"
 #include "chrono/physics/ChContactDVI.h"
 #include "chrono/physics/ChContactDVIrolling.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many complementarity contacts.
-/// This is implemented as a typical linked list of ChContactDVI objects
+/// This is implemented as pooled, contiguous storage of ChContactDVI objects
 /// (that is, contacts between two ChContactable objects, with 3 reactions).
 /// It might also contain ChContactDVIrolling objects (extended versions of ChContactDVI,
 /// with 6 reactions, that account also for rolling and spinning resistance), but also
@@ -41,21 +40,16 @@ class ChApi ChContactContainerDVI : public ChContactContainerBase {
     typedef ChContactDVIrolling<ChContactable_1vars<6>, ChContactable_1vars<6> > ChContactDVIrolling_6_6;
 
   protected:
-    std::list<ChContactDVI_6_6*> contactlist_6_6;
-    std::list<ChContactDVI_6_3*> contactlist_6_3;
-    std::list<ChContactDVI_3_3*> contactlist_3_3;
-    std::list<ChContactDVIrolling_6_6*> contactlist_6_6_rolling;
+    ChContactPool<ChContactDVI_6_6> contactlist_6_6;
+    ChContactPool<ChContactDVI_6_3> contactlist_6_3;
+    ChContactPool<ChContactDVI_3_3> contactlist_3_3;
+    ChContactPool<ChContactDVIrolling_6_6> contactlist_6_6_rolling;
 
     int n_added_6_6;
     int n_added_6_3;
     int n_added_3_3;
     int n_added_6_6_rolling;
 
-    std::list<ChContactDVI_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactDVI_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactDVI_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactDVIrolling_6_6*>::iterator lastcontact_6_6_rolling;
-
   public:
     ChContactContainerDVI();
     ChContactContainerDVI(const ChContactContainerDVI& other);
@@ -72,17 +66,18 @@ class ChApi ChContactContainerDVI : public ChContactContainerBase {
 
     /// The collision system will call BeginAddContact() before adding
     /// all contacts (for example with AddContact() or similar). Instead of
-    /// simply deleting all list of the previous contacts, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous contact objects
+    /// simply deleting all the previous contacts, this optimized implementation
+    /// resets the contact pools in bulk and reuses previous contact objects
     /// until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two frames.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
-    /// The collision system will call BeginAddContact() after adding
-    /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
+    /// The collision system will call EndAddContact() after adding
+    /// all contacts (for example with AddContact() or similar). Contact objects that
+    /// were not reused (if any) are kept in the pools, to be recycled in later steps;
+    /// a pool is trimmed if most of it stays unused for many steps (see ChContactPool).
     virtual void EndAddContact() override;
 
     /// Scans all the contacts and for each contact executes the ReportContactCallback()
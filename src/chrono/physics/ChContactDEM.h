@@ -53,17 +53,19 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
 
     ChVector<> m_force;        ///< contact force on objB
     ChContactJacobian* m_Jac;  ///< contact Jacobian data
+    ChVector<>* m_shear_disp;  ///< accumulated tangential displacement, in the contact history (may be NULL)
 
   public:
-    ChContactDEM() : m_Jac(NULL) {}
+    ChContactDEM() : m_Jac(NULL), m_shear_disp(NULL) {}
 
     ChContactDEM(ChContactContainerBase* mcontainer,      ///< contact container
                  Ta* mobjA,                               ///< collidable object A
                  Tb* mobjB,                               ///< collidable object B
-                 const collision::ChCollisionInfo& cinfo  ///< data for the contact pair
+                 const collision::ChCollisionInfo& cinfo, ///< data for the contact pair
+                 ChVector<>* shear_disp = NULL            ///< contact history slot (MultiStep model only)
                  )
-        : ChContactTuple<Ta, Tb>(mcontainer, mobjA, mobjB, cinfo), m_Jac(NULL) {
-        Reset(mobjA, mobjB, cinfo);
+        : ChContactTuple<Ta, Tb>(mcontainer, mobjA, mobjB, cinfo), m_Jac(NULL), m_shear_disp(NULL) {
+        Reset(mobjA, mobjB, cinfo, shear_disp);
     }
 
     ~ChContactDEM() {
@@ -89,17 +91,42 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
                        Tb* mobjB,                               ///< collidable object B
                        const collision::ChCollisionInfo& cinfo  ///< data for the contact pair
                        ) override {
+        Reset(mobjA, mobjB, cinfo, NULL);
+    }
+
+    /// Reinitialize this contact, with the given slot of the contact history.
+    /// If not NULL, the accumulated tangential displacement is incremented with the
+    /// current relative tangential velocity and used in place of the one-step estimate.
+    void Reset(Ta* mobjA,                                ///< collidable object A
+               Tb* mobjB,                                ///< collidable object B
+               const collision::ChCollisionInfo& cinfo,  ///< data for the contact pair
+               ChVector<>* shear_disp                    ///< contact history slot (MultiStep model only)
+               ) {
         // Inherit base class.
         ChContactTuple<Ta, Tb>::Reset(mobjA, mobjB, cinfo);
 
         // Note: cinfo.distance is the same as this->norm_dist.
         assert(cinfo.distance < 0);
 
+        ChVector<> vel1 = this->objA->GetContactPointSpeed(this->p1);
+        ChVector<> vel2 = this->objB->GetContactPointSpeed(this->p2);
+
+        // Increment the stored tangential displacement and project it onto the current contact plane.
+        m_shear_disp = shear_disp;
+        if (m_shear_disp) {
+            double dT = this->container->GetSystem()->GetStep();
+            ChVector<> relvel = vel2 - vel1;
+            ChVector<> relvel_t = relvel - relvel.Dot(this->normal) * this->normal;
+            *m_shear_disp += relvel_t * dT;
+            *m_shear_disp -= m_shear_disp->Dot(this->normal) * this->normal;
+        }
+
         // Calculate contact force.
-        m_force = CalculateForce(-this->norm_dist,                            // overlap (here, always positive)
-                                 this->normal,                                // normal contact direction
-                                 this->objA->GetContactPointSpeed(this->p1),  // velocity of contact point on objA
-                                 this->objB->GetContactPointSpeed(this->p2)   // velocity of contact point on objB
+        m_force = CalculateForce(-this->norm_dist,  // overlap (here, always positive)
+                                 this->normal,      // normal contact direction
+                                 vel1,              // velocity of contact point on objA
+                                 vel2,              // velocity of contact point on objB
+                                 m_shear_disp       // accumulated tangential displacement (may be NULL)
                                  );
 
         // Set up and compute Jacobian matrices.
@@ -110,11 +137,14 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
     }
 
     /// Calculate contact force, expressed in absolute coordinates.
+    /// If the MultiStep tangential displacement model is used and a contact history slot is
+    /// provided, the slot is truncated in place when the tangential force exceeds the Coulomb limit.
     ChVector<> CalculateForce(
         double delta,                  ///< overlap in normal direction
         const ChVector<>& normal_dir,  ///< normal contact direction (expressed in global frame)
         const ChVector<>& vel1,        ///< velocity of contact point on objA (expressed in global frame)
-        const ChVector<>& vel2         ///< velocity of contact point on objB (expressed in global frame)
+        const ChVector<>& vel2,        ///< velocity of contact point on objB (expressed in global frame)
+        ChVector<>* shear_disp = NULL  ///< accumulated tangential displacement (expressed in global frame)
         ) {
         // Set contact force to zero if no penetration.
         if (delta <= 0) {
@@ -240,8 +270,8 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
                 delta_t = relvel_t_mag * dT;
                 break;
             case ChSystemDEM::MultiStep:
-                //// TODO: implement proper MultiStep mode
-                delta_t = relvel_t_mag * dT;
+                // without a contact history slot, fall back to the one-step estimate
+                delta_t = shear_disp ? shear_disp->Length() : relvel_t_mag * dT;
                 break;
         }
 
@@ -251,7 +281,8 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
 
         // If the resulting normal contact force is negative, the two shapes are moving
         // away from each other so fast that no contact force is generated.
-        if (forceN < 0) {
+        bool separating = (forceN < 0);
+        if (separating) {
             forceN = 0;
             forceT = 0;
         }
@@ -266,6 +297,33 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
                 break;
         }
 
+        // With contact history, the tangential force has a stiff part along the accumulated
+        // tangential displacement and a viscous part along the relative tangential velocity.
+        if (tdispl_model == ChSystemDEM::MultiStep && shear_disp) {
+            ChVector<> forceT_stiff = kt * (*shear_disp);
+            ChVector<> forceT_damp = gt * relvel_t;
+            if (separating) {
+                forceT_stiff = VNULL;
+                forceT_damp = VNULL;
+            }
+
+            // Coulomb law. When sliding, scale the stored displacement so that the tangential force is
+            // correct if it drops again below the Coulomb limit, and drop the tangential damping.
+            double forceT_slide = mat.mu_eff * std::abs(forceN);
+            double forceT_stiff_mag = forceT_stiff.Length();
+            if (forceT_stiff_mag > forceT_slide) {
+                if (shear_disp->Length() > CH_MICROTOL) {
+                    forceT_stiff *= forceT_slide / forceT_stiff_mag;
+                    *shear_disp = forceT_stiff / kt;
+                } else {
+                    forceT_stiff = VNULL;
+                }
+                forceT_damp = VNULL;
+            }
+
+            return forceN * normal_dir - forceT_stiff - forceT_damp;
+        }
+
         // Coulomb law
         forceT = std::min<double>(forceT, mat.mu_eff * std::abs(forceN));
 
@@ -318,7 +376,12 @@ class ChContactDEM : public ChContactTuple<Ta, Tb> {
         ChVector<> vel2 = this->objB->GetContactPointSpeed(p2_loc, stateB_x, stateB_w);
 
         // Compute the contact force.
-        ChVector<> force = CalculateForce(delta, normal_dir, vel1, vel2);
+        // The accumulated tangential displacement is kept fixed during the perturbations; pass a copy
+        // so that the Coulomb truncation does not alter the contact history.
+        ChVector<> shear_disp;
+        if (m_shear_disp)
+            shear_disp = *m_shear_disp;
+        ChVector<> force = CalculateForce(delta, normal_dir, vel1, vel2, m_shear_disp ? &shear_disp : NULL);
 
         // Compute and load the generalized contact forces.
         this->objA->ContactForceLoadQ(-force, p1_abs, stateA_x, Q, 0);
@@ -0,0 +1,183 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Alessandro Tasora, Radu Serban
+// =============================================================================
+
+#ifndef CHCONTACTPOOL_H
+#define CHCONTACTPOOL_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace chrono {
+
+/// Pooled storage for contact objects of a single type.
+/// Contacts are constructed in place inside fixed-size slabs of contiguous memory,
+/// so that traversing all contacts touches consecutive addresses instead of scattered
+/// heap nodes. Slabs are never moved once allocated, hence pointers to contacts (and
+/// pointers that contacts keep to their own members, as in ChContactDVI) stay valid.
+/// Contacts are recycled: Reset() only rewinds the active counter, and the objects
+/// constructed in previous steps are handed out again by Recycle() until exhausted.
+/// Iterating the pool (begin/end) visits only the active contacts; dereferencing an
+/// iterator gives a Tcont* so that the pool can be traversed like a std::list<Tcont*>.
+/// The pool grows to the largest number of contacts seen; TrimUnused() gives back the
+/// memory when the number of contacts stays well below that for many steps.
+template <class Tcont>
+class ChContactPool {
+  public:
+    /// Number of contacts per slab, as a power of 2.
+    static const size_t slab_shift = 10;
+    static const size_t slab_size = size_t(1) << slab_shift;
+    static const size_t slab_mask = slab_size - 1;
+
+    /// Number of consecutive low-usage steps after which TrimUnused() releases memory.
+    static const int trim_steps = 100;
+
+    /// Forward iterator over the active contacts.
+    class iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Tcont* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Tcont* const* pointer;
+        typedef Tcont* reference;
+
+        iterator(const ChContactPool* mpool, size_t mindex) : pool(mpool), index(mindex) {}
+
+        Tcont* operator*() const { return pool->at(index); }
+        iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp(*this);
+            ++index;
+            return tmp;
+        }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+      private:
+        const ChContactPool* pool;
+        size_t index;
+    };
+
+    ChContactPool() : n_active(0), n_constructed(0), low_peak(0), low_steps(0) {}
+
+    ~ChContactPool() { Clear(); }
+
+    /// Number of active contacts.
+    size_t size() const { return n_active; }
+
+    /// Return true if there are no active contacts.
+    bool empty() const { return n_active == 0; }
+
+    /// Number of contact objects constructed so far (active or waiting to be recycled).
+    size_t GetNconstructed() const { return n_constructed; }
+
+    /// Access the i-th contact (no bound checking against the active count).
+    Tcont* at(size_t i) const { return slabs[i >> slab_shift] + (i & slab_mask); }
+    Tcont* operator[](size_t i) const { return at(i); }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, n_active); }
+
+    /// Deactivate all contacts in bulk. Objects are kept alive, to be recycled.
+    void Reset() { n_active = 0; }
+
+    /// Activate and return the next contact constructed in a previous step,
+    /// or return NULL if all constructed contacts are already active.
+    /// The caller is responsible for re-initializing the returned object.
+    Tcont* Recycle() {
+        if (n_active == n_constructed)
+            return NULL;
+        return at(n_active++);
+    }
+
+    /// Construct a new contact at the end of the pool, forwarding the arguments
+    /// to the Tcont constructor, and activate it. Use only when Recycle() fails.
+    template <typename... Args>
+    Tcont* Create(Args&&... args) {
+        assert(n_active == n_constructed);
+        if ((n_constructed >> slab_shift) == slabs.size())
+            slabs.push_back(static_cast<Tcont*>(::operator new(slab_size * sizeof(Tcont))));
+        Tcont* mc = new (at(n_constructed)) Tcont(std::forward<Args>(args)...);
+        ++n_constructed;
+        ++n_active;
+        return mc;
+    }
+
+    /// Destroy all contact objects and release the memory of all slabs.
+    void Clear() {
+        for (size_t i = 0; i < n_constructed; ++i)
+            at(i)->~Tcont();
+        for (size_t j = 0; j < slabs.size(); ++j)
+            ::operator delete(slabs[j]);
+        slabs.clear();
+        n_active = 0;
+        n_constructed = 0;
+        low_peak = 0;
+        low_steps = 0;
+    }
+
+    /// Destroy the inactive contacts beyond the first 'keep' ones and release the slabs
+    /// left empty. Active contacts are not touched, so pointers to them stay valid.
+    void Trim(size_t keep) {
+        size_t n_keep = std::max(n_active, keep);
+        if (n_keep >= n_constructed)
+            return;
+        for (size_t i = n_keep; i < n_constructed; ++i)
+            at(i)->~Tcont();
+        n_constructed = n_keep;
+        size_t n_slabs = (n_keep + slab_mask) >> slab_shift;
+        for (size_t j = n_slabs; j < slabs.size(); ++j)
+            ::operator delete(slabs[j]);
+        slabs.resize(n_slabs);
+    }
+
+    /// Shrink policy, to be called once per step after the contacts were added.
+    /// If fewer than a quarter of the constructed contacts were active for trim_steps
+    /// consecutive calls, the pool is trimmed to twice the largest number of active
+    /// contacts of those steps. The first slab is never released.
+    void TrimUnused() {
+        if (n_constructed <= slab_size || 4 * n_active >= n_constructed) {
+            low_peak = 0;
+            low_steps = 0;
+            return;
+        }
+        low_peak = std::max(low_peak, n_active);
+        if (++low_steps < trim_steps)
+            return;
+        Trim(std::max(2 * low_peak, size_t(slab_size)));
+        low_peak = 0;
+        low_steps = 0;
+    }
+
+  private:
+    ChContactPool(const ChContactPool&);
+    ChContactPool& operator=(const ChContactPool&);
+
+    std::vector<Tcont*> slabs;
+    size_t n_active;
+    size_t n_constructed;
+    size_t low_peak;  ///< largest active count in the current run of low-usage steps
+    int low_steps;    ///< length of the current run of low-usage steps
+};
+
+}  // end namespace chrono
+
+#endif
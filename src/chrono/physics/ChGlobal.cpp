@@ -35,31 +35,44 @@ void SetFirstIntID(int val) {
     first_id = val;
 }
 
+// Private sequence of IDs of the calling thread, if any
+static thread_local bool use_thread_id = false;
+static thread_local int thread_id = 0;
+
+void SetThreadFirstIntID(int val) {
+    use_thread_id = true;
+    thread_id = val;
+}
+
+void ResetThreadIntID() {
+    use_thread_id = false;
+}
+
 // Obtain a unique identifier (thread-safe; platform-dependent)
 #if (defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4) || defined(__ARM_ARCH_5T__) || defined(__ARM_ARCH_5TE__))
 
-int GetUniqueIntID() {
+static int GetGlobalUniqueIntID() {
     static volatile int id = first_id;
     return __sync_add_and_fetch(&id, 1);
 }
 
 #elif defined(_WIN32)
 
-int GetUniqueIntID() {
+static int GetGlobalUniqueIntID() {
     volatile static long id = first_id;
     return (int)InterlockedIncrement(&id);
 }
 
 #elif defined(_WIN64)
 
-int GetUniqueIntID() {
+static int GetGlobalUniqueIntID() {
     volatile static long long id = first_id;
     return (int)InterlockedIncrement64(&id);
 }
 
 #elif defined(__APPLE__)
 
-int GetUniqueIntID() {
+static int GetGlobalUniqueIntID() {
     static volatile int32_t id = first_id;
     return (int)OSAtomicIncrement32Barrier(&id);
 }
@@ -71,6 +84,12 @@ int GetUniqueIntID() {
 
 #endif
 
+int GetUniqueIntID() {
+    if (use_thread_id)
+        return ++thread_id;
+    return GetGlobalUniqueIntID();
+}
+
 // -----------------------------------------------------------------------------
 // Functions for manipulating the Chrono data directory
 // -----------------------------------------------------------------------------
@@ -25,6 +25,16 @@ ChApi void SetFirstIntID(int val);
 /// Obtain a unique identifier (thread-safe)
 ChApi int GetUniqueIntID();
 
+/// Use a private sequence of IDs in the calling thread: subsequent calls to
+/// GetUniqueIntID() from this thread return val+1, val+2, etc. and do not
+/// advance the global sequence. Objects created in different threads can then
+/// have the same ID, so this is meant for threads that build and simulate
+/// their own independent systems (see ChBatchRunner).
+ChApi void SetThreadFirstIntID(int val);
+
+/// Go back to the global sequence of IDs in the calling thread.
+ChApi void ResetThreadIntID();
+
 /// Set the path to the Chrono data directory (ATTENTION: not thread safe)
 ChApi void SetChronoDataPath(const std::string& path);
 
@@ -0,0 +1,701 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/physics/ChGlobal.h"
+#include "chrono/physics/ChLightBodyContainer.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+using namespace collision;
+
+// -----------------------------------------------------------------------------
+// CLASS FOR THE PROXY OF A LIGHT BODY
+// -----------------------------------------------------------------------------
+
+ChLightBody::ChLightBody(ChLightBodyContainer* mcontainer, unsigned int mindex)
+    : container(mcontainer), index(mindex), collision_model(NULL) {}
+
+ChLightBody::~ChLightBody() {
+    delete collision_model;
+}
+
+ChCollisionModel* ChLightBody::GetCollisionModel() {
+    // Created on demand, so that bodies without a shape do not pay for it
+    if (!collision_model) {
+        collision_model = new ChModelBullet;
+        collision_model->SetContactable(this);
+    }
+    return collision_model;
+}
+
+std::shared_ptr<ChMaterialSurfaceBase>& ChLightBody::GetMaterialSurfaceBase() {
+    return container->GetMaterialSurfaceBase();
+}
+
+void ChLightBody::ContactableGetStateBlock_x(ChState& x) {
+    x.PasteCoordsys(container->GetCoord(index), 0, 0);
+}
+
+void ChLightBody::ContactableGetStateBlock_w(ChStateDelta& w) {
+    w.PasteVector(container->GetPos_dt(index), 0, 0);
+    w.PasteVector(container->GetWvel_loc(index), 3, 0);
+}
+
+void ChLightBody::ContactableIncrementState(const ChState& x, const ChStateDelta& dw, ChState& x_new) {
+    // Increment position
+    x_new(0) = x(0) + dw(0);
+    x_new(1) = x(1) + dw(1);
+    x_new(2) = x(2) + dw(2);
+
+    // Increment rotation: rot' = delta*rot  (use quaternion for delta rotation)
+    ChQuaternion<> mdeltarot;
+    ChQuaternion<> moldrot = x.ClipQuaternion(3, 0);
+    ChVector<> newwel_abs = container->GetRot(index).Rotate(dw.ClipVector(3, 0));
+    double mangle = newwel_abs.Length();
+    newwel_abs.Normalize();
+    mdeltarot.Q_from_AngAxis(mangle, newwel_abs);
+    ChQuaternion<> mnewrot = mdeltarot * moldrot;  // quaternion product
+    x_new.PasteQuaternion(mnewrot, 3, 0);
+}
+
+ChVector<> ChLightBody::GetContactPoint(const ChVector<>& loc_point, const ChState& state_x) {
+    ChCoordsys<> csys = state_x.ClipCoordsys(0, 0);
+    return csys.TransformPointLocalToParent(loc_point);
+}
+
+ChVector<> ChLightBody::GetContactPointSpeed(const ChVector<>& loc_point,
+                                             const ChState& state_x,
+                                             const ChStateDelta& state_w) {
+    ChCoordsys<> csys = state_x.ClipCoordsys(0, 0);
+    ChVector<> abs_vel = state_w.ClipVector(0, 0);
+    ChVector<> loc_omg = state_w.ClipVector(3, 0);
+    ChVector<> abs_omg = csys.TransformDirectionLocalToParent(loc_omg);
+
+    return abs_vel + Vcross(abs_omg, loc_point);
+}
+
+ChVector<> ChLightBody::GetContactPointSpeed(const ChVector<>& abs_point) {
+    ChVector<> m_p1_loc = container->GetCoord(index).TransformPointParentToLocal(abs_point);
+    return container->PointSpeedLocalToParent(index, m_p1_loc);
+}
+
+ChCoordsys<> ChLightBody::GetCsysForCollisionModel() {
+    return container->GetCoord(index);
+}
+
+void ChLightBody::ContactForceLoadResidual_F(const ChVector<>& F, const ChVector<>& abs_point, ChVectorDynamic<>& R) {
+    ChCoordsys<> csys = container->GetCoord(index);
+    ChVector<> m_p1_loc = csys.TransformPointParentToLocal(abs_point);
+    ChVector<> force1_loc = csys.TransformDirectionParentToLocal(F);
+    ChVector<> torque1_loc = Vcross(m_p1_loc, force1_loc);
+    R.PasteSumVector(F, variables.GetOffset() + 0, 0);
+    R.PasteSumVector(torque1_loc, variables.GetOffset() + 3, 0);
+}
+
+void ChLightBody::ContactForceLoadQ(const ChVector<>& F,
+                                    const ChVector<>& point,
+                                    const ChState& state_x,
+                                    ChVectorDynamic<>& Q,
+                                    int offset) {
+    ChCoordsys<> csys = state_x.ClipCoordsys(0, 0);
+    ChVector<> point_loc = csys.TransformPointParentToLocal(point);
+    ChVector<> force_loc = csys.TransformDirectionParentToLocal(F);
+    ChVector<> torque_loc = Vcross(point_loc, force_loc);
+    Q.PasteVector(F, offset + 0, 0);
+    Q.PasteVector(torque_loc, offset + 3, 0);
+}
+
+void ChLightBody::ComputeJacobianForContactPart(
+    const ChVector<>& abs_point,
+    ChMatrix33<>& contact_plane,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
+    bool second) {
+    ChMatrix33<> A(container->GetRot(index));
+    ChVector<> m_p1_loc = A.MatrT_x_Vect(abs_point - container->GetPos(index));
+    ChMatrix33<> Jx1, Jr1;
+    ChMatrix33<> Ps1, Jtemp;
+    Ps1.Set_X_matrix(m_p1_loc);
+
+    Jx1.CopyFromMatrixT(contact_plane);
+    if (!second)
+        Jx1.MatrNeg();
+
+    Jtemp.MatrMultiply(A, Ps1);
+    Jr1.MatrTMultiply(contact_plane, Jtemp);
+    if (second)
+        Jr1.MatrNeg();
+
+    jacobian_tuple_N.Get_Cq()->PasteClippedMatrix(&Jx1, 0, 0, 1, 3, 0, 0);
+    jacobian_tuple_U.Get_Cq()->PasteClippedMatrix(&Jx1, 1, 0, 1, 3, 0, 0);
+    jacobian_tuple_V.Get_Cq()->PasteClippedMatrix(&Jx1, 2, 0, 1, 3, 0, 0);
+    jacobian_tuple_N.Get_Cq()->PasteClippedMatrix(&Jr1, 0, 0, 1, 3, 0, 3);
+    jacobian_tuple_U.Get_Cq()->PasteClippedMatrix(&Jr1, 1, 0, 1, 3, 0, 3);
+    jacobian_tuple_V.Get_Cq()->PasteClippedMatrix(&Jr1, 2, 0, 1, 3, 0, 3);
+}
+
+void ChLightBody::ComputeJacobianForRollingContactPart(
+    const ChVector<>& abs_point,
+    ChMatrix33<>& contact_plane,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
+    ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
+    bool second) {
+    ChMatrix33<> A(container->GetRot(index));
+    ChMatrix33<> Jx1, Jr1;
+
+    Jr1.MatrTMultiply(contact_plane, A);
+    if (!second)
+        Jr1.MatrNeg();
+
+    jacobian_tuple_N.Get_Cq()->PasteClippedMatrix(&Jx1, 0, 0, 1, 3, 0, 0);
+    jacobian_tuple_U.Get_Cq()->PasteClippedMatrix(&Jx1, 1, 0, 1, 3, 0, 0);
+    jacobian_tuple_V.Get_Cq()->PasteClippedMatrix(&Jx1, 2, 0, 1, 3, 0, 0);
+    jacobian_tuple_N.Get_Cq()->PasteClippedMatrix(&Jr1, 0, 0, 1, 3, 0, 3);
+    jacobian_tuple_U.Get_Cq()->PasteClippedMatrix(&Jr1, 1, 0, 1, 3, 0, 3);
+    jacobian_tuple_V.Get_Cq()->PasteClippedMatrix(&Jr1, 2, 0, 1, 3, 0, 3);
+}
+
+ChPhysicsItem* ChLightBody::GetPhysicsItem() {
+    return container;
+}
+
+// -----------------------------------------------------------------------------
+// CLASS FOR THE CONTAINER OF LIGHT BODIES
+// -----------------------------------------------------------------------------
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+ChClassRegister<ChLightBodyContainer> a_registration_ChLightBodyContainer;
+
+// Number of threads for the loops over the bodies. Each body only writes its own
+// entries of the arrays, of its variables and of the state/residual vectors.
+static int UpdateThreadNumber(ChSystem* msystem) {
+    return msystem ? msystem->GetParallelUpdateThreadNumber() : 1;
+}
+
+ChLightBodyContainer::ChLightBodyContainer()
+    : do_collide(false), do_limit_speed(false), max_speed(0.5f), max_wvel((float)CH_C_2PI) {
+    // default DVI material
+    matsurface = std::make_shared<ChMaterialSurface>();
+}
+
+ChLightBodyContainer::ChLightBodyContainer(const ChLightBodyContainer& other) : ChPhysicsItem(other) {
+    pos = other.pos;
+    rot = other.rot;
+    pos_dt = other.pos_dt;
+    wvel_loc = other.wvel_loc;
+    pos_dtdt = other.pos_dtdt;
+    wacc_loc = other.wacc_loc;
+    mass = other.mass;
+    force = other.force;
+    torque = other.torque;
+
+    CreateProxies(0);
+    for (size_t j = 0; j < bodies.size(); j++) {
+        if (other.bodies[j]->HasCollisionModel()) {
+            bodies[j]->GetCollisionModel()->AddCopyOfAnotherModel(other.bodies[j]->collision_model);
+        }
+    }
+
+    matsurface = std::shared_ptr<ChMaterialSurfaceBase>(other.matsurface->Clone());  // deep copy
+
+    do_collide = other.do_collide;
+    do_limit_speed = other.do_limit_speed;
+    max_speed = other.max_speed;
+    max_wvel = other.max_wvel;
+}
+
+ChLightBodyContainer::~ChLightBodyContainer() {
+    // the base class cannot do this, once the collision models are deleted
+    if (GetSystem() && GetCollide())
+        RemoveCollisionModelsFromSystem();
+
+    for (size_t j = 0; j < bodies.size(); j++)
+        delete bodies[j];
+}
+
+void ChLightBodyContainer::Reserve(size_t num_bodies) {
+    pos.reserve(num_bodies);
+    rot.reserve(num_bodies);
+    pos_dt.reserve(num_bodies);
+    wvel_loc.reserve(num_bodies);
+    pos_dtdt.reserve(num_bodies);
+    wacc_loc.reserve(num_bodies);
+    force.reserve(num_bodies);
+    torque.reserve(num_bodies);
+    bodies.reserve(num_bodies);
+
+    if (num_bodies > mass.capacity()) {
+        mass.reserve(num_bodies);
+        UpdateSharedMass();
+    }
+}
+
+unsigned int ChLightBodyContainer::AddBody(const ChCoordsys<>& initial_state,
+                                           double body_mass,
+                                           const ChVector<>& inertiaXX) {
+    unsigned int n = (unsigned int)bodies.size();
+
+    pos.push_back(initial_state.pos);
+    rot.push_back(initial_state.rot);
+    pos_dt.push_back(VNULL);
+    wvel_loc.push_back(VNULL);
+    pos_dtdt.push_back(VNULL);
+    wacc_loc.push_back(VNULL);
+    force.push_back(VNULL);
+    torque.push_back(VNULL);
+
+    // the variables of the bodies point into the mass array: fix them if it is reallocated
+    size_t old_capacity = mass.capacity();
+    mass.push_back(ChSharedMassBody());
+    if (mass.capacity() != old_capacity)
+        UpdateSharedMass();
+
+    CreateProxies(n);
+
+    SetMass(n, body_mass);
+    SetInertiaXX(n, inertiaXX);
+
+    return n;
+}
+
+void ChLightBodyContainer::CreateProxies(size_t from) {
+    bodies.resize(pos.size());
+    for (size_t j = from; j < bodies.size(); j++) {
+        bodies[j] = new ChLightBody(this, (unsigned int)j);
+        bodies[j]->variables.SetSharedMass(&mass[j]);
+        bodies[j]->variables.SetUserData((void*)this);
+    }
+}
+
+void ChLightBodyContainer::UpdateSharedMass() {
+    for (size_t j = 0; j < bodies.size(); j++)
+        bodies[j]->variables.SetSharedMass(&mass[j]);
+}
+
+ChQuaternion<> ChLightBodyContainer::IncrementRotation(const ChQuaternion<>& q, const ChVector<>& dw_loc) {
+    ChQuaternion<> mdeltarot;
+    ChVector<> newwel_abs = q.Rotate(dw_loc);
+    double mangle = newwel_abs.Length();
+    newwel_abs.Normalize();
+    mdeltarot.Q_from_AngAxis(mangle, newwel_abs);
+    return mdeltarot * q;  // quaternion product
+}
+
+// The inertia tensor functions
+
+void ChLightBodyContainer::SetInertiaXX(unsigned int n, const ChVector<>& iner) {
+    mass[n].GetBodyInertia().SetElement(0, 0, iner.x);
+    mass[n].GetBodyInertia().SetElement(1, 1, iner.y);
+    mass[n].GetBodyInertia().SetElement(2, 2, iner.z);
+    mass[n].GetBodyInertia().FastInvert(&mass[n].GetBodyInvInertia());
+}
+
+ChVector<> ChLightBodyContainer::GetInertiaXX(unsigned int n) const {
+    ChVector<> iner;
+    iner.x = mass[n].GetBodyInertia().GetElement(0, 0);
+    iner.y = mass[n].GetBodyInertia().GetElement(1, 1);
+    iner.z = mass[n].GetBodyInertia().GetElement(2, 2);
+    return iner;
+}
+
+ChFrame<> ChLightBodyContainer::GetAssetsFrame(unsigned int nclone) {
+    return ChFrame<>(pos[nclone], rot[nclone]);
+}
+
+void ChLightBodyContainer::ClampSpeed() {
+    if (!GetLimitSpeed())
+        return;
+
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        double w = wvel_loc[j].Length();
+        if (w > max_wvel)
+            wvel_loc[j] *= max_wvel / w;
+
+        double v = pos_dt[j].Length();
+        if (v > max_speed)
+            pos_dt[j] *= max_speed / v;
+    }
+}
+
+void ChLightBodyContainer::SetNoSpeedNoAcceleration() {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        pos_dt[j] = VNULL;
+        wvel_loc[j] = VNULL;
+        pos_dtdt[j] = VNULL;
+        wacc_loc[j] = VNULL;
+    }
+}
+
+void ChLightBodyContainer::Update(bool update_assets) {
+    ChLightBodyContainer::Update(GetChTime(), update_assets);
+}
+
+void ChLightBodyContainer::Update(double mytime, bool update_assets) {
+    ChTime = mytime;
+
+    // There are no auxiliary data (rotation matrices, markers, forces lists) to refresh
+    ClampSpeed();  // Apply limits (if in speed clamping mode) to speeds.
+}
+
+// STATE BOOKKEEPING FUNCTIONS
+
+void ChLightBodyContainer::IntStateGather(const unsigned int off_x,  // offset in x state vector
+                                          ChState& x,                // state vector, position part
+                                          const unsigned int off_v,  // offset in v state vector
+                                          ChStateDelta& v,           // state vector, speed part
+                                          double& T                  // time
+                                          ) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        x.PasteVector(pos[j], off_x + 7 * j, 0);
+        x.PasteQuaternion(rot[j], off_x + 7 * j + 3, 0);
+        v.PasteVector(pos_dt[j], off_v + 6 * j, 0);
+        v.PasteVector(wvel_loc[j], off_v + 6 * j + 3, 0);
+    }
+    T = GetChTime();
+}
+
+void ChLightBodyContainer::IntStateScatter(const unsigned int off_x,  // offset in x state vector
+                                           const ChState& x,          // state vector, position part
+                                           const unsigned int off_v,  // offset in v state vector
+                                           const ChStateDelta& v,     // state vector, speed part
+                                           const double T             // time
+                                           ) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        pos[j] = x.ClipVector(off_x + 7 * j, 0);
+        rot[j] = x.ClipQuaternion(off_x + 7 * j + 3, 0);
+        pos_dt[j] = v.ClipVector(off_v + 6 * j, 0);
+        wvel_loc[j] = v.ClipVector(off_v + 6 * j + 3, 0);
+    }
+    SetChTime(T);
+    Update();
+}
+
+void ChLightBodyContainer::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        a.PasteVector(pos_dtdt[j], off_a + 6 * (unsigned int)j, 0);
+        a.PasteVector(wacc_loc[j], off_a + 6 * (unsigned int)j + 3, 0);
+    }
+}
+
+void ChLightBodyContainer::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        pos_dtdt[j] = a.ClipVector(off_a + 6 * (unsigned int)j, 0);
+        wacc_loc[j] = a.ClipVector(off_a + 6 * (unsigned int)j + 3, 0);
+    }
+}
+
+void ChLightBodyContainer::IntStateIncrement(const unsigned int off_x,  // offset in x state vector
+                                             ChState& x_new,            // state vector, position part, incremented result
+                                             const ChState& x,          // state vector, initial position part
+                                             const unsigned int off_v,  // offset in v state vector
+                                             const ChStateDelta& Dv     // state vector, increment
+                                             ) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        // ADVANCE POSITION:
+        x_new(off_x + 7 * j) = x(off_x + 7 * j) + Dv(off_v + 6 * j);
+        x_new(off_x + 7 * j + 1) = x(off_x + 7 * j + 1) + Dv(off_v + 6 * j + 1);
+        x_new(off_x + 7 * j + 2) = x(off_x + 7 * j + 2) + Dv(off_v + 6 * j + 2);
+
+        // ADVANCE ROTATION: rot' = delta*rot  (use quaternion for delta rotation)
+        ChQuaternion<> moldrot = x.ClipQuaternion(off_x + 7 * j + 3, 0);
+        x_new.PasteQuaternion(IncrementRotation(moldrot, Dv.ClipVector(off_v + 6 * j + 3, 0)), off_x + 7 * j + 3, 0);
+    }
+}
+
+void ChLightBodyContainer::IntLoadResidual_F(const unsigned int off,  // offset in R residual
+                                             ChVectorDynamic<>& R,    // result: the R residual, R += c*F
+                                             const double c           // a scaling factor
+                                             ) {
+    ChVector<> G_acc = GetSystem() ? GetSystem()->Get_G_acc() : VNULL;
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        // body gyroscopic force:
+        ChVector<> gyro = Vcross(wvel_loc[j], mass[j].GetBodyInertia().Matr_x_Vect(wvel_loc[j]));
+
+        // add applied forces and torques (and also the gyroscopic torque and gravity!) to 'fb' vector
+        R.PasteSumVector((force[j] + G_acc * mass[j].GetBodyMass()) * c, off + 6 * j, 0);
+        R.PasteSumVector((torque[j] - gyro) * c, off + 6 * j + 3, 0);
+    }
+}
+
+void ChLightBodyContainer::IntLoadResidual_Mv(const unsigned int off,      // offset in R residual
+                                              ChVectorDynamic<>& R,        // result: the R residual, R += c*M*v
+                                              const ChVectorDynamic<>& w,  // the w vector
+                                              const double c               // a scaling factor
+                                              ) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        double cm = c * mass[j].GetBodyMass();
+        R(off + 6 * j + 0) += cm * w(off + 6 * j + 0);
+        R(off + 6 * j + 1) += cm * w(off + 6 * j + 1);
+        R(off + 6 * j + 2) += cm * w(off + 6 * j + 2);
+        ChVector<> Iw = mass[j].GetBodyInertia() * w.ClipVector(off + 6 * j + 3, 0);
+        Iw *= c;
+        R.PasteSumVector(Iw, off + 6 * j + 3, 0);
+    }
+}
+
+void ChLightBodyContainer::IntToDescriptor(const unsigned int off_v,  // offset in v, R
+                                           const ChStateDelta& v,
+                                           const ChVectorDynamic<>& R,
+                                           const unsigned int off_L,  // offset in L, Qc
+                                           const ChVectorDynamic<>& L,
+                                           const ChVectorDynamic<>& Qc) {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        unsigned int off = off_v + 6 * (unsigned int)j;
+        bodies[j]->variables.Get_qb().PasteClippedMatrix(&v, off, 0, 6, 1, 0, 0);
+        bodies[j]->variables.Get_fb().PasteClippedMatrix(&R, off, 0, 6, 1, 0, 0);
+    }
+}
+
+void ChLightBodyContainer::IntFromDescriptor(const unsigned int off_v,  // offset in v
+                                             ChStateDelta& v,
+                                             const unsigned int off_L,  // offset in L
+                                             ChVectorDynamic<>& L) {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        v.PasteMatrix(&bodies[j]->variables.Get_qb(), off_v + 6 * (unsigned int)j, 0);
+    }
+}
+
+// SOLVER FUNCTIONS
+
+void ChLightBodyContainer::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        mdescriptor.InsertVariables(&bodies[j]->variables);
+    }
+}
+
+void ChLightBodyContainer::VariablesFbReset() {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        bodies[j]->variables.Get_fb().FillElem(0.0);
+    }
+}
+
+void ChLightBodyContainer::VariablesFbLoadForces(double factor) {
+    ChVector<> G_acc = GetSystem() ? GetSystem()->Get_G_acc() : VNULL;
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        // body gyroscopic force:
+        ChVector<> gyro = Vcross(wvel_loc[j], mass[j].GetBodyInertia().Matr_x_Vect(wvel_loc[j]));
+
+        // add applied forces and torques (and also the gyroscopic torque and gravity!) to 'fb' vector
+        ChMatrix<>& fb = bodies[j]->variables.Get_fb();
+        fb.PasteSumVector((force[j] + G_acc * mass[j].GetBodyMass()) * factor, 0, 0);
+        fb.PasteSumVector((torque[j] - gyro) * factor, 3, 0);
+    }
+}
+
+void ChLightBodyContainer::VariablesQbLoadSpeed() {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        // set current speed in 'qb', it can be used by the solver when working in incremental mode
+        ChMatrix<>& qb = bodies[j]->variables.Get_qb();
+        qb.PasteVector(pos_dt[j], 0, 0);
+        qb.PasteVector(wvel_loc[j], 3, 0);
+    }
+}
+
+void ChLightBodyContainer::VariablesFbIncrementMq() {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        bodies[j]->variables.Compute_inc_Mb_v(bodies[j]->variables.Get_fb(), bodies[j]->variables.Get_qb());
+    }
+}
+
+void ChLightBodyContainer::VariablesQbSetSpeed(double step) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        ChVector<> old_pos_dt = pos_dt[j];
+        ChVector<> old_wvel_loc = wvel_loc[j];
+
+        // from 'qb' vector, sets body speed
+        ChMatrix<>& qb = bodies[j]->variables.Get_qb();
+        pos_dt[j] = qb.ClipVector(0, 0);
+        wvel_loc[j] = qb.ClipVector(3, 0);
+
+        // Compute accel. by BDF (approximate by differentiation);
+        if (step) {
+            pos_dtdt[j] = (pos_dt[j] - old_pos_dt) / step;
+            wacc_loc[j] = (wvel_loc[j] - old_wvel_loc) / step;
+        }
+    }
+
+    // apply limits (if in speed clamping mode) to speeds.
+    ClampSpeed();
+}
+
+void ChLightBodyContainer::VariablesQbIncrementPosition(double dt_step) {
+    int num = (int)bodies.size();
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int j = 0; j < num; j++) {
+        // Updates position with incremental action of speed contained in the
+        // 'qb' vector:  pos' = pos + dt * speed   , like in an Eulero step.
+        ChMatrix<>& qb = bodies[j]->variables.Get_qb();
+
+        // ADVANCE POSITION: pos' = pos + dt * vel
+        pos[j] += qb.ClipVector(0, 0) * dt_step;
+
+        // ADVANCE ROTATION: rot' = [dt*wwel]%rot  (use quaternion for delta rotation)
+        rot[j] = IncrementRotation(rot[j], qb.ClipVector(3, 0) * dt_step);
+    }
+}
+
+// COLLISION FUNCTIONS
+
+void ChLightBodyContainer::SetCollide(bool mcoll) {
+    if (mcoll == do_collide)
+        return;
+
+    if (GetSystem()) {
+        if (mcoll) {
+            do_collide = true;
+            AddCollisionModelsToSystem();
+        } else {
+            RemoveCollisionModelsFromSystem();
+            do_collide = false;
+        }
+    } else {
+        do_collide = mcoll;
+    }
+}
+
+void ChLightBodyContainer::SyncCollisionModels() {
+    for (size_t j = 0; j < bodies.size(); j++) {
+        if (bodies[j]->collision_model)
+            bodies[j]->collision_model->SyncPosition();
+    }
+}
+
+void ChLightBodyContainer::AddCollisionModelsToSystem() {
+    assert(GetSystem());
+    SyncCollisionModels();
+    for (size_t j = 0; j < bodies.size(); j++) {
+        if (bodies[j]->collision_model)
+            GetSystem()->GetCollisionSystem()->Add(bodies[j]->collision_model);
+    }
+}
+
+void ChLightBodyContainer::RemoveCollisionModelsFromSystem() {
+    assert(GetSystem());
+    // with many bodies, removing them one at a time from the collision system is too slow
+    std::vector<ChCollisionModel*> models;
+    models.reserve(bodies.size());
+    for (size_t j = 0; j < bodies.size(); j++) {
+        if (bodies[j]->collision_model)
+            models.push_back(bodies[j]->collision_model);
+    }
+    GetSystem()->GetCollisionSystem()->RemoveBatch(models);
+}
+
+// FILE I/O
+
+void ChLightBodyContainer::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite(1);
+
+    // serialize parent class
+    ChPhysicsItem::ArchiveOUT(marchive);
+
+    // serialize all member data:
+    // (the collision shapes of the bodies are not serialized)
+    marchive << CHNVP(pos);
+    marchive << CHNVP(rot);
+    marchive << CHNVP(pos_dt);
+    marchive << CHNVP(wvel_loc);
+    marchive << CHNVP(force);
+    marchive << CHNVP(torque);
+    marchive << CHNVP(mass);
+    marchive << CHNVP(matsurface);
+    marchive << CHNVP(do_collide);
+    marchive << CHNVP(do_limit_speed);
+    marchive << CHNVP(max_speed);
+    marchive << CHNVP(max_wvel);
+}
+
+void ChLightBodyContainer::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead();
+
+    // deserialize parent class:
+    ChPhysicsItem::ArchiveIN(marchive);
+
+    // deserialize all member data:
+
+    if (GetSystem() && GetCollide())
+        RemoveCollisionModelsFromSystem();
+    for (size_t j = 0; j < bodies.size(); j++)
+        delete bodies[j];
+    bodies.clear();
+
+    marchive >> CHNVP(pos);
+    marchive >> CHNVP(rot);
+    marchive >> CHNVP(pos_dt);
+    marchive >> CHNVP(wvel_loc);
+    marchive >> CHNVP(force);
+    marchive >> CHNVP(torque);
+    marchive >> CHNVP(mass);
+    marchive >> CHNVP(matsurface);
+    marchive >> CHNVP(do_collide);
+    marchive >> CHNVP(do_limit_speed);
+    marchive >> CHNVP(max_speed);
+    marchive >> CHNVP(max_wvel);
+
+    pos_dtdt.assign(pos.size(), VNULL);
+    wacc_loc.assign(pos.size(), VNULL);
+    CreateProxies(0);
+}
+
+}  // end namespace chrono
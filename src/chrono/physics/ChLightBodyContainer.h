@@ -0,0 +1,394 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHLIGHTBODYCONTAINER_H
+#define CHLIGHTBODYCONTAINER_H
+
+#include <vector>
+
+#include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/physics/ChContactable.h"
+#include "chrono/physics/ChMaterialSurface.h"
+#include "chrono/physics/ChPhysicsItem.h"
+#include "chrono/solver/ChVariablesBodySharedMass.h"
+
+namespace chrono {
+
+// Forward references
+class ChLightBodyContainer;
+
+/// Proxy of a single body of a ChLightBodyContainer.
+/// It does not store the state, the mass or the forces of the body, that are kept in the
+/// arrays of the container; it only holds what the collision system and the solver need
+/// to reference the body: the variables and the (optional) collision model.
+
+class ChApi ChLightBody : public ChContactable_1vars<6> {
+  public:
+    ChLightBody(ChLightBodyContainer* mcontainer, unsigned int mindex);
+    virtual ~ChLightBody();
+
+    /// Get the container
+    ChLightBodyContainer* GetContainer() const { return container; }
+
+    /// Get the index of this body in the arrays of the container
+    unsigned int GetIndex() const { return index; }
+
+    /// Access the variables of the body
+    ChVariablesBodySharedMass& Variables() { return variables; }
+
+    /// Access the collision model of the body, creating it if needed.
+    collision::ChCollisionModel* GetCollisionModel();
+
+    /// Tell if the collision model of the body was ever created
+    bool HasCollisionModel() const { return collision_model != NULL; }
+
+    //
+    // INTERFACE TO ChContactable
+    //
+
+    /// Access variables.
+    virtual ChVariables* GetVariables1() override { return &variables; }
+
+    /// Tell if the object must be considered in collision detection.
+    virtual bool IsContactActive() override { return true; }
+
+    /// Get the number of DOFs affected by this object (position part).
+    virtual int ContactableGet_ndof_x() override { return 7; }
+
+    /// Get the number of DOFs affected by this object (speed part).
+    virtual int ContactableGet_ndof_w() override { return 6; }
+
+    /// Get all the DOFs packed in a single vector (position part)
+    virtual void ContactableGetStateBlock_x(ChState& x) override;
+
+    /// Get all the DOFs packed in a single vector (speed part)
+    virtual void ContactableGetStateBlock_w(ChStateDelta& w) override;
+
+    /// Increment the provided state of this object by the given state-delta increment.
+    /// Compute: x_new = x + dw.
+    virtual void ContactableIncrementState(const ChState& x, const ChStateDelta& dw, ChState& x_new) override;
+
+    /// Return the pointer to the contact surface material.
+    virtual std::shared_ptr<ChMaterialSurfaceBase>& GetMaterialSurfaceBase() override;
+
+    /// Express the local point in absolute frame, for the given state position.
+    virtual ChVector<> GetContactPoint(const ChVector<>& loc_point, const ChState& state_x) override;
+
+    /// Get the absolute speed of a local point attached to the contactable.
+    /// The given point is assumed to be expressed in the local frame of this object.
+    /// This function must use the provided states.
+    virtual ChVector<> GetContactPointSpeed(const ChVector<>& loc_point,
+                                            const ChState& state_x,
+                                            const ChStateDelta& state_w) override;
+
+    /// Get the absolute speed of point abs_point if attached to the surface.
+    virtual ChVector<> GetContactPointSpeed(const ChVector<>& abs_point) override;
+
+    /// Return the coordinate system for the associated collision model.
+    virtual ChCoordsys<> GetCsysForCollisionModel() override;
+
+    /// Apply the force, expressed in absolute reference, applied in pos, to the
+    /// coordinates of the variables. Force for example could come from a penalty model.
+    virtual void ContactForceLoadResidual_F(const ChVector<>& F,
+                                            const ChVector<>& abs_point,
+                                            ChVectorDynamic<>& R) override;
+
+    /// Apply the given force at the given point and load the generalized force array.
+    /// The force and its application point are specified in the gloabl frame.
+    /// Each object must set the entries in Q corresponding to its variables, starting at the specified offset.
+    /// If needed, the object states must be extracted from the provided state position.
+    virtual void ContactForceLoadQ(const ChVector<>& F,
+                                   const ChVector<>& point,
+                                   const ChState& state_x,
+                                   ChVectorDynamic<>& Q,
+                                   int offset) override;
+
+    /// Compute the jacobian(s) part(s) for this contactable item.
+    virtual void ComputeJacobianForContactPart(const ChVector<>& abs_point,
+                                               ChMatrix33<>& contact_plane,
+                                               ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
+                                               ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
+                                               ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
+                                               bool second) override;
+
+    /// Compute the jacobian(s) part(s) for this contactable item, for rolling about N,u,v
+    /// (used only for rolling friction DVI contacts)
+    virtual void ComputeJacobianForRollingContactPart(
+        const ChVector<>& abs_point,
+        ChMatrix33<>& contact_plane,
+        ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
+        ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
+        ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
+        bool second) override;
+
+    /// used by some DEM code
+    virtual double GetContactableMass() override { return variables.GetBodyMass(); }
+
+    /// This is only for backward compatibility
+    virtual ChPhysicsItem* GetPhysicsItem() override;
+
+  private:
+    ChLightBodyContainer* container;
+    unsigned int index;
+    ChVariablesBodySharedMass variables;
+    collision::ChCollisionModel* collision_model;
+
+    friend class ChLightBodyContainer;
+};
+
+/// Container of many light rigid bodies, an alternative to adding a large number of
+/// ChBody objects to the system.
+/// The state (position, rotation, speeds, accelerations), the mass, the inertia and the
+/// applied forces of all the bodies are stored in contiguous arrays, one per quantity,
+/// and the container updates all of them in single loops, without per-body virtual calls.
+/// Light bodies have no markers, no forces list and cannot be fixed or put to sleep;
+/// they can collide and can be referenced by contacts, through their ChLightBody proxies.
+/// Unlike ChParticlesClones, each body has its own mass, inertia and collision shape.
+
+class ChApi ChLightBodyContainer : public ChPhysicsItem {
+    // Chrono simulation of RTTI, needed for serialization
+    CH_RTTI(ChLightBodyContainer, ChPhysicsItem);
+
+  private:
+    std::vector<ChVector<> > pos;           ///< positions of the bodies (abs.)
+    std::vector<ChQuaternion<> > rot;       ///< rotations of the bodies
+    std::vector<ChVector<> > pos_dt;        ///< linear speeds (abs.)
+    std::vector<ChVector<> > wvel_loc;      ///< angular speeds (local)
+    std::vector<ChVector<> > pos_dtdt;      ///< linear accelerations (abs.)
+    std::vector<ChVector<> > wacc_loc;      ///< angular accelerations (local)
+    std::vector<ChSharedMassBody> mass;     ///< mass, inertia and their inverses
+    std::vector<ChVector<> > force;         ///< applied forces (abs.)
+    std::vector<ChVector<> > torque;        ///< applied torques (local)
+    std::vector<ChLightBody*> bodies;       ///< proxies for the collision system and the solver
+
+    std::shared_ptr<ChMaterialSurfaceBase> matsurface;  ///< data for surface contact and impact
+
+    bool do_collide;
+    bool do_limit_speed;
+
+    float max_speed;  ///< limit on linear speed (useful for increased simulation speed)
+    float max_wvel;   ///< limit on angular vel. (useful for increased simulation speed)
+
+  public:
+    ChLightBodyContainer();
+    ChLightBodyContainer(const ChLightBodyContainer& other);
+    ~ChLightBodyContainer();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChLightBodyContainer* Clone() const override { return new ChLightBodyContainer(*this); }
+
+    /// Reserve memory for the given number of bodies.
+    void Reserve(size_t num_bodies);
+
+    /// Add a new body, with the given initial position, mass and diagonal inertia.
+    /// Returns the index of the body in the container.
+    /// Define its collision shape, if any, using GetCollisionModel(index).
+    unsigned int AddBody(const ChCoordsys<>& initial_state = CSYSNORM,
+                         double body_mass = 1,
+                         const ChVector<>& inertiaXX = ChVector<>(1, 1, 1));
+
+    /// Get the number of bodies
+    size_t GetNbodies() const { return bodies.size(); }
+
+    /// Access the proxy of the n-th body (used by the collision system and by the solver)
+    ChLightBody& GetBody(unsigned int n) { return *bodies[n]; }
+
+    /// Access the collision model of the n-th body, creating it if needed.
+    /// As for ChBody, use ClearModel(), Add...() and BuildModel() to define its shape.
+    collision::ChCollisionModel* GetCollisionModel(unsigned int n) { return bodies[n]->GetCollisionModel(); }
+
+    //
+    // ACCESS TO THE BODY DATA
+    //
+
+    const ChVector<>& GetPos(unsigned int n) const { return pos[n]; }
+    void SetPos(unsigned int n, const ChVector<>& mpos) { pos[n] = mpos; }
+
+    const ChQuaternion<>& GetRot(unsigned int n) const { return rot[n]; }
+    void SetRot(unsigned int n, const ChQuaternion<>& mrot) { rot[n] = mrot; }
+
+    /// Get the coordinate system of the n-th body
+    ChCoordsys<> GetCoord(unsigned int n) const { return ChCoordsys<>(pos[n], rot[n]); }
+
+    const ChVector<>& GetPos_dt(unsigned int n) const { return pos_dt[n]; }
+    void SetPos_dt(unsigned int n, const ChVector<>& mvel) { pos_dt[n] = mvel; }
+
+    /// Angular speed of the n-th body, in local coordinates
+    const ChVector<>& GetWvel_loc(unsigned int n) const { return wvel_loc[n]; }
+    void SetWvel_loc(unsigned int n, const ChVector<>& mwvel) { wvel_loc[n] = mwvel; }
+
+    /// Angular speed of the n-th body, in absolute coordinates
+    ChVector<> GetWvel_par(unsigned int n) const { return rot[n].Rotate(wvel_loc[n]); }
+    void SetWvel_par(unsigned int n, const ChVector<>& mwvel) { wvel_loc[n] = rot[n].RotateBack(mwvel); }
+
+    const ChVector<>& GetPos_dtdt(unsigned int n) const { return pos_dtdt[n]; }
+
+    /// Angular acceleration of the n-th body, in local coordinates
+    const ChVector<>& GetWacc_loc(unsigned int n) const { return wacc_loc[n]; }
+
+    /// Mass of the n-th body. Must be positive.
+    double GetMass(unsigned int n) const { return mass[n].GetBodyMass(); }
+    void SetMass(unsigned int n, double newmass) {
+        if (newmass > 0)
+            mass[n].SetBodyMass(newmass);
+    }
+
+    /// Set the inertia tensor of the n-th body
+    void SetInertia(unsigned int n, const ChMatrix33<>& newXInertia) { mass[n].SetBodyInertia(newXInertia); }
+    /// Set the diagonal part of the inertia tensor of the n-th body
+    void SetInertiaXX(unsigned int n, const ChVector<>& iner);
+    /// Get the diagonal part of the inertia tensor of the n-th body
+    ChVector<> GetInertiaXX(unsigned int n) const;
+
+    /// Force applied to the n-th body, in absolute coordinates (gravity is added automatically)
+    const ChVector<>& GetForce(unsigned int n) const { return force[n]; }
+    void SetForce(unsigned int n, const ChVector<>& mforce) { force[n] = mforce; }
+
+    /// Torque applied to the n-th body, in local coordinates
+    const ChVector<>& GetTorque(unsigned int n) const { return torque[n]; }
+    void SetTorque(unsigned int n, const ChVector<>& mtorque) { torque[n] = mtorque; }
+
+    /// Get the position of the point with local coordinates loc_point on the n-th body
+    ChVector<> TransformPointLocalToParent(unsigned int n, const ChVector<>& loc_point) const {
+        return pos[n] + rot[n].Rotate(loc_point);
+    }
+
+    /// Get the absolute speed of the point with local coordinates loc_point on the n-th body
+    ChVector<> PointSpeedLocalToParent(unsigned int n, const ChVector<>& loc_point) const {
+        return pos_dt[n] + rot[n].Rotate(Vcross(wvel_loc[n], loc_point));
+    }
+
+    //
+    // COLLISION AND CONTACT
+    //
+
+    /// Enable/disable the collision for all the bodies of the container.
+    void SetCollide(bool mcoll);
+    virtual bool GetCollide() override { return do_collide; }
+
+    /// Set the material surface for contacts (shared by all bodies)
+    void SetMaterialSurface(const std::shared_ptr<ChMaterialSurfaceBase>& mnewsurf) { matsurface = mnewsurf; }
+
+    /// Get the material surface for contacts
+    std::shared_ptr<ChMaterialSurfaceBase>& GetMaterialSurfaceBase() { return matsurface; }
+
+    /// Synchronize coll.models coordinates and bounding boxes to the positions of the bodies.
+    virtual void SyncCollisionModels() override;
+    virtual void AddCollisionModelsToSystem() override;
+    virtual void RemoveCollisionModelsFromSystem() override;
+
+    /// Trick. Set the maximum linear and angular speed of the bodies (beyond these
+    /// limits they will be clamped). This speed limit is active only if you set SetLimitSpeed(true);
+    void SetLimitSpeed(bool mlimit) { do_limit_speed = mlimit; }
+    bool GetLimitSpeed() const { return do_limit_speed; }
+    void SetMaxSpeed(float m_max_speed) { max_speed = m_max_speed; }
+    float GetMaxSpeed() const { return max_speed; }
+    void SetMaxWvel(float m_max_wvel) { max_wvel = m_max_wvel; }
+    float GetMaxWvel() const { return max_wvel; }
+
+    /// When this function is called, the speeds of the bodies are clamped
+    /// into limits posed by max_speed and max_wvel, if in SetLimitSpeed(true) mode.
+    void ClampSpeed();
+
+    /// Set no speed and no accelerations (but does not change the position)
+    virtual void SetNoSpeedNoAcceleration() override;
+
+    //
+    // FUNCTIONS
+    //
+
+    /// Number of coordinates of all the bodies, x7 because with quaternions for rotation
+    virtual int GetDOF() override { return 7 * (int)bodies.size(); }
+    /// Number of coordinates of all the bodies, x6 because derivatives es. angular vel.
+    virtual int GetDOF_w() override { return 6 * (int)bodies.size(); }
+
+    /// Get the coordinate system of the n-th body, for the visualization assets
+    virtual ChFrame<> GetAssetsFrame(unsigned int nclone = 0) override;
+    virtual unsigned int GetAssetsFrameNclones() override { return (unsigned int)bodies.size(); }
+
+    /// Update all auxiliary data of the bodies
+    virtual void Update(double mytime, bool update_assets = true) override;
+    /// Update all auxiliary data of the bodies
+    virtual void Update(bool update_assets = true) override;
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER FUNCTIONS
+    //
+
+    // Override/implement system functions of ChPhysicsItem
+    // (to assemble/manage data for system solver)
+
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+
+    //
+    // SERIALIZATION
+    //
+
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Create the proxies of the bodies, after the arrays were resized
+    void CreateProxies(size_t from);
+    /// Point the variables of the proxies to the (possibly reallocated) mass array
+    void UpdateSharedMass();
+    /// Advance rotation q by the local angular increment dw, as rot' = delta*rot
+    static ChQuaternion<> IncrementRotation(const ChQuaternion<>& q, const ChVector<>& dw_loc);
+};
+
+}  // end namespace chrono
+
+#endif
@@ -13,6 +13,9 @@
 #ifndef CHLOAD_H
 #define CHLOAD_H
 
+#include <algorithm>
+#include <vector>
+
 #include "chrono/physics/ChLoader.h"
 #include "chrono/physics/ChLoaderU.h"
 #include "chrono/physics/ChLoaderUV.h"
@@ -140,6 +143,20 @@ public:
         /// the jacobians of the load.
     virtual bool IsStiff() = 0;
 
+        /// Sparsity of the jacobians, used to compute them by colored finite differences.
+        /// A load whose Q is made of parts that depend only on some of its coordinates (ex. forces
+        /// on many nodes, each depending on the state of few nodes) can split its coordinates in
+        /// blocks, and tell for each block j the blocks of Q that depend on the coordinates of j.
+        /// Blocks whose dependent parts of Q do not overlap are perturbed at the same time, so
+        /// the jacobians are computed with much less evaluations of Q.
+        /// Return false (default) if the jacobians are dense.
+    virtual bool GetJacobianSparsity(std::vector<int>& block_offsets_x,  ///< offsets of the blocks in x, plus size of x
+                                     std::vector<int>& block_offsets_w,  ///< offsets of the blocks in w, plus size of w
+                                     std::vector<std::vector<int> >& block_deps  ///< blocks of Q depending on each block
+                                     ) {
+        return false;
+    }
+
     //
     // Functions for interfacing to the state bookkeeping and solver
     //
@@ -169,6 +186,97 @@ public:
             this->jacobians->KRM.Get_K()->MatrInc(this->jacobians->M * Mfactor);
         }
     }
+
+protected:
+        /// Compute the K=-dQ/dx, R=-dQ/dv jacobians by backward differentiation, calling
+        /// ComputeQ() with perturbed states; mQ is where ComputeQ() stores Q.
+        /// Columns of independent blocks (see GetJacobianSparsity) are computed together.
+    void ComputeJacobianFD(ChState*      state_x, ///< state position to evaluate jacobians
+                           ChStateDelta* state_w, ///< state speed to evaluate jacobians
+                           ChMatrix<>& mK,        ///< result -dQ/dx
+                           ChMatrix<>& mR,        ///< result -dQ/dv
+                           ChVectorDynamic<>& mQ  ///< the Q vector computed by ComputeQ()
+                           ) {
+        double Delta = 1e-8;
+
+        int mrows_w = this->LoadGet_ndof_w();
+
+        // blocks of coordinates, and blocks of Q depending on them (default: one dense block)
+        std::vector<int> offs_x, offs_w;
+        std::vector<std::vector<int> > deps;
+        if (!this->GetJacobianSparsity(offs_x, offs_w, deps)) {
+            offs_x.assign(1, 0);
+            offs_x.push_back(this->LoadGet_ndof_x());
+            offs_w.assign(1, 0);
+            offs_w.push_back(mrows_w);
+            deps.assign(1, std::vector<int>(1, 0));
+        }
+        int nblocks = (int)deps.size();
+
+        // greedy coloring: blocks with a common dependent block of Q get different colors
+        std::vector<std::vector<int> > users(nblocks);  // blocks whose coordinates affect each block of Q
+        for (int j = 0; j < nblocks; ++j)
+            for (size_t r = 0; r < deps[j].size(); ++r)
+                users[deps[j][r]].push_back(j);
+        std::vector<int> color(nblocks, -1);
+        std::vector<int> mark;
+        std::vector<std::vector<int> > colors;
+        for (int j = 0; j < nblocks; ++j) {
+            mark.assign(colors.size() + 1, 0);
+            for (size_t r = 0; r < deps[j].size(); ++r)
+                for (size_t u = 0; u < users[deps[j][r]].size(); ++u)
+                    if (color[users[deps[j][r]][u]] >= 0)
+                        mark[color[users[deps[j][r]][u]]] = 1;
+            int c = 0;
+            while (mark[c])
+                ++c;
+            if (c == (int)colors.size())
+                colors.push_back(std::vector<int>());
+            color[j] = c;
+            colors[c].push_back(j);
+        }
+
+        // compute Q at current speed & position, x_0, v_0
+        this->ComputeQ(state_x, state_w);       // Q0 = Q(x, v)
+        ChVectorDynamic<> Q0(mQ);
+
+        mK.FillElem(0);
+        mR.FillElem(0);
+
+        // Compute K=-dQ(x,v)/dx and R=-dQ(x,v)/dv by backward differentiation, perturbing at the
+        // same time the k-th coordinate of all blocks of a color
+        for (int pass = 0; pass < 2; ++pass) {
+            ChVectorDynamic<>* state = (pass == 0) ? (ChVectorDynamic<>*)state_x : (ChVectorDynamic<>*)state_w;
+            std::vector<int>& offs = (pass == 0) ? offs_x : offs_w;
+            ChMatrix<>& mJ = (pass == 0) ? mK : mR;
+            for (size_t c = 0; c < colors.size(); ++c) {
+                int maxsize = 0;
+                for (size_t ib = 0; ib < colors[c].size(); ++ib)
+                    maxsize = std::max(maxsize, offs_w[colors[c][ib] + 1] - offs_w[colors[c][ib]]);
+                for (int k = 0; k < maxsize; ++k) {
+                    for (size_t ib = 0; ib < colors[c].size(); ++ib) {
+                        int j = colors[c][ib];
+                        if (k < offs_w[j + 1] - offs_w[j])
+                            state->ElementN(offs[j] + k) += Delta; //***TODO*** use NodeIntStateIncrement
+                    }
+                    this->ComputeQ(state_x, state_w);   // Q1 = Q(x+Dx, v) or Q(x, v+Dv)
+                    for (size_t ib = 0; ib < colors[c].size(); ++ib) {
+                        int j = colors[c][ib];
+                        if (k >= offs_w[j + 1] - offs_w[j])
+                            continue;
+                        state->ElementN(offs[j] + k) -= Delta; //***TODO*** use NodeIntStateIncrement
+                        int col = offs_w[j] + k;
+                        for (size_t r = 0; r < deps[j].size(); ++r)
+                            for (int row = offs_w[deps[j][r]]; row < offs_w[deps[j][r] + 1]; ++row)
+                                mJ(row, col) = (mQ(row) - Q0(row)) * (-1.0 / Delta);   // - sign because K=-dQ/dx
+                    }
+                }
+            }
+        }
+
+        // leave Q as computed at the current state
+        mQ = Q0;
+    }
 };
 
 
@@ -206,9 +314,9 @@ public:
         this->loader.ComputeQ(state_x, state_w);
     };
 
-        /// Compute jacobians (default fallback).
-        /// Uses a numerical differentiation for computing K, R, M jacobians, if stiff load.
-        /// If possible, override this with an analytical jacobian. 
+        /// Compute jacobians.
+        /// Uses the analytical jacobians of the loader, if it provides them (see
+        /// ChLoader::ComputeJacobian), otherwise a numerical differentiation.
         /// Compute the K=-dQ/dx, R=-dQ/dv , M=-dQ/da jacobians.
         /// Called automatically at each Update().
     virtual void ComputeJacobian(ChState*      state_x, ///< state position to evaluate jacobians
@@ -217,38 +325,8 @@ public:
                                  ChMatrix<>& mR, ///< result dQ/dv
                                  ChMatrix<>& mM) ///< result dQ/da  
      { 
-        double Delta = 1e-8;
-
-        int mrows_w = this->LoadGet_ndof_w();
-
-        // compute Q at current speed & position, x_0, v_0
-        ChVectorDynamic<> Q0(mrows_w);
-        this->loader.ComputeQ(state_x, state_w);       // Q0 = Q(x, v)
-        Q0 = this->loader.Q;
-
-        ChVectorDynamic<> Q1(mrows_w);
-        ChVectorDynamic<> Jcolumn(mrows_w);
-
-        // Compute K=-dQ(x,v)/dx by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_x)(i)+= Delta; //***TODO*** use NodeIntStateIncrement
-            this->loader.ComputeQ(state_x, state_w);   // Q1 = Q(x+Dx, v)
-            Q1 = this->loader.Q;
-            (*state_x)(i)-= Delta; //***TODO*** use NodeIntStateIncrement
-            
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because K=-dQ/dx
-            this->jacobians->K.PasteMatrix(&Jcolumn,0,i);
-        }
-        // Compute R=-dQ(x,v)/dv by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_w)(i)+= Delta;
-            this->loader.ComputeQ(state_x, state_w);   // Q1 = Q(x, v+Dv)
-            Q1 = this->loader.Q;
-            (*state_w)(i)-= Delta;
-            
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because R=-dQ/dv
-            this->jacobians->R.PasteMatrix(&Jcolumn,0,i);
-        }
+        if (!this->loader.ComputeJacobian(state_x, state_w, mK, mR, mM))
+            this->ComputeJacobianFD(state_x, state_w, mK, mR, this->loader.Q);
      }; 
 
  
@@ -328,38 +406,7 @@ public:
                                  ChMatrix<>& mR, ///< result dQ/dv
                                  ChMatrix<>& mM) ///< result dQ/da  
      {
-        double Delta = 1e-8;
-
-        int mrows_w = this->LoadGet_ndof_w();
-
-        // compute Q at current speed & position, x_0, v_0
-        ChVectorDynamic<> Q0(mrows_w);
-        this->ComputeQ(state_x, state_w);       // Q0 = Q(x, v)
-        Q0 = this->load_Q;
-
-        ChVectorDynamic<> Q1(mrows_w);
-        ChVectorDynamic<> Jcolumn(mrows_w);
-
-        // Compute K=-dQ(x,v)/dx by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_x)(i)+= Delta; //***TODO*** use NodeIntStateIncrement
-            this->ComputeQ(state_x, state_w);   // Q1 = Q(x+Dx, v)
-            Q1 = this->load_Q;
-            (*state_x)(i)-= Delta; //***TODO*** use NodeIntStateIncrement
-            
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because K=-dQ/dx
-            this->jacobians->K.PasteMatrix(&Jcolumn,0,i);
-        }
-        // Compute R=-dQ(x,v)/dv by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_w)(i)+= Delta;
-            this->ComputeQ(state_x, state_w);   // Q1 = Q(x, v+Dv)
-            Q1 = this->load_Q;
-            (*state_w)(i)-= Delta;
-            
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because R=-dQ/dv
-            this->jacobians->R.PasteMatrix(&Jcolumn,0,i);
-        }
+        this->ComputeJacobianFD(state_x, state_w, mK, mR, this->load_Q);
      }; 
 
  
@@ -485,39 +532,27 @@ public:
                                  ChMatrix<>& mR, ///< result dQ/dv
                                  ChMatrix<>& mM) ///< result dQ/da  
      {
-        double Delta = 1e-8;
-
-        int mrows_w = this->LoadGet_ndof_w();
-
-        // compute Q at current speed & position, x_0, v_0
-        ChVectorDynamic<> Q0(mrows_w);
-        this->ComputeQ(state_x, state_w);       // Q0 = Q(x, v)
-        Q0 = this->load_Q;
-
-        ChVectorDynamic<> Q1(mrows_w);
-        ChVectorDynamic<> Jcolumn(mrows_w);
-
-        // Compute K=-dQ(x,v)/dx by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_x)(i)+= Delta; //***TODO*** use NodeIntStateIncrement
-            this->ComputeQ(state_x, state_w);   // Q1 = Q(x+Dx, v)
-            Q1 = this->load_Q;
-            (*state_x)(i)-= Delta; //***TODO*** use NodeIntStateIncrement
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because K=-dQ/dx
-            this->jacobians->K.PasteMatrix(&Jcolumn,0,i);
-        }
-        // Compute R=-dQ(x,v)/dv by backward differentiation
-        for (int i=0; i<mrows_w; ++i) {
-            (*state_w)(i)+= Delta;
-            this->ComputeQ(state_x, state_w);   // Q1 = Q(x, v+Dv)
-            Q1 = this->load_Q;
-            (*state_w)(i)-= Delta;
-            
-            Jcolumn = (Q1 - Q0)*(-1.0/Delta);   // - sign because R=-dQ/dv
-            this->jacobians->R.PasteMatrix(&Jcolumn,0,i);
-        }
+        this->ComputeJacobianFD(state_x, state_w, mK, mR, this->load_Q);
      }; 
 
+        /// Sparsity of the jacobians (default: one block per loadable, each block of Q depending
+        /// on all blocks). Override this if the sub-forces Q depend only on some of the loadables.
+    virtual bool GetJacobianSparsity(std::vector<int>& block_offsets_x,
+                                     std::vector<int>& block_offsets_w,
+                                     std::vector<std::vector<int> >& block_deps) {
+        int nblocks = (int)loadables.size();
+        block_offsets_x.assign(1, 0);
+        block_offsets_w.assign(1, 0);
+        for (int i = 0; i < nblocks; ++i) {
+            block_offsets_x.push_back(block_offsets_x.back() + loadables[i]->LoadableGet_ndof_x());
+            block_offsets_w.push_back(block_offsets_w.back() + loadables[i]->LoadableGet_ndof_w());
+        }
+        block_deps.assign(nblocks, std::vector<int>(nblocks));
+        for (int i = 0; i < nblocks; ++i)
+            for (int j = 0; j < nblocks; ++j)
+                block_deps[i][j] = j;
+        return true;
+    }
  
     virtual void LoadIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {
         unsigned int rowQ = 0;
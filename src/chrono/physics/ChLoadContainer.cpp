@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystem.h"
 
 namespace chrono {
 
@@ -32,8 +33,18 @@ void ChLoadContainer::Add(std::shared_ptr<ChLoadBase> newload) {
     loadlist.push_back(newload);
 }
 
+// Number of threads for the loops over the loads. Each load computes its own Q and jacobians,
+// so the loads are updated concurrently; the residual is loaded serially instead, because
+// different loads may act on the same items.
+static int UpdateThreadNumber(ChSystem* msystem) {
+    return msystem ? msystem->GetParallelUpdateThreadNumber() : 1;
+}
+
 void ChLoadContainer::Update(double mytime, bool update_assets) {
-    for (size_t i = 0; i < loadlist.size(); ++i) {
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < (int)loadlist.size(); ++i) {
         loadlist[i]->Update();
     }
     // Overloading of base class:
@@ -56,7 +67,10 @@ void ChLoadContainer::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChLoadContainer::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    for (size_t i = 0; i < loadlist.size(); ++i) {
+    int nthreads = UpdateThreadNumber(GetSystem());
+
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < (int)loadlist.size(); ++i) {
         loadlist[i]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
 }
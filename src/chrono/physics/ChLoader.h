@@ -40,6 +40,18 @@ public:
     virtual std::shared_ptr<ChLoadable> GetLoadable() =0;
 
     virtual bool IsStiff() {return false;}
+
+        /// Compute the K=-dQ/dx, R=-dQ/dv, M=-dQ/da jacobians analytically, if possible,
+        /// and return true. Otherwise return false (default): then the ChLoad that uses
+        /// this loader computes the jacobians by finite differences.
+    virtual bool ComputeJacobian(ChVectorDynamic<>* state_x, ///< state position to evaluate jacobians
+                                 ChVectorDynamic<>* state_w, ///< state speed to evaluate jacobians
+                                 ChMatrix<>& mK,             ///< result -dQ/dx
+                                 ChMatrix<>& mR,             ///< result -dQ/dv
+                                 ChMatrix<>& mM              ///< result -dQ/da
+                                 ) {
+        return false;
+    }
 };
 
 
@@ -183,6 +183,21 @@ public:
         F.PasteVector(mnorm * (-pressure), 0,0);
     }
 
+        /// The normal and the area are those of the current configuration of the loadable
+        /// (ComputeNormal() does not use state_x), so Q does not depend on the state passed
+        /// to ComputeQ() and the jacobians are null: no need of finite differences.
+        /// Note that the stiffness of the follower load is not taken into account.
+    virtual bool ComputeJacobian(ChVectorDynamic<>* state_x,
+                                 ChVectorDynamic<>* state_w,
+                                 ChMatrix<>& mK,
+                                 ChMatrix<>& mR,
+                                 ChMatrix<>& mM) override {
+        mK.FillElem(0);
+        mR.FillElem(0);
+        mM.FillElem(0);
+        return true;
+    }
+
     void SetPressure(double mpressure) {pressure = mpressure;}
     double GetPressure() {return pressure;}
 
@@ -131,7 +131,7 @@ class ChLoaderUVWatomic : public ChLoaderUVW {
     double Pw;
 
     ChLoaderUVWatomic(std::shared_ptr<ChLoadableUVW> mloadable, const double mU, const double mV, const double mW)
-        : ChLoaderUVW(mloadable){};
+        : ChLoaderUVW(mloadable), Pu(mU), Pv(mV), Pw(mW){};
 
     /// Computes Q = N'*F
     virtual void ComputeQ(ChVectorDynamic<>* state_x,  ///< if != 0, update state (pos. part) to this, then evaluate Q
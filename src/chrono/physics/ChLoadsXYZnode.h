@@ -54,6 +54,18 @@ class ChLoaderXYZnode : public ChLoaderUVWatomic {
         F.PasteVector(this->force, 0, 0);  // load, force part
     }
 
+    /// The force is constant, so the jacobians are null: no need of finite differences.
+    virtual bool ComputeJacobian(ChVectorDynamic<>* state_x,
+                                 ChVectorDynamic<>* state_w,
+                                 ChMatrix<>& mK,
+                                 ChMatrix<>& mR,
+                                 ChMatrix<>& mM) override {
+        mK.FillElem(0);
+        mR.FillElem(0);
+        mM.FillElem(0);
+        return true;
+    }
+
     /// Set force (ex. in [N] units), assumed to be constant in space and time,
     /// assumed applyed at the node.
     void SetForce(const ChVector<>& mf) { this->force = mf; }
@@ -218,6 +218,9 @@ ChSystem::ChSystem(unsigned int max_objects, double scene_size, bool init_sys)
       G_acc(ChVector<>(0, -9.8, 0)),
       stepcount(0),
       solvecount(0),
+      jacobian_reuse(false),
+      jacobian_updated(true),
+      jacobian_valid(false),
       dump_matrices(false),
       last_err(0),
       scriptEngine(NULL),
@@ -232,6 +235,7 @@ ChSystem::ChSystem(unsigned int max_objects, double scene_size, bool init_sys)
     SetIntegrationType(INT_EULER_IMPLICIT_LINEARIZED);
 
     parallel_thread_number = CHOMPfunctions::GetNumProcs();  // default n.threads as n.cores
+    parallel_update_thread_number = 1;                       // serial updates of bodies and links
 
     // Set default contact container
     if (init_sys) {
@@ -258,9 +262,32 @@ ChSystem::ChSystem(unsigned int max_objects, double scene_size, bool init_sys)
     events = new ChEvents(250);
 }
 
-ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
+ChSystem::ChSystem(const ChSystem& other)
+    : ChAssembly(other),
+      ncontacts(0),
+      collision_system(NULL),
+      descriptor(NULL),
+      solver_speed(NULL),
+      solver_stab(NULL),
+      integration_type(INT_EULER_IMPLICIT_LINEARIZED),
+      jacobian_reuse(false),
+      jacobian_updated(true),
+      jacobian_valid(false),
+      scriptEngine(NULL),
+      scriptForStart(NULL),
+      scriptForUpdate(NULL),
+      scriptForStep(NULL),
+      scriptFor3DStep(NULL) {
     system = this;  // as needed by ChAssembly
 
+    // Custom solvers (see ChangeSolverSpeed) are owned by 'other' and they cannot be
+    // cloned, nor shared: do not create a copy without solvers.
+    if (other.solver_type == SOLVER_CUSTOM)
+        throw ChException("ChSystem: a system with custom solvers cannot be copied");
+
+    // Note: the bodies, links and other physics items of 'other' are not copied
+    // (see ChBatchRunner::CloneSystem for a copy of the bodies).
+
     G_acc = other.G_acc;
     end_time = other.end_time;
     step = other.step;
@@ -269,7 +296,6 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     stepcount = other.stepcount;
     solvecount = other.solvecount;
     dump_matrices = other.dump_matrices;
-    SetIntegrationType(other.integration_type);
     tol = other.tol;
     tol_force = other.tol_force;
     maxiter = other.maxiter;
@@ -278,21 +304,23 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
     max_iter_solver_speed = other.max_iter_solver_speed;
     max_iter_solver_stab = other.max_iter_solver_stab;
-    SetSolverType(GetSolverType());
     parallel_thread_number = other.parallel_thread_number;
+    parallel_update_thread_number = other.parallel_update_thread_number;
     use_sleeping = other.use_sleeping;
 
-    ncontacts = other.ncontacts;
+    // A new collision engine (the default one), timestepper, solvers and contact container of
+    // the same types as in 'other'.
+    collision_system = new ChCollisionSystemBullet();
+    timestepper = std::make_shared<ChTimestepperEulerImplicitLinearized>(this);
+    SetIntegrationType(other.integration_type);
+    SetSolverType(other.solver_type);
 
     collision_callbacks = other.collision_callbacks;
     collisionpoint_callback = other.collisionpoint_callback;
 
     last_err = other.last_err;
 
-    RemoveAllProbes();
-    RemoveAllControls();
-
-    events->ResetAllEvents();  // don't copy events.
+    events = new ChEvents(250);  // don't copy events.
 
     SetScriptForStartFile(other.scriptForStartFile);
     SetScriptForUpdateFile(other.scriptForUpdateFile);
@@ -354,6 +382,7 @@ void ChSystem::SetSolverType(eCh_solverType mval) {
         return;
 
     solver_type = mval;
+    jacobian_valid = false;
 
     if (solver_speed)
         delete solver_speed;
@@ -505,6 +534,13 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
     }
 }
 
+void ChSystem::SetParallelUpdateThreadNumber(int mthreads) {
+    if (mthreads < 1)
+        mthreads = 1;
+
+    parallel_update_thread_number = mthreads;
+}
+
 // Plug-in components configuration
 
 void ChSystem::ChangeSystemDescriptor(ChSystemDescriptor* newdescriptor) {
@@ -519,6 +555,7 @@ void ChSystem::ChangeSolverSpeed(ChSolver* newsolver) {
         delete (this->solver_speed);
     this->solver_speed = newsolver;
     this->solver_type = SOLVER_CUSTOM;
+    this->jacobian_valid = false;
 }
 
 void ChSystem::ChangeSolverStab(ChSolver* newsolver) {
@@ -946,6 +983,8 @@ void ChSystem::DescriptorPrepareInject(ChSystemDescriptor& mdescriptor) {
 // allocates or reallocate bookkeeping data/vectors, if any,
 
 void ChSystem::Setup() {
+    ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_SETUP);
+
     events->Record(CHEVENT_SETUP);
 
     // inherit the parent class
@@ -1016,6 +1055,7 @@ void ChSystem::Setup() {
 
 void ChSystem::Update(bool update_assets) {
     timer_update.start();  // Timer for profiling
+    ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_UPDATE);
 
     events->Record(CHEVENT_UPDATE);  // Record an update event
 
@@ -1413,18 +1453,43 @@ void ChSystem::StateSolveCorrection(ChStateDelta& Dv,             ///< result: c
 
     // R and Qc vectors  --> solver sparse solver structures  (also sets L and Dv to warmstart)
 
-    this->IntToDescriptor(0, Dv, R, 0, L, Qc);
+    {
+        ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_DESCRIPTOR);
+
+        this->IntToDescriptor(0, Dv, R, 0, L, Qc);
+
+        // G and Cq  matrices:  fill the sparse solver structures:
 
-    // G and Cq  matrices:  fill the sparse solver structures:
+        this->ConstraintsLoadJacobians();
+    }
 
-    this->ConstraintsLoadJacobians();
+    // M, K, R matrices:  fill the sparse solver structures, unless those of the last call can be
+    // reused (modified Newton). Note that the Cq jacobians are always loaded, because they are
+    // also used to compute the residuals.
 
-    // M, K, R matrices:  fill the sparse solver structures:
+    int nkblocks = (int)this->descriptor->GetKblocksList().size();
+    bool reuse = jacobian_reuse && jacobian_valid && c_a == jacobian_coeffs[0] && c_v == jacobian_coeffs[1] &&
+                 c_x == jacobian_coeffs[2] && R.GetRows() == jacobian_sizes[0] && Qc.GetRows() == jacobian_sizes[1] &&
+                 nkblocks == jacobian_sizes[2];
 
-    if (c_a || c_v || c_x)
-        this->KRMmatricesLoad(-c_x, -c_v, c_a);  // for KRM blocks in ChKblock objects: fill them
-    this->descriptor->SetMassFactor(
-        c_a);  // for ChVariable objects, that does not have ChKblock: just use a coeff., to avoid duplicated data
+    {
+        ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_KRM_LOAD);
+
+        if (!reuse) {
+            if (c_a || c_v || c_x)
+                this->KRMmatricesLoad(-c_x, -c_v, c_a);  // for KRM blocks in ChKblock objects: fill them
+            jacobian_valid = true;
+            jacobian_coeffs[0] = c_a;
+            jacobian_coeffs[1] = c_v;
+            jacobian_coeffs[2] = c_x;
+            jacobian_sizes[0] = R.GetRows();
+            jacobian_sizes[1] = Qc.GetRows();
+            jacobian_sizes[2] = nkblocks;
+        }
+        jacobian_updated = !reuse;
+        this->descriptor->SetMassFactor(
+            c_a);  // for ChVariable objects, that does not have ChKblock: just use a coeff., to avoid duplicated data
+    }
 
     // diagnostics:
 
@@ -1461,14 +1526,20 @@ void ChSystem::StateSolveCorrection(ChStateDelta& Dv,             ///< result: c
     // Solve the problem
 
     timer_solver.start();
+    {
+        ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_SOLVE);
 
-    GetSolverSpeed()->Solve(*this->descriptor);
-
+        GetSolverSpeed()->SetReuseFactorization(reuse);
+        GetSolverSpeed()->Solve(*this->descriptor);
+    }
     timer_solver.stop();
 
     // Dv and L vectors  <-- sparse solver structures
 
-    this->IntFromDescriptor(0, Dv, 0, L);
+    {
+        ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_DESCRIPTOR);
+        this->IntFromDescriptor(0, Dv, 0, L);
+    }
 
     // diagnostics:
 
@@ -1567,7 +1638,10 @@ double ChSystem::ComputeCollisions() {
     timer_collision_broad.start();
 
     // Update all positions of collision models: delegate this to the ChAssembly
-    SyncCollisionModels();
+    {
+        ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_COLLISION_BROAD);
+        SyncCollisionModels();
+    }
 
     // Prepare the callback
 
@@ -1581,6 +1655,7 @@ double ChSystem::ComputeCollisions() {
 
     // !!! Perform the collision detection ( broadphase and narrowphase ) !!!
 
+    collision_system->SetProfiler(&profiler);
     collision_system->Run();
 
     // Report and store contacts and/or proximities, if there are some
@@ -1638,59 +1713,70 @@ int ChSystem::Integrate_Y() {
     int ret_code = TRUE;
 
     timer_step.start();
+    profiler.BeginStep(stepcount, ChTime);
+    {
+        ChStepProfiler::Scope profile_step(profiler, ChStepProfiler::PHASE_STEP);
 
-    events->Record(CHEVENT_TIMESTEP);
+        events->Record(CHEVENT_TIMESTEP);
 
-    // Executes the "forStep" script, if any
-    ExecuteScriptForStep();
-    // Executes the "forStep" script
-    // in all controls of controlslist
-    ExecuteControlsForStep();
+        // Executes the "forStep" script, if any
+        ExecuteScriptForStep();
+        // Executes the "forStep" script
+        // in all controls of controlslist
+        ExecuteControlsForStep();
 
-    this->stepcount++;
-    this->solvecount = 0;
+        this->stepcount++;
+        this->solvecount = 0;
 
-    // Compute contacts and create contact constraints
-    ComputeCollisions();
+        // Compute contacts and create contact constraints
+        ComputeCollisions();
 
-    // Counts dofs, statistics, etc. (not needed because already in Advance()...? )
-    Setup();
+        // Counts dofs, statistics, etc. (not needed because already in Advance()...? )
+        Setup();
 
-    // Update everything - and put to sleep bodies that need it (not needed because already in Advance()...? )
-    // No need to update visualization assets here.
-    Update(false);
+        // Update everything - and put to sleep bodies that need it (not needed because already in Advance()...? )
+        // No need to update visualization assets here.
+        Update(false);
 
-    // Re-wake the bodies that cannot sleep because they are in contact with
-    // some body that is not in sleep state.
-    ManageSleepingBodies();
+        // Re-wake the bodies that cannot sleep because they are in contact with
+        // some body that is not in sleep state.
+        ManageSleepingBodies();
 
-    // Prepare lists of variables and constraints.
-    DescriptorPrepareInject(*descriptor);
-    descriptor->UpdateCountsAndOffsets();
+        // Prepare lists of variables and constraints.
+        {
+            ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_DESCRIPTOR);
+            DescriptorPrepareInject(*descriptor);
+            descriptor->UpdateCountsAndOffsets();
+        }
 
-    timer_solver.reset();
+        timer_solver.reset();
 
-    // Set some settings in timestepper object
-    timestepper->SetQcDoClamp(true);
-    timestepper->SetQcClamping(this->max_penetration_recovery_speed);
-    if (std::dynamic_pointer_cast<ChTimestepperHHT>(timestepper) ||
-        std::dynamic_pointer_cast<ChTimestepperNewmark>(timestepper))
-        timestepper->SetQcDoClamp(false);
+        // Set some settings in timestepper object
+        timestepper->SetQcDoClamp(true);
+        timestepper->SetQcClamping(this->max_penetration_recovery_speed);
+        if (std::dynamic_pointer_cast<ChTimestepperHHT>(timestepper) ||
+            std::dynamic_pointer_cast<ChTimestepperNewmark>(timestepper))
+            timestepper->SetQcDoClamp(false);
 
-    // PERFORM TIME STEP HERE!
-    this->timestepper->Advance(step);
+        // PERFORM TIME STEP HERE!
+        this->timestepper->Advance(step);
 
-    // Executes custom processing at the end of step
-    CustomEndOfStep();
+        // Executes custom processing at the end of step
+        CustomEndOfStep();
 
-    // If there are some probe objects in the probe list,
-    // tell them to record their variables (ususally x-y couples)
-    RecordAllProbes();
+        // If there are some probe objects in the probe list,
+        // tell them to record their variables (ususally x-y couples)
+        RecordAllProbes();
 
-    // Call method to gather contact forces/torques in rigid bodies
-    contact_container->ComputeContactForces();
+        // Call method to gather contact forces/torques in rigid bodies
+        {
+            ChStepProfiler::Scope profile(profiler, ChStepProfiler::PHASE_CONTACT_FORCES);
+            contact_container->ComputeContactForces();
+        }
+    }
 
     // Time elapsed for step..
+    profiler.EndStep();
     timer_step.stop();
 
     return (ret_code);
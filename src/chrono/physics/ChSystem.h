@@ -26,6 +26,7 @@
 #include "collision/ChCCollisionSystem.h"
 #include "core/ChLog.h"
 #include "core/ChMath.h"
+#include "core/ChStepProfiler.h"
 #include "core/ChTimer.h"
 #include "physics/ChAssembly.h"
 #include "physics/ChBodyAuxRef.h"
@@ -82,7 +83,10 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
     /// assumes that the user will do so.
     ChSystem(unsigned int max_objects = 16000, double scene_size = 500, bool init_sys = true);
 
-    /// Copy constructor
+    /// Copy constructor. The copy has a new collision system, and new solvers, descriptor,
+    /// timestepper and contact container of the same types as in \a other; its bodies,
+    /// links and other physics items are not copied. Throws a ChException if \a other uses
+    /// custom solvers (see ChangeSolverSpeed()), since these cannot be copied.
     ChSystem(const ChSystem& other);
 
     /// Destructor
@@ -339,6 +343,16 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
     /// Note that not all solvers use parallel computation.
     int GetParallelThreadNumber() { return parallel_thread_number; }
 
+    /// Changes the number of threads used to update the bodies and links of the system (and of its
+    /// sub-assemblies), to gather/scatter their states, to load their residuals and to inject their
+    /// variables, and to update the loads of ChLoadContainer items (Q and jacobians). By default this
+    /// is 1, i.e. these loops are serial. With more threads, bodies (and links, and loads) are processed
+    /// concurrently, so their updates must not modify data shared with other items (for instance,
+    /// functions with internal caches shared by forces of different bodies).
+    void SetParallelUpdateThreadNumber(int mthreads = 2);
+    /// Get the number of threads used to update bodies and links.
+    int GetParallelUpdateThreadNumber() { return parallel_update_thread_number; }
+
     /// Sets the G (gravity) acceleration vector, affecting all the bodies in the system.
     void Set_G_acc(const ChVector<>& m_acc) { G_acc = m_acc; }
     /// Gets the G (gravity) acceleration vector affecting all the bodies in the system.
@@ -423,6 +437,11 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
         timer_update.reset();
     }
 
+    /// Gets the profiler of the phases of the time steps (disabled by default: enable it
+    /// with GetProfiler().Enable(true)). Unlike the timers above, it keeps a history of
+    /// the last steps, which can be exported in CSV or JSON format.
+    ChStepProfiler& GetProfiler() { return profiler; }
+
     /// Gets the cyclic event buffer of this system (it can be used for
     /// debugging/profiling etc.)
     ChEvents* Get_events() { return events; }
@@ -579,6 +598,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
         bool force_state_scatter = true  ///< if false, x,v and T are not scattered to the system
         ) override;
 
+    /// Allow or forbid the reuse of the K, R, M blocks and of the factorization of the
+    /// last StateSolveCorrection (modified Newton). The matrix is updated anyway if the
+    /// factors c_a, c_v, c_x or the number of variables, constraints or KRM blocks changed.
+    virtual void SetJacobianReuse(bool reuse) override { jacobian_reuse = reuse; }
+
+    /// Return true if the last StateSolveCorrection updated the K, R, M blocks.
+    virtual bool GetJacobianUpdated() const override { return jacobian_updated; }
+
     /// Increment a vector R with the term c*F:
     ///    R += c*F
     virtual void LoadResidual_F(ChVectorDynamic<>& R,  ///< result: the R residual, R += c*F
@@ -887,11 +914,18 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
     double max_penetration_recovery_speed;  ///< this limits the speed of penetration recovery (>0, speed of exiting)
 
     int parallel_thread_number;  ///< used for multithreaded solver etc.
+    int parallel_update_thread_number;  ///< used for multithreaded updates of bodies and links
 
     size_t stepcount;  ///< internal counter for steps
 
     int solvecount;  ///< number of StateSolveCorrection (reset to 0 at each timestep os static analysis)
 
+    bool jacobian_reuse;        ///< reuse the matrix of the last StateSolveCorrection, if possible
+    bool jacobian_updated;      ///< the last StateSolveCorrection updated the matrix
+    bool jacobian_valid;        ///< the KRM blocks and the factorization can be reused
+    double jacobian_coeffs[3];  ///< c_a, c_v, c_x factors of the last update
+    int jacobian_sizes[3];      ///< number of variables, constraints and KRM blocks of the last update
+
     bool dump_matrices;  ///< for debugging
 
     int ncontacts;  ///< total number of contacts
@@ -926,6 +960,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorderEasy {
     ChTimer<double> timer_collision_narrow;
     ChTimer<double> timer_update;
 
+    ChStepProfiler profiler;  ///< per-phase profiler with history of the last steps
+
     std::shared_ptr<ChTimestepper> timestepper;
 };
 
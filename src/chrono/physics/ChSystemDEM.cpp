@@ -52,6 +52,27 @@ ChSystemDEM::ChSystemDEM(bool use_material_properties, unsigned int max_objects,
     m_characteristicVelocity = 1; 
 }
 
+ChSystemDEM::ChSystemDEM(const ChSystemDEM& other)
+    : ChSystem(other),
+      m_use_mat_props(other.m_use_mat_props),
+      m_contact_model(other.m_contact_model),
+      m_adhesion_model(other.m_adhesion_model),
+      m_tdispl_model(other.m_tdispl_model),
+      m_stiff_contact(other.m_stiff_contact),
+      m_minSlipVelocity(other.m_minSlipVelocity),
+      m_characteristicVelocity(other.m_characteristicVelocity) {
+    // The base copy constructor does not know about SOLVER_DEM and the DEM contact container
+    if (solver_type == ChSystem::SOLVER_DEM) {
+        delete solver_speed;
+        delete solver_stab;
+        solver_speed = new ChSolverDEM();
+        solver_stab = new ChSolverDEM();
+    }
+
+    contact_container = std::make_shared<ChContactContainerDEM>();
+    contact_container->SetSystem(this);
+}
+
 void ChSystemDEM::SetSolverType(eCh_solverType mval) {
 
     ChSystem::SetSolverType(mval);
@@ -61,6 +61,9 @@ class ChApi ChSystemDEM : public ChSystem {
                 double scene_size = 500               ///< approximate bounding radius of the scene
                 );
 
+    /// Copy constructor (see ChSystem::ChSystem(const ChSystem&)).
+    ChSystemDEM(const ChSystemDEM& other);
+
     virtual ~ChSystemDEM() {}
 
     /// "Virtual" copy constructor (covariant return type).
@@ -98,7 +101,8 @@ class ChApi ChSystemDEM : public ChSystem {
     AdhesionForceModel GetAdhesionForceModel() const { return m_adhesion_model; }
 
     /// Set the tangential displacement model.
-    /// Note that currently MultiStep falls back to OneStep.
+    /// With MultiStep, the accumulated tangential displacement of each contact is kept in the
+    /// contact history of the ChContactContainerDEM and persists while the contact lasts.
     void SetTangentialDisplacementModel(TangentialDisplacementModel model) { m_tdispl_model = model; }
     /// Get the current tangential displacement model.
     TangentialDisplacementModel GetTangentialDisplacementModel() const { return m_tdispl_model; }
@@ -0,0 +1,414 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/solver/ChPackedSystemOperator.h"
+#include "chrono/core/ChSparseMatrix.h"
+
+namespace chrono {
+
+namespace {
+
+// Sparse matrix that does not store anything, but records the dense blocks pasted
+// by ChKblock::Build_K() and ChConstraint::Build_Cq(), in the order of the calls.
+class ChBlockCollector : public ChSparseMatrix {
+  public:
+    ChBlockCollector() {}
+
+    void Clear() {
+        row.clear();
+        col.clear();
+        nrows.clear();
+        ncols.clear();
+        values.clear();
+    }
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        AddBlock(insrow, inscol, 1, 1);
+        values.push_back(insval);
+    }
+
+    virtual void PasteMatrix(ChMatrix<>* matra, int insrow, int inscol, bool overwrite, bool transp) override {
+        if (transp) {
+            AddBlock(insrow, inscol, matra->GetColumns(), matra->GetRows());
+            for (int r = 0; r < matra->GetColumns(); r++)
+                for (int c = 0; c < matra->GetRows(); c++)
+                    values.push_back(matra->GetElement(c, r));
+        } else {
+            AddBlock(insrow, inscol, matra->GetRows(), matra->GetColumns());
+            for (int r = 0; r < matra->GetRows(); r++)
+                for (int c = 0; c < matra->GetColumns(); c++)
+                    values.push_back(matra->GetElement(r, c));
+        }
+    }
+
+    virtual void PasteMatrixFloat(ChMatrix<float>* matra, int insrow, int inscol, bool overwrite, bool transp) override {
+        if (transp) {
+            AddBlock(insrow, inscol, matra->GetColumns(), matra->GetRows());
+            for (int r = 0; r < matra->GetColumns(); r++)
+                for (int c = 0; c < matra->GetRows(); c++)
+                    values.push_back((double)matra->GetElement(c, r));
+        } else {
+            AddBlock(insrow, inscol, matra->GetRows(), matra->GetColumns());
+            for (int r = 0; r < matra->GetRows(); r++)
+                for (int c = 0; c < matra->GetColumns(); c++)
+                    values.push_back((double)matra->GetElement(r, c));
+        }
+    }
+
+    virtual void PasteClippedMatrix(ChMatrix<>* matra,
+                                    int cliprow,
+                                    int clipcol,
+                                    int nrows,
+                                    int ncolumns,
+                                    int insrow,
+                                    int inscol,
+                                    bool overwrite) override {
+        AddBlock(insrow, inscol, nrows, ncolumns);
+        for (int r = 0; r < nrows; r++)
+            for (int c = 0; c < ncolumns; c++)
+                values.push_back(matra->GetElement(cliprow + r, clipcol + c));
+    }
+
+    std::vector<int> row;
+    std::vector<int> col;
+    std::vector<int> nrows;
+    std::vector<int> ncols;
+    std::vector<double> values;
+
+  private:
+    void AddBlock(int insrow, int inscol, int nr, int nc) {
+        row.push_back(insrow);
+        col.push_back(inscol);
+        nrows.push_back(nr);
+        ncols.push_back(nc);
+    }
+};
+
+}  // end anonymous namespace
+
+ChPackedSystemOperator::ChPackedSystemOperator() : valid(false), structure_builds(0), n_q(0), n_c(0) {}
+
+bool ChPackedSystemOperator::Update(std::vector<ChVariables*>& vvariables,
+                                    std::vector<ChConstraint*>& vconstraints,
+                                    std::vector<ChKblock*>& vstiffness,
+                                    int mn_q,
+                                    int mn_c) {
+    valid = Pack(vvariables, vconstraints, vstiffness, mn_q, mn_c);
+    if (!valid)
+        n_q = -1;  // force a rebuild of the structure at the next call
+    return valid;
+}
+
+bool ChPackedSystemOperator::Pack(std::vector<ChVariables*>& vvariables,
+                                  std::vector<ChConstraint*>& vconstraints,
+                                  std::vector<ChKblock*>& vstiffness,
+                                  int mn_q,
+                                  int mn_c) {
+    bool changed = (mn_q != n_q || mn_c != n_c);
+    n_q = mn_q;
+    n_c = mn_c;
+
+    // Layout of the variables: rebuild the row and column maps only if it changed
+    new_var_list.clear();
+    new_var_ndof.clear();
+    for (size_t iv = 0; iv < vvariables.size(); iv++) {
+        if (vvariables[iv]->IsActive()) {
+            new_var_list.push_back(vvariables[iv]);
+            new_var_ndof.push_back(vvariables[iv]->Get_ndof());
+        }
+    }
+    if (changed || new_var_list != var_list || new_var_ndof != var_ndof) {
+        changed = true;
+        var_list.swap(new_var_list);
+        var_ndof.swap(new_var_ndof);
+        var_offset.resize(var_list.size());
+        row_block.resize(n_q);
+        col_var.resize(n_q);
+        for (int b = 0; b < (int)var_list.size(); b++) {
+            var_offset[b] = var_list[b]->GetOffset();
+            for (int i = 0; i < var_ndof[b]; i++) {
+                if (var_offset[b] + i >= n_q)
+                    return false;
+                row_block[var_offset[b] + i] = b;
+                col_var[var_offset[b] + i] = var_list[b];
+            }
+        }
+    }
+
+    // Collect the K blocks and the jacobians (values and structure)
+    if (!CollectStructure(vconstraints, vstiffness))
+        return false;
+
+    if (changed || new_K_brow != K_brow || new_K_bcol != K_bcol || new_K_bncols != K_bncols ||
+        new_Cq_rowptr != Cq_rowptr || new_Cq_col != Cq_col) {
+        K_brow.swap(new_K_brow);
+        K_bcol.swap(new_K_bcol);
+        K_bncols.swap(new_K_bncols);
+        Cq_rowptr.swap(new_Cq_rowptr);
+        Cq_col.swap(new_Cq_col);
+        if (!BuildStructure())
+            return false;
+    }
+
+    // Eq terms, then the values of the transposed jacobians
+    ProbeEq(vconstraints);
+
+    for (int t = 0; t < (int)T_src.size(); t++) {
+        T_Cq[t] = Cq_values[T_src[t]];
+        T_Eq[t] = Eq_values[T_src[t]];
+    }
+
+    qb.resize(n_q);
+    return true;
+}
+
+bool ChPackedSystemOperator::CollectStructure(std::vector<ChConstraint*>& vconstraints,
+                                              std::vector<ChKblock*>& vstiffness) {
+    ChBlockCollector collector;
+
+    // K blocks, in the order used by ChKblockGeneric::MultiplyAndAdd(); each block
+    // must span all the rows of one variable.
+    new_K_brow.clear();
+    new_K_bcol.clear();
+    new_K_bncols.clear();
+    K_values.clear();
+    for (size_t ik = 0; ik < vstiffness.size(); ik++) {
+        collector.Clear();
+        vstiffness[ik]->Build_K(collector, true);
+        int v = 0;
+        for (size_t k = 0; k < collector.row.size(); k++) {
+            int r = collector.row[k];
+            if (r < 0 || r >= n_q || collector.col[k] < 0 || collector.col[k] + collector.ncols[k] > n_q)
+                return false;
+            int b = row_block[r];
+            if (var_offset[b] != r || var_ndof[b] != collector.nrows[k])
+                return false;
+            new_K_brow.push_back(b);
+            new_K_bcol.push_back(collector.col[k]);
+            new_K_bncols.push_back(collector.ncols[k]);
+            int nv = collector.nrows[k] * collector.ncols[k];
+            K_values.insert(K_values.end(), collector.values.begin() + v, collector.values.begin() + v + nv);
+            v += nv;
+        }
+    }
+
+    // Jacobians: one row per active constraint, in the order of their offsets
+    new_Cq_rowptr.clear();
+    new_Cq_col.clear();
+    Cq_values.clear();
+    cfm.clear();
+    new_Cq_rowptr.push_back(0);
+    for (size_t ic = 0; ic < vconstraints.size(); ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        int row = (int)cfm.size();
+        if (vconstraints[ic]->GetOffset() != row)
+            return false;
+        collector.Clear();
+        vconstraints[ic]->Build_Cq(collector, row);
+        int v = 0;
+        for (size_t k = 0; k < collector.row.size(); k++) {
+            if (collector.row[k] != row || collector.nrows[k] != 1)
+                return false;
+            for (int c = 0; c < collector.ncols[k]; c++) {
+                int col = collector.col[k] + c;
+                if (col < 0 || col >= n_q)
+                    return false;
+                new_Cq_col.push_back(col);
+                Cq_values.push_back(collector.values[v++]);
+            }
+        }
+        new_Cq_rowptr.push_back((int)new_Cq_col.size());
+        cfm.push_back(vconstraints[ic]->Get_cfm_i());
+    }
+
+    return (int)cfm.size() == n_c;
+}
+
+bool ChPackedSystemOperator::BuildStructure() {
+    structure_builds++;
+
+    // First value of each K block
+    K_start.resize(K_brow.size());
+    int start = 0;
+    for (size_t k = 0; k < K_brow.size(); k++) {
+        K_start[k] = start;
+        start += var_ndof[K_brow[k]] * K_bncols[k];
+    }
+
+    // Group the K blocks by block row (stable, to keep the order of the sums)
+    int nb = (int)var_list.size();
+    K_rowptr.assign(nb + 1, 0);
+    for (size_t k = 0; k < K_brow.size(); k++)
+        K_rowptr[K_brow[k] + 1]++;
+    for (int b = 0; b < nb; b++)
+        K_rowptr[b + 1] += K_rowptr[b];
+    K_order.resize(K_brow.size());
+    std::vector<int> next(K_rowptr.begin(), K_rowptr.end() - 1);
+    for (size_t k = 0; k < K_brow.size(); k++)
+        K_order[next[K_brow[k]]++] = (int)k;
+
+    // The Eq terms are probed per column, so a constraint must not reference
+    // the same column twice.
+    std::vector<int> mark(n_q, -1);
+    for (int ic = 0; ic < n_c; ic++) {
+        for (int k = Cq_rowptr[ic]; k < Cq_rowptr[ic + 1]; k++) {
+            if (mark[Cq_col[k]] == ic)
+                return false;
+            mark[Cq_col[k]] = ic;
+        }
+    }
+
+    // Transposed jacobians (stable, so each row of q is summed in constraint order)
+    int nnz = (int)Cq_col.size();
+    T_rowptr.assign(n_q + 1, 0);
+    for (int k = 0; k < nnz; k++)
+        T_rowptr[Cq_col[k] + 1]++;
+    for (int i = 0; i < n_q; i++)
+        T_rowptr[i + 1] += T_rowptr[i];
+    T_row.resize(nnz);
+    T_src.resize(nnz);
+    next.assign(T_rowptr.begin(), T_rowptr.end() - 1);
+    for (int ic = 0; ic < n_c; ic++) {
+        for (int k = Cq_rowptr[ic]; k < Cq_rowptr[ic + 1]; k++) {
+            int t = next[Cq_col[k]]++;
+            T_row[t] = ic;
+            T_src[t] = k;
+        }
+    }
+    T_Cq.resize(nnz);
+    T_Eq.resize(nnz);
+    Eq_values.resize(nnz);
+
+    return true;
+}
+
+void ChPackedSystemOperator::ProbeEq(std::vector<ChConstraint*>& vconstraints) {
+    // Increment_q(1) adds exactly the [Eq] terms of a constraint to the zeroed qb of
+    // its variables, so the Eq terms are read back from qb, one constraint at a time.
+    // The qb of the variables is restored at the end.
+    saved.resize(n_q);
+    for (size_t b = 0; b < var_list.size(); b++) {
+        ChMatrix<double>& mqb = var_list[b]->Get_qb();
+        for (int i = 0; i < var_ndof[b]; i++)
+            saved[var_offset[b] + i] = mqb(i);
+        mqb.FillElem(0);
+    }
+
+    int ic = 0;
+    for (size_t i = 0; i < vconstraints.size(); i++) {
+        if (!vconstraints[i]->IsActive())
+            continue;
+        vconstraints[i]->Increment_q(1.0);
+        for (int k = Cq_rowptr[ic]; k < Cq_rowptr[ic + 1]; k++) {
+            ChVariables* var = col_var[Cq_col[k]];
+            double& mqb = var->Get_qb()(Cq_col[k] - var->GetOffset());
+            Eq_values[k] = mqb;
+            mqb = 0;
+        }
+        ic++;
+    }
+
+    for (size_t b = 0; b < var_list.size(); b++) {
+        ChMatrix<double>& mqb = var_list[b]->Get_qb();
+        for (int i = 0; i < var_ndof[b]; i++)
+            mqb(i) = saved[var_offset[b] + i];
+    }
+}
+
+void ChPackedSystemOperator::ShurComplementProduct(ChMatrix<>& result,
+                                                   const ChMatrix<>& lvector,
+                                                   const std::vector<bool>* enabled,
+                                                   int nthreads) {
+    assert(valid);
+    assert(lvector.GetRows() == n_c);
+
+    result.Reset(n_c, 1);
+    double* res = result.GetAddress();
+    const double* l = lvector.GetAddress();
+    double* mqb = qb.data();
+
+    // qb = [M^(-1)][Cq']*l, by rows of the transposed [Eq]
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int i = 0; i < n_q; i++) {
+        double tot = 0;
+        for (int t = T_rowptr[i]; t < T_rowptr[i + 1]; t++) {
+            int ic = T_row[t];
+            if (!enabled || (*enabled)[ic])
+                tot += T_Eq[t] * l[ic];
+        }
+        mqb[i] = tot;
+    }
+
+    // result = [Cq]*qb - [E]*l
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ic = 0; ic < n_c; ic++) {
+        if (enabled && !(*enabled)[ic]) {
+            res[ic] = 0;
+            continue;
+        }
+        double tot = 0;
+        for (int k = Cq_rowptr[ic]; k < Cq_rowptr[ic + 1]; k++)
+            tot += Cq_values[k] * mqb[Cq_col[k]];
+        res[ic] = cfm[ic] * l[ic] + tot;
+    }
+}
+
+void ChPackedSystemOperator::SystemProduct(ChMatrix<>& result, const ChMatrix<>& x, double c_a, int nthreads) {
+    assert(valid);
+    assert(x.GetRows() == n_q + n_c);
+
+    result.Reset(n_q + n_c, 1);
+    double* res = result.GetAddress();
+    const double* vect = x.GetAddress();
+    int nb = (int)var_list.size();
+
+    // First row: result.q = [M + K]*x.q + [Cq']*x.l, by block rows
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int b = 0; b < nb; b++) {
+        var_list[b]->MultiplyAndAdd(result, x, c_a);
+
+        int io = var_offset[b];
+        int in = var_ndof[b];
+        for (int kb = K_rowptr[b]; kb < K_rowptr[b + 1]; kb++) {
+            int k = K_order[kb];
+            int jo = K_bcol[k];
+            int jn = K_bncols[k];
+            const double* block = &K_values[K_start[k]];
+            for (int r = 0; r < in; r++) {
+                double tot = 0;
+                for (int c = 0; c < jn; c++)
+                    tot += block[r * jn + c] * vect[jo + c];
+                res[io + r] += tot;
+            }
+        }
+
+        for (int i = io; i < io + in; i++) {
+            double tot = res[i];
+            for (int t = T_rowptr[i]; t < T_rowptr[i + 1]; t++)
+                tot += T_Cq[t] * vect[n_q + T_row[t]];
+            res[i] = tot;
+        }
+    }
+
+    // Second row: result.l = [Cq]*x.q + [E]*x.l
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
+    for (int ic = 0; ic < n_c; ic++) {
+        double tot = 0;
+        for (int k = Cq_rowptr[ic]; k < Cq_rowptr[ic + 1]; k++)
+            tot += vect[Cq_col[k]] * Cq_values[k];
+        tot -= cfm[ic] * vect[n_q + ic];
+        res[n_q + ic] = tot;
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHPACKEDSYSTEMOPERATOR_H
+#define CHPACKEDSYSTEMOPERATOR_H
+
+#include <vector>
+
+#include "chrono/solver/ChVariables.h"
+#include "chrono/solver/ChConstraint.h"
+#include "chrono/solver/ChKblock.h"
+
+namespace chrono {
+
+/// Packed form of the matrix products of a ChSystemDescriptor.
+/// The K blocks are stored in block-sparse-row (BSR) format, with one block row
+/// per active ChVariables, and the constraint jacobians [Cq] and the [Eq]=[invM]*[Cq]'
+/// terms are stored in CSR format, together with their transposed (CSC) form.
+/// This allows the products of ShurComplementProduct() and SystemProduct() to
+/// be computed as row-parallel SpMV over contiguous arrays, instead of calling
+/// the virtual methods of the scattered ChVariables, ChKblock and ChConstraint objects.
+/// Each row is accumulated with the same terms and in the same order used by the
+/// virtual methods, and the results do not depend on the number of threads. They may
+/// still differ from the unpacked products by roundoff, where the compiler fuses the
+/// multiplications and additions (FMA) of the two forms in different ways.
+/// The mass matrices are still applied through ChVariables::MultiplyAndAdd() (in
+/// parallel, since each variable writes its own rows), because each ChVariables
+/// type scales its mass by c_a in its own way.
+/// Update() refreshes the values at each call; the sparsity structure (and its
+/// transposed form) is rebuilt only when it differs from the previous one.
+class ChApi ChPackedSystemOperator {
+  public:
+    ChPackedSystemOperator();
+
+    /// Pack the K blocks and the constraint jacobians of the given lists.
+    /// The offsets of the variables and of the constraints must be up to date (see
+    /// ChSystemDescriptor::UpdateCountsAndOffsets()), as well as the [Eq] terms of
+    /// the constraints (see ChConstraint::Update_auxiliary()).
+    /// Returns false if the items cannot be packed (for example a constraint that
+    /// references the same variables twice); in this case the operator is not valid.
+    bool Update(std::vector<ChVariables*>& vvariables,
+                std::vector<ChConstraint*>& vconstraints,
+                std::vector<ChKblock*>& vstiffness,
+                int n_q,
+                int n_c);
+
+    /// Mark the packed data as out of date.
+    void Invalidate() { valid = false; }
+
+    /// Tell if the packed data can be used for the products.
+    bool IsValid() const { return valid; }
+
+    /// Number of times the sparsity structure has been built (for statistics).
+    int GetStructureBuilds() const { return structure_builds; }
+
+    /// Same as ChSystemDescriptor::ShurComplementProduct(), with the packed data.
+    /// Differently from the descriptor version, the 'qb' data of the variables is not changed.
+    void ShurComplementProduct(ChMatrix<>& result,
+                               const ChMatrix<>& lvector,
+                               const std::vector<bool>* enabled,
+                               int nthreads);
+
+    /// Same as ChSystemDescriptor::SystemProduct(), with the packed data.
+    void SystemProduct(ChMatrix<>& result, const ChMatrix<>& x, double c_a, int nthreads);
+
+  private:
+    bool Pack(std::vector<ChVariables*>& vvariables,
+              std::vector<ChConstraint*>& vconstraints,
+              std::vector<ChKblock*>& vstiffness,
+              int mn_q,
+              int mn_c);
+    bool CollectStructure(std::vector<ChConstraint*>& vconstraints, std::vector<ChKblock*>& vstiffness);
+    bool BuildStructure();
+    void ProbeEq(std::vector<ChConstraint*>& vconstraints);
+
+    bool valid;
+    int structure_builds;
+    int n_q;
+    int n_c;
+
+    // Block rows: the active variables, in the order of their offsets
+    std::vector<ChVariables*> var_list;
+    std::vector<int> var_offset;
+    std::vector<int> var_ndof;
+    std::vector<int> row_block;         // block row of each row of q
+    std::vector<ChVariables*> col_var;  // variables owning each column of q
+
+    // K blocks, in insertion order (the order of ChKblock::MultiplyAndAdd())
+    std::vector<int> K_brow;    // block row of each block
+    std::vector<int> K_bcol;    // first column of each block
+    std::vector<int> K_bncols;  // number of columns of each block
+    std::vector<int> K_start;   // first value of each block (row-major)
+    std::vector<double> K_values;
+
+    // K blocks, BSR format: the blocks of each block row, in insertion order
+    std::vector<int> K_rowptr;
+    std::vector<int> K_order;
+
+    // Constraint jacobians, CSR format
+    std::vector<int> Cq_rowptr;
+    std::vector<int> Cq_col;
+    std::vector<double> Cq_values;
+    std::vector<double> Eq_values;
+    std::vector<double> cfm;
+
+    // Transposed jacobians, CSR format over the rows of q (CSC of the above)
+    std::vector<int> T_rowptr;
+    std::vector<int> T_row;  // constraint row of each entry
+    std::vector<int> T_src;  // index of each entry in the Cq_values, Eq_values arrays
+    std::vector<double> T_Cq;
+    std::vector<double> T_Eq;
+
+    // Structure collected at the last Update(), compared with the one above
+    std::vector<ChVariables*> new_var_list;
+    std::vector<int> new_var_ndof;
+    std::vector<int> new_K_brow;
+    std::vector<int> new_K_bcol;
+    std::vector<int> new_K_bncols;
+    std::vector<int> new_Cq_rowptr;
+    std::vector<int> new_Cq_col;
+
+    std::vector<double> qb;     // work vector for ShurComplementProduct()
+    std::vector<double> saved;  // qb of the variables, saved while probing the Eq terms
+};
+
+}  // end namespace chrono
+
+#endif
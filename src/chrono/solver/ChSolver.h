@@ -46,7 +46,7 @@ class ChApi ChSolver {
   public:
     bool verbose;
 
-    ChSolver() : verbose(false) {}
+    ChSolver() : verbose(false), reuse_factorization(false) {}
 
     virtual ~ChSolver() {}
 
@@ -69,6 +69,13 @@ class ChApi ChSolver {
         return 0;
     }
 
+    /// Tell the solver that the matrix of the next calls to Solve() is the same of the
+    /// last factorized one, so that direct solvers can skip its assembly and factorization
+    /// and only solve for the new right hand side (modified Newton iterations).
+    /// Iterative solvers do not factorize the matrix and ignore this flag.
+    void SetReuseFactorization(bool val) { reuse_factorization = val; }
+    bool GetReuseFactorization() const { return reuse_factorization; }
+
     void SetVerbose(bool mv) { this->verbose = mv; }
     bool GetVerbose() const { return this->verbose; }
 
@@ -92,6 +99,9 @@ class ChApi ChSolver {
         // stream in all member data:
         marchive >> CHNVP(verbose);
     }
+
+  protected:
+    bool reuse_factorization;  ///< the matrix did not change since the last factorization
 };
 
 /// @} chrono_solver
@@ -83,6 +83,9 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     double L, t;
     double theta;
     double thetaNew;
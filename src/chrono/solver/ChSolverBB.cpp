@@ -72,6 +72,9 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd  ///< system description with
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used for the fixed point phase and/or by preconditioner.
     int j_friction_comp = 0;
@@ -430,6 +433,9 @@ double ChSolverBB::Solve_SupportingStiffness(
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  This is necessary because we want the scaling to be isotropic for each friction cone
     int j_friction_comp = 0;
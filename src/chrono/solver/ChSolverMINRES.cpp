@@ -39,6 +39,9 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used for the fixed point phase and/or by preconditioner.
     int j_friction_comp = 0;
@@ -423,6 +426,9 @@ double ChSolverMINRES::Solve_SupportingStiffness(
     double abs_tol = this->tolerance;
     double rel_tol_d = d.NormInf() * rel_tol;
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // r = d - Z*x;
     sysd.SystemProduct(
         r, &x);    // 1)  r = Z*x ...        #### MATR.MULTIPLICATION!!!### can be avoided if no warm starting!
@@ -31,6 +31,9 @@ double ChSolverPCG::Solve(ChSystemDescriptor& sysd  ///< system description with
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // Allocate auxiliary vectors;
 
     int nc = sysd.CountActiveConstraints();
@@ -57,6 +57,9 @@ double ChSolverPMINRES::Solve(ChSystemDescriptor& sysd  ///< system description
     for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
         mconstraints[ic]->Update_auxiliary();
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used as diagonal preconditioner.
     int j_friction_comp = 0;
@@ -364,6 +367,9 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
     // Initial projection of mx   ***TO DO***?
     sysd.UnknownsProject(mx);
 
+    // Pack the jacobians and the K blocks for the matrix products
+    sysd.UpdatePackedProducts();
+
     // r = d - Z*x;
     sysd.SystemProduct(
         mr, &mx);    // 1)  r = Z*x ...        #### MATR.MULTIPLICATION!!!### can be avoided if no warm starting!
@@ -9,11 +9,10 @@
 // and at http://projectchrono.org/license-chrono.txt.
 //
 
-#include <stdio.h>
-#include "chrono/parallel/ChThreadsSync.h"
-#include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
-#include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
-#include "chrono/solver/ChConstraintTwoTuplesRollingT.h"
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChSparseMatrix.h"
 #include "chrono/solver/ChSolverSORmultithread.h"
 
 namespace chrono {
@@ -22,360 +21,367 @@ namespace chrono {
 // dynamic creation and persistence
 ChClassRegister<ChSolverSORmultithread> a_registration_ChSolverSORmultithread;
 
-// Each thread will own an instance of the following data:
+// Sparse matrix that does not store anything, but records the columns written by
+// ChConstraint::Build_Cq(), i.e. the degrees of freedom a constraint acts upon.
+class ChColumnRecorder : public ChSparseMatrix {
+  public:
+    std::vector<int>* columns_list;
+
+    ChColumnRecorder(std::vector<int>& mcolumns) : columns_list(&mcolumns) {}
 
-struct thread_data {
-    ChSolverSORmultithread* solver;  // reference to solver
-    ChMutexSpinlock* mutex;          // this will be used to avoid race condition when writing to shared memory.
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        columns_list->push_back(inscol);
+    }
+    virtual void PasteMatrix(ChMatrix<>* matra, int insrow, int inscol, bool overwrite = true, bool transp = false) override {
+        int ncols = transp ? matra->GetRows() : matra->GetColumns();
+        for (int j = 0; j < ncols; j++)
+            columns_list->push_back(inscol + j);
+    }
+    virtual void PasteMatrixFloat(ChMatrix<float>* matra,
+                                  int insrow,
+                                  int inscol,
+                                  bool overwrite = true,
+                                  bool transp = false) override {
+        int ncols = transp ? matra->GetRows() : matra->GetColumns();
+        for (int j = 0; j < ncols; j++)
+            columns_list->push_back(inscol + j);
+    }
+    virtual void PasteClippedMatrix(ChMatrix<>* matra,
+                                    int cliprow,
+                                    int clipcol,
+                                    int nrows,
+                                    int ncolumns,
+                                    int insrow,
+                                    int inscol,
+                                    bool overwrite = true) override {
+        for (int j = 0; j < ncolumns; j++)
+            columns_list->push_back(inscol + j);
+    }
+};
+
+ChSolverSORmultithread::ChSolverSORmultithread(char* uniquename,
+                                               int nthreads,
+                                               int mmax_iters,
+                                               bool mwarm_start,
+                                               double mtolerance,
+                                               double momega)
+    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), executor(nthreads), coloring_builds(0) {}
 
-    enum solver_stage { STAGE1_PREPARE = 0, STAGE2_ADDFORCES, STAGE3_LOOPCONSTRAINTS };
+ChSolverSORmultithread::~ChSolverSORmultithread() {}
 
-    solver_stage stage;
+// The layout collects what the coloring depends upon: the active variables (hence the
+// offsets of their degrees of freedom), the mode of each constraint and the columns
+// written by its Build_Cq(). The vectors of the new layout keep their capacity between
+// calls, so that no allocation is done when the layout does not change.
 
-    // the range of scanned multipliers (for loops on multipliers)
-    unsigned int constr_from;
-    unsigned int constr_to;
+bool ChSolverSORmultithread::UpdateLayout(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
-    // the range of scanned 'variables' objects (for loops on variables, aka rigid bodies)
-    unsigned int var_from;
-    unsigned int var_to;
+    // This also sets the offsets of the variables.
+    sysd.CountActiveVariables();
 
-    std::vector<ChConstraint*>* mconstraints;
-    std::vector<ChVariables*>* mvariables;
-};
+    new_layout_vars.clear();
+    new_layout_ndof.clear();
+    for (size_t iv = 0; iv < mvariables.size(); iv++) {
+        if (mvariables[iv]->IsActive()) {
+            new_layout_vars.push_back(mvariables[iv]);
+            new_layout_ndof.push_back(mvariables[iv]->Get_ndof());
+        }
+    }
+
+    ChColumnRecorder recorder(new_layout_cq_col);
+    new_layout_mode.clear();
+    new_layout_cq_start.clear();
+    new_layout_cq_col.clear();
+    new_layout_cq_start.push_back(0);
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        new_layout_mode.push_back(mconstraints[ic]->GetMode());
+        mconstraints[ic]->Build_Cq(recorder, 0);
+        new_layout_cq_start.push_back((int)new_layout_cq_col.size());
+    }
 
-// Don't create local store memory, just return 0
+    if (coloring_builds > 0 && new_layout_vars == layout_vars && new_layout_ndof == layout_ndof &&
+        new_layout_mode == layout_mode && new_layout_cq_start == layout_cq_start && new_layout_cq_col == layout_cq_col)
+        return false;
 
-void* SolverMemoryFunc() {
-    return 0;
+    layout_vars.swap(new_layout_vars);
+    layout_ndof.swap(new_layout_ndof);
+    layout_mode.swap(new_layout_mode);
+    layout_cq_start.swap(new_layout_cq_start);
+    layout_cq_col.swap(new_layout_cq_col);
+    return true;
 }
 
-// The following is the function which will be executed by
-// each thread, when threads are launched at each Solve()
+// Constraints are grouped as in ChSolverSOR: the three consecutive multipliers of a
+// frictional contact (CONSTRAINT_FRIC mode) form one group, since they are projected
+// together; any other constraint is a group by itself.
+// Groups are then colored greedily (each group gets the smallest color not used by the
+// groups that share some active variable with it) and sorted by color, keeping the
+// original order within each color.
+
+void ChSolverSORmultithread::ColorConstraints() {
+    coloring_builds++;
+
+    // Map each active degree of freedom to its (active) variables object.
+    int nvars = (int)layout_vars.size();
+    int n_q = 0;
+    for (int iv = 0; iv < nvars; iv++)
+        n_q += layout_ndof[iv];
+    std::vector<int> dof_to_var(n_q);
+    for (int iv = 0; iv < nvars; iv++) {
+        for (int d = 0; d < layout_ndof[iv]; d++)
+            dof_to_var[layout_vars[iv]->GetOffset() + d] = iv;
+    }
 
-void SolverThreadFunc(void* userPtr, void* lsMemory) {
-    double maxviolation = 0.;
-    double maxdeltalambda = 0.;
-    int i_friction_comp = 0;
-    double old_lambda_friction[3];
-
-    thread_data* tdata = (thread_data*)userPtr;
-
-    std::vector<ChConstraint*>* mconstraints = tdata->mconstraints;
-    std::vector<ChVariables*>* mvariables = tdata->mvariables;
-
-    switch (tdata->stage) {
-        case thread_data::STAGE1_PREPARE: {
-            //    Update auxiliary data in all constraints before starting,
-            //    that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-            //
-            for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                (*mconstraints)[ic]->Update_auxiliary();
-
-            //    Average all g_i for the triplet of contact constraints n,u,v.
-            //
-            int j_friction_comp = 0;
-            double gi_values[3];
-            for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++) {
-                if ((*mconstraints)[ic]->GetMode() == CONSTRAINT_FRIC) {
-                    gi_values[j_friction_comp] = (*mconstraints)[ic]->Get_g_i();
-                    j_friction_comp++;
-                    if (j_friction_comp == 3) {
-                        double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
-                        (*mconstraints)[ic - 2]->Set_g_i(average_g_i);
-                        (*mconstraints)[ic - 1]->Set_g_i(average_g_i);
-                        (*mconstraints)[ic - 0]->Set_g_i(average_g_i);
-                        j_friction_comp = 0;
-                    }
-                }
+    // Build the groups.
+    std::vector<int> start;
+    std::vector<int> size;
+    int nc = (int)layout_mode.size();
+    for (int ic = 0; ic < nc;) {
+        int n = (layout_mode[ic] == CONSTRAINT_FRIC && ic + 2 < nc) ? 3 : 1;
+        start.push_back(ic);
+        size.push_back(n);
+        ic += n;
+    }
+    int ngroups = (int)start.size();
+
+    // Greedy coloring.
+    std::vector<std::vector<int> > var_colors(nvars);  // colors of the groups acting on each variable
+    std::vector<int> var_stamp(nvars, -1);
+    std::vector<int> color_stamp;
+    std::vector<int> color(ngroups);
+    std::vector<int> group_vars;
+    int ncolors = 0;
+
+    for (int ig = 0; ig < ngroups; ig++) {
+        // Collect the variables of the group, without duplicates.
+        group_vars.clear();
+        for (int k = layout_cq_start[start[ig]]; k < layout_cq_start[start[ig] + size[ig]]; k++) {
+            int iv = dof_to_var[layout_cq_col[k]];
+            if (var_stamp[iv] != ig) {
+                var_stamp[iv] = ig;
+                group_vars.push_back(iv);
             }
+        }
 
-            break;  // end stage
+        // Mark the colors already used by neighbour groups, pick the first free one.
+        for (size_t k = 0; k < group_vars.size(); k++) {
+            const std::vector<int>& vc = var_colors[group_vars[k]];
+            for (size_t j = 0; j < vc.size(); j++)
+                color_stamp[vc[j]] = ig;
         }
+        int c = 0;
+        while (c < ncolors && color_stamp[c] == ig)
+            c++;
+        if (c == ncolors) {
+            ncolors++;
+            color_stamp.push_back(-1);
+        }
+        color[ig] = c;
+        for (size_t k = 0; k < group_vars.size(); k++)
+            var_colors[group_vars[k]].push_back(c);
+    }
 
-        case thread_data::STAGE2_ADDFORCES: {
-            //     Compute, for all items with variables, the initial guess for
-            //     still unconstrained system:
-            //
-            for (unsigned int iv = tdata->var_from; iv < tdata->var_to; iv++)
-                if ((*mvariables)[iv]->IsActive())
-                    (*mvariables)[iv]->Compute_invMb_v((*mvariables)[iv]->Get_qb(),
-                                                       (*mvariables)[iv]->Get_fb());  // q = [M]'*fb
+    // Sort the groups by color (counting sort, stable).
+    color_start.assign(ncolors + 1, 0);
+    for (int ig = 0; ig < ngroups; ig++)
+        color_start[color[ig] + 1]++;
+    for (int c = 0; c < ncolors; c++)
+        color_start[c + 1] += color_start[c];
+    group_start.resize(ngroups);
+    group_size.resize(ngroups);
+    std::vector<int> fill(color_start.begin(), color_start.end() - 1);
+    for (int ig = 0; ig < ngroups; ig++) {
+        int pos = fill[color[ig]]++;
+        group_start[pos] = start[ig];
+        group_size[pos] = size[ig];
+    }
+}
 
-            break;  // end stage
+double ChSolverSORmultithread::Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                                     ) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    tot_iterations = 0;
+    double maxviolation = 0.;
+    int nthreads = executor.GetNumThreads();
+
+    // Per-thread results of the iteration loops.
+    std::vector<double> thread_maxviolation(nthreads);
+    std::vector<double> thread_maxdeltalambda(nthreads);
+
+    if (UpdateLayout(sysd))
+        ColorConstraints();
+    int ngroups = (int)group_start.size();
+    int ncolors = GetNumColors();
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    //     and average all g_i for the triplet of contact constraints n,u,v.
+    executor.ParallelFor(0, ngroups, 0, [&](int from, int to, int thread) {
+        for (int ig = from; ig < to; ig++) {
+            int ic0 = group_start[ig];
+            for (int ic = ic0; ic < ic0 + group_size[ig]; ic++)
+                mconstraints[ic]->Update_auxiliary();
+            if (group_size[ig] == 3) {
+                double average_g_i = (mconstraints[ic0]->Get_g_i() + mconstraints[ic0 + 1]->Get_g_i() +
+                                      mconstraints[ic0 + 2]->Get_g_i()) / 3.0;
+                mconstraints[ic0]->Set_g_i(average_g_i);
+                mconstraints[ic0 + 1]->Set_g_i(average_g_i);
+                mconstraints[ic0 + 2]->Set_g_i(average_g_i);
+            }
         }
+    });
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+    executor.ParallelFor(0, (int)mvariables.size(), 0, [&](int from, int to, int thread) {
+        for (int iv = from; iv < to; iv++)
+            if (mvariables[iv]->IsActive())
+                mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    });
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of contraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    //     Groups of the same color do not share variables, so they can increment q concurrently.
+    for (int c = 0; c < ncolors; c++) {
+        executor.ParallelFor(color_start[c], color_start[c + 1], 0, [&](int from, int to, int thread) {
+            for (int ig = from; ig < to; ig++) {
+                for (int ic = group_start[ig]; ic < group_start[ig] + group_size[ig]; ic++) {
+                    if (!warm_start)
+                        mconstraints[ic]->Set_l_i(0.);
+                    else if (mconstraints[ic]->IsActive())
+                        mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+                }
+            }
+        });
+    }
+
+    // 4)  Perform the iteration loops
+    //
+
+    // The SOR update of a range of groups; the maximum violation and delta lambda are
+    // accumulated in the slots of the executing thread.
+    auto sor_update = [&](int from, int to, int thread) {
+        double maxviolation_t = thread_maxviolation[thread];
+        double maxdeltalambda_t = thread_maxdeltalambda[thread];
+
+        for (int ig = from; ig < to; ig++) {
+            int ic0 = group_start[ig];
+
+            // skip computations if constraint not active.
+            if (!mconstraints[ic0]->IsActive())
+                continue;
+
+            if (group_size[ig] == 3) {
+                // Frictional contact: update n,u,v, then project on the friction cone.
+                double old_lambda_friction[3];
+                for (int k = 0; k < 3; k++) {
+                    ChConstraint* mc = mconstraints[ic0 + k];
+                    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+                    double mresidual = mc->Compute_Cq_q() + mc->Get_b_i() + mc->Get_cfm_i() * mc->Get_l_i();
+                    // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+                    double deltal = (omega / mc->Get_g_i()) * (-mresidual);
+                    // update:   lambda += delta_lambda;
+                    old_lambda_friction[k] = mc->Get_l_i();
+                    mc->Set_l_i(old_lambda_friction[k] + deltal);
+                    if (k == 0)
+                        maxviolation_t = ChMax(maxviolation_t, std::fabs(ChMin(0.0, mresidual)));
+                }
 
-        case thread_data::STAGE3_LOOPCONSTRAINTS: {
-            //     For all items with variables, add the effect of initial (guessed)
-            //     lagrangian reactions of contraints, if a warm start is desired.
-            //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
-            //
-            if (tdata->solver->GetWarmStart()) {
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                    if ((*mconstraints)[ic]->IsActive()) {
-                        //	tdata->mutex->Lock();   // this avoids double writing on shared q vector
-                        (*mconstraints)[ic]->Increment_q((*mconstraints)[ic]->Get_l_i());
-                        //	tdata->mutex->Unlock(); // end critical section
+                mconstraints[ic0]->Project();  // the N normal component will take care of N,U,V
+                double new_lambda[3];
+                for (int k = 0; k < 3; k++) {
+                    new_lambda[k] = mconstraints[ic0 + k]->Get_l_i();
+                    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                    if (shlambda != 1.0) {
+                        new_lambda[k] = shlambda * new_lambda[k] + (1.0 - shlambda) * old_lambda_friction[k];
+                        mconstraints[ic0 + k]->Set_l_i(new_lambda[k]);
                     }
+                }
+                for (int k = 0; k < 3; k++) {
+                    double true_delta = new_lambda[k] - old_lambda_friction[k];
+                    mconstraints[ic0 + k]->Increment_q(true_delta);
+                    maxdeltalambda_t = ChMax(maxdeltalambda_t, std::fabs(true_delta));
+                }
             } else {
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                    (*mconstraints)[ic]->Set_l_i(0.);
-            }
+                ChConstraint* mc = mconstraints[ic0];
 
-            //    Perform the solver iteration loops
-            //
-            for (int iter = 0; iter < tdata->solver->GetMaxIterations(); iter++) {
-                // The iteration on all constraints
-                //
-
-                maxviolation = 0;
-                maxdeltalambda = 0;
-                i_friction_comp = 0;
-
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++) {
-                    // skip computations if constraint not active.
-                    if ((*mconstraints)[ic]->IsActive()) {
-                        // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
-                        double mresidual = (*mconstraints)[ic]->Compute_Cq_q() + (*mconstraints)[ic]->Get_b_i() +
-                                           (*mconstraints)[ic]->Get_cfm_i() * (*mconstraints)[ic]->Get_l_i();
-
-                        // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
-                        double candidate_violation = fabs((*mconstraints)[ic]->Violation(mresidual));
-
-                        // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
-                        double deltal = (tdata->solver->GetOmega() / (*mconstraints)[ic]->Get_g_i()) * (-mresidual);
-
-                        if ((*mconstraints)[ic]->GetMode() == CONSTRAINT_FRIC) {
-                            candidate_violation = 0;
-                            
-                            // update:   lambda += delta_lambda;
-                            old_lambda_friction[i_friction_comp] = (*mconstraints)[ic]->Get_l_i();
-                            (*mconstraints)[ic]->Set_l_i(old_lambda_friction[i_friction_comp] + deltal);
-                            i_friction_comp++;
-
-                            if (i_friction_comp == 1)
-                                candidate_violation = fabs(ChMin(0.0, mresidual));
-
-                            if (i_friction_comp == 3) {
-                                (*mconstraints)[ic - 2]->Project();  // the N normal component will take care of N,U,V
-                                double new_lambda_0 = (*mconstraints)[ic - 2]->Get_l_i();
-                                double new_lambda_1 = (*mconstraints)[ic - 1]->Get_l_i();
-                                double new_lambda_2 = (*mconstraints)[ic - 0]->Get_l_i();
-                                // Apply the smoothing: lambda= sharpness*lambda_new_projected +
-                                // (1-sharpness)*lambda_old
-                                if (tdata->solver->GetSharpnessLambda() != 1.0) {
-                                    double shlambda = tdata->solver->GetSharpnessLambda();
-                                    new_lambda_0 = shlambda * new_lambda_0 + (1.0 - shlambda) * old_lambda_friction[0];
-                                    new_lambda_1 = shlambda * new_lambda_1 + (1.0 - shlambda) * old_lambda_friction[1];
-                                    new_lambda_2 = shlambda * new_lambda_2 + (1.0 - shlambda) * old_lambda_friction[2];
-                                    (*mconstraints)[ic - 2]->Set_l_i(new_lambda_0);
-                                    (*mconstraints)[ic - 1]->Set_l_i(new_lambda_1);
-                                    (*mconstraints)[ic - 0]->Set_l_i(new_lambda_2);
-                                }
-                                double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
-                                double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
-                                double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
-                                //	tdata->mutex->Lock();   // this avoids double writing on shared q vector
-                                (*mconstraints)[ic - 2]->Increment_q(true_delta_0);
-                                (*mconstraints)[ic - 1]->Increment_q(true_delta_1);
-                                (*mconstraints)[ic - 0]->Increment_q(true_delta_2);
-                                //	tdata->mutex->Unlock(); // end critical section
-                                /*
-								if (this->record_violation_history)
-								{
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_0));
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_1));
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_2));
-								}
-								*/  //***TO DO***
-                                i_friction_comp = 0;
-                            }
-                        } else {
-                            // update:   lambda += delta_lambda;
-                            double old_lambda = (*mconstraints)[ic]->Get_l_i();
-                            (*mconstraints)[ic]->Set_l_i(old_lambda + deltal);
-
-                            // If new lagrangian multiplier does not satisfy inequalities, project
-                            // it into an admissible orthant (or, in general, onto an admissible set)
-                            (*mconstraints)[ic]->Project();
-
-                            // After projection, the lambda may have changed a bit..
-                            double new_lambda = (*mconstraints)[ic]->Get_l_i();
-
-                            // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
-                            if (tdata->solver->GetSharpnessLambda() != 1.0) {
-                                double shlambda = tdata->solver->GetSharpnessLambda();
-                                new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
-                                (*mconstraints)[ic]->Set_l_i(new_lambda);
-                            }
-
-                            double true_delta = new_lambda - old_lambda;
-
-                            // For all items with variables, add the effect of incremented
-                            // (and projected) lagrangian reactions:
-                            tdata->mutex->Lock();  // this avoids double writing on shared q vector
-                            (*mconstraints)[ic]->Increment_q(true_delta);
-                            tdata->mutex->Unlock();  // end critical section
-                            /*
-							if (this->record_violation_history)
-								maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta)); 
-							*/                       //***TO DO***
-                        }
-
-                        maxviolation = ChMax(maxviolation, fabs(candidate_violation));
-
-                    }  // end IsActive()
-
-                }  // end loop on constraints
-
-                // For recording into violaiton history, if debugging
-                // if (this->record_violation_history)
-                //	AtIterationEnd(maxviolation, maxdeltalambda, iter);  //***TO DO***
-
-                // Terminate the loop if violation in constraints has been succesfully limited.
-                if (maxviolation < tdata->solver->GetTolerance())
-                    break;
-
-            }  // end iteration loop
+                // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+                double mresidual = mc->Compute_Cq_q() + mc->Get_b_i() + mc->Get_cfm_i() * mc->Get_l_i();
 
-            break;
-        }  // end stage
+                // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+                double candidate_violation = std::fabs(mc->Violation(mresidual));
 
-        default: { break; }
-    }  // end stage  switching
-}
+                // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+                double deltal = (omega / mc->Get_g_i()) * (-mresidual);
 
-// When the solver object is created, threads are also
-// created and initialized, in 'wait' mode.
+                // update:   lambda += delta_lambda;
+                double old_lambda = mc->Get_l_i();
+                mc->Set_l_i(old_lambda + deltal);
 
-ChSolverSORmultithread::ChSolverSORmultithread(char* uniquename,
-                                               int nthreads,
-                                               int mmax_iters,
-                                               bool mwarm_start,
-                                               double mtolerance,
-                                               double momega)
-    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega) {
-    ChThreadConstructionInfo create_args(uniquename, SolverThreadFunc, SolverMemoryFunc, nthreads);
+                // If new lagrangian multiplier does not satisfy inequalities, project
+                // it into an admissible orthant (or, in general, onto an admissible set)
+                mc->Project();
 
-    solver_threads = new ChThreads(create_args);
-}
+                // After projection, the lambda may have changed a bit..
+                double new_lambda = mc->Get_l_i();
 
-ChSolverSORmultithread::~ChSolverSORmultithread() {
-    if (solver_threads) {
-        solver_threads->flush();
-        delete (solver_threads);
-        solver_threads = 0;
-    }
-}
+                // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                if (shlambda != 1.0) {
+                    new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+                    mc->Set_l_i(new_lambda);
+                }
 
-// The SOR solver process has been modified so that some
-// parallelizable code has been moved to the SolverThreadFunc().
-// So, the N threads must be started (each executing SolverThreadFunc() )
-// and, after waiting for all them to be completed, with flush(), the
-// solution is done.
+                double true_delta = new_lambda - old_lambda;
 
-double ChSolverSORmultithread::Solve(
-    ChSystemDescriptor& sysd  ///< system description with constraints and variables
-    ) {
-    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
-    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+                // For all items with variables, add the effect of incremented
+                // (and projected) lagrangian reactions (no other group of this color
+                // acts on the same variables):
+                mc->Increment_q(true_delta);
 
-    double maxviolation = 0.;
-    double maxdeltalambda = 0.;
-    int i_friction_comp = 0;
-
-    /////////////////////////////////////////////
-    /// THE PARALLEL SOLVER, PERFORMED IN STAGES
-
-    ChMutexSpinlock spinlock;
-
-    // --0--  preparation:
-    //        subdivide the workload to the threads and prepare their 'thread_data':
-
-    int numthreads = this->solver_threads->getNumberOfThreads();
-    std::vector<thread_data> mdataN(numthreads);
-
-    int var_slice = 0;
-    int constr_slice = 0;
-    for (int nth = 0; nth < numthreads; nth++) {
-        unsigned int var_from = var_slice;
-        unsigned int var_to = var_from + ((unsigned int)mvariables.size() - var_from) / (numthreads - nth);
-        unsigned int constr_from = constr_slice;
-        unsigned int constr_to = constr_from + ((unsigned int)mconstraints.size() - constr_from) / (numthreads - nth);
-        if (constr_to < mconstraints.size())  // do not slice the three contact multipliers (or six in case of rolling)
-        {
-            if (dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[constr_to]))
-                constr_to++;
-            if (dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[constr_to]))
-                constr_to++;
-            if (constr_to < mconstraints.size()) {
-                if (dynamic_cast<ChConstraintTwoTuplesRollingNall*>(mconstraints[constr_to]))
-                    constr_to++;
-                if (dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[constr_to]))
-                    constr_to++;
-                if (dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[constr_to]))
-                    constr_to++;
+                maxdeltalambda_t = ChMax(maxdeltalambda_t, std::fabs(true_delta));
+                maxviolation_t = ChMax(maxviolation_t, candidate_violation);
             }
         }
-        mdataN[nth].solver = this;
-        mdataN[nth].mutex = &spinlock;
-        mdataN[nth].constr_from = constr_from;
-        mdataN[nth].constr_to = constr_to;
-        mdataN[nth].var_from = var_from;
-        mdataN[nth].var_to = var_to;
-        mdataN[nth].mconstraints = &mconstraints;
-        mdataN[nth].mvariables = &mvariables;
-
-        var_slice = var_to;
-        constr_slice = constr_to;
-    }
 
-    // LAUNCH THE PARALLEL COMPUTATION ON THREADS !!!!
+        thread_maxviolation[thread] = maxviolation_t;
+        thread_maxdeltalambda[thread] = maxdeltalambda_t;
+    };
 
-    // --1--  stage:
-    //        precompute aux variables in constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE1_PREPARE;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
-    // --2--  stage:
-    //        add external forces and mass effects, on variables.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE2_ADDFORCES;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
-    // --3--  stage:
-    //        loop on constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE3_LOOPCONSTRAINTS;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
+    for (int iter = 0; iter < max_iterations; iter++) {
+        std::fill(thread_maxviolation.begin(), thread_maxviolation.end(), 0.0);
+        std::fill(thread_maxdeltalambda.begin(), thread_maxdeltalambda.end(), 0.0);
 
-    return 0;
+        // The iteration on all constraints, one color at a time
+        for (int c = 0; c < ncolors; c++)
+            executor.ParallelFor(color_start[c], color_start[c + 1], 0, sor_update);
+
+        maxviolation = *std::max_element(thread_maxviolation.begin(), thread_maxviolation.end());
+        double maxdeltalambda = *std::max_element(thread_maxdeltalambda.begin(), thread_maxdeltalambda.end());
+
+        // For recording into violaiton history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been succesfully limited.
+        if (maxviolation < tolerance)
+            break;
+
+    }  // end iteration loop
+
+    return maxviolation;
 }
 
 void ChSolverSORmultithread::ChangeNumberOfThreads(int mthreads) {
     if (mthreads < 1)
         mthreads = 1;
 
-    char mname[100];
-    strncpy(mname, solver_threads->getUniqueName().c_str(), sizeof(mname)-1);
-
-    solver_threads->flush();
-    delete (solver_threads);
-    solver_threads = 0;
-
-    ChThreadConstructionInfo create_args(mname, SolverThreadFunc, SolverMemoryFunc, mthreads);
-
-    solver_threads = new ChThreads(create_args);
+    executor.SetNumThreads(mthreads);
 }
 
-} // end namespace chrono
+}  // end namespace chrono
@@ -13,24 +13,60 @@
 #ifndef CHSOLVERSORMULTITHREAD_H
 #define CHSOLVERSORMULTITHREAD_H
 
+#include <vector>
+
 #include "chrono/solver/ChIterativeSolver.h"
-#include "chrono/parallel/ChThreads.h"
+#include "chrono/parallel/ChTaskExecutor.h"
 
 namespace chrono {
 
+/// A multithreaded version of the projected SOR solver (see ChSolverSOR).
+/// Constraints are processed in groups (a single constraint, or the three multipliers
+/// n,u,v of a frictional contact). The groups are colored so that two groups of the
+/// same color never act on the same variables; the colors are then processed one after
+/// the other, and the groups of each color are updated in parallel, without locks, by
+/// the tasks of a work-stealing ChTaskExecutor.
+/// Since the update order only depends on the coloring, the results do not depend on
+/// the number of threads (they differ from ChSolverSOR, whose order is the plain
+/// order of the constraints).
+/// The coloring is kept between calls to Solve(), and it is rebuilt only when the layout
+/// of the problem (active variables, modes of the constraints and variables they act
+/// upon) differs from the one of the last coloring.
 class ChApi ChSolverSORmultithread : public ChIterativeSolver {
     // Chrono RTTI, needed for serialization
     CH_RTTI(ChSolverSORmultithread, ChIterativeSolver);
 
   protected:
-    ChThreads* solver_threads;
+    ChTaskExecutor executor;
+
+    // Groups of constraints (first constraint and number of constraints), sorted by color.
+    std::vector<int> group_start;
+    std::vector<int> group_size;
+    std::vector<int> color_start;  ///< groups of color c are color_start[c] .. color_start[c+1]-1
+
+    // Layout of the last coloring: active variables and their sizes, mode of each
+    // constraint, columns of q each constraint acts upon (CSR format).
+    std::vector<ChVariables*> layout_vars;
+    std::vector<int> layout_ndof;
+    std::vector<int> layout_mode;
+    std::vector<int> layout_cq_start;
+    std::vector<int> layout_cq_col;
+
+    // Layout collected at the current Solve(), compared with the one above
+    std::vector<ChVariables*> new_layout_vars;
+    std::vector<int> new_layout_ndof;
+    std::vector<int> new_layout_mode;
+    std::vector<int> new_layout_cq_start;
+    std::vector<int> new_layout_cq_col;
+
+    int coloring_builds;
 
   public:
     //
     // CONSTRUCTORS
     //
 
-    ChSolverSORmultithread(char* uniquename = (char*)"solver",  ///< this name must be unique.
+    ChSolverSORmultithread(char* uniquename = (char*)"solver",  ///< unused, kept for compatibility
                            int nthreads = 2,                    ///< number of threads
                            int mmax_iters = 50,                 ///< max.number of iterations
                            bool mwarm_start = false,            ///< uses warm start?
@@ -52,6 +88,19 @@ class ChApi ChSolverSORmultithread : public ChIterativeSolver {
 
     /// Changes the number of threads which run in parallel (should be > 1 )
     void ChangeNumberOfThreads(int mthreads = 2);
+
+    /// Number of colors used in the last Solve().
+    int GetNumColors() const { return color_start.empty() ? 0 : (int)color_start.size() - 1; }
+
+    /// Number of times the coloring has been built (for statistics).
+    int GetColoringBuilds() const { return coloring_builds; }
+
+  private:
+    /// Collect the layout of the problem; return true if it differs from the one of the last coloring.
+    bool UpdateLayout(ChSystemDescriptor& sysd);
+
+    /// Group the constraints and color the groups, using the current layout.
+    void ColorConstraints();
 };
 
 }  // end namespace chrono
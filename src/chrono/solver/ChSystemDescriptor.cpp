@@ -13,7 +13,7 @@
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
-#include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/core/ChCSRMatrix.h"
 
 namespace chrono {
 
@@ -30,6 +30,8 @@ ChSystemDescriptor::ChSystemDescriptor() {
 
     c_a = 1.0;
 
+    use_packed = true;
+
     n_q = 0;
     n_c = 0;
     freeze_count = false;
@@ -106,6 +108,15 @@ void ChSystemDescriptor::UpdateCountsAndOffsets() {
     CountActiveVariables();
     CountActiveConstraints();
     freeze_count = true;
+    packed_operator.Invalidate();
+}
+
+void ChSystemDescriptor::UpdatePackedProducts() {
+    if (!use_packed)
+        return;
+    n_q = CountActiveVariables();
+    n_c = CountActiveConstraints();
+    packed_operator.Update(vvariables, vconstraints, vstiffness, n_q, n_c);
 }
 
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
@@ -197,6 +208,14 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
                     s_c++;
                 }
     }
+
+    // Complete the assembly (e.g. build or update the sparsity pattern of CSR matrices)
+    if (Cq)
+        Cq->Finalize();
+    if (M)
+        M->Finalize();
+    if (E)
+        E->Finalize();
 }
 
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs) {
@@ -249,6 +268,9 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs)
 				s_c++;
 			}
 		}
+
+		// Complete the assembly (e.g. build or update the sparsity pattern of CSR matrices)
+		Z->Finalize();
 	}
     
 
@@ -298,7 +320,7 @@ void ChSystemDescriptor::DumpLastMatrices(bool assembled, const char* path) {
         const char* numformat = "%.12g";
 
         if (assembled) {
-            ChLinkedListMatrix Z;
+            ChCSRMatrix Z;
             ChMatrixDynamic<double> rhs;
             ConvertToMatrixForm(&Z, &rhs);
 
@@ -312,9 +334,9 @@ void ChSystemDescriptor::DumpLastMatrices(bool assembled, const char* path) {
             file_rhs.SetNumFormat(numformat);
             rhs.StreamOUTdenseMatlabFormat(file_rhs);
         } else {
-            ChLinkedListMatrix mdM;
-            ChLinkedListMatrix mdCq;
-            ChLinkedListMatrix mdE;
+            ChCSRMatrix mdM;
+            ChCSRMatrix mdCq;
+            ChCSRMatrix mdE;
             ChMatrixDynamic<double> mdf;
             ChMatrixDynamic<double> mdb;
             ChMatrixDynamic<double> mdfric;
@@ -555,6 +577,11 @@ void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* l
     assert(lvector->GetRows() == CountActiveConstraints());
     assert(lvector->GetColumns() == 1);
 
+    if (lvector && IsPacked()) {
+        packed_operator.ShurComplementProduct(result, *lvector, enabled, num_threads);
+        return;
+    }
+
     result.Reset(n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
 // Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
@@ -642,6 +669,13 @@ void ChSystemDescriptor::SystemProduct(
         this->FromUnknownsToVector(*vect);
     }
 
+    if (IsPacked()) {
+        packed_operator.SystemProduct(result, *vect, c_a, num_threads);
+        if (x_ql)
+            delete x_ql;
+        return;
+    }
+
     result.Reset(n_q + n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
 // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
@@ -18,6 +18,7 @@
 #include "chrono/solver/ChVariables.h"
 #include "chrono/solver/ChConstraint.h"
 #include "chrono/solver/ChKblock.h"
+#include "chrono/solver/ChPackedSystemOperator.h"
 #include "chrono/parallel/ChOpenMP.h"
 #include "chrono/parallel/ChThreadsSync.h"
 
@@ -67,6 +68,9 @@ class ChApi ChSystemDescriptor {
 
     double c_a;         // coefficient form M mass matrices in vvariables
 
+    bool use_packed;                         // use the packed form in the products, when available
+    ChPackedSystemOperator packed_operator;  // packed form of the products
+
   private:
     int n_q;            // n.active variables
     int n_c;            // n.active constraints
@@ -99,6 +103,7 @@ class ChApi ChSystemDescriptor {
         vconstraints.clear();
         vvariables.clear();
         vstiffness.clear();
+        packed_operator.Invalidate();
     }
 
     /// Insert reference to a ChConstraint object
@@ -141,6 +146,31 @@ class ChApi ChSystemDescriptor {
     /// BuildMatrices(), DumpMatrices().
     virtual double GetMassFactor() { return c_a;}
 
+    /// Enable/disable the packed form of ShurComplementProduct() and SystemProduct()
+    /// (default: true). See UpdatePackedProducts().
+    void SetUsePackedProducts(bool mp) {
+        use_packed = mp;
+        packed_operator.Invalidate();
+    }
+    bool GetUsePackedProducts() const { return use_packed; }
+
+    /// Pack the K blocks, the jacobians and the [Eq] terms of the constraints in contiguous
+    /// block-sparse arrays (see ChPackedSystemOperator), used by the following calls to
+    /// ShurComplementProduct() and SystemProduct(), which give the same results as the
+    /// unpacked products up to roundoff. Call this after the jacobians, the K blocks and
+    /// the auxiliary data of the constraints (see ChConstraint::Update_auxiliary()) have
+    /// been loaded: the iterative solvers do so at the beginning of Solve(). The sparsity
+    /// structure is rebuilt only if it changed since the last call; the packed form is
+    /// discarded by BeginInsertion() and UpdateCountsAndOffsets(). If the items cannot be
+    /// packed, the products fall back to the unpacked form.
+    virtual void UpdatePackedProducts();
+
+    /// Tell if the products currently use the packed form.
+    bool IsPacked() const { return use_packed && packed_operator.IsValid(); }
+
+    /// Access the packed form of the products.
+    ChPackedSystemOperator& GetPackedOperator() { return packed_operator; }
+
     //
     // DATA <-> MATH.VECTORS FUNCTIONS
     //
@@ -251,7 +281,8 @@ class ChApi ChSystemDescriptor {
     /// Optionally, you can pass an 'enabled' vector of bools, that must have the same
     /// length of the l_i reactions vector; constraints with enabled=false are not handled.
     /// NOTE! the 'q' data in the ChVariables of the system descriptor is changed by this
-    /// operation, so it may happen that you need to backup them via FromVariablesToVector()
+    /// operation (unless the packed form is used), so it may happen that you need to backup
+    /// them via FromVariablesToVector()
     /// NOTE! currently this function does NOT support the cases that use also ChKblock
     /// objects, because it would need to invert the global M+K, that is not diagonal,
     /// for doing = [N]*l = [ [Cq][(M+K)^(-1)][Cq'] - [E] ] * l
@@ -340,6 +371,8 @@ class ChApi ChSystemDescriptor {
     /// using these matrices, for performance), for example you will load these matrices in Matlab.
     /// Optionally, tangential (u,v) contact jacobians may be skipped, or only bilaterals can be considered
     /// The matrices and vectors are automatically resized if needed.
+    /// ChCSRMatrix is the recommended sparse matrix type: its sparsity pattern is computed in the
+    /// first call and reused in the following ones, as long as the system size does not change.
 	virtual void ConvertToMatrixForm(ChSparseMatrix* Cq,   ///< fill this system jacobian matrix, if not null
 									 ChSparseMatrix* M,    ///< fill this system mass matrix, if not null
 									 ChSparseMatrix* E,    ///< fill this system 'compliance' matrix , if not null
@@ -320,6 +320,17 @@ class ChApi ChIntegrableIIorder : public ChIntegrable {
         throw ChException("StateSolveCorrection() not implemented, implicit integrators cannot be used. ");
     };
 
+    /// Allow or forbid, in the next calls to StateSolveCorrection(), the reuse of the
+    /// matrix [G Cq'; Cq 0] (and of its factorization, with direct solvers) of a previous
+    /// call, as in modified Newton iterations. Even if allowed, the child class updates
+    /// the matrix if it cannot be reused (e.g. if the c_a, c_v, c_x factors or the size
+    /// of the problem changed). By default the reuse is not supported and this is ignored.
+    virtual void SetJacobianReuse(bool reuse) {}
+
+    /// Return true if the last call to StateSolveCorrection() updated the matrix
+    /// (and its factorization), false if it reused the one of a previous call.
+    virtual bool GetJacobianUpdated() const { return true; }
+
     /// Assuming   M*a = F(x,v,t) + Cq'*L
     ///         C(x,t) = 0
     /// increment a vector R (usually the residual in a Newton Raphson iteration
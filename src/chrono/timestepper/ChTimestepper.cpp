@@ -17,6 +17,47 @@ using namespace chrono;
 
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Modified Newton support of implicit iterative timesteppers.
+// The Jacobian is updated at the first iteration, then reused until the ratio between the norms of
+// two successive corrections exceeds jacobian_max_rate (slow convergence, the Jacobian is updated
+// at the next iteration) or until it was used in jacobian_max_solves Newton solves.
+
+void ChImplicitIterativeTimestepper::JacobianBeginStep() {
+    num_jacobian_updates = 0;
+    total_steps++;
+}
+
+void ChImplicitIterativeTimestepper::JacobianBeginSolve() {
+    if (jacobian_age >= jacobian_max_solves)
+        jacobian_refresh = true;
+    jacobian_age++;
+    jacobian_stale = false;
+    jacobian_last_norm = 0;
+}
+
+void ChImplicitIterativeTimestepper::JacobianBeginIteration(ChIntegrableIIorder* integrable) {
+    integrable->SetJacobianReuse(modified_newton && !jacobian_refresh);
+}
+
+void ChImplicitIterativeTimestepper::JacobianEndIteration(ChIntegrableIIorder* integrable, double correction_norm) {
+    if (integrable->GetJacobianUpdated()) {
+        num_jacobian_updates++;
+        total_jacobian_updates++;
+        jacobian_refresh = false;
+        jacobian_age = 1;
+    } else {
+        jacobian_stale = true;
+        if (correction_norm > jacobian_max_rate * jacobian_last_norm && jacobian_last_norm > 0)
+            jacobian_refresh = true;
+    }
+    jacobian_last_norm = correction_norm;
+}
+
+
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -317,6 +358,9 @@ void ChTimestepperEulerImplicit::Advance(const double dt  ///< timestep to advan
 
     mintegrable->StateGather(X, V, T);  // state <- system
 
+    JacobianBeginStep();
+    JacobianBeginSolve();
+
     // Extrapolate a prediction as warm start
 
     Xnew = X + V * dt;
@@ -342,6 +386,8 @@ void ChTimestepperEulerImplicit::Advance(const double dt  ///< timestep to advan
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
             break;
 
+        JacobianBeginIteration(mintegrable);
+
         mintegrable->StateSolveCorrection(
             Dv, Dl, R, Qc,
             1.0,       // factor for  M
@@ -351,6 +397,8 @@ void ChTimestepperEulerImplicit::Advance(const double dt  ///< timestep to advan
             false  // do not StateScatter update to Xnew Vnew T+dt before computing correction
             );
 
+        JacobianEndIteration(mintegrable, Dv.NormTwo());
+
         Dl *= (1.0 / dt);  // Note it is not -(1.0/dt) because we assume StateSolveCorrection already flips sign of Dl
         L += Dl;
 
@@ -823,6 +871,8 @@ void ChTimestepperHHT::Advance(const double dt) {
     mintegrable->StateGatherAcceleration(A);  // <- system
     mintegrable->StateGatherReactions(L);     // <- system
 
+    JacobianBeginStep();
+
     // Advance solution to time T+dt, possibly taking multiple steps
     double tfinal = T + dt;  // target final time
     num_it = 0;              // total number of NR iterations 
@@ -845,9 +895,12 @@ void ChTimestepperHHT::Advance(const double dt) {
         h = ChMin(h, dt);
     }
 
+    bool jacobian_retry = false;  // step attempted again with an updated Jacobian
+
     while (T < tfinal) {
         double scaling_factor = scaling ? beta * h * h : 1;
         Prepare(mintegrable, scaling_factor);
+        JacobianBeginSolve();
 
         // Newton-Raphson for state at T+h
         bool converged;
@@ -860,7 +913,16 @@ void ChTimestepperHHT::Advance(const double dt) {
                 break;
         }
 
-        if (converged || !step_control) {
+        if (!converged && jacobian_stale && !jacobian_retry) {
+            // NR did not converge with a reused Jacobian (modified Newton):
+            // - try again with the same stepsize and an updated Jacobian
+
+            jacobian_refresh = true;
+            jacobian_retry = true;
+            if (verbose)
+                GetLog() << " ---HHT update Jacobian\n";
+
+        } else if (converged || !step_control) {
             // NR converged (or step size control disabled):
             // - if the number of iterations was low enough, increase the count of successive
             //   successful steps (for possible step increase)
@@ -888,6 +950,7 @@ void ChTimestepperHHT::Advance(const double dt) {
             V = Vnew;
             A = Anew;
             L = Lnew;
+            jacobian_retry = false;
 
         } else {
             // NR did not converge.
@@ -896,6 +959,7 @@ void ChTimestepperHHT::Advance(const double dt) {
             // - bail out if stepsize reaches minimum allowable
 
             num_successful_steps = 0;
+            jacobian_retry = false;
             h *= step_decrease_factor;
             if (verbose)
                 GetLog() << " ---HHT reduce stepsize to " << h << "\n";
@@ -984,6 +1048,7 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
             integrable->LoadConstraint_C(Qc, 1 / (beta * h * h), Qc_do_clamp, Qc_clamping);  //  1/(beta*dt^2)*C
 
             // Solve linear system
+            JacobianBeginIteration(integrable);
             integrable->StateSolveCorrection(
                 Da, Dl, R, Qc,
                 1 / (1 + alpha),  // factor for  M (was 1 in Negrut paper ?!)
@@ -992,6 +1057,7 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
                 Xnew, Vnew, T + h,
                 false  // do not StateScatter update to Xnew Vnew T+h before computing correction
                 );
+            JacobianEndIteration(integrable, Da.NormTwo());
 
             // Update estimate of state at t+h
             Lnew += Dl;  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
@@ -1009,6 +1075,7 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
             integrable->LoadConstraint_C(Qc, 1.0, Qc_do_clamp, Qc_clamping);          //  1/(beta*dt^2)*C
 
             // Solve linear system
+            JacobianBeginIteration(integrable);
             integrable->StateSolveCorrection(
                 Da, Dl, R, Qc,
                 scaling_factor / ((1 + alpha) * beta * h * h),  // factor for  M
@@ -1017,6 +1084,7 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
                 Xnew, Vnew, T + h,
                 false  // do not StateScatter update to Xnew Vnew T+h before computing correction
                 );
+            JacobianEndIteration(integrable, Da.NormTwo());
 
             // Update estimate of state at t+h
             Lnew += Dl * (1.0 / scaling_factor);  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
@@ -202,9 +202,34 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     double abstolS;  // absolute tolerance (states)
     double abstolL;  // absolute tolerance (Lagrange multipliers)
 
+    bool modified_newton;             // reuse the Jacobian over Newton iterations and steps
+    int jacobian_max_solves;          // maximum number of Newton solves with the same Jacobian
+    double jacobian_max_rate;         // Jacobian update if the convergence rate is above this value
+    bool jacobian_refresh;            // update the Jacobian at the next Newton iteration
+    bool jacobian_stale;              // a reused Jacobian was used in the current Newton solve
+    int jacobian_age;                 // number of Newton solves since the last Jacobian update
+    double jacobian_last_norm;        // norm of the last Newton correction
+    int num_jacobian_updates;         // number of Jacobian updates over the last step
+    long long total_jacobian_updates;  // number of Jacobian updates since the last statistics reset
+    long long total_steps;             // number of steps since the last statistics reset
+
   public:
     /// Constructors
-    ChImplicitIterativeTimestepper() : maxiters(6), reltol(1e-4), abstolS(1e-10), abstolL(1e-10) {}
+    ChImplicitIterativeTimestepper()
+        : maxiters(6),
+          reltol(1e-4),
+          abstolS(1e-10),
+          abstolL(1e-10),
+          modified_newton(false),
+          jacobian_max_solves(20),
+          jacobian_max_rate(0.5),
+          jacobian_refresh(true),
+          jacobian_stale(false),
+          jacobian_age(0),
+          jacobian_last_norm(0),
+          num_jacobian_updates(0),
+          total_jacobian_updates(0),
+          total_steps(0) {}
 
     /// Set the max number of iterations using the Newton Raphson procedure
     void SetMaxiters(int miters) { maxiters = miters; }
@@ -234,17 +259,58 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
         abstolL = abs_tol;
     }
 
+    /// Turn the modified Newton method on/off (default off).
+    /// If on, the Jacobian (and its factorization, with direct solvers) is kept over the
+    /// Newton iterations and over the following steps, and it is updated only when the
+    /// convergence slows down (see SetJacobianMaxRate), after a given number of Newton
+    /// solves (see SetJacobianMaxSolves), or when the factors of the matrix change (e.g.
+    /// because of a step size change). More iterations are usually needed, so consider
+    /// increasing the max number of iterations.
+    /// This requires an integrable that supports the Jacobian reuse, such as ChSystem.
+    void SetModifiedNewton(bool val) {
+        modified_newton = val;
+        jacobian_refresh = true;
+    }
+    bool GetModifiedNewton() const { return modified_newton; }
+
+    /// Set the max number of Newton solves (one per step, or more if the step is repeated)
+    /// that reuse the same Jacobian in the modified Newton method (default 20).
+    void SetJacobianMaxSolves(int num_solves) { jacobian_max_solves = num_solves; }
+
+    /// Set the max convergence rate of the modified Newton method, as the ratio between the
+    /// norms of two successive corrections: if exceeded, the Jacobian is updated (default 0.5).
+    void SetJacobianMaxRate(double rate) { jacobian_max_rate = rate; }
+
+    /// Return the number of Jacobian updates (and factorizations, with direct solvers) over
+    /// the last step. Without the modified Newton method, this is the number of iterations.
+    int GetNumJacobianUpdates() const { return num_jacobian_updates; }
+
+    /// Return the average number of Jacobian updates per step since the last statistics reset.
+    double GetAvgJacobianUpdates() const { return total_steps ? (double)total_jacobian_updates / total_steps : 0; }
+
+    /// Return the number of Jacobian updates since the last statistics reset.
+    long long GetTotalJacobianUpdates() const { return total_jacobian_updates; }
+
+    /// Reset the statistics of Jacobian updates.
+    void ResetJacobianStatistics() {
+        total_jacobian_updates = 0;
+        total_steps = 0;
+    }
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
-        marchive.VersionWrite(1);
+        marchive.VersionWrite(2);
         // serialize all member data:
         marchive << CHNVP(maxiters);
         marchive << CHNVP(reltol);
         marchive << CHNVP(abstolS);
         marchive << CHNVP(abstolL);
+        marchive << CHNVP(modified_newton);
+        marchive << CHNVP(jacobian_max_solves);
+        marchive << CHNVP(jacobian_max_rate);
     }
 
     /// Method to allow de serialization of transient data from archives.
@@ -256,7 +322,24 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
         marchive >> CHNVP(reltol);
         marchive >> CHNVP(abstolS);
         marchive >> CHNVP(abstolL);
+        // modified Newton settings, added in version 2
+        if (version >= 2) {
+            marchive >> CHNVP(modified_newton);
+            marchive >> CHNVP(jacobian_max_solves);
+            marchive >> CHNVP(jacobian_max_rate);
+        }
     }
+
+  protected:
+    // Modified Newton: start a new step (reset the statistics of the step).
+    void JacobianBeginStep();
+    // Modified Newton: start a new Newton solve (update the Jacobian if too old).
+    void JacobianBeginSolve();
+    // Modified Newton: tell the integrable if the Jacobian can be reused in the next iteration.
+    void JacobianBeginIteration(ChIntegrableIIorder* integrable);
+    // Modified Newton: count the Jacobian updates and check the convergence rate, given the
+    // norm of the last correction.
+    void JacobianEndIteration(ChIntegrableIIorder* integrable, double correction_norm);
 };
 
 /// Euler explicit timestepper
@@ -56,7 +56,7 @@ class ChApiFea ChElementBase {
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
     /// CHLDREN CLASSES MUST IMPLEMENT THIS!!!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) = 0;
+    virtual void GetStateBlock(ChMatrix<>& mD) = 0;
 
     /// Sets M as the mass matrix.
     /// The matrix is expressed in global reference.
@@ -144,7 +144,7 @@ class ChElementBeamANCF : public ChElementBeam, public ChLoadableU, public ChLoa
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     ///  {x_a y_a z_a Dx_a Dx_a Dx_a x_b y_b z_b Dx_b Dy_b Dz_b}
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(12, 1);
 
         mD.PasteVector(this->nodes[0]->GetPos(), 0, 0);
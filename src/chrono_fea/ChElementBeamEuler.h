@@ -228,7 +228,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
     /// For corotational elements, field is assumed in local reference!
     /// Give that this element includes rotations at nodes, this gives:
     ///  {x_a y_a z_a Rx_a Ry_a Rz_a x_b y_b z_b Rx_b Ry_b Rz_b}
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(12, 1);
 
         ChVector<> delta_rot_dir;
@@ -275,7 +275,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
     /// For corotational elements, field is assumed in local reference!
     /// Give that this element includes rotations at nodes, this gives:
     ///  {v_a v_a v_a wx_a wy_a wz_a v_b v_b v_b wx_b wy_b wz_b}
-    virtual void GetField_dt(ChMatrixDynamic<>& mD_dt) {
+    virtual void GetField_dt(ChMatrix<>& mD_dt) {
         mD_dt.Reset(12, 1);
 
         // Node 0, velocity (in local element frame, corotated back by A' )
@@ -455,8 +455,8 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
         assert(section);
 
         // Corotational K stiffness:
-        ChMatrixDynamic<> CK(12, 12);
-        ChMatrixDynamic<> CKCt(12, 12);  // the global, corotated, K matrix
+        ChMatrixNM<double, 12, 12> CK;
+        ChMatrixNM<double, 12, 12> CKCt;  // the global, corotated, K matrix
 
         if (!disable_projector) {
             //
@@ -465,7 +465,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
 
             // compute [H(theta)]'[K_loc] [H(theta]
 
-            ChMatrixDynamic<> displ(12, 1);
+            ChMatrixNM<double, 12, 1> displ;
             this->GetStateBlock(displ);
 
             ChMatrix33<> mI;
@@ -496,12 +496,8 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
 
             LambdaA.MatrTranspose();
             LambdaB.MatrTranspose();
-            ChMatrixDynamic<> HtKH(12, 12);
-            std::vector<ChMatrix33<>*> Ht;
-            Ht.push_back(&mI);
-            Ht.push_back(&LambdaA);
-            Ht.push_back(&mI);
-            Ht.push_back(&LambdaB);
+            ChMatrixNM<double, 12, 12> HtKH;
+            ChMatrix33<>* Ht[4] = {&mI, &LambdaA, &mI, &LambdaB};
 
             ChMatrixCorotation<>::ComputeCK(this->StiffnessMatrix, Ht, 4, CK);  // CK = [H(theta)]'[K_loc]
             ChMatrixCorotation<>::ComputeKCt(CK, Ht, 4, HtKH);                  // HtKH = [H(theta)]'[K_loc] [H(theta)]
@@ -518,13 +514,13 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             mX_a.Set_X_matrix(-vX_a_loc);
             mX_b.Set_X_matrix(-vX_b_loc);
 
-            ChMatrixDynamic<> mS(12, 3);  // [S] = [ -skew[X_a_loc];  [I];  -skew[X_b_loc];  [I] ]
+            ChMatrixNM<double, 12, 3> mS;  // [S] = [ -skew[X_a_loc];  [I];  -skew[X_b_loc];  [I] ]
             mS.PasteMatrix(&mX_a, 0, 0);
             mS.PasteMatrix(&mI, 3, 0);
             mS.PasteMatrix(&mX_b, 6, 0);
             mS.PasteMatrix(&mI, 9, 0);
 
-            ChMatrixDynamic<> mG(3, 12);  // [G] = [dw_frame/du_a; dw_frame/dw_a; dw_frame/du_b; dw_frame/dw_b]
+            ChMatrixNM<double, 3, 12> mG;  // [G] = [dw_frame/du_a; dw_frame/dw_a; dw_frame/du_b; dw_frame/dw_b]
             mG(2, 1) = -1. / Lel;
             mG(1, 2) = 1. / Lel;
             mG(2, 7) = 1. / Lel;
@@ -532,26 +528,26 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             mG(0, 4) = 0.5;
             mG(0, 10) = 0.5;
 
-            ChMatrixDynamic<> mP(12, 12);  // [P] = [I]-[S][G]
+            ChMatrixNM<double, 12, 12> mP;  // [P] = [I]-[S][G]
             mP.MatrMultiply(mS, mG);
             mP.MatrNeg();
             for (int k = 0; k < 12; ++k)
                 mP(k, k) += 1.0;
 
-            ChMatrixDynamic<> f_local(12, 1);  // f_loc = [K_loc]*u_loc
+            ChMatrixNM<double, 12, 1> f_local;  // f_loc = [K_loc]*u_loc
             f_local.MatrMultiply(StiffnessMatrix, displ);
 
-            ChMatrixDynamic<> f_h(12, 1);  // f_h = [H(theta)]' [K_loc]*u_loc
+            ChMatrixNM<double, 12, 1> f_h;  // f_h = [H(theta)]' [K_loc]*u_loc
             f_h.PasteVector(f_local.ClipVector(0, 0), 0, 0);
             f_h.PasteVector(LambdaA * f_local.ClipVector(3, 0), 3, 0);  // LambdaA is already transposed
             f_h.PasteVector(f_local.ClipVector(6, 0), 6, 0);
             f_h.PasteVector(LambdaB * f_local.ClipVector(9, 0), 9, 0);  // LambdaB is already transposed
 
-            ChMatrixDynamic<> f_p(12, 1);  // f_p = [P]' [H(theta)]' [K_loc]*u_loc
+            ChMatrixNM<double, 12, 1> f_p;  // f_p = [P]' [H(theta)]' [K_loc]*u_loc
             f_p.MatrTMultiply(mP, f_h);
 
-            ChMatrixDynamic<> mFnm(12, 3);
-            ChMatrixDynamic<> mFn(12, 3);
+            ChMatrixNM<double, 12, 3> mFnm;
+            ChMatrixNM<double, 12, 3> mFn;
             ChMatrix33<> skew_f;
 
             if (!force_symmetric_stiffness) {
@@ -577,22 +573,22 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
                 mFn = mFnm;
             }
 
-            ChMatrixDynamic<> mtemp(12, 12);
+            ChMatrixNM<double, 12, 12> mtemp;
 
-            ChMatrixDynamic<> K_m(12, 12);  // [K_m]  = [P]' [H(theta)]'[K_loc] [H(theta] [P]
+            ChMatrixNM<double, 12, 12> K_m;  // [K_m]  = [P]' [H(theta)]'[K_loc] [H(theta] [P]
             mtemp.MatrMultiply(HtKH, mP);
             K_m.MatrTMultiply(mP, mtemp);
 
-            ChMatrixDynamic<> K_gr(12, 12);  // [K_gr] = [F_nm][G]
+            ChMatrixNM<double, 12, 12> K_gr;  // [K_gr] = [F_nm][G]
             K_gr.MatrMultiply(mFnm, mG);
 
-            ChMatrixDynamic<> K_gp(12, 12);  // [K_gp] = [G]'[F_n]'[P] = ([F_n][G])'[P]
+            ChMatrixNM<double, 12, 12> K_gp;  // [K_gp] = [G]'[F_n]'[P] = ([F_n][G])'[P]
             mtemp.MatrMultiply(mFn, mG);
             K_gp.MatrTMultiply(mtemp, mP);
 
             // ...							// [K_gm] = [P]'[L][P]  (simplify: avoid computing this)
 
-            ChMatrixDynamic<> K_tang(12, 12);  // [K_tang] = [K_m] - [K_gr] - [K_gp] + [K_gm]
+            ChMatrixNM<double, 12, 12> K_tang;  // [K_tang] = [K_m] - [K_gr] - [K_gp] + [K_gm]
             K_tang.MatrInc(K_m);
             K_tang.MatrDec(K_gr);
             K_tang.MatrDec(K_gp);
@@ -601,11 +597,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             ChMatrix33<> Atoabs(this->q_element_abs_rot);
             ChMatrix33<> AtolocwelA(this->GetNodeA()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
             ChMatrix33<> AtolocwelB(this->GetNodeB()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
-            std::vector<ChMatrix33<>*> R;
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelA);
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelB);
+            ChMatrix33<>* R[4] = {&Atoabs, &AtolocwelA, &Atoabs, &AtolocwelB};
 
             ChMatrixCorotation<>::ComputeCK(K_tang, R, 4, CK);
             ChMatrixCorotation<>::ComputeKCt(CK, R, 4, CKCt);
@@ -617,11 +609,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             ChMatrix33<> Atoabs(this->q_element_abs_rot);
             ChMatrix33<> AtolocwelA(this->GetNodeA()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
             ChMatrix33<> AtolocwelB(this->GetNodeB()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
-            std::vector<ChMatrix33<>*> R;
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelA);
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelB);
+            ChMatrix33<>* R[4] = {&Atoabs, &AtolocwelA, &Atoabs, &AtolocwelB};
 
             ChMatrixCorotation<>::ComputeCK(this->StiffnessMatrix, R, 4, CK);
             ChMatrixCorotation<>::ComputeKCt(CK, R, 4, CKCt);
@@ -645,7 +633,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
 
         // For M mass matrix, do mass lumping:
 
-        ChMatrixDynamic<> Mloc(12, 12);
+        ChMatrixNM<double, 12, 12> Mloc;
 
         double lmass = mass * 0.5;
         double lineryz = (1. / 50.) * mass * pow(length, 2);  // note: 1/50 can be even less (this is 0 in many texts)
@@ -698,18 +686,18 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
         assert(section);
 
         // set up vector of nodal displacements and small rotations (in local element system)
-        ChMatrixDynamic<> displ(12, 1);
+        ChMatrixNM<double, 12, 1> displ;
         this->GetStateBlock(displ);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         // set up vector of nodal velocities (in local element system)
-        ChMatrixDynamic<> displ_dt(12, 1);
+        ChMatrixNM<double, 12, 1> displ_dt;
         this->GetField_dt(displ_dt);
 
-        ChMatrixDynamic<> FiR_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ_dt);
         FiR_local.MatrScale(this->section->GetBeamRaleyghDamping());
 
@@ -722,7 +710,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             // Corotational approach as in G.Felippa
             //
 
-            ChMatrixDynamic<> displ(12, 1);
+            ChMatrixNM<double, 12, 1> displ;
             this->GetStateBlock(displ);
             ChMatrix33<> mI;
             mI.Set33Identity();
@@ -762,13 +750,13 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             mX_a.Set_X_matrix(-vX_a_loc);
             mX_b.Set_X_matrix(-vX_b_loc);
 
-            ChMatrixDynamic<> mS(12, 3);  // [S] = [ -skew[X_a_loc];  [I];  -skew[X_b_loc];  [I] ]
+            ChMatrixNM<double, 12, 3> mS;  // [S] = [ -skew[X_a_loc];  [I];  -skew[X_b_loc];  [I] ]
             mS.PasteMatrix(&mX_a, 0, 0);
             mS.PasteMatrix(&mI, 3, 0);
             mS.PasteMatrix(&mX_b, 6, 0);
             mS.PasteMatrix(&mI, 9, 0);
 
-            ChMatrixDynamic<> mG(3, 12);  // [G] = [dw_frame/du_a; dw_frame/dw_a; dw_frame/du_b; dw_frame/dw_b]
+            ChMatrixNM<double, 3, 12> mG;  // [G] = [dw_frame/du_a; dw_frame/dw_a; dw_frame/du_b; dw_frame/dw_b]
             mG(2, 1) = -1. / Lel;
             mG(1, 2) = 1. / Lel;
             mG(2, 7) = 1. / Lel;
@@ -776,29 +764,25 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             mG(0, 4) = 0.5;
             mG(0, 10) = 0.5;
 
-            ChMatrixDynamic<> mP(12, 12);  // [P] = [I]-[S][G]
+            ChMatrixNM<double, 12, 12> mP;  // [P] = [I]-[S][G]
             mP.MatrMultiply(mS, mG);
             mP.MatrNeg();
             for (int k = 0; k < 12; ++k)
                 mP(k, k) += 1.0;
 
-            ChMatrixDynamic<> HF(12, 1);  //  HF =  [H(theta)]' F_local
+            ChMatrixNM<double, 12, 1> HF;  //  HF =  [H(theta)]' F_local
             HF.PasteVector(FiK_local.ClipVector(0, 0), 0, 0);
             HF.PasteVector(LambdaA * FiK_local.ClipVector(3, 0), 3, 0);
             HF.PasteVector(FiK_local.ClipVector(6, 0), 6, 0);
             HF.PasteVector(LambdaB * FiK_local.ClipVector(9, 0), 9, 0);
 
-            ChMatrixDynamic<> PHF(12, 1);
+            ChMatrixNM<double, 12, 1> PHF;
             PHF.MatrTMultiply(mP, HF);
 
             ChMatrix33<> Atoabs(this->q_element_abs_rot);
             ChMatrix33<> AtolocwelA(this->GetNodeA()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
             ChMatrix33<> AtolocwelB(this->GetNodeB()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
-            std::vector<ChMatrix33<>*> R;
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelA);
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelB);
+            ChMatrix33<>* R[4] = {&Atoabs, &AtolocwelA, &Atoabs, &AtolocwelB};
             ChMatrixCorotation<>::ComputeCK(PHF, R, 4, Fi);
         } else {
             //
@@ -809,11 +793,7 @@ class ChApiFea ChElementBeamEuler : public ChElementBeam,
             ChMatrix33<> Atoabs(this->q_element_abs_rot);
             ChMatrix33<> AtolocwelA(this->GetNodeA()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
             ChMatrix33<> AtolocwelB(this->GetNodeB()->Frame().GetRot().GetConjugate() % this->q_element_abs_rot);
-            std::vector<ChMatrix33<>*> R;
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelA);
-            R.push_back(&Atoabs);
-            R.push_back(&AtolocwelB);
+            ChMatrix33<>* R[4] = {&Atoabs, &AtolocwelA, &Atoabs, &AtolocwelB};
             ChMatrixCorotation<>::ComputeCK(FiK_local, R, 4, Fi);
         }
 
@@ -513,7 +513,7 @@ void ChElementBrick::Update() {
 
 // -----------------------------------------------------------------------------
 
-void ChElementBrick::GetStateBlock(ChMatrixDynamic<>& mD) {
+void ChElementBrick::GetStateBlock(ChMatrix<>& mD) {
     mD.PasteVector(m_nodes[0]->GetPos(), 0, 0);
     mD.PasteVector(m_nodes[1]->GetPos(), 3, 0);
     mD.PasteVector(m_nodes[2]->GetPos(), 6, 0);
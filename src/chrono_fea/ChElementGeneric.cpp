@@ -16,8 +16,17 @@
 namespace chrono {
 namespace fea {
 
+// Per-thread scratch matrices for the element routines below, which run inside
+// the OpenMP loops of ChMesh. They are reallocated only when the number of dofs
+// changes from one element to the next, so in a mesh of one element type there
+// is no heap allocation (and no contention on the malloc lock) at each call.
+static thread_local ChMatrixDynamic<> scratch_Fi;
+static thread_local ChMatrixDynamic<> scratch_qi;
+static thread_local ChMatrixDynamic<> scratch_Mi;
+
 void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {
-    ChMatrixDynamic<> mFi(this->GetNdofs(), 1);
+    ChMatrixDynamic<>& mFi = scratch_Fi;
+    mFi.Reset(this->GetNdofs(), 1);
     this->ComputeInternalForces(mFi);
     // GetLog() << "EleIntLoadResidual_F , mFi=" << mFi << "  c=" << c << "\n";
     mFi.MatrScale(c);
@@ -37,10 +46,12 @@ void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVecto
     // This is a default (VERY UNOPTIMAL) book keeping so that in children classes you can avoid
     // implementing this EleIntLoadResidual_Mv function, unless you need faster code)
 
-    ChMatrixDynamic<> mMi(this->GetNdofs(), this->GetNdofs());
+    ChMatrixDynamic<>& mMi = scratch_Mi;
+    mMi.Reset(this->GetNdofs(), this->GetNdofs());
     this->ComputeMmatrixGlobal(mMi);
 
-    ChMatrixDynamic<> mqi(this->GetNdofs(), 1);
+    ChMatrixDynamic<>& mqi = scratch_qi;
+    mqi.Reset(this->GetNdofs(), 1);
     int stride = 0;
     for (int in = 0; in < this->GetNnodes(); in++) {
         int nodedofs = GetNodeNdofs(in);
@@ -49,7 +60,8 @@ void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVecto
         stride += nodedofs;
     }
 
-    ChMatrixDynamic<> mFi(this->GetNdofs(), 1);
+    ChMatrixDynamic<>& mFi = scratch_Fi;
+    mFi.Reset(this->GetNdofs(), 1);
     mFi.MatrMultiply(mMi, mqi);
     mFi.MatrScale(c);
 
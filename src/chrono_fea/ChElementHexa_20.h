@@ -165,7 +165,7 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(this->GetNdofs(), 1);
 
         for (int i = 0; i < GetNnodes(); i++)
@@ -175,8 +175,8 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
     /// Puts inside 'Jacobian' and 'J1' the Jacobian matrix and the shape functions derivatives matrix of the element
     /// The vector "coord" contains the natural coordinates of the integration point
     /// in case of hexahedral elements natural coords vary in the classical range -1 ... +1
-    virtual void ComputeJacobian(ChMatrixDynamic<>& Jacobian, ChMatrixDynamic<>& J1, ChVector<> coord) {
-        ChMatrixDynamic<> J2(20, 3);
+    virtual void ComputeJacobian(ChMatrix<>& Jacobian, ChMatrix<>& J1, ChVector<> coord) {
+        ChMatrixNM<double, 20, 3> J2;
 
         J1.SetElement(0, 0, -(1 - coord.y) * (1 - coord.z) * (-1 - 2 * coord.x - coord.y - coord.z) / 8);
         J1.SetElement(0, 1, +(1 - coord.y) * (1 - coord.z) * (-1 + 2 * coord.x - coord.y - coord.z) / 8);
@@ -310,17 +310,17 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
     /// Computes the matrix of partial derivatives and puts data in "MatrB"
     ///	evaluated at natural coordinates zeta1,...,zeta4 . Also computes determinant of jacobian.
     /// note: in case of hexahedral elements natural coord. vary in the range -1 ... +1
-    virtual void ComputeMatrB(ChMatrixDynamic<>& MatrB, double zeta1, double zeta2, double zeta3, double& JacobianDet) {
-        ChMatrixDynamic<> Jacobian(3, 3);
-        ChMatrixDynamic<> J1(3, 20);
+    virtual void ComputeMatrB(ChMatrix<>& MatrB, double zeta1, double zeta2, double zeta3, double& JacobianDet) {
+        ChMatrixNM<double, 3, 3> Jacobian;
+        ChMatrixNM<double, 3, 20> J1;
         ComputeJacobian(Jacobian, J1, ChVector<>(zeta1, zeta2, zeta3));
 
         double Jdet = Jacobian.Det();
         JacobianDet = Jdet;  // !!! store the Jacobian Determinant: needed for the integration
 
-        ChMatrixDynamic<> Jinv = Jacobian;
+        ChMatrixNM<double, 3, 3> Jinv = Jacobian;
         Jinv.MatrInverse();
-        ChMatrixDynamic<> Btemp(3, 20);
+        ChMatrixNM<double, 3, 20> Btemp;
         Btemp.MatrMultiply(Jinv, J1);
         MatrB.Resize(6, 60);  // Remember to resize the matrix!
 
@@ -693,11 +693,11 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
     /// The tensor is in the original undeformed unrotated reference.
     ChStrainTensor<> GetStrain(double z1, double z2, double z3) {
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 60, 1> displ;
         this->GetStateBlock(displ);
 
         double JacobianDet;
-        ChMatrixDynamic<> amatrB(6, GetNdofs());
+        ChMatrixNM<double, 6, 60> amatrB;
         ComputeMatrB(amatrB, z1, z2, z3, JacobianDet);
 
         ChStrainTensor<> mstrain;
@@ -720,18 +720,16 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
 
         // warp the local stiffness matrix K in order to obtain global
         // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(GetNdofs(), GetNdofs());
-        ChMatrixDynamic<> CKCt(GetNdofs(), GetNdofs());  // the global, corotated, K matrix, for 20 nodes
+        // (the global, corotated, K matrix for 20 nodes is written directly in H)
+        ChMatrixNM<double, 60, 60> CK;
         ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 20, CK);
-        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 20, CKCt);
+        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 20, H);
 
         // For K stiffness matrix and R damping matrix:
 
         double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
 
-        CKCt.MatrScale(mkfactor);
-
-        H.PasteMatrix(&CKCt, 0, 0);
+        H.MatrScale(mkfactor);
 
         // For M mass matrix:
         if (Mfactor) {
@@ -751,17 +749,17 @@ class ChApiFea ChElementHexa_20 : public ChElementHexahedron, public ChLoadableU
         assert((Fi.GetRows() == GetNdofs()) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 60, 1> displ;
         this->GetStateBlock(displ);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(GetNdofs(), 1);
+        ChMatrixNM<double, 60, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         for (int in = 0; in < 20; ++in) {
             displ.PasteVector(A.MatrT_x_Vect(nodes[in]->pos_dt), in * 3, 0);  // nodal speeds, local
         }
-        ChMatrixDynamic<> FiR_local(GetNdofs(), 1);
+        ChMatrixNM<double, 60, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
@@ -108,7 +108,7 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(this->GetNdofs(), 1);
 
         for (int i = 0; i < GetNnodes(); i++)
@@ -118,8 +118,8 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
     /// Puts inside 'Jacobian' and 'J1' the Jacobian matrix and the shape functions derivatives matrix of the element.
     /// The vector "coord" contains the natural coordinates of the integration point.
     /// in case of hexahedral elements natural coords vary in the classical range -1 ... +1.
-    virtual void ComputeJacobian(ChMatrixDynamic<>& Jacobian, ChMatrixDynamic<>& J1, ChVector<> coord) {
-        ChMatrixDynamic<> J2(8, 3);
+    virtual void ComputeJacobian(ChMatrix<>& Jacobian, ChMatrix<>& J1, ChVector<> coord) {
+        ChMatrixNM<double, 8, 3> J2;
 
         J1.SetElement(0, 0, -(1 - coord.y) * (1 - coord.z) / 8);
         J1.SetElement(0, 1, +(1 - coord.y) * (1 - coord.z) / 8);
@@ -181,18 +181,18 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
     /// Computes the matrix of partial derivatives and puts data in "MatrB"
     ///	evaluated at natural coordinates zeta1,...,zeta4 . Also computes determinant of jacobian.
     /// note: in case of hexahedral elements natural coord. vary in the range -1 ... +1
-    virtual void ComputeMatrB(ChMatrixDynamic<>& MatrB, double zeta1, double zeta2, double zeta3, double& JacobianDet) {
-        ChMatrixDynamic<> Jacobian(3, 3);
-        ChMatrixDynamic<> J1(3, 8);
+    virtual void ComputeMatrB(ChMatrix<>& MatrB, double zeta1, double zeta2, double zeta3, double& JacobianDet) {
+        ChMatrixNM<double, 3, 3> Jacobian;
+        ChMatrixNM<double, 3, 8> J1;
         ComputeJacobian(Jacobian, J1, ChVector<>(zeta1, zeta2, zeta3));
 
         double Jdet = Jacobian.Det();
         JacobianDet = Jdet;  // !!! store the Jacobian Determinant: needed for the integration
 
-        ChMatrixDynamic<> Jinv = Jacobian;
+        ChMatrixNM<double, 3, 3> Jinv = Jacobian;
         Jinv.MatrInverse();
 
-        ChMatrixDynamic<> Btemp(3, 8);
+        ChMatrixNM<double, 3, 8> Btemp;
         Btemp.MatrMultiply(Jinv, J1);
         MatrB.Resize(6, 24);  // Remember to resize the matrix!
 
@@ -342,11 +342,11 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
     /// The tensor is in the original undeformed unrotated reference.
     ChStrainTensor<> GetStrain(double z1, double z2, double z3) {
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> displ;
         this->GetStateBlock(displ);
 
         double JacobianDet;
-        ChMatrixDynamic<> amatrB(6, GetNdofs());
+        ChMatrixNM<double, 6, 24> amatrB;
         ComputeMatrB(amatrB, z1, z2, z3, JacobianDet);
 
         ChStrainTensor<> mstrain;
@@ -369,18 +369,16 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
 
         // warp the local stiffness matrix K in order to obtain global
         // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(GetNdofs(), GetNdofs());
-        ChMatrixDynamic<> CKCt(GetNdofs(), GetNdofs());  // the global, corotated, K matrix, for 8 nodes
+        // (the global, corotated, K matrix for 8 nodes is written directly in H)
+        ChMatrixNM<double, 24, 24> CK;
         ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 8, CK);
-        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 8, CKCt);
+        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 8, H);
 
         // For K stiffness matrix and R damping matrix:
 
         double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
 
-        CKCt.MatrScale(mkfactor);
-
-        H.PasteMatrix(&CKCt, 0, 0);
+        H.MatrScale(mkfactor);
 
         // For M mass matrix:
         if (Mfactor) {
@@ -400,17 +398,17 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         assert((Fi.GetRows() == GetNdofs()) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> displ;
         this->GetStateBlock(displ);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         for (int in = 0; in < 8; ++in) {
             displ.PasteVector(A.MatrT_x_Vect(nodes[in]->pos_dt), in * 3, 0);  // nodal speeds, local
         }
-        ChMatrixDynamic<> FiR_local(GetNdofs(), 1);
+        ChMatrixNM<double, 24, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
@@ -120,7 +120,7 @@ void ChElementShellANCF::Update() {
 }
 
 // Fill the D vector with the current field values at the element nodes.
-void ChElementShellANCF::GetStateBlock(ChMatrixDynamic<>& mD) {
+void ChElementShellANCF::GetStateBlock(ChMatrix<>& mD) {
     mD.PasteVector(m_nodes[0]->GetPos(), 0, 0);
     mD.PasteVector(m_nodes[0]->GetD(), 3, 0);
     mD.PasteVector(m_nodes[1]->GetPos(), 6, 0);
@@ -241,7 +241,7 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     // nodes of the element, with proper ordering.
     // If the D vector has not the size of this->GetNdofs(), it will be resized.
     //  {x_a y_a z_a Dx_a Dx_a Dx_a x_b y_b z_b Dx_b Dy_b Dz_b}
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) override;
+    virtual void GetStateBlock(ChMatrix<>& mD) override;
 
     // Set H as a linear combination of M, K, and R.
     //   H = Mfactor * [M] + Kfactor * [K] + Rfactor * [R],
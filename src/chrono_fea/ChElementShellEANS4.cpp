@@ -785,7 +785,7 @@ void ChElementShellEANS4::Update() {
 }
 
 // Fill the D vector with the current field values at the element nodes.
-void ChElementShellEANS4::GetStateBlock(ChMatrixDynamic<>& mD) {
+void ChElementShellEANS4::GetStateBlock(ChMatrix<>& mD) {
     mD.Reset(4*7, 1);
     mD.PasteVector(m_nodes[0]->GetPos(), 0, 0);
     mD.PasteQuaternion(m_nodes[0]->GetRot(), 3, 0);
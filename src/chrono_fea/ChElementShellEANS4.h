@@ -441,7 +441,7 @@ public:
     // nodes of the element, with proper ordering.
     // If the D vector has not the size of this->GetNdofs_x(), it will be resized.
     //  {x_a y_a z_a Rx_a Rx_a Rx_a x_b y_b z_b Rx_b Ry_b Rz_b}
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) override;
+    virtual void GetStateBlock(ChMatrix<>& mD) override;
 
     // Set H as a linear combination of M, K, and R.
     //   H = Mfactor * [M] + Kfactor * [K] + Rfactor * [R],
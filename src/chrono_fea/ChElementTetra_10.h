@@ -113,7 +113,7 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(this->GetNdofs(), 1);
 
         for (int i = 0; i < GetNnodes(); i++)
@@ -127,7 +127,7 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
         B1.Sub(nodes[1]->pos, nodes[0]->pos);
         C1.Sub(nodes[2]->pos, nodes[0]->pos);
         D1.Sub(nodes[3]->pos, nodes[0]->pos);
-        ChMatrixDynamic<> M(3, 3);
+        ChMatrixNM<double, 3, 3> M;
         M.PasteVector(B1, 0, 0);
         M.PasteVector(C1, 0, 1);
         M.PasteVector(D1, 0, 2);
@@ -139,7 +139,7 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
     /// Puts inside 'Jacobian' the Jacobian matrix of the element
     /// zeta1,...,zeta4 are the four natural coordinates of the integration point
     /// note: in case of tetrahedral elements natural coord. vary in the range 0 ... +1
-    virtual void ComputeJacobian(ChMatrixDynamic<>& Jacobian, double zeta1, double zeta2, double zeta3, double zeta4) {
+    virtual void ComputeJacobian(ChMatrix<>& Jacobian, double zeta1, double zeta2, double zeta3, double zeta4) {
         Jacobian.FillElem(1);
 
         Jacobian.SetElement(1, 0, 4 * (nodes[0]->pos.x * (zeta1 - 1 / 4) + nodes[4]->pos.x * zeta2 +
@@ -171,13 +171,13 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
     /// Computes the matrix of partial derivatives and puts data in "mmatrB"
     ///	evaluated at natural coordinates zeta1,...,zeta4
     /// note: in case of tetrahedral elements natural coord. vary in the range 0 ... +1
-    virtual void ComputeMatrB(ChMatrixDynamic<>& mmatrB,
+    virtual void ComputeMatrB(ChMatrix<>& mmatrB,
                               double zeta1,
                               double zeta2,
                               double zeta3,
                               double zeta4,
                               double& JacobianDet) {
-        ChMatrixDynamic<> Jacobian(4, 4);
+        ChMatrixNM<double, 4, 4> Jacobian;
         ComputeJacobian(Jacobian, zeta1, zeta2, zeta3, zeta4);
 
         double Jdet = Jacobian.Det();
@@ -547,11 +547,11 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
     /// The tensor is in the original undeformed unrotated reference.
     ChStrainTensor<> GetStrain(double z1, double z2, double z3, double z4) {
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 30, 1> displ;
         this->GetStateBlock(displ);
 
         double JacobianDet;
-        ChMatrixDynamic<> amatrB(6, GetNdofs());
+        ChMatrixNM<double, 6, 30> amatrB;
         ComputeMatrB(amatrB, z1, z2, z3, z4, JacobianDet);
 
         ChStrainTensor<> mstrain;
@@ -610,18 +610,16 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
 
         // warp the local stiffness matrix K in order to obtain global
         // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(GetNdofs(), GetNdofs());
-        ChMatrixDynamic<> CKCt(GetNdofs(), GetNdofs());  // the global, corotated, K matrix
+        // (the global, corotated, K matrix is written directly in H)
+        ChMatrixNM<double, 30, 30> CK;
         ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 10, CK);
-        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 10, CKCt);
+        ChMatrixCorotation<>::ComputeKCt(CK, this->A, 10, H);
 
         // For K stiffness matrix and R damping matrix:
 
         double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
 
-        CKCt.MatrScale(mkfactor);
-
-        H.PasteMatrix(&CKCt, 0, 0);
+        H.MatrScale(mkfactor);
 
         // For M mass matrix:
         if (Mfactor) {
@@ -641,11 +639,11 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
         assert((Fi.GetRows() == GetNdofs()) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(GetNdofs(), 1);
+        ChMatrixNM<double, 30, 1> displ;
         this->GetStateBlock(displ);
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(GetNdofs(), 1);
+        ChMatrixNM<double, 30, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         displ.PasteVector(A.MatrT_x_Vect(nodes[0]->pos_dt), 0, 0);  // nodal speeds, local
@@ -658,7 +656,7 @@ class ChApiFea ChElementTetra_10 : public ChElementTetrahedron, public ChLoadabl
         displ.PasteVector(A.MatrT_x_Vect(nodes[7]->pos_dt), 21, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[8]->pos_dt), 24, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[9]->pos_dt), 27, 0);
-        ChMatrixDynamic<> FiR_local(GetNdofs(), 1);
+        ChMatrixNM<double, 30, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
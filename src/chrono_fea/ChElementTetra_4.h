@@ -90,7 +90,7 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(this->GetNdofs(), 1);
         mD.PasteVector(A.MatrT_x_Vect(nodes[0]->pos) - nodes[0]->GetX0(), 0, 0);
         mD.PasteVector(A.MatrT_x_Vect(nodes[1]->pos) - nodes[1]->GetX0(), 3, 0);
@@ -103,7 +103,7 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         B1.Sub(nodes[1]->pos, nodes[0]->pos);
         C1.Sub(nodes[2]->pos, nodes[0]->pos);
         D1.Sub(nodes[3]->pos, nodes[0]->pos);
-        ChMatrixDynamic<> M(3, 3);
+        ChMatrixNM<double, 3, 3> M;
         M.PasteVector(B1, 0, 0);
         M.PasteVector(C1, 0, 1);
         M.PasteVector(D1, 0, 2);
@@ -239,8 +239,8 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
 
         // warp the local stiffness matrix K in order to obtain global
         // tangent stiffness CKCt:
-        ChMatrixDynamic<> CK(12, 12);
-        ChMatrixDynamic<> CKCt(12, 12);  // the global, corotated, K matrix
+        ChMatrixNM<double, 12, 12> CK;
+        ChMatrixNM<double, 12, 12> CKCt;  // the global, corotated, K matrix
         ChMatrixCorotation<>::ComputeCK(StiffnessMatrix, this->A, 4, CK);
         ChMatrixCorotation<>::ComputeKCt(CK, this->A, 4, CKCt);
         /*
@@ -342,18 +342,18 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         assert((Fi.GetRows() == 12) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(12, 1);
+        ChMatrixNM<double, 12, 1> displ;
         this->GetStateBlock(displ);  // nodal displacements, local
 
         // [local Internal Forces] = [Klocal] * displ + [Rlocal] * displ_dt
-        ChMatrixDynamic<> FiK_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         displ.PasteVector(A.MatrT_x_Vect(nodes[0]->pos_dt), 0, 0);  // nodal speeds, local
         displ.PasteVector(A.MatrT_x_Vect(nodes[1]->pos_dt), 3, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[2]->pos_dt), 6, 0);
         displ.PasteVector(A.MatrT_x_Vect(nodes[3]->pos_dt), 9, 0);
-        ChMatrixDynamic<> FiR_local(12, 1);
+        ChMatrixNM<double, 12, 1> FiR_local;
         FiR_local.MatrMultiply(StiffnessMatrix, displ);
         FiR_local.MatrScale(this->Material->Get_RayleighDampingK());
 
@@ -387,7 +387,7 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
     /// The tensor is in the original undeformed unrotated reference.
     ChStrainTensor<> GetStrain() {
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(12, 1);
+        ChMatrixNM<double, 12, 1> displ;
         this->GetStateBlock(displ);  // nodal displacements, local
 
         ChStrainTensor<> mstrain;
@@ -566,7 +566,7 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
     /// field values at the nodes of the element, with proper ordering.
     /// If the D vector has not the size of this->GetNdofs(), it will be resized.
     /// For corotational elements, field is assumed in local reference!
-    virtual void GetStateBlock(ChMatrixDynamic<>& mD) {
+    virtual void GetStateBlock(ChMatrix<>& mD) {
         mD.Reset(this->GetNdofs(), 1);
         mD(0) = nodes[0]->GetP();
         mD(1) = nodes[1]->GetP();
@@ -579,7 +579,7 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
         B1.Sub(nodes[1]->GetPos(), nodes[0]->GetPos());
         C1.Sub(nodes[2]->GetPos(), nodes[0]->GetPos());
         D1.Sub(nodes[3]->GetPos(), nodes[0]->GetPos());
-        ChMatrixDynamic<> M(3, 3);
+        ChMatrixNM<double, 3, 3> M;
         M.PasteVector(B1, 0, 0);
         M.PasteVector(C1, 0, 1);
         M.PasteVector(D1, 0, 2);
@@ -669,7 +669,8 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
 
         // For K  matrix (jacobian d/dT of  c dT/dt + div [C] grad T = f )
 
-        ChMatrixDynamic<> mK(this->StiffnessMatrix);  // local copy of stiffness
+        ChMatrixNM<double, 4, 4> mK;  // local copy of stiffness
+        mK.CopyFromMatrix(this->StiffnessMatrix);
         mK.MatrScale(Kfactor);
 
         H.PasteMatrix(&mK, 0, 0);
@@ -694,11 +695,11 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
         assert((Fi.GetRows() == 4) && (Fi.GetColumns() == 1));
 
         // set up vector of nodal fields
-        ChMatrixDynamic<> displ(4, 1);
+        ChMatrixNM<double, 4, 1> displ;
         this->GetStateBlock(displ);
 
         // [local Internal Forces] = [Klocal] * P
-        ChMatrixDynamic<> FiK_local(4, 1);
+        ChMatrixNM<double, 4, 1> FiK_local;
         FiK_local.MatrMultiply(StiffnessMatrix, displ);
 
         //***TO DO*** derivative terms? + [Rlocal] * P_dt ???? ***NO because Poisson  rho dP/dt + div [C] grad P = 0
@@ -727,7 +728,7 @@ class ChApiFea ChElementTetra_4_P : public ChElementTetrahedron, public ChLoadab
     /// It is in the original undeformed unrotated reference.
     ChMatrixNM<double, 3, 1> GetPgradient() {
         // set up vector of nodal displacements (in local element system) u_l = R*p - p0
-        ChMatrixDynamic<> displ(4, 1);
+        ChMatrixNM<double, 4, 1> displ;
         this->GetStateBlock(displ);
 
         ChMatrixNM<double, 3, 1> mPgrad;
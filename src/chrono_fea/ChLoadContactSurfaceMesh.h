@@ -183,27 +183,77 @@ class ChApiFea ChLoadContactSurfaceMesh : public ChLoadBase {
     virtual int LoadGet_field_ncoords() { return 3; }
 
     /// Compute Q, the generalized load.
+    /// Each force is evaluated with the part of the state of its node.
     virtual void ComputeQ(ChState* state_x,      ///< state position to evaluate Q
                           ChStateDelta* state_w  ///< state speed to evaluate Q
                           ) {
+        int offset_x = 0;
+        int offset_w = 0;
         for (int i = 0; i < forces.size(); ++i) {
-            forces[i]->ComputeQ(state_x, state_w);
+            int ndof_x = forces[i]->LoadGet_ndof_x();
+            int ndof_w = forces[i]->LoadGet_ndof_w();
+            ChState mstate_x(ndof_x, 0);
+            ChStateDelta mstate_w(ndof_w, 0);
+            if (state_x)
+                mstate_x.PasteClippedMatrix(state_x, offset_x, 0, ndof_x, 1, 0, 0);
+            if (state_w)
+                mstate_w.PasteClippedMatrix(state_w, offset_w, 0, ndof_w, 1, 0, 0);
+            forces[i]->ComputeQ(state_x ? &mstate_x : 0, state_w ? &mstate_w : 0);
+            offset_x += ndof_x;
+            offset_w += ndof_w;
         }
     }
 
     /// Compute jacobians.
-    /// Not needed when forces are constant, btw.
+    /// The force on a node depends only on the state of that node, so the jacobians are
+    /// block diagonal, with the jacobians of each force (null, for constant forces).
     virtual void ComputeJacobian(ChState* state_x,       ///< state position to evaluate jacobians
                                  ChStateDelta* state_w,  ///< state speed to evaluate jacobians
                                  ChMatrix<>& mK,         ///< result dQ/dx
                                  ChMatrix<>& mR,         ///< result dQ/dv
                                  ChMatrix<>& mM)         ///< result dQ/da
     {
+        mK.FillElem(0);
+        mR.FillElem(0);
+        mM.FillElem(0);
+        int offset_x = 0;
+        int offset_w = 0;
         for (int i = 0; i < forces.size(); ++i) {
-            forces[i]->ComputeJacobian(state_x, state_w, mK, mR, mM);
+            int ndof_x = forces[i]->LoadGet_ndof_x();
+            int ndof_w = forces[i]->LoadGet_ndof_w();
+            ChState mstate_x(ndof_x, 0);
+            ChStateDelta mstate_w(ndof_w, 0);
+            if (state_x)
+                mstate_x.PasteClippedMatrix(state_x, offset_x, 0, ndof_x, 1, 0, 0);
+            if (state_w)
+                mstate_w.PasteClippedMatrix(state_w, offset_w, 0, ndof_w, 1, 0, 0);
+            ChMatrixDynamic<> mKi(ndof_w, ndof_w);
+            ChMatrixDynamic<> mRi(ndof_w, ndof_w);
+            ChMatrixDynamic<> mMi(ndof_w, ndof_w);
+            forces[i]->ComputeJacobian(state_x ? &mstate_x : 0, state_w ? &mstate_w : 0, mKi, mRi, mMi);
+            mK.PasteMatrix(&mKi, offset_w, offset_w);
+            mR.PasteMatrix(&mRi, offset_w, offset_w);
+            mM.PasteMatrix(&mMi, offset_w, offset_w);
+            offset_x += ndof_x;
+            offset_w += ndof_w;
         }
     }
 
+    /// One block of coordinates per force: the force on a node depends only on that node.
+    virtual bool GetJacobianSparsity(std::vector<int>& block_offsets_x,
+                                     std::vector<int>& block_offsets_w,
+                                     std::vector<std::vector<int> >& block_deps) {
+        block_offsets_x.assign(1, 0);
+        block_offsets_w.assign(1, 0);
+        block_deps.resize(forces.size());
+        for (int i = 0; i < forces.size(); ++i) {
+            block_offsets_x.push_back(block_offsets_x.back() + forces[i]->LoadGet_ndof_x());
+            block_offsets_w.push_back(block_offsets_w.back() + forces[i]->LoadGet_ndof_w());
+            block_deps[i].assign(1, i);
+        }
+        return true;
+    }
+
     virtual bool IsStiff() { return false; }
 
     virtual void CreateJacobianMatrices() {
@@ -65,6 +65,23 @@ class ChMatrixCorotation {
                            const std::vector<ChMatrix33<Real>*>& R,  /// 3x3 rotation matrices (used transposed)
                            const int nblocks,                        /// number of rotation blocks
                            ChMatrix<Real>& KC);                      /// result matrix: C*K
+
+    /// Perform a corotation (warping) of a K matrix by pre-multiplying
+    /// it with a C matrix; C has 3x3 rotation matrices R as diagonal blocks
+    /// (generic version with different rotations, given as an array of nblocks
+    /// pointers, so that the caller does not need to allocate a std::vector)
+    static void ComputeCK(const ChMatrix<Real>& K,          /// matrix to pre-corotate
+                          ChMatrix33<Real>* const* R,       /// 3x3 rotation matrices
+                          const int nblocks,                /// number of rotation blocks
+                          ChMatrix<Real>& CK);              /// result matrix: C*K
+
+    /// Perform a corotation (warping) of a K matrix by post-multiplying
+    /// it with a transposed C matrix; C has 3x3 rotation matrices R as diagonal blocks
+    /// (generic version with different rotations, given as an array of nblocks pointers)
+    static void ComputeKCt(const ChMatrix<Real>& K,          /// matrix to post-corotate
+                           ChMatrix33<Real>* const* R,       /// 3x3 rotation matrices (used transposed)
+                           const int nblocks,                /// number of rotation blocks
+                           ChMatrix<Real>& KC);              /// result matrix: C*K
 };
 
 /// Perform a corotation (warping) of a K matrix by pre-multiplying
@@ -114,6 +131,16 @@ void ChMatrixCorotation<Real>::ComputeCK(const ChMatrix<Real>& K,
                                          const std::vector<ChMatrix33<Real>*>& R,  /// 3x3 rotation matrices
                                          const int nblocks,                        /// number of rotation blocks
                                          ChMatrix<Real>& CK)                       /// result matrix: C*K
+{
+    ComputeCK(K, R.data(), nblocks, CK);
+}
+
+/// generic version, rotations given as an array of pointers
+template <class Real>
+void ChMatrixCorotation<Real>::ComputeCK(const ChMatrix<Real>& K,     /// matrix to corotate
+                                         ChMatrix33<Real>* const* R,  /// 3x3 rotation matrices
+                                         const int nblocks,           /// number of rotation blocks
+                                         ChMatrix<Real>& CK)          /// result matrix: C*K
 {
     for (int iblock = 0; iblock < nblocks; iblock++) {
         const ChMatrix33<>* mR = R[iblock];
@@ -136,6 +163,16 @@ void ChMatrixCorotation<Real>::ComputeKCt(
     const std::vector<ChMatrix33<Real>*>& R,  /// 3x3 rotation matrices (used transposed)
     const int nblocks,                        /// number of rotation blocks
     ChMatrix<Real>& KC)                       /// result matrix: C*K
+{
+    ComputeKCt(K, R.data(), nblocks, KC);
+}
+
+/// generic version, rotations given as an array of pointers
+template <class Real>
+void ChMatrixCorotation<Real>::ComputeKCt(const ChMatrix<Real>& K,     /// matrix to corotate
+                                          ChMatrix33<Real>* const* R,  /// 3x3 rotation matrices (used transposed)
+                                          const int nblocks,           /// number of rotation blocks
+                                          ChMatrix<Real>& KC)          /// result matrix: C*K
 {
     for (int iblock = 0; iblock < nblocks; iblock++) {
         const ChMatrix33<>* mR = R[iblock];
@@ -444,6 +444,20 @@ void ChCSR3Matrix::GetMemoryInfo() const {
            static_cast<double>((2 * colIndex_occupancy * sizeof(double) + rowIndex_occupancy * sizeof(int))) / 1000000);
 }
 
+void ChCSR3Matrix::GetSparsityPattern(std::vector<int>& rowIndex_out, std::vector<int>& colIndex_out) const {
+    rowIndex_out.assign(rowIndex, rowIndex + rows + 1);
+    colIndex_out.assign(colIndex, colIndex + rowIndex[rows]);
+}
+
+bool ChCSR3Matrix::IsSparsityPatternEqual(const std::vector<int>& rowIndex_in,
+                                          const std::vector<int>& colIndex_in) const {
+    if (rowIndex_in.size() != static_cast<size_t>(rows + 1) ||
+        colIndex_in.size() != static_cast<size_t>(rowIndex[rows]))
+        return false;
+    return std::equal(rowIndex, rowIndex + rows + 1, rowIndex_in.begin()) &&
+           std::equal(colIndex, colIndex + rowIndex[rows], colIndex_in.begin());
+}
+
 // Verify Matrix; output:
 //  3 - warning message: in the row there are no initialized elements
 //  1 - warning message: the matrix is not compressed
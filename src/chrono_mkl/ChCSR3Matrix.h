@@ -2,6 +2,7 @@
 #define CHCSR3MATRIX_H
 
 #include <limits>
+#include <vector>
 
 #include "chrono/core/ChSparseMatrix.h"
 #include "chrono_mkl/ChApiMkl.h"
@@ -142,6 +143,10 @@ class ChApiMkl ChCSR3Matrix : public ChSparseMatrix {
     int GetColIndexMemOccupancy() const { return colIndex_occupancy; };
     int GetRowIndexMemOccupancy() const { return rowIndex_occupancy; };
     void GetNonZerosDistribution(int* nonzeros_vector) const;
+    /// Copy the sparsity pattern (rowIndex and colIndex arrays) into the given vectors.
+    void GetSparsityPattern(std::vector<int>& rowIndex_out, std::vector<int>& colIndex_out) const;
+    /// Return true if the sparsity pattern is identical to the one stored with GetSparsityPattern().
+    bool IsSparsityPatternEqual(const std::vector<int>& rowIndex_in, const std::vector<int>& colIndex_in) const;
     void SetMaxShifts(int max_shifts_new = std::numeric_limits<int>::max()) { max_shifts = max_shifts_new; };
     void SetRowIndexLock(bool on_off) { rowIndex_lock = on_off; }
     void SetColIndexLock(bool on_off) { colIndex_lock = on_off; }
@@ -22,10 +22,17 @@ ChSolverMKL::ChSolverMKL()
       use_perm(false),
       use_rhs_sparsity(false),
       manual_factorization(false),
-      nnz(0) {}
+      nnz(0),
+      reuse_symbolic(true),
+      symbolic_valid(false),
+      symbolic_symmetry(0),
+      pattern_cache_hits(0),
+      pattern_cache_misses(0) {}
 
 double ChSolverMKL::Solve(ChSystemDescriptor& sysd) {
-    if (!manual_factorization)
+    // The factorization is reused if requested by the caller (e.g. in modified Newton iterations),
+    // provided that at least one factorization was done.
+    if (!manual_factorization && !(reuse_factorization && solver_call > 0))
         Factorize(sysd);
 
     sysd.ConvertToMatrixForm(nullptr, &rhs);
@@ -88,6 +95,7 @@ double ChSolverMKL::Factorize(ChSystemDescriptor& sysd) {
     }
 
     // remember: the matrix is constructed with broken locks; so for solver_call==0 they are broken!
+    bool pattern_updated = false;
     if (!sparsity_pattern_lock || matCSR3.IsRowIndexLockBroken() || matCSR3.IsColIndexLockBroken()) {
         // breaking the row_index_block means that the size has changed so every dimension has to be reset
         if (matCSR3.IsRowIndexLockBroken()) {
@@ -99,13 +107,20 @@ double ChSolverMKL::Factorize(ChSystemDescriptor& sysd) {
         // if sparsity is not locked OR the sparsity_lock is broken (like in the first cycle!); the matrix must be
         // recompressed
         matCSR3.Compress();
-
-        // the permutation vector is based on the sparsity of the matrix;
-        // if ColIndexLockBroken/RowIndexLockBroken are on then the permutation must be updated
-        if (use_perm)
-            mkl_engine.UsePermutationVector(true);
+        pattern_updated = true;
     }
 
+    // The analysis and reordering phases of Pardiso depend only on the sparsity pattern:
+    // if the pattern is the same as in the last symbolic factorization, only the numeric factorization is done.
+    // An unbroken lock guarantees that the pattern did not change; otherwise the (compressed) pattern is compared.
+    bool reuse = reuse_symbolic && symbolic_valid && static_cast<int>(matCSR3.GetSymmetry()) == symbolic_symmetry &&
+                 (!pattern_updated || matCSR3.IsSparsityPatternEqual(symbolic_rowIndex, symbolic_colIndex));
+
+    // the permutation vector is based on the sparsity of the matrix;
+    // if ColIndexLockBroken/RowIndexLockBroken are on then the permutation must be updated
+    if (pattern_updated && !reuse && use_perm)
+        mkl_engine.UsePermutationVector(true);
+
     // the sparsity of rhs must be updated at every cycle (am I wrong?)
     if (use_rhs_sparsity && !use_perm)
         mkl_engine.UsePartialSolution(2);
@@ -113,6 +128,22 @@ double ChSolverMKL::Factorize(ChSystemDescriptor& sysd) {
     // Solve with Pardiso Sparse Direct Solver
     // the problem size must be updated also in the Engine: this is done by SetProblem() itself.
     mkl_engine.SetProblem(matCSR3, rhs, sol);
+
+    if (reuse) {
+        pattern_cache_hits++;
+        int pardiso_message_phase22 = mkl_engine.PardisoCall(22, 0);
+
+        if (pardiso_message_phase22) {
+            GetLog() << "Pardiso factorize error code = " << pardiso_message_phase22 << "\n";
+            GetLog() << "Matrix verification code = " << matCSR3.VerifyMatrix() << "\n";
+            GetLog() << "Matrix MKL verification code = " << matCSR3.VerifyMatrixByMKL() << "\n";
+            symbolic_valid = false;
+        }
+
+        return pardiso_message_phase22;
+    }
+
+    pattern_cache_misses++;
     int pardiso_message_phase12 = mkl_engine.PardisoCall(12, 0);
 
     if (pardiso_message_phase12) {
@@ -121,6 +152,13 @@ double ChSolverMKL::Factorize(ChSystemDescriptor& sysd) {
         GetLog() << "Matrix MKL verification code = " << matCSR3.VerifyMatrixByMKL() << "\n";
     }
 
+    // Store the sparsity pattern of this symbolic factorization, for comparison in the next calls.
+    symbolic_valid = reuse_symbolic && !pardiso_message_phase12;
+    if (symbolic_valid) {
+        symbolic_symmetry = static_cast<int>(matCSR3.GetSymmetry());
+        matCSR3.GetSparsityPattern(symbolic_rowIndex, symbolic_colIndex);
+    }
+
     return pardiso_message_phase12;
 }
 
@@ -12,6 +12,8 @@
 #ifndef CHSOLVERMKL_H
 #define CHSOLVERMKL_H
 
+#include <vector>
+
 #include "chrono/core/ChMatrixDynamic.h"
 #include "chrono/solver/ChSolver.h"
 #include "chrono/solver/ChSystemDescriptor.h"
@@ -48,6 +50,14 @@ class ChApiMkl ChSolverMKL : public ChSolver {
     bool use_rhs_sparsity;
     bool manual_factorization;
 
+    bool reuse_symbolic;                 ///< reuse the symbolic factorization if the sparsity pattern is unchanged
+    bool symbolic_valid;                 ///< a symbolic factorization is available for reuse
+    int symbolic_symmetry;               ///< matrix symmetry at the last symbolic factorization
+    std::vector<int> symbolic_rowIndex;  ///< sparsity pattern at the last symbolic factorization
+    std::vector<int> symbolic_colIndex;
+    size_t pattern_cache_hits;    ///< factorizations that reused the symbolic factorization
+    size_t pattern_cache_misses;  ///< factorizations that performed the symbolic factorization
+
   public:
     ChSolverMKL();
     virtual ~ChSolverMKL() {}
@@ -66,6 +76,18 @@ class ChApiMkl ChSolverMKL : public ChSolver {
     /// must be preceded by a ::Factorize(ChSystemDescriptor&) call.
     void SetManualFactorization(bool on_off) { manual_factorization = on_off; }
     void SetMatrixNNZ(size_t nnz_input) { nnz = nnz_input; };
+    /// If \a on_off is set to \c true (default) then ::Factorize(ChSystemDescriptor&) compares the sparsity
+    /// pattern of the assembled matrix with the one of the last symbolic factorization; if they are identical
+    /// (e.g. the set of variables, constraints and stiffness blocks did not change) the Pardiso analysis and
+    /// reordering are skipped and only the numeric factorization is done (phase 22 instead of 12).
+    void SetReuseSymbolicFactorization(bool on_off) {
+        reuse_symbolic = on_off;
+        symbolic_valid = symbolic_valid && on_off;
+    }
+    /// Number of factorizations that reused the last symbolic factorization.
+    size_t GetPatternCacheHits() const { return pattern_cache_hits; }
+    /// Number of factorizations that performed a new symbolic factorization.
+    size_t GetPatternCacheMisses() const { return pattern_cache_misses; }
 
 
     /// Solve using the MKL Pardiso sparse direct solver.
@@ -76,6 +76,10 @@ struct host_container {
     host_vector<real3> aabb_min_rigid;  // List of bounding boxes minimum point
     host_vector<real3> aabb_max_rigid;  // List of bounding boxes maximum point
     host_vector<real3> convex_data;     // list of convex points
+    host_vector<real3> mesh_data;       // Vertices of the triangles of the mesh shapes
+    host_vector<real3> bvh_min_rigid;   // Bounding boxes of the BVH nodes of the mesh shapes
+    host_vector<real3> bvh_max_rigid;
+    host_vector<int2> bvh_node_rigid;   // Children or triangles of the BVH nodes
 
     // Contact data
     host_vector<real3> norm_rigid_rigid;
@@ -85,6 +89,7 @@ struct host_container {
     host_vector<real> erad_rigid_rigid;
     host_vector<int2> bids_rigid_rigid;
     host_vector<long long> pair_rigid_rigid;
+    host_vector<int> tri_rigid_rigid;  // Triangle of a mesh shape in contact (-1 if none)
 
     host_vector<real3> norm_rigid_fluid;
     host_vector<real3> cpta_rigid_fluid;
@@ -31,11 +31,25 @@ struct collision_measures {
     max_bounding_point = 0;
     global_origin = 0;
     bin_size_vec = 0;
+    coarse_bins_per_axis = I3(0);
+    coarse_bin_size_vec = 0;
+    num_shapes_coarse = 0;
+    num_pairs_fine = 0;
+    num_pairs_coarse = 0;
+    num_broadphase_rebuilds = 0;
+    num_broadphase_reuses = 0;
   }
-  real3 min_bounding_point;  // The minimal global bounding point
-  real3 max_bounding_point;  // The maximum global bounding point
-  real3 global_origin;       // The global zero point
-  real3 bin_size_vec;        // Vector holding bin sizes for each dimension
+  real3 min_bounding_point;    // The minimal global bounding point
+  real3 max_bounding_point;    // The maximum global bounding point
+  real3 global_origin;         // The global zero point
+  real3 bin_size_vec;          // Vector holding bin sizes for each dimension
+  int3 coarse_bins_per_axis;   // Resolution of the coarse grid (GRID_TWO_LEVEL only)
+  real3 coarse_bin_size_vec;   // Bin sizes of the coarse grid (GRID_TWO_LEVEL only)
+  uint num_shapes_coarse;      // Number of shapes binned on the coarse grid
+  uint num_pairs_fine;         // AABB pairs found on the fine (or uniform) grid
+  uint num_pairs_coarse;       // AABB pairs found on the coarse grid
+  uint num_broadphase_rebuilds;  // Total number of full broadphase passes
+  uint num_broadphase_reuses;    // Total number of steps that reused the previous pair list
 };
 // solver_measures, like the name implies is the structure that contains all
 // measures associated with the parallel solver.
@@ -44,10 +58,12 @@ struct solver_measures {
     total_iteration = 0;
     residual = 0;
     objective_value = 0;
+    num_warm_started = 0;
   }
-  int total_iteration;   // The total number of iterations performed, this variable accumulates
-  real residual;         // Current residual for the solver
-  real objective_value;  // Current objective value for the solver
+  int total_iteration;    // The total number of iterations performed, this variable accumulates
+  real residual;          // Current residual for the solver
+  real objective_value;   // Current objective value for the solver
+  uint num_warm_started;  // Contacts whose impulses were seeded with the ones of the last step
 
   // These three variables are used to store the convergence history of the solver
   custom_vector<real> maxd_hist, maxdeltalambda_hist;
@@ -137,6 +137,16 @@ enum NARROWPHASETYPE {
     NARROWPHASE_HYBRID_GJK
 };
 
+// Layout of the broadphase grid: a single uniform grid, or a fine grid for the
+// small shapes plus a coarse grid for the shapes that are large compared to the
+// fine bins.
+enum BROADPHASEGRIDTYPE { GRID_UNIFORM, GRID_TWO_LEVEL };
+
+// Accumulation of the DEM contact forces on the bodies: sort the per-contact
+// forces by body and reduce them by key, or bin them by body with a counting
+// sort and sum the forces of each body in parallel.
+enum DEMFORCEACCUMULATION { ACCUMULATE_SORT, ACCUMULATE_BINNED };
+
 // This is set so that parts of the code that have been "flattened" can know what
 // type of system is used.
 enum SYSTEMTYPE { SYSTEM_DVI, SYSTEM_DEM };
@@ -52,6 +52,10 @@ struct collision_settings {
     narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
     grid_density = 5;
     fixed_bins = true;
+    grid_type = GRID_UNIFORM;
+    grid_level_ratio = 2;
+    temporal_coherence = false;
+    coherence_margin = 0;
   }
 
   real3 min_bounding_point, max_bounding_point;
@@ -80,6 +84,21 @@ struct collision_settings {
   real grid_density;
   //use fixed number of bins instead of tuning them
   bool fixed_bins;
+  // With GRID_TWO_LEVEL, shapes whose largest AABB extent exceeds
+  // grid_level_ratio times the smallest fine bin size are binned on a coarse
+  // grid instead of the fine one. This keeps a few large shapes (walls,
+  // terrain, containers) from being replicated into thousands of fine bins.
+  // The coarse grid resolution is computed from grid_density and the number of
+  // large shapes; its bins are never smaller than grid_level_ratio fine bins.
+  BROADPHASEGRIDTYPE grid_type;
+  real grid_level_ratio;
+  // When temporal coherence is enabled, the broadphase bins the AABBs inflated
+  // by coherence_margin and keeps the resulting pair list for the following
+  // steps, as long as every AABB stays inside its inflated copy. This skips the
+  // binning, sorting and pair search for slowly moving systems (settled
+  // granular beds). If coherence_margin is zero the collision envelope is used.
+  bool temporal_coherence;
+  real coherence_margin;
 };
 // solver_settings, like the name implies is the structure that contains all
 // settings associated with the parallel solver.
@@ -119,6 +138,7 @@ struct solver_settings {
     use_material_properties = true;
     characteristic_vel = 1;
     min_slip_vel = 1e-4;
+    force_accumulation = ACCUMULATE_SORT;
   }
 
   // The solver type variable defines name of the solver that will be used to
@@ -182,6 +202,12 @@ struct solver_settings {
   real characteristic_vel;
   // Threshold tangential velocity
   real min_slip_vel;
+  // Accumulation of the DEM contact forces per body. ACCUMULATE_SORT sorts the
+  // two entries of each contact by body and reduces them. ACCUMULATE_BINNED
+  // avoids the sort: the entries are binned by body with a counting sort and the
+  // forces of each body are summed in the order of the contacts, which makes
+  // the result independent of the number of threads.
+  DEMFORCEACCUMULATION force_accumulation;
 
   // Along with setting the solver mode, the total number of iterations for each
   // type of constraints can be performed.
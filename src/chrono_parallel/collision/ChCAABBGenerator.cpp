@@ -150,6 +150,8 @@ void ChCAABBGenerator::GenerateAABB() {
   const host_vector<real3>& obj_data_C = data_manager->host_data.ObC_rigid;
   const host_vector<real4>& obj_data_R = data_manager->host_data.ObR_rigid;
   const host_vector<real3>& convex_data = data_manager->host_data.convex_data;
+  const host_vector<real3>& bvh_min = data_manager->host_data.bvh_min_rigid;
+  const host_vector<real3>& bvh_max = data_manager->host_data.bvh_max_rigid;
   const host_vector<real3>& body_pos = data_manager->host_data.pos_rigid;
   const host_vector<real4>& body_rot = data_manager->host_data.rot_rigid;
   uint num_rigid_shapes = data_manager->num_rigid_shapes;
@@ -194,6 +196,13 @@ void ChCAABBGenerator::GenerateAABB() {
       ComputeAABBConvex(convex_data.data(), B, A, position, rotation, temp_min, temp_max);
       temp_min -= collision_envelope;
       temp_max += collision_envelope;
+    } else if (type == TRIANGLEMESH_BVH) {
+      // Box of the root node of the mesh BVH
+      int root = int(B.z);
+      real3 center = (bvh_min[root] + bvh_max[root]) * 0.5;
+      real3 half = (bvh_max[root] - bvh_min[root]) * 0.5;
+      ComputeAABBBox(half + collision_envelope, A + quatRotate(center, obj_data_R[index]), position, obj_data_R[index],
+                     body_rot[id], temp_min, temp_max);
     } else {
       continue;
     }
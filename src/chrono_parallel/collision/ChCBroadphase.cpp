@@ -18,7 +18,12 @@ inline void function_Count_AABB_BIN_Intersection(const uint index,
                                                  const real3& inv_bin_size_vec,
                                                  const host_vector<real3>& aabb_min_data,
                                                  const host_vector<real3>& aabb_max_data,
+                                                 const bool include,
                                                  host_vector<uint>& bins_intersected) {
+  if (!include) {
+    bins_intersected[index] = 0;
+    return;
+  }
   int3 gmin = HashMin(aabb_min_data[index], inv_bin_size_vec);
   int3 gmax = HashMax(aabb_max_data[index], inv_bin_size_vec);
   bins_intersected[index] = (gmax.x - gmin.x + 1) * (gmax.y - gmin.y + 1) * (gmax.z - gmin.z + 1);
@@ -30,9 +35,13 @@ inline void function_Store_AABB_BIN_Intersection(const uint index,
                                                  const real3& inv_bin_size_vec,
                                                  const host_vector<real3>& aabb_min_data,
                                                  const host_vector<real3>& aabb_max_data,
+                                                 const bool include,
                                                  const host_vector<uint>& bins_intersected,
                                                  host_vector<uint>& bin_number,
                                                  host_vector<uint>& aabb_number) {
+  if (!include) {
+    return;
+  }
   uint count = 0, i, j, k;
   int3 gmin = HashMin(aabb_min_data[index], inv_bin_size_vec);
   int3 gmax = HashMax(aabb_max_data[index], inv_bin_size_vec);
@@ -57,6 +66,8 @@ inline void function_Count_AABB_AABB_Intersection(const uint index,
                                                   const host_vector<uint>& bin_number,
                                                   const host_vector<uint>& aabb_number,
                                                   const host_vector<uint>& bin_start_index,
+                                                  const host_vector<uint>& bin_num_lead,
+                                                  const bool use_lead,
                                                   const host_vector<short2>& fam_data,
                                                   const host_vector<bool>& body_active,
                                                   const host_vector<uint>& body_id,
@@ -69,7 +80,10 @@ inline void function_Count_AABB_AABB_Intersection(const uint index,
     num_contact[index] = 0;
     return;
   }
-  for (uint i = start; i < end; i++) {
+  // On the coarse level only the pairs involving one of the (leading) large
+  // shapes of the bin are tested
+  uint lead_end = use_lead ? start + bin_num_lead[index] : end;
+  for (uint i = start; i < lead_end; i++) {
     uint shapeA = aabb_number[i];
     real3 Amin = aabb_min_data[shapeA];
     real3 Amax = aabb_max_data[shapeA];
@@ -111,6 +125,8 @@ inline void function_Store_AABB_AABB_Intersection(const uint index,
                                                   const host_vector<uint>& bin_number,
                                                   const host_vector<uint>& aabb_number,
                                                   const host_vector<uint>& bin_start_index,
+                                                  const host_vector<uint>& bin_num_lead,
+                                                  const bool use_lead,
                                                   const host_vector<uint>& num_contact,
                                                   const host_vector<short2>& fam_data,
                                                   const host_vector<bool>& body_active,
@@ -125,7 +141,10 @@ inline void function_Store_AABB_AABB_Intersection(const uint index,
   uint offset = num_contact[index];
   uint count = 0;
 
-  for (uint i = start; i < end; i++) {
+  // On the coarse level only the pairs involving one of the (leading) large
+  // shapes of the bin are tested
+  uint lead_end = use_lead ? start + bin_num_lead[index] : end;
+  for (uint i = start; i < lead_end; i++) {
     uint shapeA = aabb_number[i];
     real3 Amin = aabb_min_data[shapeA];
     real3 Amax = aabb_max_data[shapeA];
@@ -151,14 +170,11 @@ inline void function_Store_AABB_AABB_Intersection(const uint index,
       if (!overlap(Amin, Amax, Bmin, Bmax))
         continue;
 
-      if (shapeB < shapeA) {
-        uint t = shapeA;
-        shapeA = shapeB;
-        shapeB = t;
-      }
-
-      // the two indices of the shapes that make up the contact
-      potential_contacts[offset + count] = ((long long)shapeA << 32 | (long long)shapeB);
+      // the two indices of the shapes that make up the contact, smallest first
+      // (shapeA is not changed, it is used by the next iterations)
+      uint lo = Min(shapeA, shapeB);
+      uint hi = Max(shapeA, shapeB);
+      potential_contacts[offset + count] = ((long long)lo << 32 | (long long)hi);
       count++;
     }
   }
@@ -174,23 +190,138 @@ ChCBroadphase::ChCBroadphase() {
 // use spatial subdivision to detect the list of POSSIBLE collisions
 // let user define their own narrow-phase collision detection
 void ChCBroadphase::DetectPossibleCollisions() {
+  collision_measures& measures = data_manager->measures.collision;
+  ChTimerParallel& timer = data_manager->system_timer;
+
+  if (data_manager->settings.collision.temporal_coherence && CanReusePairs()) {
+    timer.start("collision_broad_reuse");
+    // Keep the pair list and the grid of the last full pass, only bring the
+    // AABBs in the same frame as a full pass would
+    data_manager->host_data.pair_rigid_rigid = cached_pairs;
+    host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
+    host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
+    thrust::constant_iterator<real3> offset(measures.global_origin);
+    transform(aabb_min_rigid.begin(), aabb_min_rigid.end(), offset, aabb_min_rigid.begin(), thrust::minus<real3>());
+    transform(aabb_max_rigid.begin(), aabb_max_rigid.end(), offset, aabb_max_rigid.begin(), thrust::minus<real3>());
+    measures.num_broadphase_reuses++;
+    LOG(TRACE) << "Reusing " << number_of_contacts_possible << " possible collisions";
+    timer.stop("collision_broad_reuse");
+    return;
+  }
+
+  timer.start("collision_broad_rebuild");
+  if (data_manager->settings.collision.temporal_coherence) {
+    CachePairingBoxes();
+  } else {
+    cached_aabb_min.clear();
+    cached_aabb_max.clear();
+    cached_pairs.clear();
+  }
+  RebuildPairs();
+  if (data_manager->settings.collision.temporal_coherence) {
+    // The narrowphase compacts the pair list to the actual contacts, keep a copy
+    cached_pairs = data_manager->host_data.pair_rigid_rigid;
+    // Give the actual AABBs back to the narrowphase, in the frame of the grid
+    host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
+    host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
+    thrust::constant_iterator<real3> offset(measures.global_origin);
+    transform(actual_aabb_min.begin(), actual_aabb_min.end(), offset, aabb_min_rigid.begin(), thrust::minus<real3>());
+    transform(actual_aabb_max.begin(), actual_aabb_max.end(), offset, aabb_max_rigid.begin(), thrust::minus<real3>());
+  }
+  measures.num_broadphase_rebuilds++;
+  timer.stop("collision_broad_rebuild");
+}
+// =========================================================================================================
+// The pair list of the last full pass contains all the pairs whose inflated
+// AABBs overlap. It is still complete if each AABB is contained in its inflated
+// copy, and if no shape changed family or activity.
+bool ChCBroadphase::CanReusePairs() {
+  const host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
+  const host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
+  const host_vector<short2>& fam_data = data_manager->host_data.fam_rigid;
+  const host_vector<bool>& obj_active = data_manager->host_data.active_rigid;
+  uint num_shapes = data_manager->num_rigid_shapes;
+  uint num_bodies = data_manager->num_rigid_bodies;
+
+  if (cached_aabb_min.size() != num_shapes || cached_active.size() != num_bodies ||
+      cached_pairs.size() != number_of_contacts_possible) {
+    return false;
+  }
+
+  for (int i = 0; i < num_bodies; i++) {
+    if (cached_active[i] != char(obj_active[i]))
+      return false;
+  }
+
+  uint num_changed = 0;
+#pragma omp parallel for reduction(+ : num_changed)
+  for (int i = 0; i < num_shapes; i++) {
+    real3 amin = aabb_min_rigid[i];
+    real3 amax = aabb_max_rigid[i];
+    real3 cmin = cached_aabb_min[i];
+    real3 cmax = cached_aabb_max[i];
+    bool inside = amin.x >= cmin.x && amin.y >= cmin.y && amin.z >= cmin.z &&  //
+                  amax.x <= cmax.x && amax.y <= cmax.y && amax.z <= cmax.z;
+    bool same_family = fam_data[i].x == cached_fam[i].x && fam_data[i].y == cached_fam[i].y;
+    if (!inside || !same_family)
+      num_changed++;
+  }
+
+  return num_changed == 0;
+}
+// =========================================================================================================
+void ChCBroadphase::CachePairingBoxes() {
+  host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
+  host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
+  const host_vector<bool>& obj_active = data_manager->host_data.active_rigid;
+  uint num_shapes = data_manager->num_rigid_shapes;
+  uint num_bodies = data_manager->num_rigid_bodies;
+
+  real margin = data_manager->settings.collision.coherence_margin;
+  if (margin <= 0) {
+    margin = data_manager->settings.collision.collision_envelope;
+  }
+
+  // The full pass bins the inflated AABBs, the actual ones are restored after it
+  actual_aabb_min = aabb_min_rigid;
+  actual_aabb_max = aabb_max_rigid;
+
+#pragma omp parallel for
+  for (int i = 0; i < num_shapes; i++) {
+    aabb_min_rigid[i] -= R3(margin);
+    aabb_max_rigid[i] += R3(margin);
+  }
+
+  cached_aabb_min = aabb_min_rigid;
+  cached_aabb_max = aabb_max_rigid;
+  cached_fam = data_manager->host_data.fam_rigid;
+  cached_active.resize(num_bodies);
+  for (int i = 0; i < num_bodies; i++) {
+    cached_active[i] = obj_active[i];
+  }
+}
+// =========================================================================================================
+void ChCBroadphase::RebuildPairs() {
   host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
   host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
 
   host_vector<long long>& contact_pairs = data_manager->host_data.pair_rigid_rigid;
-  real3& min_bounding_point = data_manager->measures.collision.min_bounding_point;
-  real3& max_bounding_point = data_manager->measures.collision.max_bounding_point;
-  real3& bin_size_vec = data_manager->measures.collision.bin_size_vec;
-  real3& global_origin = data_manager->measures.collision.global_origin;
+  collision_measures& measures = data_manager->measures.collision;
+  real3& min_bounding_point = measures.min_bounding_point;
+  real3& max_bounding_point = measures.max_bounding_point;
+  real3& bin_size_vec = measures.bin_size_vec;
+  real3& global_origin = measures.global_origin;
   int3& bins_per_axis = data_manager->settings.collision.bins_per_axis;
   const real density = data_manager->settings.collision.grid_density;
-  const host_vector<short2>& fam_data = data_manager->host_data.fam_rigid;
-  const host_vector<bool>& obj_active = data_manager->host_data.active_rigid;
-  const host_vector<uint>& obj_data_ID = data_manager->host_data.id_rigid;
+  const bool two_level = data_manager->settings.collision.grid_type == GRID_TWO_LEVEL;
+  const real level_ratio = data_manager->settings.collision.grid_level_ratio;
   uint num_shapes = data_manager->num_rigid_shapes;
 
   LOG(TRACE) << "Number of AABBs: " << num_shapes;
   contact_pairs.clear();
+  measures.num_shapes_coarse = 0;
+  measures.num_pairs_fine = 0;
+  measures.num_pairs_coarse = 0;
   // STEP 2: determine the bounds on the total space and subdivide based on the bins per axis
   // create a zero volume bounding box using the first aabb
   bbox res = bbox(aabb_min_rigid[0], aabb_min_rigid[0]);
@@ -208,7 +339,6 @@ void ChCBroadphase::DetectPossibleCollisions() {
     bins_per_axis = function_Compute_Grid_Resolution(num_shapes, diagonal, density);
   }
   bin_size_vec = diagonal / R3(bins_per_axis.x, bins_per_axis.y, bins_per_axis.z);
-  real3 inv_bin_size_vec = 1.0 / bin_size_vec;
 
   thrust::constant_iterator<real3> offset(global_origin);
   transform(aabb_min_rigid.begin(), aabb_min_rigid.end(), offset, aabb_min_rigid.begin(), thrust::minus<real3>());
@@ -218,12 +348,79 @@ void ChCBroadphase::DetectPossibleCollisions() {
   LOG(TRACE) << "Maximum bounding point: (" << res.second.x << ", " << res.second.y << ", " << res.second.z << ")";
   LOG(TRACE) << "Bin size vector: (" << bin_size_vec.x << ", " << bin_size_vec.y << ", " << bin_size_vec.z << ")";
 
+  if (!two_level) {
+    measures.num_pairs_fine = DetectLevel(LEVEL_UNIFORM, bins_per_axis, bin_size_vec);
+    number_of_contacts_possible = measures.num_pairs_fine;
+    LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+    return;
+  }
+
+  // Split the shapes between the two levels: a shape is large if it spans
+  // more than level_ratio fine bins along any axis
+  real min_bin_size = std::min(bin_size_vec.x, std::min(bin_size_vec.y, bin_size_vec.z));
+  real large_size = level_ratio * min_bin_size;
+  shape_large.resize(num_shapes);
+  uint num_large = 0;
+#pragma omp parallel for reduction(+ : num_large)
+  for (int i = 0; i < num_shapes; i++) {
+    real3 extent = aabb_max_rigid[i] - aabb_min_rigid[i];
+    real max_extent = std::max(extent.x, std::max(extent.y, extent.z));
+    shape_large[i] = (max_extent > large_size);
+    num_large += shape_large[i];
+  }
+  measures.num_shapes_coarse = num_large;
+
+  LOG(TRACE) << "Number of large shapes: " << num_large;
+
+  measures.num_pairs_fine = DetectLevel(LEVEL_FINE, bins_per_axis, bin_size_vec);
+
+  if (num_large > 0) {
+    // The coarse grid is sized for the large shapes, with bins no smaller than
+    // level_ratio fine bins
+    int3& coarse_bins = measures.coarse_bins_per_axis;
+    coarse_bins = function_Compute_Grid_Resolution(num_large, diagonal, density);
+    coarse_bins.x = std::max(1, std::min(coarse_bins.x, int(bins_per_axis.x / level_ratio)));
+    coarse_bins.y = std::max(1, std::min(coarse_bins.y, int(bins_per_axis.y / level_ratio)));
+    coarse_bins.z = std::max(1, std::min(coarse_bins.z, int(bins_per_axis.z / level_ratio)));
+    measures.coarse_bin_size_vec = diagonal / R3(coarse_bins.x, coarse_bins.y, coarse_bins.z);
+
+    LOG(TRACE) << "Coarse grid: " << coarse_bins.x << " " << coarse_bins.y << " " << coarse_bins.z;
+
+    measures.num_pairs_coarse = DetectLevel(LEVEL_COARSE, coarse_bins, measures.coarse_bin_size_vec);
+  }
+
+  number_of_contacts_possible = measures.num_pairs_fine + measures.num_pairs_coarse;
+
+  LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible << " (fine "
+             << measures.num_pairs_fine << ", coarse " << measures.num_pairs_coarse << ")";
+}
+// =========================================================================================================
+// Bin the shapes of one grid level, the AABBs are expected to be already
+// translated to the global origin. The pairs found are appended to the list of
+// rigid-rigid pairs. On the fine level the large shapes are skipped; on the
+// coarse level all shapes are binned but, in each bin, only the pairs with at
+// least one large shape are tested, so that the two levels never report the
+// same pair.
+uint ChCBroadphase::DetectLevel(GridLevel level, const int3& bins_per_axis, const real3& bin_size_vec) {
+  const host_vector<real3>& aabb_min_rigid = data_manager->host_data.aabb_min_rigid;
+  const host_vector<real3>& aabb_max_rigid = data_manager->host_data.aabb_max_rigid;
+
+  host_vector<long long>& contact_pairs = data_manager->host_data.pair_rigid_rigid;
+  const host_vector<short2>& fam_data = data_manager->host_data.fam_rigid;
+  const host_vector<bool>& obj_active = data_manager->host_data.active_rigid;
+  const host_vector<uint>& obj_data_ID = data_manager->host_data.id_rigid;
+  uint num_shapes = data_manager->num_rigid_shapes;
+  real3 inv_bin_size_vec = 1.0 / bin_size_vec;
+  const bool fine = (level == LEVEL_FINE);
+  const bool coarse = (level == LEVEL_COARSE);
+
   bins_intersected.resize(num_shapes + 1);
   bins_intersected[num_shapes] = 0;
 
 #pragma omp parallel for
   for (int i = 0; i < num_shapes; i++) {
-    function_Count_AABB_BIN_Intersection(i, inv_bin_size_vec, aabb_min_rigid, aabb_max_rigid, bins_intersected);
+    function_Count_AABB_BIN_Intersection(i, inv_bin_size_vec, aabb_min_rigid, aabb_max_rigid,
+                                         !fine || !shape_large[i], bins_intersected);
   }
 
   Thrust_Exclusive_Scan(bins_intersected);
@@ -239,7 +436,7 @@ void ChCBroadphase::DetectPossibleCollisions() {
 #pragma omp parallel for
   for (int i = 0; i < num_shapes; i++) {
     function_Store_AABB_BIN_Intersection(i, bins_per_axis, inv_bin_size_vec, aabb_min_rigid, aabb_max_rigid,
-                                         bins_intersected, bin_number, aabb_number);
+                                         !fine || !shape_large[i], bins_intersected, bin_number, aabb_number);
   }
 
   LOG(TRACE) << "Completed (device_Store_AABB_BIN_Intersection)";
@@ -248,8 +445,7 @@ void ChCBroadphase::DetectPossibleCollisions() {
   num_bins_active = Run_Length_Encode(bin_number, bin_number_out, bin_start_index);
 
   if (num_bins_active <= 0) {
-    number_of_contacts_possible = 0;
-    return;
+    return 0;
   }
 
   bin_start_index.resize(num_bins_active + 1);
@@ -259,6 +455,20 @@ void ChCBroadphase::DetectPossibleCollisions() {
   LOG(TRACE) << "Last active bin: " << num_bins_active;
 
   Thrust_Exclusive_Scan(bin_start_index);
+
+  // On the coarse level move the large shapes to the front of each bin, the
+  // pair tests then only start from those
+  if (coarse) {
+    bin_num_lead.resize(num_bins_active);
+#pragma omp parallel for
+    for (int i = 0; i < num_bins_active; i++) {
+      uint* first = &aabb_number[0] + bin_start_index[i];
+      uint* last = &aabb_number[0] + bin_start_index[i + 1];
+      uint* mid = std::stable_partition(first, last, [this](uint shape) { return shape_large[shape] != 0; });
+      bin_num_lead[i] = uint(mid - first);
+    }
+  }
+
   num_contact.resize(num_bins_active + 1);
   num_contact[num_bins_active] = 0;
 
@@ -273,15 +483,25 @@ void ChCBroadphase::DetectPossibleCollisions() {
       bin_number_out, 
       aabb_number, 
       bin_start_index,
+      bin_num_lead,
+      coarse,
       fam_data, 
       obj_active, 
       obj_data_ID, 
       num_contact);
   }
   Thrust_Exclusive_Scan(num_contact);
-  number_of_contacts_possible = num_contact.back();
-  contact_pairs.resize(number_of_contacts_possible);
-  LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+  uint num_pairs = num_contact.back();
+  uint pair_offset = contact_pairs.size();
+  contact_pairs.resize(pair_offset + num_pairs);
+
+  // Shift the output offsets past the pairs of the previous level
+  if (pair_offset > 0) {
+#pragma omp parallel for
+    for (int i = 0; i < num_bins_active; i++) {
+      num_contact[i] += pair_offset;
+    }
+  }
 
 #pragma omp parallel for
   for (int index = 0; index < num_bins_active; index++) {
@@ -293,6 +513,8 @@ void ChCBroadphase::DetectPossibleCollisions() {
       bin_number_out, 
       aabb_number,
       bin_start_index, 
+      bin_num_lead,
+      coarse,
       num_contact, 
       fam_data, 
       obj_active, 
@@ -300,11 +522,7 @@ void ChCBroadphase::DetectPossibleCollisions() {
       contact_pairs);
   }
 
-  contact_pairs.resize(number_of_contacts_possible);
-
-  LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
-
-  return;
+  return num_pairs;
 }
 }
 }
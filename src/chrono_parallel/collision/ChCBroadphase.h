@@ -12,7 +12,8 @@
 // Authors: Hammad Mazhar
 // =============================================================================
 // The boradphase algorithm uses a spatial subdivison approach to find contacts
-// between objects of different sizes
+// between objects of different sizes. Optionally (GRID_TWO_LEVEL) the shapes
+// that are large compared to the bins are binned on a separate coarse grid.
 // =============================================================================
 
 #pragma once
@@ -35,6 +36,23 @@ class CH_PARALLEL_API ChCBroadphase {
   void DetectPossibleCollisions();
   ChParallelDataManager* data_manager;
  private:
+  // Grid levels: all shapes on one grid, small shapes on the fine grid, or
+  // all shapes on the coarse grid with only the pairs involving a large shape.
+  enum GridLevel { LEVEL_UNIFORM, LEVEL_FINE, LEVEL_COARSE };
+
+  // Full broadphase pass: bin all AABBs and build the pair list from scratch.
+  void RebuildPairs();
+  // Temporal coherence: check whether the current AABBs are still contained in
+  // the inflated AABBs of the last full pass (and nothing else changed).
+  bool CanReusePairs();
+  // Inflate the AABBs by the coherence margin and keep a copy for CanReusePairs;
+  // the actual AABBs are saved and restored after the full pass.
+  void CachePairingBoxes();
+
+  // Bin the shapes of the given level and append the AABB pairs found to the
+  // rigid-rigid pair list; returns the number of pairs found.
+  uint DetectLevel(GridLevel level, const int3& bins_per_axis, const real3& bin_size_vec);
+
   uint num_bins_active;
   uint number_of_bin_intersections;
   uint number_of_contacts_possible;
@@ -45,6 +63,17 @@ class CH_PARALLEL_API ChCBroadphase {
   custom_vector<uint> aabb_number;
   custom_vector<uint> bin_start_index;
   custom_vector<uint> num_contact;
+  custom_vector<uint> bin_num_lead;  // coarse level: number of large shapes at the start of each bin
+  custom_vector<char> shape_large;   // two-level grid: 1 if the shape is binned on the coarse grid
+
+  // Temporal coherence: state of the last full pass
+  custom_vector<real3> cached_aabb_min;
+  custom_vector<real3> cached_aabb_max;
+  custom_vector<short2> cached_fam;
+  custom_vector<char> cached_active;
+  custom_vector<long long> cached_pairs;  // the narrowphase compacts the pair list to the contacts
+  custom_vector<real3> actual_aabb_min;   // AABBs before inflation, during a full pass
+  custom_vector<real3> actual_aabb_max;
 
 };
 
@@ -15,6 +15,7 @@
 // Description: class for a parallel collision model
 // =============================================================================
 #include "chrono_parallel/collision/ChCCollisionModelParallel.h"
+#include "chrono_parallel/collision/ChCMeshBVH.h"
 #include "physics/ChBody.h"
 #include "physics/ChBodyAuxRef.h"
 #include "physics/ChSystem.h"
@@ -36,6 +37,10 @@ int ChCollisionModelParallel::ClearModel() {
     }
 
     mData.clear();
+    local_mesh_data.clear();
+    local_bvh_min.clear();
+    local_bvh_max.clear();
+    local_bvh_node.clear();
     nObjects = 0;
     family_group = 1;
     family_mask = 0x7FFF;
@@ -335,18 +340,47 @@ bool ChCollisionModelParallel::AddTriangleMesh(const geometry::ChTriangleMesh& t
     const ChVector<>& position = frame.GetPos();
     const ChQuaternion<>& rotation = frame.GetRot();
 
-    nObjects += trimesh.getNumTriangles();
-    ConvexShape tData;
+    if (is_convex) {
+        std::vector<ChVector<double> > points;
+        for (int i = 0; i < trimesh.getNumTriangles(); i++) {
+            geometry::ChTriangle temptri = trimesh.getTriangle(i);
+            points.push_back(temptri.p1);
+            points.push_back(temptri.p2);
+            points.push_back(temptri.p3);
+        }
+        return AddConvexHull(points, pos, rot);
+    }
+
+    if (trimesh.getNumTriangles() == 0)
+        return false;
+
+    // The vertices are stored in the frame of the shape, the BVH is built on them
+    std::vector<real3> triangles;
     for (int i = 0; i < trimesh.getNumTriangles(); i++) {
         geometry::ChTriangle temptri = trimesh.getTriangle(i);
-        tData.A = R3(temptri.p1.x + position.x, temptri.p1.y + position.y, temptri.p1.z + position.z);
-        tData.B = R3(temptri.p2.x + position.x, temptri.p2.y + position.y, temptri.p2.z + position.z);
-        tData.C = R3(temptri.p3.x + position.x, temptri.p3.y + position.y, temptri.p3.z + position.z);
-        tData.R = R4(rotation.e0, rotation.e1, rotation.e2, rotation.e3);
-        tData.type = TRIANGLEMESH;
-        tData.margin = model_safe_margin;
-        mData.push_back(tData);
+        triangles.push_back(R3(temptri.p1.x, temptri.p1.y, temptri.p1.z));
+        triangles.push_back(R3(temptri.p2.x, temptri.p2.y, temptri.p2.z));
+        triangles.push_back(R3(temptri.p3.x, temptri.p3.y, temptri.p3.z));
     }
+    std::vector<real3> node_min;
+    std::vector<real3> node_max;
+    std::vector<int2> node_data;
+    BuildMeshBVH(triangles, node_min, node_max, node_data);
+
+    nObjects++;
+    ConvexShape tData;
+    tData.A = R3(position.x, position.y, position.z);
+    tData.B = R3(trimesh.getNumTriangles(), local_mesh_data.size() / 3, local_bvh_node.size());
+    tData.C = R3(0, 0, 0);
+    tData.R = R4(rotation.e0, rotation.e1, rotation.e2, rotation.e3);
+    tData.type = TRIANGLEMESH_BVH;
+    tData.margin = model_safe_margin;
+    mData.push_back(tData);
+
+    local_mesh_data.insert(local_mesh_data.end(), triangles.begin(), triangles.end());
+    local_bvh_min.insert(local_bvh_min.end(), node_min.begin(), node_min.end());
+    local_bvh_max.insert(local_bvh_max.end(), node_max.begin(), node_max.end());
+    local_bvh_node.insert(local_bvh_node.end(), node_data.begin(), node_data.end());
 
     return true;
 }
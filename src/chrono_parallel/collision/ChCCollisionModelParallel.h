@@ -148,6 +148,9 @@ class CH_PARALLEL_API ChCollisionModelParallel : public ChCollisionModel {
     /// classes, maybe the triangle is referenced via a striding interface or just copied)
     /// Note: if possible, in sake of high performance, avoid triangle meshes and prefer simplified
     /// representations as compounds of convex shapes of boxes/spheres/etc.. type.
+    /// The triangles are copied in a single shape with its own BVH: the broadphase only sees the
+    /// bounding box of the whole mesh and the narrowphase tests the other shapes against the
+    /// triangles found in the BVH. If is_convex is true, the convex hull of the vertices is used.
     virtual bool AddTriangleMesh(
         const geometry::ChTriangleMesh& trimesh,  ///< the triangle mesh
         bool is_static,  ///< true only if model doesn't move (es.a terrain). May improve performance
@@ -195,6 +198,10 @@ class CH_PARALLEL_API ChCollisionModelParallel : public ChCollisionModel {
 
     std::vector<ConvexShape> mData;
     std::vector<real3> local_convex_data;
+    std::vector<real3> local_mesh_data;  ///< vertices of the mesh triangles, in the frame of their shape
+    std::vector<real3> local_bvh_min;    ///< bounding boxes of the BVH nodes of the meshes
+    std::vector<real3> local_bvh_max;
+    std::vector<int2> local_bvh_node;    ///< children or triangles of the BVH nodes (see BuildMeshBVH)
 
   protected:
     ChBody* mbody;
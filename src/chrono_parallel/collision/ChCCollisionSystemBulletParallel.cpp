@@ -78,7 +78,7 @@ void ChCollisionSystemBulletParallel::Add(ChCollisionModel* model) {
 
 void ChCollisionSystemBulletParallel::Remove(ChCollisionModel* model) {
   ChModelBullet* bmodel = static_cast<ChModelBullet*>(model);
-  if (bmodel->GetBulletModel()->getCollisionShape()) {
+  if (bmodel->GetBulletModel()->getCollisionShape() && bmodel->GetBulletModel()->getBroadphaseHandle()) {
     bt_collision_world->removeCollisionObject(bmodel->GetBulletModel());
   }
 }
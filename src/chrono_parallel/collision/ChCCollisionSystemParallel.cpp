@@ -39,6 +39,17 @@ void ChCollisionSystemParallel::Add(ChCollisionModel* model) {
     // Insert the points into the global convex list
     data_manager->host_data.convex_data.insert(data_manager->host_data.convex_data.end(),
                                                pmodel->local_convex_data.begin(), pmodel->local_convex_data.end());
+    // Same for the triangles and the BVH nodes of the meshes
+    int mesh_data_offset = data_manager->host_data.mesh_data.size() / 3;
+    int bvh_data_offset = data_manager->host_data.bvh_node_rigid.size();
+    data_manager->host_data.mesh_data.insert(data_manager->host_data.mesh_data.end(), pmodel->local_mesh_data.begin(),
+                                             pmodel->local_mesh_data.end());
+    data_manager->host_data.bvh_min_rigid.insert(data_manager->host_data.bvh_min_rigid.end(),
+                                                 pmodel->local_bvh_min.begin(), pmodel->local_bvh_min.end());
+    data_manager->host_data.bvh_max_rigid.insert(data_manager->host_data.bvh_max_rigid.end(),
+                                                 pmodel->local_bvh_max.begin(), pmodel->local_bvh_max.end());
+    data_manager->host_data.bvh_node_rigid.insert(data_manager->host_data.bvh_node_rigid.end(),
+                                                  pmodel->local_bvh_node.begin(), pmodel->local_bvh_node.end());
 
     for (int j = 0; j < pmodel->GetNObjects(); j++) {
       real3 obB = pmodel->mData[j].B;
@@ -47,6 +58,9 @@ void ChCollisionSystemParallel::Add(ChCollisionModel* model) {
       // already present
       if (pmodel->mData[j].type == CONVEX) {
         obB.y += convex_data_offset;  // update to get the global offset
+      } else if (pmodel->mData[j].type == TRIANGLEMESH_BVH) {
+        obB.y += mesh_data_offset;
+        obB.z += bvh_data_offset;
       }
 
       data_manager->host_data.ObA_rigid.push_back(pmodel->mData[j].A);
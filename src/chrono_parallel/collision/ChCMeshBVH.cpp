@@ -0,0 +1,132 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Description: bounding volume hierarchy of the triangles of a mesh shape.
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono_parallel/collision/ChCMeshBVH.h"
+
+namespace chrono {
+namespace collision {
+
+namespace {
+
+inline real Component(const real3& v, int axis) {
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+struct MeshBVHBuilder {
+  const std::vector<real3>& triangles;
+  std::vector<real3> centroid;
+  std::vector<int> order;
+  std::vector<real3>& node_min;
+  std::vector<real3>& node_max;
+  std::vector<int2>& node_data;
+
+  MeshBVHBuilder(const std::vector<real3>& tri,
+                 std::vector<real3>& nmin,
+                 std::vector<real3>& nmax,
+                 std::vector<int2>& ndata)
+      : triangles(tri), node_min(nmin), node_max(nmax), node_data(ndata) {
+    int num_triangles = (int)triangles.size() / 3;
+    centroid.resize(num_triangles);
+    order.resize(num_triangles);
+    for (int t = 0; t < num_triangles; t++) {
+      centroid[t] = (triangles[3 * t + 0] + triangles[3 * t + 1] + triangles[3 * t + 2]) / 3.0;
+      order[t] = t;
+    }
+  }
+
+  int AddNode() {
+    node_min.push_back(R3(0));
+    node_max.push_back(R3(0));
+    node_data.push_back(I2(0, 0));
+    return (int)node_data.size() - 1;
+  }
+
+  // Split the triangles [first, first + count) of the node at the median of
+  // their centroids along the longest axis of the centroid bounds.
+  void Build(int node, int first, int count) {
+    real3 bmin = triangles[3 * order[first]];
+    real3 bmax = bmin;
+    real3 cmin = centroid[order[first]];
+    real3 cmax = cmin;
+    for (int i = first; i < first + count; i++) {
+      for (int v = 0; v < 3; v++) {
+        const real3& p = triangles[3 * order[i] + v];
+        bmin = R3(Min(bmin.x, p.x), Min(bmin.y, p.y), Min(bmin.z, p.z));
+        bmax = R3(Max(bmax.x, p.x), Max(bmax.y, p.y), Max(bmax.z, p.z));
+      }
+      const real3& c = centroid[order[i]];
+      cmin = R3(Min(cmin.x, c.x), Min(cmin.y, c.y), Min(cmin.z, c.z));
+      cmax = R3(Max(cmax.x, c.x), Max(cmax.y, c.y), Max(cmax.z, c.z));
+    }
+    node_min[node] = bmin;
+    node_max[node] = bmax;
+
+    if (count <= MESH_BVH_LEAF_SIZE) {
+      node_data[node] = I2(first, count);
+      return;
+    }
+
+    real3 extent = cmax - cmin;
+    int axis = 0;
+    if (extent.y > extent.x && extent.y >= extent.z) {
+      axis = 1;
+    } else if (extent.z > extent.x && extent.z > extent.y) {
+      axis = 2;
+    }
+    int half = count / 2;
+    const std::vector<real3>& c = centroid;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                     [&c, axis](int a, int b) { return Component(c[a], axis) < Component(c[b], axis); });
+
+    int child = AddNode();
+    AddNode();
+    node_data[node] = I2(child, 0);
+    Build(child, first, half);
+    Build(child + 1, first + half, count - half);
+  }
+};
+
+}  // end anonymous namespace
+
+void BuildMeshBVH(std::vector<real3>& triangles,
+                  std::vector<real3>& node_min,
+                  std::vector<real3>& node_max,
+                  std::vector<int2>& node_data) {
+  node_min.clear();
+  node_max.clear();
+  node_data.clear();
+  int num_triangles = (int)triangles.size() / 3;
+  if (num_triangles == 0) {
+    return;
+  }
+
+  MeshBVHBuilder builder(triangles, node_min, node_max, node_data);
+  builder.AddNode();
+  builder.Build(0, 0, num_triangles);
+
+  // Store the triangles in the order of the leaves
+  std::vector<real3> sorted(triangles.size());
+  for (int t = 0; t < num_triangles; t++) {
+    int source = builder.order[t];
+    sorted[3 * t + 0] = triangles[3 * source + 0];
+    sorted[3 * t + 1] = triangles[3 * source + 1];
+    sorted[3 * t + 2] = triangles[3 * source + 2];
+  }
+  triangles.swap(sorted);
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,91 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Description: bounding volume hierarchy of the triangles of a mesh shape.
+// The BVH is built once, in the frame of the shape, when the mesh is added to
+// the collision model. The narrowphase uses it to find the triangles of a mesh
+// that are close to the shapes overlapping with the mesh in the broadphase.
+// =============================================================================
+
+#pragma once
+
+#include <vector>
+
+#include "chrono_parallel/ChApiParallel.h"
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/math/ChParallelMath.h"
+#include "chrono_parallel/collision/ChCBroadphaseUtils.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup parallel_module
+/// @{
+
+// Maximum number of triangles in a leaf of the BVH
+#define MESH_BVH_LEAF_SIZE 4
+// Size of the stack used to traverse the BVH (larger than its depth)
+#define MESH_BVH_STACK_SIZE 64
+
+/// Build the BVH of a triangle mesh, given as a list of vertices (three per
+/// triangle). The triangles are reordered so that each leaf covers a contiguous
+/// range of them. For each node, node_min and node_max hold its bounding box and
+/// node_data holds, for a leaf, the first triangle (x) and the number of
+/// triangles (y) and, for an internal node, the first of its two consecutive
+/// children (x) and 0 (y). All indices are relative to the mesh, the root is the
+/// first node.
+CH_PARALLEL_API void BuildMeshBVH(std::vector<real3>& triangles,
+                                  std::vector<real3>& node_min,
+                                  std::vector<real3>& node_max,
+                                  std::vector<int2>& node_data);
+
+/// Call visit(t) for each triangle t of a mesh whose bounding box overlaps with
+/// the box (qmin, qmax), expressed in the frame of the mesh. The arrays start at
+/// the root node and at the first triangle of the mesh, t is relative to them.
+template <typename Visitor>
+inline void QueryMeshBVH(const real3* node_min,
+                         const real3* node_max,
+                         const int2* node_data,
+                         const real3* triangles,
+                         const real3& qmin,
+                         const real3& qmax,
+                         Visitor& visit) {
+  int stack[MESH_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    int node = stack[--top];
+    if (!overlap(node_min[node], node_max[node], qmin, qmax)) {
+      continue;
+    }
+    int2 data = node_data[node];
+    if (data.y == 0) {
+      stack[top++] = data.x;
+      stack[top++] = data.x + 1;
+      continue;
+    }
+    for (int t = data.x; t < data.x + data.y; t++) {
+      const real3& A = triangles[3 * t + 0];
+      const real3& B = triangles[3 * t + 1];
+      const real3& C = triangles[3 * t + 2];
+      real3 tmin = R3(Min(A.x, Min(B.x, C.x)), Min(A.y, Min(B.y, C.y)), Min(A.z, Min(B.z, C.z)));
+      real3 tmax = R3(Max(A.x, Max(B.x, C.x)), Max(A.y, Max(B.y, C.y)), Max(A.z, Max(B.z, C.z)));
+      if (overlap(tmin, tmax, qmin, qmax)) {
+        visit(t);
+      }
+    }
+  }
+}
+
+/// @} parallel_module
+
+}  // end namespace collision
+}  // end namespace chrono
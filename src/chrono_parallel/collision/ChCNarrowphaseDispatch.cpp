@@ -7,6 +7,7 @@
 #include "chrono_parallel/collision/ChCNarrowphaseMPR.h"
 #include "chrono_parallel/collision/ChCNarrowphaseR.h"
 #include "chrono_parallel/collision/ChCNarrowphaseGJK_EPA.h"
+#include "chrono_parallel/collision/ChCMeshBVH.h"
 namespace chrono {
 namespace collision {
 
@@ -18,6 +19,7 @@ void ChCNarrowphaseDispatch::Process() {
   custom_vector<real>& dpth_data = data_manager->host_data.dpth_rigid_rigid;
   custom_vector<real>& erad_data = data_manager->host_data.erad_rigid_rigid;
   custom_vector<int2>& bids_data = data_manager->host_data.bids_rigid_rigid;
+  custom_vector<int>& tri_data = data_manager->host_data.tri_rigid_rigid;
 
   //======== Body state information
   custom_vector<bool>& obj_active = data_manager->host_data.active_rigid;
@@ -41,6 +43,7 @@ void ChCNarrowphaseDispatch::Process() {
     dpth_data.resize(0);
     erad_data.resize(0);
     bids_data.resize(0);
+    tri_data.resize(0);
     number_of_contacts = 0;
     return;
   }
@@ -48,6 +51,21 @@ void ChCNarrowphaseDispatch::Process() {
   // Transform to global coordinate system
   PreprocessLocalToParent();
 
+  // Test the shapes overlapping with a triangle mesh against its BVH
+  MidPhase();
+  num_potentialCollisions = potentialCollisions.size();
+  if (num_potentialCollisions == 0) {
+    norm_data.resize(0);
+    cpta_data.resize(0);
+    cptb_data.resize(0);
+    dpth_data.resize(0);
+    erad_data.resize(0);
+    bids_data.resize(0);
+    tri_data.resize(0);
+    number_of_contacts = 0;
+    return;
+  }
+
   // Set maximum possible number of contacts for each potential collision
   // (depending on the narrowphase algorithm and on the types of shapes in
   // potential collision)
@@ -72,6 +90,21 @@ void ChCNarrowphaseDispatch::Process() {
   erad_data.resize(num_potentialContacts);
   bids_data.resize(num_potentialContacts);
 
+  // A pair can produce more than one contact: give each potential contact the
+  // key of its pair, and its mesh triangle, so that the compacted lists have
+  // one key per contact
+  contact_pair.resize(num_potentialContacts);
+  contact_triangle.resize(num_potentialContacts);
+#pragma omp parallel for
+  for (int index = 0; index < num_potentialCollisions; index++) {
+    uint end = (index + 1 < num_potentialCollisions) ? contact_index[index + 1] : num_potentialContacts;
+    int triangle = pair_triangle.empty() ? -1 : pair_triangle[index];
+    for (uint i = contact_index[index]; i < end; i++) {
+      contact_pair[i] = potentialCollisions[index];
+      contact_triangle[i] = triangle;
+    }
+  }
+
   Dispatch();
 
   // Set the number of active contacts.
@@ -82,9 +115,10 @@ void ChCNarrowphaseDispatch::Process() {
   thrust::remove_if(
       thrust::make_zip_iterator(thrust::make_tuple(norm_data.begin(), cpta_data.begin(), cptb_data.begin(),
                                                    dpth_data.begin(), erad_data.begin(), bids_data.begin(),
-                                                   potentialCollisions.begin())),
+                                                   contact_pair.begin(), contact_triangle.begin())),
       thrust::make_zip_iterator(thrust::make_tuple(norm_data.end(), cpta_data.end(), cptb_data.end(), dpth_data.end(),
-                                                   erad_data.end(), bids_data.end(), potentialCollisions.end())),
+                                                   erad_data.end(), bids_data.end(), contact_pair.end(),
+                                                   contact_triangle.end())),
       contact_active.begin(), thrust::logical_not<bool>());
 
   // Resize all lists so that we don't access invalid contacts
@@ -94,7 +128,10 @@ void ChCNarrowphaseDispatch::Process() {
   dpth_data.resize(number_of_contacts);
   erad_data.resize(number_of_contacts);
   bids_data.resize(number_of_contacts);
-  potentialCollisions.resize(number_of_contacts);
+  contact_pair.resize(number_of_contacts);
+  contact_triangle.resize(number_of_contacts);
+  potentialCollisions.swap(contact_pair);
+  tri_data.swap(contact_triangle);
 
   // std::cout << num_potentialContacts << " " << number_of_contacts << std::endl;
 }
@@ -177,6 +214,103 @@ void ChCNarrowphaseDispatch::PreprocessLocalToParent() {
   }
 }
 
+void ChCNarrowphaseDispatch::MidPhase() {
+  custom_vector<long long>& potentialCollisions = data_manager->host_data.pair_rigid_rigid;
+
+  pair_triangle.clear();
+  if (data_manager->host_data.bvh_node_rigid.size() == 0) {
+    return;
+  }
+
+  const shape_type* obj_data_T = data_manager->host_data.typ_rigid.data();
+  const real3* obj_data_B = data_manager->host_data.ObB_rigid.data();
+  const real3* aabb_min = data_manager->host_data.aabb_min_rigid.data();
+  const real3* aabb_max = data_manager->host_data.aabb_max_rigid.data();
+  const real3* mesh_data = data_manager->host_data.mesh_data.data();
+  const real3* bvh_min = data_manager->host_data.bvh_min_rigid.data();
+  const real3* bvh_max = data_manager->host_data.bvh_max_rigid.data();
+  const int2* bvh_node = data_manager->host_data.bvh_node_rigid.data();
+  // The broadphase left the AABBs relative to the global origin
+  real3 global_origin = data_manager->measures.collision.global_origin;
+
+  // Find the mesh of a pair, and the bounding box of the other shape in the
+  // frame of the mesh. Returns false if the pair does not involve exactly one mesh.
+  auto query_box = [&](long long p, int& mesh, real3& qmin, real3& qmax) {
+    int2 pair = I2(int(p >> 32), int(p & 0xffffffff));
+    bool meshA = obj_data_T[pair.x] == TRIANGLEMESH_BVH;
+    bool meshB = obj_data_T[pair.y] == TRIANGLEMESH_BVH;
+    if (meshA == meshB) {
+      return false;
+    }
+    mesh = meshA ? pair.x : pair.y;
+    int other = meshA ? pair.y : pair.x;
+
+    real3 center = (aabb_min[other] + aabb_max[other]) * 0.5 + global_origin;
+    real3 half = (aabb_max[other] - aabb_min[other]) * 0.5 + collision_envelope;
+    real3 local_center = TransformParentToLocal(obj_data_A_global[mesh], obj_data_R_global[mesh], center);
+    real3 local_half = MatMult(AbsMat(AMatT(obj_data_R_global[mesh])), half);
+    qmin = local_center - local_half;
+    qmax = local_center + local_half;
+    return true;
+  };
+
+  // Count the pairs generated by each broadphase pair
+  mesh_pair_index.resize(num_potentialCollisions);
+#pragma omp parallel for
+  for (int index = 0; index < num_potentialCollisions; index++) {
+    long long p = potentialCollisions[index];
+    int2 pair = I2(int(p >> 32), int(p & 0xffffffff));
+    int mesh;
+    real3 qmin, qmax;
+    if (query_box(p, mesh, qmin, qmax)) {
+      int root = int(obj_data_B[mesh].z);
+      uint count = 0;
+      auto count_triangle = [&count](int t) { count++; };
+      QueryMeshBVH(bvh_min + root, bvh_max + root, bvh_node + root, mesh_data + 3 * int(obj_data_B[mesh].y), qmin,
+                   qmax, count_triangle);
+      mesh_pair_index[index] = count;
+    } else if (obj_data_T[pair.x] == TRIANGLEMESH_BVH) {
+      mesh_pair_index[index] = 0;
+    } else {
+      mesh_pair_index[index] = 1;
+    }
+  }
+
+  uint num_pairs = mesh_pair_index.back();
+  thrust::exclusive_scan(thrust_parallel, mesh_pair_index.begin(), mesh_pair_index.end(), mesh_pair_index.begin());
+  num_pairs += mesh_pair_index.back();
+
+  // Generate the pairs, with the same traversal of the BVH
+  mesh_pair.resize(num_pairs);
+  pair_triangle.resize(num_pairs);
+#pragma omp parallel for
+  for (int index = 0; index < num_potentialCollisions; index++) {
+    long long p = potentialCollisions[index];
+    uint offset = mesh_pair_index[index];
+    uint end = (index + 1 < num_potentialCollisions) ? mesh_pair_index[index + 1] : num_pairs;
+    if (offset == end) {
+      continue;
+    }
+    int mesh;
+    real3 qmin, qmax;
+    if (query_box(p, mesh, qmin, qmax)) {
+      int root = int(obj_data_B[mesh].z);
+      int first = int(obj_data_B[mesh].y);
+      auto add_triangle = [&](int t) {
+        mesh_pair[offset] = p;
+        pair_triangle[offset] = first + t;
+        offset++;
+      };
+      QueryMeshBVH(bvh_min + root, bvh_max + root, bvh_node + root, mesh_data + 3 * first, qmin, qmax, add_triangle);
+    } else {
+      mesh_pair[offset] = p;
+      pair_triangle[offset] = -1;
+    }
+  }
+
+  potentialCollisions.swap(mesh_pair);
+}
+
 void ChCNarrowphaseDispatch::Dispatch_Init(uint index,
                                            uint& icoll,
                                            uint& ID_A,
@@ -212,6 +346,19 @@ void ChCNarrowphaseDispatch::Dispatch_Init(uint index,
   shapeA.margin = collision_margins[pair.x];
   shapeB.margin = collision_margins[pair.y];
 
+  // A mesh is tested one triangle at a time, the triangle given by the mid-phase
+  if (!pair_triangle.empty() && pair_triangle[index] >= 0) {
+    const real3* mesh_data = data_manager->host_data.mesh_data.data();
+    ConvexShape& mesh = (shapeA.type == TRIANGLEMESH_BVH) ? shapeA : shapeB;
+    int t = pair_triangle[index];
+    real3 pos = mesh.A;
+    real4 rot = mesh.R;
+    mesh.type = TRIANGLEMESH;
+    mesh.A = TransformLocalToParent(pos, rot, mesh_data[3 * t + 0]);
+    mesh.B = TransformLocalToParent(pos, rot, mesh_data[3 * t + 1]);
+    mesh.C = TransformLocalToParent(pos, rot, mesh_data[3 * t + 2]);
+  }
+
   //// TODO: what is the best way to dispatch this?
   icoll = contact_index[index];
 }
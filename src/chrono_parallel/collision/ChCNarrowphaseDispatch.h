@@ -31,6 +31,11 @@ class CH_PARALLEL_API ChCNarrowphaseDispatch {
   // transformed once per shape
   void PreprocessLocalToParent();
 
+  // Mid-phase for the triangle meshes: replace each pair of a mesh and another
+  // shape with one pair per triangle of the mesh found in its BVH with the
+  // bounding box of the other shape. Pairs of two meshes are dropped.
+  void MidPhase();
+
   // For each contact pair decide what to do.
   void Dispatch();
   void DispatchMPR();
@@ -47,6 +52,11 @@ class CH_PARALLEL_API ChCNarrowphaseDispatch {
   custom_vector<real4> obj_data_R_global;
   custom_vector<bool> contact_active;
   custom_vector<uint> contact_index;
+  custom_vector<long long> contact_pair;  // shape pair of each potential contact
+  custom_vector<int> contact_triangle;    // mesh triangle of each potential contact (-1 if none)
+  custom_vector<uint> mesh_pair_index;    // first mid-phase pair of each broadphase pair
+  custom_vector<long long> mesh_pair;     // shape pairs after the mid-phase
+  custom_vector<int> pair_triangle;       // mesh triangle of each pair (-1 if none)
   unsigned int num_potentialCollisions;
   real collision_envelope;
   NARROWPHASETYPE narrowphase_algorithm;
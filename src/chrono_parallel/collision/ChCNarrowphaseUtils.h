@@ -27,11 +27,7 @@ inline real3 GetSupportPoint_Triangle(const real3& A, const real3& B, const real
   return point;
 }
 inline real3 GetSupportPoint_Box(const real3& B, const real3& n) {
-  real3 result = R3(0, 0, 0);
-  result.x = sign(n.x) * B.x;
-  result.y = sign(n.y) * B.y;
-  result.z = sign(n.z) * B.z;
-  return result;
+  return sign(n) * B;
 }
 inline real3 GetSupportPoint_Ellipsoid(const real3& B, const real3& n) {
   real3 normal = n;
@@ -27,6 +27,18 @@ struct M33 {
     inline M33() : U(0), V(0), W(0) {}
     inline M33(const real3& u, const real3& v, const real3& w) : U(u), V(v), W(w) {}
 
+#ifdef CHRONO_USE_AVX
+    // Column-wise products: each column of the result is a combination of the
+    // columns U, V, W, computed in one AVX register.
+    inline M33 operator*(const M33& B) const { return M33(*this * B.U, *this * B.V, *this * B.W); }
+
+    inline real3 operator*(const real3& B) const {
+        __m256d r = _mm256_mul_pd(U, _mm256_set1_pd(B.x));
+        r = _mm256_add_pd(r, _mm256_mul_pd(V, _mm256_set1_pd(B.y)));
+        r = _mm256_add_pd(r, _mm256_mul_pd(W, _mm256_set1_pd(B.z)));
+        return r;
+    }
+#else
     inline M33 operator*(const M33& B) const {
         M33 result;
         result.U.x = U.x * B.U.x + V.x * B.U.y + W.x * B.U.z;  // row1 * col1
@@ -53,22 +65,15 @@ struct M33 {
 
         return result;
     }
+#endif
 };
 
+// The matrices below are built column by column through the real3 constructor:
+// writing the components one by one defeats the vectorized (AVX) real3.
 static inline M33 XMatrix(const real3& vect) {
-    M33 Xmat;
-    Xmat.U.x = 0;
-    Xmat.V.x = -vect.z;
-    Xmat.W.x = vect.y;
-
-    Xmat.U.y = vect.z;
-    Xmat.V.y = 0;
-    Xmat.W.y = -vect.x;
-
-    Xmat.U.z = -vect.y;
-    Xmat.V.z = vect.x;
-    Xmat.W.z = 0;
-    return Xmat;
+    return M33(real3(0, vect.z, -vect.y),   //
+               real3(-vect.z, 0, vect.x),   //
+               real3(vect.y, -vect.x, 0));  //
 }
 static inline M33 MatMult(const M33& A, const M33& B) {
     return A * B;
@@ -77,26 +82,21 @@ static inline real3 MatMult(const M33& A, const real3& B) {
     return A * B;
 }
 
+static inline real3 MatTMult(const M33& A, const real3& B) {
+    return real3(dot(A.U, B), dot(A.V, B), dot(A.W, B));  // rows of A^T * B
+}
+
 // A is transposed
 static inline M33 MatTMult(const M33& A, const M33& B) {
-    M33 result;
-    result.U.x = A.U.x * B.U.x + A.U.y * B.U.y + A.U.z * B.U.z;  // row1 * col1
-    result.V.x = A.U.x * B.V.x + A.U.y * B.V.y + A.U.z * B.V.z;  // row1 * col2
-    result.W.x = A.U.x * B.W.x + A.U.y * B.W.y + A.U.z * B.W.z;  // row1 * col3
-
-    result.U.y = A.V.x * B.U.x + A.V.y * B.U.y + A.V.z * B.U.z;  // row2 * col1
-    result.V.y = A.V.x * B.V.x + A.V.y * B.V.y + A.V.z * B.V.z;  // row2 * col2
-    result.W.y = A.V.x * B.W.x + A.V.y * B.W.y + A.V.z * B.W.z;  // row2 * col3
-
-    result.U.z = A.W.x * B.U.x + A.W.y * B.U.y + A.W.z * B.U.z;  // row3 * col1
-    result.V.z = A.W.x * B.V.x + A.W.y * B.V.y + A.W.z * B.V.z;  // row3 * col2
-    result.W.z = A.W.x * B.W.x + A.W.y * B.W.y + A.W.z * B.W.z;  // row3 * col3
-
-    return result;
+    return M33(MatTMult(A, B.U), MatTMult(A, B.V), MatTMult(A, B.W));
 }
 
 // B is transposed
 static inline M33 MatMultT(const M33& A, const M33& B) {
+#ifdef CHRONO_USE_AVX
+    // column j of the result is A * (row j of B)
+    return M33(A * real3(B.U.x, B.V.x, B.W.x), A * real3(B.U.y, B.V.y, B.W.y), A * real3(B.U.z, B.V.z, B.W.z));
+#else
     M33 result;
     result.U.x = A.U.x * B.U.x + A.V.x * B.V.x + A.W.x * B.W.x;  // row1 * col1
     result.V.x = A.U.x * B.U.y + A.V.x * B.V.y + A.W.x * B.W.y;  // row1 * col2
@@ -111,17 +111,9 @@ static inline M33 MatMultT(const M33& A, const M33& B) {
     result.W.z = A.U.z * B.U.z + A.V.z * B.V.z + A.W.z * B.W.z;  // row3 * col3
 
     return result;
+#endif
 }
 
-static inline real3 MatTMult(const M33& A, const real3& B) {
-    real3 result;
-
-    result.x = A.U.x * B.x + A.U.y * B.y + A.U.z * B.z;  // row1 * col1
-    result.y = A.V.x * B.x + A.V.y * B.y + A.V.z * B.z;  // row2 * col2
-    result.z = A.W.x * B.x + A.W.y * B.y + A.W.z * B.z;  // row3 * col3
-
-    return result;
-}
 
 static inline M33 AMat(const real4& q) {
     M33 result;
@@ -136,17 +128,9 @@ static inline M33 AMat(const real4& q) {
     real e1e2 = q.x * q.y;
     real e1e3 = q.x * q.z;
     real e2e3 = q.y * q.z;
-    result.U.x = (e0e0 + e1e1) * 2 - 1;
-    result.V.x = (e1e2 - e0e3) * 2;
-    result.W.x = (e1e3 + e0e2) * 2;
-
-    result.U.y = (e1e2 + e0e3) * 2;
-    result.V.y = (e0e0 + e2e2) * 2 - 1;
-    result.W.y = (e2e3 - e0e1) * 2;
-
-    result.U.z = (e1e3 - e0e2) * 2;
-    result.V.z = (e2e3 + e0e1) * 2;
-    result.W.z = (e0e0 + e3e3) * 2 - 1;
+    result.U = real3((e0e0 + e1e1) * 2 - 1, (e1e2 + e0e3) * 2, (e1e3 - e0e2) * 2);
+    result.V = real3((e1e2 - e0e3) * 2, (e0e0 + e2e2) * 2 - 1, (e2e3 + e0e1) * 2);
+    result.W = real3((e1e3 + e0e2) * 2, (e2e3 - e0e1) * 2, (e0e0 + e3e3) * 2 - 1);
 
     //	result.U.x = (q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z);
     //	result.V.x = (2 * q.x * q.y - 2 * q.w * q.z);
@@ -177,17 +161,9 @@ static inline M33 AMatT(const real4& q) {
     real e1e2 = q.x * q.y;
     real e1e3 = q.x * q.z;
     real e2e3 = q.y * q.z;
-    result.U.x = (e0e0 + e1e1) * 2 - 1;
-    result.U.y = (e1e2 - e0e3) * 2;
-    result.U.z = (e1e3 + e0e2) * 2;
-
-    result.V.x = (e1e2 + e0e3) * 2;
-    result.V.y = (e0e0 + e2e2) * 2 - 1;
-    result.V.z = (e2e3 - e0e1) * 2;
-
-    result.W.x = (e1e3 - e0e2) * 2;
-    result.W.y = (e2e3 + e0e1) * 2;
-    result.W.z = (e0e0 + e3e3) * 2 - 1;
+    result.U = real3((e0e0 + e1e1) * 2 - 1, (e1e2 - e0e3) * 2, (e1e3 + e0e2) * 2);
+    result.V = real3((e1e2 + e0e3) * 2, (e0e0 + e2e2) * 2 - 1, (e2e3 - e0e1) * 2);
+    result.W = real3((e1e3 - e0e2) * 2, (e2e3 + e0e1) * 2, (e0e0 + e3e3) * 2 - 1);
 
     return result;
 }
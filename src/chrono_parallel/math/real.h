@@ -48,6 +48,20 @@ namespace chrono {
 // If the user specified using doubles in CMake make sure that SSE is disabled
 #ifdef CHRONO_PARALLEL_USE_DOUBLE
 #undef CHRONO_USE_SIMD
+// In double precision, a 256 bit AVX register holds a real3 (plus one padding
+// lane) or a real4. The AVX path is selected in CMake (USE_PARALLEL_AVX) and
+// requires AVX support on the host; permutations need AVX2.
+#if defined(CHRONO_HAS_AVX) && defined(CHRONO_PARALLEL_USE_AVX)
+#include <immintrin.h>
+#define CHRONO_USE_AVX
+// Storage type of the AVX registers in real3/real4: containers only guarantee
+// 16 byte alignment, so the 32 byte alignment of __m256d is relaxed.
+#if defined(__GNUC__) || defined(__clang__)
+typedef double m256d_storage __attribute__((__vector_size__(32), __aligned__(16)));
+#else
+typedef __m256d m256d_storage;
+#endif
+#endif
 #endif
 // If the user specified using doubles, define the real type as double
 // Also set some constants. The same is done if floats were specified.
@@ -12,7 +12,7 @@
 // Authors: Hammad Mazhar
 // =============================================================================
 //
-// Description: SSE and normal implementation of a 3D vector
+// Description: SSE (float), AVX (double) and normal implementation of a 3D vector
 // =============================================================================
 
 #pragma once
@@ -29,6 +29,11 @@ namespace chrono {
 #ifdef CHRONO_USE_SIMD
 static const __m128 SIGNMASK = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
 #endif
+#ifdef CHRONO_USE_AVX
+static const __m256d SIGNMASK_D = _mm256_set1_pd(-0.0);
+// Lane mask for x, y, z: the fourth lane of a real3 is padding and kept at zero.
+static const __m256d XYZMASK_D = _mm256_castsi256_pd(_mm256_set_epi64x(0, -1, -1, -1));
+#endif
 
 class CHRONO_ALIGN_16 real3 {
  public:
@@ -39,6 +44,9 @@ class CHRONO_ALIGN_16 real3 {
     real array[3];
 #ifdef CHRONO_USE_SIMD
     __m128 mmvalue;
+#endif
+#ifdef CHRONO_USE_AVX
+    m256d_storage mmvalue;  // x, y, z and a padding lane, kept at zero
 #endif
   };
 
@@ -72,6 +80,49 @@ class CHRONO_ALIGN_16 real3 {
                                  _mm_shuffle_ps(b.mmvalue, b.mmvalue, _MM_SHUFFLE(3, 0, 2, 1))));
   }
 
+#elif defined(CHRONO_USE_AVX)
+  inline real3() : mmvalue(_mm256_setzero_pd()) {}
+  inline real3(real a) : mmvalue(_mm256_set_pd(0, a, a, a)) {}
+  inline real3(real a, real b, real c) : mmvalue(_mm256_set_pd(0, c, b, a)) {}
+  inline real3(__m256d m) : mmvalue(m) {}
+
+  inline operator __m256d() const { return mmvalue; }
+
+  inline real3 operator+(const real3& b) const { return _mm256_add_pd(*this, b); }
+  inline real3 operator-(const real3& b) const { return _mm256_sub_pd(*this, b); }
+  inline real3 operator*(const real3& b) const { return _mm256_mul_pd(*this, b); }
+  // 0/0 in the padding lane must not leave a NaN there
+  inline real3 operator/(const real3& b) const { return _mm256_and_pd(_mm256_div_pd(*this, b), XYZMASK_D); }
+  inline real3 operator-() const { return _mm256_xor_pd(*this, SIGNMASK_D); }
+
+  inline real3 operator+(real b) const { return _mm256_add_pd(*this, _mm256_set_pd(0, b, b, b)); }
+  inline real3 operator-(real b) const { return _mm256_sub_pd(*this, _mm256_set_pd(0, b, b, b)); }
+  inline real3 operator*(real b) const { return _mm256_mul_pd(*this, _mm256_set_pd(0, b, b, b)); }
+  inline real3 operator/(real b) const { return _mm256_and_pd(_mm256_div_pd(*this, _mm256_set1_pd(b)), XYZMASK_D); }
+
+  inline real dot(const real3& b) const {
+    __m256d p = _mm256_mul_pd(*this, b);
+    __m128d xy = _mm256_castpd256_pd128(p);
+    __m128d zw = _mm256_extractf128_pd(p, 1);
+    return _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(xy, _mm_unpackhi_pd(xy, xy)), zw));
+  }
+  inline real length() const { return Sqrt(dot(*this)); }
+  inline real rlength() const { return real(1.0) / length(); }
+  inline real3 normalize() const { return *this * rlength(); }
+#ifdef CHRONO_AVX_2_0
+  inline real3 cross(const real3& b) const {
+    __m256d a_yzx = _mm256_permute4x64_pd(*this, _MM_SHUFFLE(3, 0, 2, 1));
+    __m256d a_zxy = _mm256_permute4x64_pd(*this, _MM_SHUFFLE(3, 1, 0, 2));
+    __m256d b_yzx = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m256d b_zxy = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm256_sub_pd(_mm256_mul_pd(a_yzx, b_zxy), _mm256_mul_pd(a_zxy, b_yzx));
+  }
+#else
+  inline real3 cross(const real3& b) const {
+    return real3((y * b.z) - (z * b.y), (z * b.x) - (x * b.z), (x * b.y) - (y * b.x));
+  }
+#endif
+
 #else
   inline real3() : x(0), y(0), z(0) {}
   inline real3(real a) : x(a), y(a), z(a) {}
@@ -187,7 +238,22 @@ static inline real3 lerp(const real3& a, const real3& b, real alpha) {
   return (a + alpha * (b - a));
 }
 static inline real3 absolute(const real3& a) {
+#ifdef CHRONO_USE_AVX
+  return _mm256_andnot_pd(SIGNMASK_D, a);
+#else
   return R3(Abs(a.x), Abs(a.y), Abs(a.z));
+#endif
+}
+// Component-wise sign (-1, 0 or +1), see sign(real)
+static inline real3 sign(const real3& a) {
+#ifdef CHRONO_USE_AVX
+  __m256d one = _mm256_set1_pd(1.0);
+  __m256d pos = _mm256_and_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_GT_OQ), one);
+  __m256d neg = _mm256_and_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_LT_OQ), one);
+  return _mm256_sub_pd(pos, neg);
+#else
+  return R3(sign(a.x), sign(a.y), sign(a.z));
+#endif
 }
 static inline bool isEqual(const real3& a, const real3& b) {
   return isEqual(a.x, b.x) && isEqual(a.y, b.y) && isEqual(a.z, b.z);
@@ -205,11 +271,8 @@ static real min3(const real3& a) {
 }
 
 static inline real3 clamp(const real3& a, const real3& clamp_min, const real3& clamp_max) {
-  real3 clampv;
-  clampv.x = clamp(a.x, clamp_min.x, clamp_max.x);
-  clampv.y = clamp(a.y, clamp_min.y, clamp_max.y);
-  clampv.z = clamp(a.z, clamp_min.z, clamp_max.z);
-  return clampv;
+  return R3(clamp(a.x, clamp_min.x, clamp_max.x), clamp(a.y, clamp_min.y, clamp_max.y),
+            clamp(a.z, clamp_min.z, clamp_max.z));
 }
 }
 
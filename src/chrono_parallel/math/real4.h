@@ -12,7 +12,8 @@
 // Authors: Hammad Mazhar
 // =============================================================================
 //
-// Description: SSE and normal implementation of a 4D vector/Quaternion
+// Description: SSE (float), AVX (double) and normal implementation of a 4D
+// vector/Quaternion
 // =============================================================================
 
 #pragma once
@@ -52,6 +53,21 @@ static inline __m128 change_sign(__m128 const& a) {
 }
 #endif
 
+#ifdef CHRONO_USE_AVX
+static inline real horizontal_add(const __m256d& a) {
+  __m128d t1 = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(t1, _mm_unpackhi_pd(t1, t1)));
+}
+
+// Flip the sign of the lanes (in w, x, y, z order) with a non-zero template argument
+template <int i0, int i1, int i2, int i3>
+static inline __m256d change_sign(__m256d const& a) {
+  if ((i0 | i1 | i2 | i3) == 0)
+    return a;
+  return _mm256_xor_pd(a, _mm256_set_pd(i3 ? -0.0 : 0.0, i2 ? -0.0 : 0.0, i1 ? -0.0 : 0.0, i0 ? -0.0 : 0.0));
+}
+#endif
+
 class CHRONO_ALIGN_16 real4 {
  public:
   union {
@@ -60,6 +76,9 @@ class CHRONO_ALIGN_16 real4 {
     };
 #ifdef CHRONO_USE_SIMD
     __m128 mmvalue;
+#endif
+#ifdef CHRONO_USE_AVX
+    m256d_storage mmvalue;
 #endif
   };
 
@@ -94,6 +113,33 @@ class CHRONO_ALIGN_16 real4 {
     real t1 = horizontal_add(l);
     return real4(change_sign<0, 1, 1, 1>(mmvalue)) / t1;
   }
+#elif defined(CHRONO_USE_AVX)
+  inline real4() : mmvalue(_mm256_setzero_pd()) {}
+  inline real4(real a) : mmvalue(_mm256_set1_pd(a)) {}
+  inline real4(real a, real b, real c) : mmvalue(_mm256_set_pd(c, b, a, 0)) {}
+  inline real4(const real3& a) : mmvalue(_mm256_set_pd(a.z, a.y, a.x, 0)) {}
+  inline real4(real d, real a, real b, real c) : mmvalue(_mm256_set_pd(c, b, a, d)) {}
+  inline real4(__m256d m) : mmvalue(m) {}
+
+  operator __m256d() const { return mmvalue; }
+
+  inline real4 operator+(const real4& b) const { return _mm256_add_pd(*this, b); }
+  inline real4 operator-(const real4& b) const { return _mm256_sub_pd(*this, b); }
+  inline real4 operator*(const real4& b) const { return _mm256_mul_pd(*this, b); }
+  inline real4 operator/(const real4& b) const { return _mm256_div_pd(*this, b); }
+  inline real4 operator-() const { return _mm256_xor_pd(*this, SIGNMASK_D); }
+
+  inline real4 operator+(real b) const { return _mm256_add_pd(*this, _mm256_set1_pd(b)); }
+  inline real4 operator-(real b) const { return _mm256_sub_pd(*this, _mm256_set1_pd(b)); }
+  inline real4 operator*(real b) const { return _mm256_mul_pd(*this, _mm256_set1_pd(b)); }
+  inline real4 operator/(real b) const { return _mm256_div_pd(*this, _mm256_set1_pd(b)); }
+
+  inline real dot(const real4& b) const { return horizontal_add(_mm256_mul_pd(*this, b)); }
+
+  inline real4 inv() const {
+    real t1 = horizontal_add(_mm256_mul_pd(*this, *this));
+    return real4(change_sign<0, 1, 1, 1>(*this)) / t1;
+  }
 #else
   inline real4() : w(0), x(0), y(0), z(0) {}
   inline real4(real a) : w(a), x(a), y(a), z(a) {}
@@ -102,13 +148,13 @@ class CHRONO_ALIGN_16 real4 {
   inline real4(real d, real a, real b, real c) : w(d), x(a), y(b), z(c) {}
 
   inline real4 operator+(const real4& b) const { return real4(w + b.w, x + b.x, y + b.y, z + b.z); }
-  inline real4 operator-(const real4& b) const { return real4(w - b.w, x - b.x, y + b.y, z - b.z); }
+  inline real4 operator-(const real4& b) const { return real4(w - b.w, x - b.x, y - b.y, z - b.z); }
   inline real4 operator*(const real4& b) const { return real4(w * b.w, x * b.x, y * b.y, z * b.z); }
   inline real4 operator/(const real4& b) const { return real4(w / b.w, x / b.x, y / b.y, z / b.z); }
   inline real4 operator-() const { return real4(-w, -x, -y, -z); }
 
   inline real4 operator+(real b) const { return real4(w + b, x + b, y + b, z + b); }
-  inline real4 operator-(real b) const { return real4(w - b, x - b, y + b, z - b); }
+  inline real4 operator-(real b) const { return real4(w - b, x - b, y - b, z - b); }
   inline real4 operator*(real b) const { return real4(w * b, x * b, y * b, z * b); }
   inline real4 operator/(real b) const { return real4(w / b, x / b, y / b, z / b); }
 
@@ -187,7 +233,7 @@ static inline quaternion inv(const quaternion& a) {
 }
 
 static inline real4 operator~(real4 const& a) {
-#ifdef CHRONO_USE_SIMD
+#if defined(CHRONO_USE_SIMD) || defined(CHRONO_USE_AVX)
   return real4(change_sign<0, 1, 1, 1>(a));
 #else
   return real4(a.w, -a.x, -a.y, -a.z);
@@ -255,6 +301,23 @@ static inline quaternion mult(const quaternion& a, const quaternion& b) {
   __m128 t0 = _mm_mul_ps(a0000, b);
   __m128 t03 = _mm_sub_ps(t0, t3);
   return _mm_add_ps(t03, t12m);
+#elif defined(CHRONO_USE_AVX) && defined(CHRONO_AVX_2_0)
+  // Same scheme as the SSE version, with lane permutations in place of shuffles
+  __m256d a1123 = _mm256_permute4x64_pd(a, 0xE5);
+  __m256d a2231 = _mm256_permute4x64_pd(a, 0x7A);
+  __m256d b1000 = _mm256_permute4x64_pd(b, 0x01);
+  __m256d b2312 = _mm256_permute4x64_pd(b, 0x9E);
+  __m256d t1 = _mm256_mul_pd(a1123, b1000);
+  __m256d t2 = _mm256_mul_pd(a2231, b2312);
+  __m256d t12 = _mm256_add_pd(t1, t2);
+  __m256d t12m = change_sign<1, 0, 0, 0>(t12);
+  __m256d a3312 = _mm256_permute4x64_pd(a, 0x9F);
+  __m256d b3231 = _mm256_permute4x64_pd(b, 0x7B);
+  __m256d a0000 = _mm256_permute4x64_pd(a, 0x00);
+  __m256d t3 = _mm256_mul_pd(a3312, b3231);
+  __m256d t0 = _mm256_mul_pd(a0000, b);
+  __m256d t03 = _mm256_sub_pd(t0, t3);
+  return _mm256_add_pd(t03, t12m);
 #else
   quaternion temp;
   temp.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
@@ -298,7 +361,13 @@ static inline quaternion slerp(const quaternion& a, const quaternion& b, real al
 }
 
 static inline real3 quatRotate(const real3& v, const quaternion& q) {
-#ifdef CHRONO_USE_SIMD
+#if defined(CHRONO_USE_AVX) && defined(CHRONO_AVX_2_0)
+  // Same as the SSE version; the vector part and the broadcast scalar part are
+  // permuted out of the quaternion register instead of being rebuilt from its fields
+  real3 qv = _mm256_blend_pd(_mm256_permute4x64_pd(q, _MM_SHUFFLE(0, 3, 2, 1)), _mm256_setzero_pd(), 0x8);
+  real3 t = 2 * cross(qv, v);
+  return v + real3(_mm256_mul_pd(_mm256_permute4x64_pd(q, 0), t)) + cross(qv, t);
+#elif defined(CHRONO_USE_SIMD)
   real3 t = 2 * cross(real3(q.x, q.y, q.z), v);
   return v + q.w * t + cross(real3(q.x, q.y, q.z), t);
 // return v+2.0*cross(cross(v,real3(q.x,q.y,q.z))+q.w*v, real3(q.x,q.y,q.z));
@@ -326,14 +395,12 @@ static inline real3 quatRotateT(const real3& v, const quaternion& q) {
 }
 
 static inline real3 quatRotateMat(const real3& v, const quaternion& q) {
-  real3 result;
-  result.x = (q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z) * v.x + (2 * q.x * q.y - 2 * q.w * q.z) * v.y +
-             (2 * q.x * q.z + 2 * q.w * q.y) * v.z;
-  result.y = (2 * q.x * q.y + 2 * q.w * q.z) * v.x + (q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z) * v.y +
-             (2 * q.y * q.z - 2 * q.w * q.x) * v.z;
-  result.z = (2 * q.x * q.z - 2 * q.w * q.y) * v.x + (2 * q.y * q.z + 2 * q.w * q.x) * v.y +
-             (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z) * v.z;
-  return result;  // quatRotate(v,q);
+  return R3((q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z) * v.x + (2 * q.x * q.y - 2 * q.w * q.z) * v.y +
+                (2 * q.x * q.z + 2 * q.w * q.y) * v.z,
+            (2 * q.x * q.y + 2 * q.w * q.z) * v.x + (q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z) * v.y +
+                (2 * q.y * q.z - 2 * q.w * q.x) * v.z,
+            (2 * q.x * q.z - 2 * q.w * q.y) * v.x + (2 * q.y * q.z + 2 * q.w * q.x) * v.y +
+                (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z) * v.z);  // quatRotate(v,q);
 }
 static inline real3 quatRotateMatT(const real3& v, const quaternion& q) {
   //	real3 result;
@@ -350,8 +417,6 @@ static inline quaternion operator%(const quaternion rhs, const quaternion lhs) {
 }
 
 static inline real3 AMatV(const real4& q) {
-  real3 V;
-
   real e0e0 = q.w * q.w;
   real e2e2 = q.y * q.y;
   real e0e1 = q.w * q.x;
@@ -359,10 +424,6 @@ static inline real3 AMatV(const real4& q) {
   real e1e2 = q.x * q.y;
   real e2e3 = q.y * q.z;
 
-  V.x = (e1e2 - e0e3) * 2;
-  V.y = (e0e0 + e2e2) * 2 - 1;
-  V.z = (e2e3 + e0e1) * 2;
-
-  return V;
+  return R3((e1e2 - e0e3) * 2, (e0e0 + e2e2) * 2 - 1, (e2e3 + e0e1) * 2);
 }
 }
@@ -37,6 +37,8 @@ ChSystemParallel::ChSystemParallel(unsigned int max_objects) : ChSystem(1000, 10
   data_manager->system_timer.AddTimer("collision");
   data_manager->system_timer.AddTimer("collision_broad");
   data_manager->system_timer.AddTimer("collision_narrow");
+  data_manager->system_timer.AddTimer("collision_broad_rebuild");
+  data_manager->system_timer.AddTimer("collision_broad_reuse");
   data_manager->system_timer.AddTimer("solver");
 
   data_manager->system_timer.AddTimer("ChIterativeSolverParallel_Solve");
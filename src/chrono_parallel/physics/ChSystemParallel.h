@@ -99,6 +99,16 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
   /// Gets the total time for the collision detection step
   double GetTimerCollision() { return data_manager->system_timer.GetTime("collision"); }
 
+  /// Gets the fraction of broadphase calls that rebuilt the pair list from scratch
+  /// (the others reused it, see collision_settings::temporal_coherence). The time
+  /// spent in each case within the time step is reported by the timers
+  /// "collision_broad_rebuild" and "collision_broad_reuse".
+  double GetBroadphaseRebuildRatio() const {
+    const collision_measures& measures = data_manager->measures.collision;
+    uint total = measures.num_broadphase_rebuilds + measures.num_broadphase_reuses;
+    return total > 0 ? double(measures.num_broadphase_rebuilds) / total : 1.0;
+  }
+
   /// Calculate cummulative contact forces for all bodies in the system.
   virtual void CalculateContactForces() {}
 
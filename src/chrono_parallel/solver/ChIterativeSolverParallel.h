@@ -59,7 +59,8 @@ class CH_PARALLEL_API ChIterativeSolverParallel : public ChIterativeSolver {
 
 class CH_PARALLEL_API ChIterativeSolverParallelDVI : public ChIterativeSolverParallel {
   public:
-    ChIterativeSolverParallelDVI(ChParallelDataManager* dc) : ChIterativeSolverParallel(dc) {}
+    ChIterativeSolverParallelDVI(ChParallelDataManager* dc)
+        : ChIterativeSolverParallel(dc), keys_sorted(false), last_step(0) {}
 
     virtual void RunTimeStep();
     virtual void ComputeImpulses();
@@ -78,9 +79,28 @@ class CH_PARALLEL_API ChIterativeSolverParallelDVI : public ChIterativeSolverPar
     void PreSolve();
     ///< This function is used to change the solver algorithm.
     void ChangeSolverType(SOLVERTYPE type);
+    ///< With warm starting (see ChSystem::SetSolverWarmStarting), seed the impulses
+    ///< of the contacts that were also found at the last step
+    void WarmStartContacts();
+    ///< With warm starting, keep the impulses of the contacts for the next step
+    void StoreContactImpulses();
 
   private:
+    ///< Sort the keys (shape pairs, or shape and mesh triangle) of the contacts,
+    ///< keeping the contact indices
+    void SortContactKeys();
+
     ChConstraintRigidRigid rigid_rigid;
+
+    // Warm starting: sorted keys of the contacts of this step, with their indices,
+    // and sorted keys of the contacts of the last step, with their impulses
+    // (6 per contact: normal, sliding and spinning)
+    custom_vector<long long> sorted_keys;
+    custom_vector<uint> sorted_index;
+    bool keys_sorted;
+    custom_vector<long long> last_keys;
+    custom_vector<real> last_gamma;
+    real last_step;
 };
 
 class CH_PARALLEL_API ChIterativeSolverParallelDEM : public ChIterativeSolverParallel {
@@ -109,6 +129,16 @@ class CH_PARALLEL_API ChIterativeSolverParallelDEM : public ChIterativeSolverPar
     void host_AddContactForces(uint ct_body_count, const custom_vector<int>& ct_body_id);
 
     void host_SetContactForcesMap(uint ct_body_count, const custom_vector<int>& ct_body_id);
+
+    uint host_BinContactForces(const custom_vector<int>& ext_body_id,
+                               const custom_vector<real3>& ext_body_force,
+                               const custom_vector<real3>& ext_body_torque,
+                               custom_vector<int>& ct_body_id);
+
+    custom_vector<int> body_bin;     ///< bin of each body in contact (-1 for the other bodies)
+    custom_vector<uint> bin_offset;  ///< per chunk of contacts, offset of its entries in each body bin
+    custom_vector<uint> bin_start;   ///< first entry of each body bin
+    custom_vector<int> bin_entry;    ///< entries (2 per contact) sorted by body
 };
 
 }  // end namespace chrono
@@ -20,7 +20,10 @@
 // on the velocity manifold of the bilateral constraints.
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChSystemDEM.h"
+#include "chrono/collision/ChCCollisionModel.h"
 #include "chrono_parallel/solver/ChIterativeSolverParallel.h"
 
 using namespace chrono;
@@ -466,6 +469,104 @@ void ChIterativeSolverParallelDEM::host_SetContactForcesMap(uint ct_body_count,
     }
 }
 
+// -----------------------------------------------------------------------------
+// Accumulate the per-contact forces and torques on the bodies without sorting.
+// Only the bodies in contact get a bin, numbered in the order in which they
+// first appear in the entry list, so the work does not grow with the number of
+// bodies. The entries are binned with a counting sort: the entry list is split
+// in chunks, each chunk counts its entries per bin and the counts are scanned,
+// so that each chunk knows where its entries go in the bins. The entries of a
+// body are then summed by a single thread, in the order of the contacts, so the
+// result does not depend on the number of threads.
+// -----------------------------------------------------------------------------
+uint ChIterativeSolverParallelDEM::host_BinContactForces(const custom_vector<int>& ext_body_id,
+                                                         const custom_vector<real3>& ext_body_force,
+                                                         const custom_vector<real3>& ext_body_torque,
+                                                         custom_vector<int>& ct_body_id) {
+    custom_vector<real3>& ct_body_force = data_manager->host_data.ct_body_force;
+    custom_vector<real3>& ct_body_torque = data_manager->host_data.ct_body_torque;
+    int num_entries = (int)ext_body_id.size();
+    if (num_entries == 0) {
+        ct_body_force.resize(0);
+        ct_body_torque.resize(0);
+        return 0;
+    }
+
+    // Give a bin to each body in contact. body_bin is -1 for all the bodies
+    // between calls: it is reset below for the bodies in contact only.
+    body_bin.resize(data_manager->num_rigid_bodies, -1);
+    int num_bins = 0;
+    for (int i = 0; i < num_entries; i++) {
+        int body = ext_body_id[i];
+        if (body_bin[body] < 0) {
+            body_bin[body] = num_bins;
+            ct_body_id[num_bins++] = body;
+        }
+    }
+
+    int num_chunks = std::max(1, std::min(CHOMPfunctions::GetMaxThreads(), num_entries));
+    int chunk_size = (num_entries + num_chunks - 1) / num_chunks;
+
+    // Count the entries of each chunk per bin
+    bin_offset.resize((size_t)num_chunks * num_bins);
+    thrust::fill(bin_offset.begin(), bin_offset.end(), 0);
+#pragma omp parallel for
+    for (int c = 0; c < num_chunks; c++) {
+        uint* count = bin_offset.data() + (size_t)c * num_bins;
+        int end = std::min(num_entries, (c + 1) * chunk_size);
+        for (int i = c * chunk_size; i < end; i++) {
+            count[body_bin[ext_body_id[i]]]++;
+        }
+    }
+
+    // Turn the counts into the offsets of the chunks in each bin, then scan the
+    // bin sizes to find the start of the bins
+    bin_start.resize(num_bins + 1);
+#pragma omp parallel for
+    for (int b = 0; b < num_bins; b++) {
+        uint offset = 0;
+        for (int c = 0; c < num_chunks; c++) {
+            uint count = bin_offset[(size_t)c * num_bins + b];
+            bin_offset[(size_t)c * num_bins + b] = offset;
+            offset += count;
+        }
+        bin_start[b] = offset;
+    }
+    bin_start[num_bins] = 0;
+    thrust::exclusive_scan(thrust_parallel, bin_start.begin(), bin_start.end(), bin_start.begin());
+
+    // Fill the bins, keeping the order of the contacts within each bin
+    bin_entry.resize(num_entries);
+#pragma omp parallel for
+    for (int c = 0; c < num_chunks; c++) {
+        uint* offset = bin_offset.data() + (size_t)c * num_bins;
+        int end = std::min(num_entries, (c + 1) * chunk_size);
+        for (int i = c * chunk_size; i < end; i++) {
+            int bin = body_bin[ext_body_id[i]];
+            bin_entry[bin_start[bin] + offset[bin]++] = i;
+        }
+    }
+
+    ct_body_force.resize(num_bins);
+    ct_body_torque.resize(num_bins);
+
+    // Sum the forces and torques of each body (no bin is empty)
+#pragma omp parallel for
+    for (int b = 0; b < num_bins; b++) {
+        real3 force = ext_body_force[bin_entry[bin_start[b]]];
+        real3 torque = ext_body_torque[bin_entry[bin_start[b]]];
+        for (uint k = bin_start[b] + 1; k < bin_start[b + 1]; k++) {
+            force += ext_body_force[bin_entry[k]];
+            torque += ext_body_torque[bin_entry[k]];
+        }
+        ct_body_force[b] = force;
+        ct_body_torque[b] = torque;
+        body_bin[ct_body_id[b]] = -1;
+    }
+
+    return num_bins;
+}
+
 // Binary operation for adding two-object tuples
 struct sum_tuples {
   thrust::tuple<real3, real3> operator()(const thrust::tuple<real3, real3> & a, const thrust::tuple<real3, real3> & b) const {
@@ -493,10 +594,21 @@ void ChIterativeSolverParallelDEM::ProcessContacts() {
         shape_pairs.resize(data_manager->num_rigid_contacts);
         shear_touch.resize(max_shear * data_manager->num_rigid_bodies);
         thrust::fill(thrust_parallel, shear_touch.begin(), shear_touch.end(), false);
+        // The contact history of a triangle mesh shape is kept per triangle: the
+        // triangle in contact replaces the mesh, numbered after all the shapes.
+        const custom_vector<int>& triangle = data_manager->host_data.tri_rigid_rigid;
+        bool has_triangles = triangle.size() == data_manager->num_rigid_contacts;
+        int num_shapes = data_manager->num_rigid_shapes;
 #pragma omp parallel for
         for (int i = 0; i < data_manager->num_rigid_contacts; i++) {
             int2 pair = I2(int(data_manager->host_data.pair_rigid_rigid[i] >> 32),
                            int(data_manager->host_data.pair_rigid_rigid[i] & 0xffffffff));
+            if (has_triangles && triangle[i] >= 0) {
+                if (data_manager->host_data.typ_rigid[pair.x] == collision::TRIANGLEMESH_BVH)
+                    pair.x = num_shapes + triangle[i];
+                else
+                    pair.y = num_shapes + triangle[i];
+            }
             shape_pairs[i] = pair;
         }
     }
@@ -518,10 +630,18 @@ void ChIterativeSolverParallelDEM::ProcessContacts() {
     //    involved in at least one contact, by reducing the contact forces and
     //    torques from all contacts these bodies are involved in. The number of
     //    bodies that experience at least one contact is 'ct_body_count'.
+    custom_vector<int> ct_body_id(data_manager->num_rigid_bodies);
+
+    if (data_manager->settings.solver.force_accumulation == ACCUMULATE_BINNED) {
+        uint ct_body_count = host_BinContactForces(ext_body_id, ext_body_force, ext_body_torque, ct_body_id);
+        host_AddContactForces(ct_body_count, ct_body_id);
+        host_SetContactForcesMap(ct_body_count, ct_body_id);
+        return;
+    }
+
     thrust::sort_by_key(thrust_parallel, ext_body_id.begin(), ext_body_id.end(),
                         thrust::make_zip_iterator(thrust::make_tuple(ext_body_force.begin(), ext_body_torque.begin())));
 
-    custom_vector<int> ct_body_id(data_manager->num_rigid_bodies);
     custom_vector<real3>& ct_body_force = data_manager->host_data.ct_body_force;
     custom_vector<real3>& ct_body_torque = data_manager->host_data.ct_body_torque;
 
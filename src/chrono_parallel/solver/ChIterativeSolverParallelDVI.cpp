@@ -1,3 +1,9 @@
+#include <algorithm>
+
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include "collision/ChCCollisionModel.h"
+
 #include "chrono_parallel/solver/ChIterativeSolverParallel.h"
 #include "chrono_parallel/math/ChThrustLinearAlgebra.h"
 
@@ -41,6 +47,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
 
   data_manager->host_data.gamma.resize(data_manager->num_constraints);
   data_manager->host_data.gamma.reset();
+  WarmStartContacts();
 
   // Perform any setup tasks for all constraint types
   rigid_rigid.Setup(data_manager);
@@ -107,6 +114,7 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
   data_manager->system_timer.stop("ChIterativeSolverParallel_Solve");
 
   ComputeImpulses();
+  StoreContactImpulses();
 
   for (int i = 0; i < data_manager->measures.solver.maxd_hist.size(); i++) {
     AtIterationEnd(data_manager->measures.solver.maxd_hist[i], data_manager->measures.solver.maxdeltalambda_hist[i],
@@ -117,6 +125,119 @@ void ChIterativeSolverParallelDVI::RunTimeStep() {
   LOG(TRACE) << "Solve Done: " << residual;
 }
 
+// A contact is identified by the pair of shapes in contact and, for pairs with
+// more than one contact, by its rank among the contacts of the pair. For a
+// triangle mesh shape, the triangle in contact replaces the mesh in the key (the
+// triangles of all the meshes are numbered together, so they identify the mesh
+// too, and the highest bit tells these keys apart): the contacts with different
+// triangles of a mesh are told apart whatever their order. The keys of the
+// contacts of the last step are kept sorted, so that each contact of this step
+// finds its match independently with a binary search: a merge-join of the two
+// sorted key lists done in parallel.
+void ChIterativeSolverParallelDVI::SortContactKeys() {
+  uint num_contacts = data_manager->num_rigid_contacts;
+  sorted_keys = data_manager->host_data.pair_rigid_rigid;
+  const custom_vector<int>& triangle = data_manager->host_data.tri_rigid_rigid;
+  if (triangle.size() == num_contacts) {
+    const int* obj_data_T = data_manager->host_data.typ_rigid.data();
+#pragma omp parallel for
+    for (int i = 0; i < (signed)num_contacts; i++) {
+      if (triangle[i] < 0) {
+        continue;
+      }
+      long long p = sorted_keys[i];
+      int2 pair = I2(int(p >> 32), int(p & 0xffffffff));
+      unsigned long long other = (obj_data_T[pair.x] == collision::TRIANGLEMESH_BVH) ? pair.y : pair.x;
+      sorted_keys[i] = (long long)((1ULL << 63) | (other << 32) | (unsigned int)triangle[i]);
+    }
+  }
+  sorted_index.resize(num_contacts);
+  thrust::sequence(sorted_index.begin(), sorted_index.end());
+  // stable, so that the contacts of a pair keep their order
+  thrust::stable_sort_by_key(thrust_parallel, sorted_keys.begin(), sorted_keys.end(), sorted_index.begin());
+  keys_sorted = true;
+}
+
+void ChIterativeSolverParallelDVI::WarmStartContacts() {
+  uint num_contacts = data_manager->num_rigid_contacts;
+  data_manager->measures.solver.num_warm_started = 0;
+  keys_sorted = false;
+
+  // The keys are not available with the Bullet collision system
+  if (!warm_start || num_contacts == 0 || last_keys.size() == 0 || last_step <= 0 ||
+      data_manager->host_data.pair_rigid_rigid.size() != num_contacts) {
+    return;
+  }
+
+  LOG(INFO) << "ChIterativeSolverParallelDVI::WarmStartContacts()";
+  SortContactKeys();
+
+  DynamicVector<real>& gamma = data_manager->host_data.gamma;
+  const long long* keys = sorted_keys.data();
+  const long long* old_keys = last_keys.data();
+  const long long* old_end = old_keys + last_keys.size();
+  const uint offset = rigid_rigid.offset;
+  // the impulses scale with the step size
+  const real scale = data_manager->settings.step_size / last_step;
+  uint num_matched = 0;
+
+#pragma omp parallel for reduction(+ : num_matched)
+  for (int i = 0; i < (signed)num_contacts; i++) {
+    long long key = keys[i];
+    size_t rank = i - (std::lower_bound(keys, keys + i, key) - keys);
+    const long long* match = std::lower_bound(old_keys, old_end, key) + rank;
+    if (match >= old_end || *match != key) {
+      continue;
+    }
+    const real* old_gamma = &last_gamma[6 * (match - old_keys)];
+    uint c = sorted_index[i];
+    gamma[c] = scale * old_gamma[0];
+    if (offset >= 3) {
+      gamma[num_contacts + c * 2 + 0] = scale * old_gamma[1];
+      gamma[num_contacts + c * 2 + 1] = scale * old_gamma[2];
+    }
+    if (offset == 6) {
+      gamma[3 * num_contacts + c * 3 + 0] = scale * old_gamma[3];
+      gamma[3 * num_contacts + c * 3 + 1] = scale * old_gamma[4];
+      gamma[3 * num_contacts + c * 3 + 2] = scale * old_gamma[5];
+    }
+    num_matched++;
+  }
+
+  data_manager->measures.solver.num_warm_started = num_matched;
+}
+
+void ChIterativeSolverParallelDVI::StoreContactImpulses() {
+  uint num_contacts = data_manager->num_rigid_contacts;
+  if (!warm_start || data_manager->host_data.pair_rigid_rigid.size() != num_contacts) {
+    last_keys.clear();
+    return;
+  }
+
+  if (!keys_sorted) {
+    SortContactKeys();
+  }
+
+  const DynamicVector<real>& gamma = data_manager->host_data.gamma;
+  const uint offset = rigid_rigid.offset;
+  last_gamma.resize(6 * num_contacts);
+
+#pragma omp parallel for
+  for (int i = 0; i < (signed)num_contacts; i++) {
+    uint c = sorted_index[i];
+    real* g = &last_gamma[6 * i];
+    g[0] = gamma[c];
+    g[1] = offset >= 3 ? gamma[num_contacts + c * 2 + 0] : 0;
+    g[2] = offset >= 3 ? gamma[num_contacts + c * 2 + 1] : 0;
+    g[3] = offset == 6 ? gamma[3 * num_contacts + c * 3 + 0] : 0;
+    g[4] = offset == 6 ? gamma[3 * num_contacts + c * 3 + 1] : 0;
+    g[5] = offset == 6 ? gamma[3 * num_contacts + c * 3 + 2] : 0;
+  }
+
+  last_keys.swap(sorted_keys);
+  last_step = data_manager->settings.step_size;
+}
+
 void ChIterativeSolverParallelDVI::ComputeD() {
   LOG(INFO) << "ChIterativeSolverParallelDVI::ComputeD()";
   data_manager->system_timer.start("ChIterativeSolverParallel_D");
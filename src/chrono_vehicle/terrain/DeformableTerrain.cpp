@@ -16,6 +16,8 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cfloat>
 #include <cstdio>
 #include <cmath>
 
@@ -86,6 +88,28 @@ bool DeformableTerrain::GetBulldozingFlow() const {
     return m_ground->do_bulldozing;
 }
 
+// Select parallel (Jacobi) or sequential (Gauss-Seidel) erosion sweeps.
+void DeformableTerrain::SetBulldozingParallelErosion(bool mb) {
+    m_ground->bulldozing_parallel_erosion = mb;
+}
+
+bool DeformableTerrain::GetBulldozingParallelErosion() const {
+    return m_ground->bulldozing_parallel_erosion;
+}
+
+// Enable the update of the active domain only.
+void DeformableTerrain::SetActiveDomainUpdate(bool mb) {
+    m_ground->do_active_domain = mb;
+}
+
+bool DeformableTerrain::GetActiveDomainUpdate() const {
+    return m_ground->do_active_domain;
+}
+
+void DeformableTerrain::SetActiveDomainMargin(double margin) {
+    m_ground->active_domain_margin = margin;
+}
+
 // Set properties of the SCM soil model
 void DeformableTerrain::SetSoilParametersSCM(
     double mBekker_Kphi,    // Kphi, frictional modulus in Bekker model
@@ -118,6 +142,8 @@ void DeformableTerrain::SetPlotType(DataPlotType mplot, double mmin, double mmax
     m_ground->plot_type = mplot;
     m_ground->plot_v_min = mmin;
     m_ground->plot_v_max = mmax;
+    // recompute the colors of all vertices at the next update
+    m_ground->m_trimesh_shape->GetMesh().getCoordsColors().clear();
 }
 
 // Initialize the terrain as a flat grid
@@ -161,6 +187,10 @@ DeformableSoil::DeformableSoil(ChSystem* system) {
     do_bulldozing = false;
     bulldozing_flow_factor = 1.2;
     bulldozing_erosion_angle = 40;
+    bulldozing_parallel_erosion = false;
+
+    do_active_domain = false;
+    active_domain_margin = 0.1;
 
     Bekker_Kphi = 2e6;
     Bekker_Kc = 0;
@@ -244,6 +274,10 @@ void DeformableSoil::Initialize(double height, double sizeX, double sizeY, int n
 void DeformableSoil::Initialize(const std::string& mesh_file) {
     m_trimesh_shape->GetMesh().Clear();
     m_trimesh_shape->GetMesh().LoadWavefrontMesh(mesh_file, true, true);
+
+    // Needed! precomputes aux.topology 
+    // data structures for the mesh, aux. material data, etc.
+    SetupAuxData();
 }
 
 // Initialize the terrain from a specified height map.
@@ -371,7 +405,9 @@ void DeformableSoil::Initialize(const std::string& heightmap_file,
 void DeformableSoil::SetupAuxData() {
     // better readability:
     std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
 
     // Reset and initialize computation data:
     //
@@ -388,15 +424,356 @@ void DeformableSoil::SetupAuxData() {
     p_tau.resize( vertices.size());  
     p_id_island.resize (vertices.size());
     p_erosion.resize(vertices.size());
+    p_modified.assign(vertices.size(), false);
+    p_normal_modified.assign(normals.size(), false);
+
+    active_vertexes.clear();
+    modified_vertexes.clear();
+    modified_vertexes_old.clear();
 
+    p_island_parent.resize(vertices.size());
+
+    // Connected vertices are sorted by index, without duplicates
+    connected_vertexes.clear();
     connected_vertexes.resize( vertices.size() );
+    connected_faces.clear();
+    connected_faces.resize( vertices.size() );
     for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-        connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].y);
-        connected_vertexes[idx_vertices[iface].x].insert(idx_vertices[iface].z);
-        connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].x);
-        connected_vertexes[idx_vertices[iface].y].insert(idx_vertices[iface].z);
-        connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].x);
-        connected_vertexes[idx_vertices[iface].z].insert(idx_vertices[iface].y);
+        connected_vertexes[idx_vertices[iface].x].push_back(idx_vertices[iface].y);
+        connected_vertexes[idx_vertices[iface].x].push_back(idx_vertices[iface].z);
+        connected_vertexes[idx_vertices[iface].y].push_back(idx_vertices[iface].x);
+        connected_vertexes[idx_vertices[iface].y].push_back(idx_vertices[iface].z);
+        connected_vertexes[idx_vertices[iface].z].push_back(idx_vertices[iface].x);
+        connected_vertexes[idx_vertices[iface].z].push_back(idx_vertices[iface].y);
+        connected_faces[idx_vertices[iface].x].push_back(iface);
+        connected_faces[idx_vertices[iface].y].push_back(iface);
+        connected_faces[idx_vertices[iface].z].push_back(iface);
+    }
+    // The normals have their own indices (not the vertex indices, for a mesh
+    // loaded from a file): faces using each normal, in increasing order
+    normal_faces.clear();
+    normal_faces.resize( normals.size() );
+    for (unsigned int iface = 0; iface < idx_normals.size(); ++iface) {
+        normal_faces[idx_normals[iface].x].push_back(iface);
+        normal_faces[idx_normals[iface].y].push_back(iface);
+        normal_faces[idx_normals[iface].z].push_back(iface);
+    }
+    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
+        std::vector<int>& connected = connected_vertexes[iv];
+        std::sort(connected.begin(), connected.end());
+        connected.erase(std::unique(connected.begin(), connected.end()), connected.end());
+    }
+
+    // Compute (pseudo)areas per node.
+    // The vertices only move along the Y axis of the plane, so the areas projected
+    // on the plane do not change during the simulation.
+    // For a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps, 
+    // but the following is more general, also for generic meshes:
+    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
+        p_area[iv] = 0;
+    }
+    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
+        ChVector<> AB = vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x];
+        ChVector<> AC = vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x];
+        AB = plane.TransformDirectionParentToLocal(AB);
+        AC = plane.TransformDirectionParentToLocal(AC);
+        AB.y=0;
+        AC.y=0;
+        double triangle_area = 0.5*(Vcross(AB,AC)).Length();
+        p_area[idx_vertices[it].x] += triangle_area /3.0;
+        p_area[idx_vertices[it].y] += triangle_area /3.0;
+        p_area[idx_vertices[it].z] += triangle_area /3.0;
+    }
+
+    // Grid of the vertices on the X-Z plane, about 16 vertices per cell, used to find
+    // the vertices under the colliding objects (counting sort of the vertices in cells).
+    grid_x0 = grid_z0 = DBL_MAX;
+    double grid_x1 = -DBL_MAX;
+    double grid_z1 = -DBL_MAX;
+    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
+        ChVector<> loc = plane.TransformParentToLocal(vertices[iv]);
+        grid_x0 = ChMin(grid_x0, loc.x);
+        grid_x1 = ChMax(grid_x1, loc.x);
+        grid_z0 = ChMin(grid_z0, loc.z);
+        grid_z1 = ChMax(grid_z1, loc.z);
+    }
+    int n_cells = ChMax((int)vertices.size() / 16, 1);
+    double grid_area = (grid_x1 - grid_x0) * (grid_z1 - grid_z0);
+    grid_cell = (grid_area > 0) ? sqrt(grid_area / n_cells) : ChMax(grid_x1 - grid_x0, grid_z1 - grid_z0) / n_cells;
+    if (!(grid_cell > 0))
+        grid_cell = 1;
+    grid_nx = ChMin((int)((grid_x1 - grid_x0) / grid_cell), n_cells) + 1;
+    grid_nz = ChMin((int)((grid_z1 - grid_z0) / grid_cell), n_cells) + 1;
+
+    std::vector<int> vertex_cell(vertices.size());
+    grid_start.assign(grid_nx * grid_nz + 1, 0);
+    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
+        ChVector<> loc = plane.TransformParentToLocal(vertices[iv]);
+        int ix = ChMin((int)((loc.x - grid_x0) / grid_cell), grid_nx - 1);
+        int iz = ChMin((int)((loc.z - grid_z0) / grid_cell), grid_nz - 1);
+        vertex_cell[iv] = ix + grid_nx * iz;
+        grid_start[vertex_cell[iv] + 1]++;
+    }
+    for (int ic = 0; ic < grid_nx * grid_nz; ++ic)
+        grid_start[ic + 1] += grid_start[ic];
+    grid_vertexes.resize(vertices.size());
+    std::vector<int> cell_fill(grid_start.begin(), grid_start.end() - 1);
+    for (unsigned int iv = 0; iv < vertices.size(); ++iv)
+        grid_vertexes[cell_fill[vertex_cell[iv]]++] = iv;
+}
+
+// Find the vertices to be updated in this step.
+void DeformableSoil::FindActiveDomain() {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+
+    active_vertexes.clear();
+
+    if (!do_active_domain) {
+        active_vertexes.resize(vertices.size());
+        for (unsigned int iv = 0; iv < vertices.size(); ++iv)
+            active_vertexes[iv] = iv;
+        return;
+    }
+
+    // Colliding objects: bodies and other physics items (for the latter, and for bodies
+    // without collision model, the bounding box is infinite: the whole mesh is active)
+    std::vector<ChPhysicsItem*> colliding;
+    for (auto body : *GetSystem()->Get_bodylist()) {
+        if (body->GetCollide())
+            colliding.push_back(body.get());
+    }
+    for (auto item : *GetSystem()->Get_otherphysicslist()) {
+        if (item->GetCollide() && item.get() != this)
+            colliding.push_back(item.get());
+    }
+
+    for (auto item : colliding) {
+        ChVector<> bbmin, bbmax;
+        item->GetTotalAABB(bbmin, bbmax);
+
+        // Bounding box projected on the X-Z plane, with margin
+        double x0 = DBL_MAX, x1 = -DBL_MAX, z0 = DBL_MAX, z1 = -DBL_MAX;
+        for (int corner = 0; corner < 8; ++corner) {
+            ChVector<> p((corner & 1) ? bbmax.x : bbmin.x, (corner & 2) ? bbmax.y : bbmin.y,
+                         (corner & 4) ? bbmax.z : bbmin.z);
+            ChVector<> loc = plane.TransformParentToLocal(p);
+            x0 = ChMin(x0, loc.x);
+            x1 = ChMax(x1, loc.x);
+            z0 = ChMin(z0, loc.z);
+            z1 = ChMax(z1, loc.z);
+        }
+        x0 -= active_domain_margin;
+        x1 += active_domain_margin;
+        z0 -= active_domain_margin;
+        z1 += active_domain_margin;
+
+        // Clamp in floating point first, since the box might be infinite
+        int ix0 = (int)ChMax(floor((x0 - grid_x0) / grid_cell), 0.0);
+        int ix1 = (int)ChMin(floor((x1 - grid_x0) / grid_cell), grid_nx - 1.0);
+        int iz0 = (int)ChMax(floor((z0 - grid_z0) / grid_cell), 0.0);
+        int iz1 = (int)ChMin(floor((z1 - grid_z0) / grid_cell), grid_nz - 1.0);
+
+        for (int iz = iz0; iz <= iz1; ++iz) {
+            for (int ix = ix0; ix <= ix1; ++ix) {
+                int ic = ix + grid_nx * iz;
+                for (int k = grid_start[ic]; k < grid_start[ic + 1]; ++k) {
+                    int iv = grid_vertexes[k];
+                    ChVector<> loc = plane.TransformParentToLocal(vertices[iv]);
+                    if (loc.x >= x0 && loc.x <= x1 && loc.z >= z0 && loc.z <= z1)
+                        active_vertexes.push_back(iv);
+                }
+            }
+        }
+    }
+
+    // Remove the duplicates of overlapping boxes, and keep the order of the full update
+    std::sort(active_vertexes.begin(), active_vertexes.end());
+    active_vertexes.erase(std::unique(active_vertexes.begin(), active_vertexes.end()), active_vertexes.end());
+}
+
+// Find the root of the island of a vertex, halving the path.
+static int FindIsland(std::vector<int>& parent, int iv) {
+    while (parent[iv] != iv) {
+        parent[iv] = parent[parent[iv]];
+        iv = parent[iv];
+    }
+    return iv;
+}
+
+// Flow material to the side of the ruts, using heuristics.
+void DeformableSoil::ComputeBulldozingFlow() {
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
+    double dt = this->GetSystem()->GetStep();
+    int nthreads = this->GetSystem()->GetParallelThreadNumber();
+
+    // Touched vertices, in increasing order
+    // (island IDs were reset with the vertices modified in the previous step)
+    std::vector<int> touched_vertexes;
+    for (auto iv : active_vertexes) {
+        if (p_sigma[iv]>0)
+            touched_vertexes.push_back(iv);
+    }
+
+    // Contact islands: connected components of the touched vertices (union-find, the root
+    // of each island is its vertex with the lowest index)
+    for (auto iv : touched_vertexes)
+        p_island_parent[iv] = iv;
+    for (auto iv : touched_vertexes) {
+        for (auto ivconnect : connected_vertexes[iv]) {
+            if (p_sigma[ivconnect] > 0) {
+                int ra = FindIsland(p_island_parent, iv);
+                int rb = FindIsland(p_island_parent, ivconnect);
+                if (ra < rb)
+                    p_island_parent[rb] = ra;
+                else if (rb < ra)
+                    p_island_parent[ra] = rb;
+            }
+        }
+    }
+
+    // Island IDs are numbered by the lowest vertex index, as done by a flood fill from
+    // the lowest untouched vertex. Sum the displaced material of each island.
+    std::vector<double> island_step_flow(1, 0.0);
+    for (auto iv : touched_vertexes) {
+        int root = FindIsland(p_island_parent, iv);
+        if (root == iv) {
+            p_id_island[iv] = (int)island_step_flow.size();
+            island_step_flow.push_back(0);
+        } else {
+            p_id_island[iv] = p_id_island[root];
+        }
+        island_step_flow[p_id_island[iv]] += p_area[iv] * p_step_plastic_flow[iv] * dt;
+    }
+
+    // Boundary of each island: untouched vertices connected to the island. A vertex can
+    // be on the boundary of several islands; it is marked with the highest island ID.
+    std::vector<std::pair<int, int>> boundary;  // (vertex, island)
+    for (auto iv : touched_vertexes) {
+        for (auto ivconnect : connected_vertexes[iv]) {
+            if (p_sigma[ivconnect] == 0)
+                boundary.push_back(std::make_pair(ivconnect, p_id_island[iv]));
+        }
+    }
+    std::sort(boundary.begin(), boundary.end());
+    boundary.erase(std::unique(boundary.begin(), boundary.end()), boundary.end());
+
+    std::vector<double> island_area_boundary(island_step_flow.size(), 0.0);
+    for (auto& ib : boundary) {
+        island_area_boundary[ib.second] += p_area[ib.first];
+        p_id_island[ib.first] = -ib.second;  // negative to mark as boundary
+    }
+
+    // Raise the boundary because of material flow (it gives a sharp spike around the
+    // island boundary, but later we'll use the erosion algorithm to smooth it out)
+    for (auto& ib : boundary) {
+        double raise_y = bulldozing_flow_factor * island_step_flow[ib.second] / island_area_boundary[ib.second];
+        vertices[ib.first]           += N * raise_y;
+        p_vertices_initial[ib.first] += N * raise_y;
+        SetModified(ib.first);
+    }
+
+    // Erosion domain area select, by topologically dilation of all the 
+    // boundaries of the islands:
+    std::vector<int> domain_erosion;
+    for (auto& ib : boundary) {
+        if (!p_erosion[ib.first]) {
+            p_erosion[ib.first] = true;
+            domain_erosion.push_back(ib.first);
+        }
+    }
+    size_t front_begin = 0;
+    for (int iloop = 0; iloop <10; ++iloop) {
+        size_t front_end = domain_erosion.size();
+        for (size_t k = front_begin; k < front_end; ++k) {
+            for (auto ivconnect : connected_vertexes[domain_erosion[k]]) {
+                if ((p_id_island[ivconnect]==0) && !p_erosion[ivconnect]) {
+                    p_erosion[ivconnect] = true;
+                    domain_erosion.push_back(ivconnect);
+                    SetModified(ivconnect);
+                }
+            }
+        }
+        front_begin = front_end;
+    }
+
+    // Erosion smoothing: material flows from the vertices of the domain to the untouched
+    // connected vertices that are lower than allowed by the erosion angle.
+    double tan_erosion = tan(bulldozing_erosion_angle*CH_C_DEG_TO_RAD);
+
+    if (!bulldozing_parallel_erosion) {
+        // Sequential sweeps: the vertices of the domain are processed in increasing order,
+        // each one with the heights left by the previous ones (Gauss-Seidel).
+        std::sort(domain_erosion.begin(), domain_erosion.end());
+        for (int ismo = 0; ismo <3; ++ismo) {
+            for (auto is : domain_erosion) {
+                double my = Vdot(vertices[is], N);
+                double mflow = 0.5 / (double)connected_vertexes[is].size();
+                for (auto ivc : connected_vertexes[is]) {
+                    if (p_sigma[ivc] == 0) {
+                        ChVector<> vdist = vertices[ivc] - vertices[is];
+                        double ddist = (vdist - N * Vdot(vdist, N)).Length();
+                        double dy = my - Vdot(vertices[ivc], N);
+                        double dy_lim = ddist * tan_erosion;
+                        if (dy > dy_lim) {
+                            ChVector<> DV = N * ((dy - dy_lim) * mflow);
+                            vertices[is]  -= DV;
+                            vertices[ivc] += DV;
+                            SetModified(ivc);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Parallel sweeps: each sweep computes all flows from the heights at the beginning
+    // of the sweep (Jacobi), so that the vertices can be processed in parallel.
+    std::vector<int> smoothed_vertexes = domain_erosion;
+    for (auto is : domain_erosion) {
+        for (auto ivc : connected_vertexes[is]) {
+            if (p_sigma[ivc] == 0)
+                smoothed_vertexes.push_back(ivc);
+        }
+    }
+    std::sort(smoothed_vertexes.begin(), smoothed_vertexes.end());
+    smoothed_vertexes.erase(std::unique(smoothed_vertexes.begin(), smoothed_vertexes.end()), smoothed_vertexes.end());
+
+    int n_smoothed = (int)smoothed_vertexes.size();
+    std::vector<double> dy_smoothed(n_smoothed);
+
+    // Height that flows from the vertex 'is' of the domain to the connected vertex 'ivc'.
+    auto flow = [&](int is, int ivc) {
+        ChVector<> vdist = vertices[ivc] - vertices[is];
+        double dy = -Vdot(vdist, N);
+        double ddist = (vdist + N * dy).Length();
+        double dy_lim = ddist * tan_erosion;
+        if (dy > dy_lim)
+            return (dy - dy_lim) * 0.5 / (double)connected_vertexes[is].size();
+        return 0.0;
+    };
+
+    for (int ismo = 0; ismo <3; ++ismo) {
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+        for (int k = 0; k < n_smoothed; ++k) {
+            int iv = smoothed_vertexes[k];
+            double dy = 0;
+            for (auto ivc : connected_vertexes[iv]) {
+                if (p_erosion[iv] && p_sigma[ivc] == 0)
+                    dy -= flow(iv, ivc);
+                if (p_erosion[ivc] && p_sigma[iv] == 0)
+                    dy += flow(ivc, iv);
+            }
+            dy_smoothed[k] = dy;
+        }
+        for (int k = 0; k < n_smoothed; ++k) {
+            if (dy_smoothed[k] != 0) {
+                vertices[smoothed_vertexes[k]] += N * dy_smoothed[k];
+                SetModified(smoothed_vertexes[k]);
+            }
+        }
     }
 }
 
@@ -416,45 +793,46 @@ void DeformableSoil::UpdateInternalForces() {
     this->GetLoadList().clear();
 
     //
-    // Compute (pseudo)areas per node
+    // Reset the step data of the vertices modified in the previous step
+    // (the (pseudo)areas per node are computed once, in SetupAuxData())
     //
-    
-    // for a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps, 
-    // but the following is more general, also for generic meshes:
-    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-        p_area[iv] = 0;
-    }
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        ChVector<> AB = vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x];
-        ChVector<> AC = vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x];
-        AB = plane.TransformDirectionParentToLocal(AB);
-        AC = plane.TransformDirectionParentToLocal(AC);
-        AB.y=0;
-        AC.y=0;
-        double triangle_area = 0.5*(Vcross(AB,AC)).Length();
-        p_area[idx_normals[it].x] += triangle_area /3.0;
-        p_area[idx_normals[it].y] += triangle_area /3.0;
-        p_area[idx_normals[it].z] += triangle_area /3.0;
+
+    modified_vertexes_old.swap(modified_vertexes);
+    modified_vertexes.clear();
+    for (auto iv : modified_vertexes_old) {
+        p_sigma[iv] = 0;
+        p_sinkage_elastic[iv] = 0;
+        p_step_plastic_flow[iv] = 0;
+        p_erosion[iv] = false;
+        p_id_island[iv] = 0;
+        p_modified[iv] = false;
     }
 
+    FindActiveDomain();
+
     ChVector<> N    = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
 
     //
     // Perform ray-hit test to detect the contact point sinkage
     // 
     
-    collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+    // All vertical rays are cast in a single batch, so that the collision system can
+    // skip the vertices far from the colliding objects, and test the others in parallel.
+    p_ray_from.resize(active_vertexes.size());
+    for (int k=0; k< active_vertexes.size(); ++k) {
+        p_ray_from[k] = vertices[active_vertexes[k]] + N*0.01 - N*0.5;
+    }
+    this->GetSystem()->GetCollisionSystem()->RayHitBatch(p_ray_from, N*0.5, p_rayhit);
+
+    for (int k=0; k< active_vertexes.size(); ++k) {
+        int i = active_vertexes[k];
 
-    for (int i=0; i< vertices.size(); ++i) {
         p_sigma[i] = 0;
         p_sinkage_elastic[i] = 0;
         p_step_plastic_flow[i]=0;
         p_erosion[i] = false;
 
-        ChVector<> to   = vertices[i] +N*0.01; 
-        ChVector<> from = to - N*0.5;
-
-        this->GetSystem()->GetCollisionSystem()->RayHit(from,to,mrayhit_result);
+        const collision::ChCollisionSystem::ChRayhitResult& mrayhit_result = p_rayhit[k];
         if (mrayhit_result.hit == true) {
             double test_sinkage = - Vdot(( mrayhit_result.abs_hitPoint - p_vertices_initial[i] ), N);
 
@@ -518,6 +896,7 @@ void DeformableSoil::UpdateInternalForces() {
 
                 // Update mesh representation
                 vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
+                SetModified(i);
 
             } // end positive contact force
 
@@ -532,117 +911,8 @@ void DeformableSoil::UpdateInternalForces() {
     // 
 
     if (do_bulldozing) {
-        std::set<int> touched_vertexes;
-        for (int iv = 0; iv< vertices.size(); ++iv) {
-            p_id_island[iv] = 0;
-            if (p_sigma[iv]>0)
-                touched_vertexes.insert(iv);
-        }
-
-        std::set<int> domain_boundaries;
-
-        // Compute contact islands (and their displaced material) by flood-filling the mesh
-        int id_island = 0;
-        for (auto fillseed = touched_vertexes.begin(); fillseed != touched_vertexes.end(); fillseed = touched_vertexes.begin()) {
-            // new island:
-            ++id_island;
-            std::set<int> fill_front;
-
-            std::set<int> boundary;
-            int n_vert_boundary = 0;
-            double tot_area_boundary = 0;
-
-            int n_vert_island = 1;
-            double tot_step_flow_island = p_area[*fillseed] * p_step_plastic_flow[*fillseed] * this->GetSystem()->GetStep();
-            double tot_Nforce_island = p_area[*fillseed] * p_sigma[*fillseed];
-            fill_front.insert(*fillseed);
-            p_id_island[*fillseed] = id_island;
-            touched_vertexes.erase(fillseed);
-            while (fill_front.size() >0) {
-                // fill next front
-                std::set<int> fill_front_2;
-                for (auto ifront : fill_front) {
-                    for (auto ivconnect : connected_vertexes[ifront]) {
-                        if ((p_sigma[ivconnect]>0) && (p_id_island[ivconnect]==0)) {
-                            ++n_vert_island;
-                            tot_step_flow_island += p_area[ivconnect] * p_step_plastic_flow[ivconnect] * this->GetSystem()->GetStep();
-                            tot_Nforce_island += p_area[ivconnect] * p_sigma[ivconnect];
-                            fill_front_2.insert(ivconnect);
-                            p_id_island[ivconnect] = id_island;
-                            touched_vertexes.erase(ivconnect);
-                        } 
-                        else if ((p_sigma[ivconnect] == 0) && (p_id_island[ivconnect] <= 0) && (p_id_island[ivconnect] != -id_island)) {
-                            ++n_vert_boundary;
-                            tot_area_boundary += p_area[ivconnect];
-                            p_id_island[ivconnect] = -id_island; // negative to mark as boundary
-                            boundary.insert(ivconnect);
-                        }
-                    }
-                }
-                // advance to next front
-                fill_front= fill_front_2;
-            }
-            //GetLog() << " island " << id_island << " flow volume =" << tot_step_flow_island << " N force=" << tot_Nforce_island << "\n"; 
-
-            // Raise the boundary because of material flow (it gives a sharp spike around the
-            // island boundary, but later we'll use the erosion algorithm to smooth it out)
-            double tot_length_boundary = (double)boundary.size() * sqrt(0.5*tot_area_boundary / (double)boundary.size() ); // approx.
-            double tot_width_boundary = tot_area_boundary/tot_length_boundary;
-            
-            for (auto ibv : boundary) {
-                double raise_y = bulldozing_flow_factor * ((p_area[ibv]/tot_area_boundary) *  (1/p_area[ibv]) * tot_step_flow_island);
-                vertices[ibv]           += N * raise_y;
-                p_vertices_initial[ibv] += N * raise_y;
-            }
-
-            domain_boundaries.insert(boundary.begin(), boundary.end());
-
-        }// end for islands
-
-
-        // Erosion domain area select, by topologically dilation of all the 
-        // boundaries of the islands:
-        std::set<int> domain_erosion= domain_boundaries;
-        for (auto ie : domain_boundaries)
-            p_erosion[ie] = true;
-        std::set<int> front_erosion = domain_boundaries;
-        for (int iloop = 0; iloop <10; ++iloop) {
-            std::set<int> front_erosion2;
-            for(auto is : front_erosion) {
-                for (auto ivconnect : connected_vertexes[is]) {
-                    if ((p_id_island[ivconnect]==0) && (p_erosion[ivconnect]==0)) {
-                        front_erosion2.insert(ivconnect);
-                        p_erosion[ivconnect] = true;
-                    }
-                }
-            }
-            domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
-            front_erosion = front_erosion2;
-        }
-        // Erosion smoothing algorithm on domain
-        for (int ismo = 0; ismo <3; ++ismo) {
-            for (auto is : domain_erosion) {
-                double my = vertices[is].y;
-                for (auto ivc : connected_vertexes[is]) {
-                    ChVector<> vis = this->plane.TransformParentToLocal(vertices[is]);
-                    if (p_sigma[ivc] == 0) {
-                        ChVector<> vic = this->plane.TransformParentToLocal(vertices[ivc]);
-                        ChVector<> vdist = vic-vis;
-                        vdist.y=0;
-                        double ddist = vdist.Length();
-                        double dy = my - vertices[ivc].y;
-                        double dy_lim = ddist * tan(bulldozing_erosion_angle*CH_C_DEG_TO_RAD);
-                        if (dy>dy_lim) {
-                            ChVector<> DV = ((dy-dy_lim)*0.5/(double)connected_vertexes[is].size()) * this->plane.TransformDirectionLocalToParent(VECT_Y);
-                            vertices[is]  -= DV;
-                            vertices[ivc] += DV;
-                        }
-                    }
-                }
-            }
-        }
-
-    } // end bulldozing flow 
+        ComputeBulldozingFlow();
+    }
 
 
 
@@ -650,8 +920,18 @@ void DeformableSoil::UpdateInternalForces() {
     // Update the visualization colors
     // 
     if (plot_type != DeformableTerrain::PLOT_NONE) {
-        colors.resize(vertices.size());
-        for (size_t iv = 0; iv< vertices.size(); ++iv) {
+        // All vertices, or only the ones modified in this step or in the previous one
+        std::vector<int> color_vertexes;
+        if (!do_active_domain || colors.size() != vertices.size()) {
+            colors.resize(vertices.size());
+            color_vertexes.resize(vertices.size());
+            for (unsigned int iv = 0; iv < vertices.size(); ++iv)
+                color_vertexes[iv] = iv;
+        } else {
+            color_vertexes = modified_vertexes_old;
+            color_vertexes.insert(color_vertexes.end(), modified_vertexes.begin(), modified_vertexes.end());
+        }
+        for (auto iv : color_vertexes) {
             ChColor mcolor;
             switch (plot_type) {
                 case DeformableTerrain::PLOT_SINKAGE:
@@ -704,27 +984,60 @@ void DeformableSoil::UpdateInternalForces() {
     // Update the visualization normals
     // 
 
-    std::vector<int> accumulators(vertices.size(), 0);
+    if (!do_active_domain) {
+        std::vector<int> accumulators(normals.size(), 0);
 
-    // Calculate normals and then average the normals from all adjacent faces.
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        // Calculate the triangle normal as a normalized cross product.
-        ChVector<> nrm = -Vcross(vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x],
-                                vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x]);
-        nrm.Normalize();
-        // Increment the normals of all incident vertices by the face normal
-        normals[idx_normals[it].x] += nrm;
-        normals[idx_normals[it].y] += nrm;
-        normals[idx_normals[it].z] += nrm;
-        // Increment the count of all incident vertices by 1
-        accumulators[idx_normals[it].x] += 1;
-        accumulators[idx_normals[it].y] += 1;
-        accumulators[idx_normals[it].z] += 1;
-    }
+        for (unsigned int in = 0; in < normals.size(); ++in) {
+            normals[in] = VNULL;
+        }
 
-    // Set the normals to the average values.
-    for (unsigned int in = 0; in < vertices.size(); ++in) {
-        normals[in] /= (double)accumulators[in];
+        // Calculate normals and then average the normals from all adjacent faces.
+        for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
+            // Calculate the triangle normal as a normalized cross product.
+            ChVector<> nrm = -Vcross(vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x],
+                                    vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x]);
+            nrm.Normalize();
+            // Increment the normals of all incident vertices by the face normal
+            normals[idx_normals[it].x] += nrm;
+            normals[idx_normals[it].y] += nrm;
+            normals[idx_normals[it].z] += nrm;
+            // Increment the count of all incident vertices by 1
+            accumulators[idx_normals[it].x] += 1;
+            accumulators[idx_normals[it].y] += 1;
+            accumulators[idx_normals[it].z] += 1;
+        }
+
+        // Set the normals to the average values.
+        for (unsigned int in = 0; in < normals.size(); ++in) {
+            normals[in] /= (double)accumulators[in];
+        }
+    } else {
+        // Only the faces of the modified vertices changed: find the normals they use.
+        std::vector<int> normal_list;
+        for (auto iv : modified_vertexes) {
+            for (auto it : connected_faces[iv]) {
+                int in_face[3] = {idx_normals[it].x, idx_normals[it].y, idx_normals[it].z};
+                for (auto in : in_face) {
+                    if (!p_normal_modified[in]) {
+                        p_normal_modified[in] = true;
+                        normal_list.push_back(in);
+                    }
+                }
+            }
+        }
+
+        // Average the normals of all the faces using them, as above.
+        for (auto in : normal_list) {
+            p_normal_modified[in] = false;
+            ChVector<> nrm_sum = VNULL;
+            for (auto it : normal_faces[in]) {
+                ChVector<> nrm = -Vcross(vertices[idx_vertices[it].y] - vertices[idx_vertices[it].x],
+                                        vertices[idx_vertices[it].z] - vertices[idx_vertices[it].x]);
+                nrm.Normalize();
+                nrm_sum += nrm;
+            }
+            normals[in] = nrm_sum / (double)normal_faces[in].size();
+        }
     }
 
     // 
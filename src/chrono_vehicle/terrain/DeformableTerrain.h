@@ -19,7 +19,7 @@
 #ifndef DEFORMABLE_TERRAIN_H
 #define DEFORMABLE_TERRAIN_H
 
-#include <set>
+#include <vector>
 #include <string>
 
 #include "chrono/assets/ChColor.h"
@@ -118,6 +118,25 @@ public:
                                  double mbulldozing_flow_factor = 1.0  ///< growth of lateral volume respect to pressed volume
                                  );
 
+    /// If true, each sweep of the erosion smoothing of the bulldozing flow computes all the flows
+    /// from the heights at the start of the sweep, and the vertices are processed in parallel.
+    /// Material then spreads by one ring of vertices per sweep, so the berms at the sides of the
+    /// ruts are higher and narrower than with the default sequential sweeps (false), where each
+    /// vertex is updated with the heights left by the previous ones.
+    void SetBulldozingParallelErosion(bool mb);
+    bool GetBulldozingParallelErosion() const;
+
+    /// If true, at each step only the vertices under the bounding boxes of the colliding
+    /// objects (the active domain) are updated, together with their normals and colors,
+    /// instead of the whole mesh. Useful for large terrains, where the vehicle touches a
+    /// small area. Colliding objects with no bounding box, or large colliding bodies under
+    /// the terrain, make the whole mesh active.
+    void SetActiveDomainUpdate(bool mb);
+    bool GetActiveDomainUpdate() const;
+
+    /// Set the margin added around the bounding boxes of the colliding objects, on the
+    /// terrain plane, when the active domain is searched (default 0.1 m).
+    void SetActiveDomainMargin(double margin);
 
     /// Set the color plot type for the soil mesh.
     /// Also, when a scalar plot is used, also define which is the max-min range in the falsecolor colormap.
@@ -217,6 +236,21 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
+    // Fill the list of active vertices, the ones under the bounding boxes of the
+    // colliding objects (all vertices, if the active domain update is disabled).
+    void FindActiveDomain();
+
+    // Flow the material displaced by the contact islands to their sides (bulldozing).
+    void ComputeBulldozingFlow();
+
+    // Add a vertex to the list of vertices modified in the current step.
+    void SetModified(int iv) {
+        if (!p_modified[iv]) {
+            p_modified[iv] = true;
+            modified_vertexes.push_back(iv);
+        }
+    }
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
@@ -233,8 +267,13 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     std::vector<double> p_sigma_yeld;
     std::vector<double> p_tau;
     std::vector<int>    p_id_island;
+    std::vector<int>    p_island_parent;  // union-find of the contact islands
     std::vector<bool>   p_erosion;
 
+    // per-vertex ray-hit tests
+    std::vector<ChVector<>> p_ray_from;
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> p_rayhit;
+
     double Bekker_Kphi;
     double Bekker_Kc;
     double Bekker_n;
@@ -250,11 +289,32 @@ class CH_VEHICLE_API DeformableSoil : public ChLoadContainer {
     ChCoordsys<> plane;
 
     // aux. topology data
-    std::vector<std::set<int>> connected_vertexes;
+    std::vector<std::vector<int>> connected_vertexes;
+    std::vector<std::vector<int>> connected_faces;
+    std::vector<std::vector<int>> normal_faces;  // faces using each normal (by normal index)
+
+    // aux. grid of the vertices on the plane, for searching the active domain
+    double grid_x0;
+    double grid_z0;
+    double grid_cell;
+    int grid_nx;
+    int grid_nz;
+    std::vector<int> grid_start;
+    std::vector<int> grid_vertexes;
+
+    // active domain
+    bool do_active_domain;
+    double active_domain_margin;
+    std::vector<int> active_vertexes;        // vertices updated in the current step
+    std::vector<int> modified_vertexes;      // vertices modified in the current step
+    std::vector<int> modified_vertexes_old;  // vertices modified in the previous step
+    std::vector<bool> p_modified;
+    std::vector<bool> p_normal_modified;     // (by normal index)
 
     bool do_bulldozing;
     double bulldozing_flow_factor;
     double bulldozing_erosion_angle;
+    bool bulldozing_parallel_erosion;
 
     friend class DeformableTerrain;
 };
@@ -25,7 +25,8 @@ namespace chrono {
 namespace vehicle {
 
 ChCosimManager::ChCosimManager(int num_tires)
-    : m_num_tires(num_tires), m_vehicle_node(NULL), m_terrain_node(NULL), m_tire_node(NULL), m_verbose(false) {}
+    : m_num_tires(num_tires), m_vehicle_node(NULL), m_terrain_node(NULL), m_tire_node(NULL), m_verbose(false),
+      m_mesh_deltas(false) {}
 
 ChCosimManager::~ChCosimManager() {
     delete m_vehicle_node;
@@ -80,6 +81,7 @@ bool ChCosimManager::Initialize() {
         SetAsTireNode(id);
         m_tire_node = new ChCosimTireNode(m_rank, GetChronoSystemTire(id), GetTire(id), id);
         m_tire_node->SetStepsize(GetTireStepsize(id));
+        m_tire_node->SetMeshDeltas(m_mesh_deltas);
         m_tire_node->Initialize();
         if (m_verbose) {
             std::cout << "TIRE NODE created.  rank = " << m_rank << std::endl;
@@ -84,6 +84,10 @@ class CH_VEHICLE_API ChCosimManager {
 
     void SetVerbose(bool val) { m_verbose = val; }
 
+    /// Send the tire mesh vertex states as single-precision differences (default: false).
+    /// See ChCosimTireNode::SetMeshDeltas(). Must be called before Initialize().
+    void SetMeshDeltas(bool val) { m_mesh_deltas = val; }
+
     bool Initialize();
     void Abort();
 
@@ -94,6 +98,7 @@ class CH_VEHICLE_API ChCosimManager {
     int m_rank;
     int m_num_tires;
     bool m_verbose;
+    bool m_mesh_deltas;
 
     ChCosimVehicleNode* m_vehicle_node;
     ChCosimTerrainNode* m_terrain_node;
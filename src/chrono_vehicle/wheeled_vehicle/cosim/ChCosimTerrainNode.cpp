@@ -27,16 +27,45 @@ namespace vehicle {
 ChCosimTerrainNode::ChCosimTerrainNode(int rank, ChSystem* system, ChTerrain* terrain, int num_tires)
     : ChCosimNode(rank, system), m_terrain(terrain), m_num_tires(num_tires) {}
 
+ChCosimTerrainNode::~ChCosimTerrainNode() {
+    CompleteSends();
+}
+
 void ChCosimTerrainNode::Initialize() {
+    m_triangles.resize(m_num_tires);
+    m_vert_data.resize(m_num_tires);
+    m_vert_deltas.resize(m_num_tires);
+    m_index_data.resize(m_num_tires);
+    m_force_data.resize(m_num_tires);
+
     // Receive contact specification from tire nodes
     for (int it = 0; it < m_num_tires; it++) {
-        unsigned int props[2];
+        unsigned int props[3];
         MPI_Status status;
-        MPI_Recv(props, 2, MPI_UNSIGNED, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
+        MPI_Recv(props, 3, MPI_UNSIGNED, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
         m_num_vertices.push_back(props[0]);
         m_num_triangles.push_back(props[1]);
+        m_mesh_deltas.push_back(props[2] != 0);
         if (m_verbose) {
-            printf("Terrain node %d.  Recv from %d props = %d %d\n", m_rank, TIRE_NODE_RANK(it), props[0], props[1]);
+            printf("Terrain node %d.  Recv from %d props = %d %d %d\n", m_rank, TIRE_NODE_RANK(it), props[0], props[1],
+                   props[2]);
+        }
+
+        // Receive the mesh connectivity (only once, since it does not change)
+        unsigned int num_vert = props[0];
+        unsigned int num_tri = props[1];
+        std::vector<int> tri_data(3 * num_tri);
+        MPI_Recv(tri_data.data(), 3 * num_tri, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
+        for (unsigned int i = 0; i < num_tri; i++) {
+            m_triangles[it].push_back(ChVector<int>(tri_data[3 * i + 0], tri_data[3 * i + 1], tri_data[3 * i + 2]));
+        }
+
+        // Receive the initial vertex states, to which the following differences refer
+        m_vert_data[it].resize(2 * 3 * num_vert);
+        if (m_mesh_deltas[it]) {
+            MPI_Recv(m_vert_data[it].data(), 2 * 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD,
+                     &status);
+            m_vert_deltas[it].resize(2 * 3 * num_vert);
         }
 
         m_manager->OnReceiveTireInfo(it, props[0], props[1]);
@@ -44,34 +73,46 @@ void ChCosimTerrainNode::Initialize() {
 }
 
 void ChCosimTerrainNode::Synchronize(double time) {
+    // The send buffers of the previous step are reused below
+    CompleteSends();
+
+    // Post the receives of the vertex states from all tire nodes
+    std::vector<MPI_Request> recvs(m_num_tires);
+    for (int it = 0; it < m_num_tires; it++) {
+        unsigned int num_vert = m_num_vertices[it];
+        if (m_mesh_deltas[it]) {
+            MPI_Irecv(m_vert_deltas[it].data(), 2 * 3 * num_vert, MPI_FLOAT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD,
+                      &recvs[it]);
+        } else {
+            MPI_Irecv(m_vert_data[it].data(), 2 * 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD,
+                      &recvs[it]);
+        }
+    }
+
+    // Process the tires in order; the data of the other tires is received in the meantime
     for (int it = 0; it < m_num_tires; it++) {
         // Receive tire mesh vertex locations and velocities from the tire node
         MPI_Status status;
-        unsigned int num_vert = m_num_vertices[it];
-        unsigned int num_tri = m_num_triangles[it];
-        double* vert_data = new double[2 * 3 * num_vert];
-        int* tri_data = new int[3 * num_tri];
-        MPI_Recv(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
-        MPI_Recv(tri_data, 3 * num_tri, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &status);
+        MPI_Wait(&recvs[it], &status);
 
         // Unpack received data
+        unsigned int num_vert = m_num_vertices[it];
+        std::vector<double>& vert_data = m_vert_data[it];
+        if (m_mesh_deltas[it]) {
+            const std::vector<float>& vert_deltas = m_vert_deltas[it];
+            for (unsigned int i = 0; i < 2 * 3 * num_vert; i++)
+                vert_data[i] += vert_deltas[i];
+        }
         std::vector<ChVector<>> vert_pos;
         std::vector<ChVector<>> vert_vel;
-        std::vector<ChVector<int>> triangles;
         for (unsigned int i = 0; i < num_vert; i++) {
             vert_pos.push_back(ChVector<>(vert_data[3 * i + 0], vert_data[3 * i + 1], vert_data[3 * i + 2]));
             vert_vel.push_back(ChVector<>(vert_data[3 * num_vert + 3 * i + 0], vert_data[3 * num_vert + 3 * i + 1],
                                           vert_data[3 * num_vert + 3 * i + 2]));
         }
-        for (unsigned int i = 0; i < num_tri; i++) {
-            triangles.push_back(ChVector<int>(tri_data[3 * i + 0], tri_data[3 * i + 1], tri_data[3 * i + 2]));
-        }
-
-        delete[] vert_data;
-        delete[] tri_data;
 
         // Let derived class process received data
-        m_manager->OnReceiveTireData(it, vert_pos, vert_vel, triangles);
+        m_manager->OnReceiveTireData(it, vert_pos, vert_vel, m_triangles[it]);
 
         // Let derived class produce tire contact forces
         std::vector<ChVector<>> vert_forces;
@@ -81,16 +122,20 @@ void ChCosimTerrainNode::Synchronize(double time) {
 
         // Send vertex indeces and forces to the tire node
         //// TODO: use custom derived MPI types?
-        double* force_data = new double[3 * num_vert];
+        std::vector<int>& index_data = m_index_data[it];
+        std::vector<double>& force_data = m_force_data[it];
+        index_data = vert_indeces;
+        force_data.resize(3 * num_vert);
         for (unsigned int i = 0; i < num_vert; i++) {
             force_data[3 * i + 0] = vert_forces[i].x;
             force_data[3 * i + 1] = vert_forces[i].y;
             force_data[3 * i + 2] = vert_forces[i].z;
         }
-        MPI_Send(vert_indeces.data(), num_vert, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD);
-        MPI_Send(force_data, 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD);
-
-        delete[] force_data;
+        MPI_Request request;
+        MPI_Isend(index_data.data(), num_vert, MPI_INT, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &request);
+        m_sends.push_back(request);
+        MPI_Isend(force_data.data(), 3 * num_vert, MPI_DOUBLE, TIRE_NODE_RANK(it), it, MPI_COMM_WORLD, &request);
+        m_sends.push_back(request);
     }
 
     m_terrain->Synchronize(time);
@@ -106,5 +151,12 @@ void ChCosimTerrainNode::Advance(double step) {
     m_terrain->Advance(step);
 }
 
+void ChCosimTerrainNode::CompleteSends() {
+    if (m_sends.empty())
+        return;
+    MPI_Waitall((int)m_sends.size(), m_sends.data(), MPI_STATUSES_IGNORE);
+    m_sends.clear();
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
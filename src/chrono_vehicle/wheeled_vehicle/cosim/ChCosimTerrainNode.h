@@ -35,20 +35,36 @@ class ChCosimManager;
 /// @addtogroup vehicle_wheeled_cosim
 /// @{
 
+/// Cosimulation node for the terrain.
+/// The connectivity of the contact mesh of each tire is received only once, at initialization;
+/// at each step, only the vertex positions and velocities are received. The receives from all
+/// tires are posted at once and the forces are sent with non-blocking MPI calls, completed at the
+/// next synchronization, so that the transfers overlap with the integration of the terrain system.
 class CH_VEHICLE_API ChCosimTerrainNode : public ChCosimNode {
   public:
     ChCosimTerrainNode(int rank, ChSystem* system, ChTerrain* terrain, int num_tires);
+    ~ChCosimTerrainNode();
 
     void Initialize();
     void Synchronize(double time);
     void Advance(double step);
 
   private:
+    /// Wait for the completion of the messages sent at the previous synchronization.
+    void CompleteSends();
+
     ChCosimManager* m_manager;                  ///< back-pointer to the cosimulation manager
     ChTerrain* m_terrain;                       ///< underlying terrain object
     int m_num_tires;                            ///< number of tires
     std::vector<unsigned int> m_num_vertices;   ///< number of contact vertices received from each tire
     std::vector<unsigned int> m_num_triangles;  ///< number of contact triangles received from each tire
+    std::vector<bool> m_mesh_deltas;            ///< vertex states of each tire received as differences
+    std::vector<std::vector<ChVector<int>>> m_triangles;  ///< contact mesh connectivity of each tire
+    std::vector<std::vector<double>> m_vert_data;         ///< vertex states of each tire (positions, then velocities)
+    std::vector<std::vector<float>> m_vert_deltas;        ///< receive buffers for the vertex state differences
+    std::vector<std::vector<int>> m_index_data;           ///< send buffers for the indices of the loaded vertices
+    std::vector<std::vector<double>> m_force_data;        ///< send buffers for the vertex forces
+    std::vector<MPI_Request> m_sends;                     ///< pending send requests
 
     friend class ChCosimManager;
 };
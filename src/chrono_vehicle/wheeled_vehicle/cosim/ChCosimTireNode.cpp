@@ -17,6 +17,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cassert>
 #include <cstdio>
 #include <vector>
 
@@ -28,7 +29,11 @@ namespace chrono {
 namespace vehicle {
 
 ChCosimTireNode::ChCosimTireNode(int rank, ChSystem* system, ChDeformableTire* tire, WheelID id)
-    : ChCosimNode(rank, system), m_tire(tire), m_id(id) {}
+    : ChCosimNode(rank, system), m_tire(tire), m_id(id), m_mesh_deltas(false), m_num_vertices(0) {}
+
+ChCosimTireNode::~ChCosimTireNode() {
+    CompleteSends();
+}
 
 void ChCosimTireNode::Initialize() {
     // Ghost wheel body (driven kinematically through messages from vehicle node)
@@ -66,32 +71,123 @@ void ChCosimTireNode::Initialize() {
     m_contact_load = std::make_shared<fea::ChLoadContactSurfaceMesh>(contact_surface);
     m_tire->GetLoadContainer()->Add(m_contact_load);
 
+    // Extract the tire contact mesh
+    std::vector<ChVector<>> vert_pos;
+    std::vector<ChVector<>> vert_vel;
+    std::vector<ChVector<int>> triangles;
+    m_contact_load->OutputSimpleMesh(vert_pos, vert_vel, triangles);
+    m_num_vertices = (unsigned int)vert_pos.size();
+    unsigned int num_tri = (unsigned int)triangles.size();
+
     // Send contact specification to terrain node
     {
-        unsigned int props[2];
-        props[0] = contact_surface->GetNumVertices();
-        props[1] = contact_surface->GetNumTriangles();
-        MPI_Send(props, 2, MPI_UNSIGNED, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
+        unsigned int props[3];
+        props[0] = m_num_vertices;
+        props[1] = num_tri;
+        props[2] = m_mesh_deltas ? 1 : 0;
+        MPI_Send(props, 3, MPI_UNSIGNED, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
         if (m_verbose) {
-            printf("Tire node %d. Send to %d props = %d %d\n", m_rank, TERRAIN_NODE_RANK, props[0], props[1]);
+            printf("Tire node %d. Send to %d props = %d %d %d\n", m_rank, TERRAIN_NODE_RANK, props[0], props[1],
+                   props[2]);
+        }
+    }
+
+    // Send the mesh connectivity to the terrain node (only once, since it does not change)
+    std::vector<int> tri_data(3 * num_tri);
+    for (unsigned int it = 0; it < num_tri; it++) {
+        tri_data[3 * it + 0] = triangles[it].x;
+        tri_data[3 * it + 1] = triangles[it].y;
+        tri_data[3 * it + 2] = triangles[it].z;
+    }
+    MPI_Send(tri_data.data(), 3 * num_tri, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
+
+    // Send the initial vertex states in double precision: the following differences refer to these
+    m_vert_data.resize(2 * 3 * m_num_vertices);
+    if (m_mesh_deltas) {
+        for (unsigned int iv = 0; iv < m_num_vertices; iv++) {
+            m_vert_data[3 * iv + 0] = vert_pos[iv].x;
+            m_vert_data[3 * iv + 1] = vert_pos[iv].y;
+            m_vert_data[3 * iv + 2] = vert_pos[iv].z;
+            m_vert_data[3 * m_num_vertices + 3 * iv + 0] = vert_vel[iv].x;
+            m_vert_data[3 * m_num_vertices + 3 * iv + 1] = vert_vel[iv].y;
+            m_vert_data[3 * m_num_vertices + 3 * iv + 2] = vert_vel[iv].z;
         }
+        MPI_Send(m_vert_data.data(), 2 * 3 * m_num_vertices, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(),
+                 MPI_COMM_WORLD);
+        m_vert_deltas.resize(2 * 3 * m_num_vertices);
     }
+
+    // Receive buffers for the terrain forces (at most one force per vertex)
+    m_index_data.resize(m_num_vertices);
+    m_force_data.resize(3 * m_num_vertices);
 }
 
 void ChCosimTireNode::Synchronize(double time) {
+    // The buffers of the previous step are reused below
+    CompleteSends();
+
+    // Post the receives for the terrain force(s), so that they can complete while this node
+    // exchanges data with the vehicle node. The two messages from the terrain node are matched
+    // in the order they were sent.
+    MPI_Request recvs[2];
+    MPI_Irecv(m_index_data.data(), m_num_vertices, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &recvs[0]);
+    MPI_Irecv(m_force_data.data(), 3 * m_num_vertices, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+              &recvs[1]);
+
+    // Extract tire mesh vertex locations and velocities
+    std::vector<ChVector<>> vert_pos;
+    std::vector<ChVector<>> vert_vel;
+    std::vector<ChVector<int>> triangles;
+    m_contact_load->OutputSimpleMesh(vert_pos, vert_vel, triangles);
+    assert(vert_pos.size() == m_num_vertices);
+
+    // Send tire mesh vertex locations and velocities to the terrain node, either as they are or
+    // as differences from the states already known by the terrain node.
+    //// TODO: use custom derived MPI types?
+    unsigned int num_vert = m_num_vertices;
+    MPI_Request request;
+    if (m_mesh_deltas) {
+        for (unsigned int iv = 0; iv < num_vert; iv++) {
+            for (int j = 0; j < 3; j++) {
+                int ip = 3 * iv + j;
+                int iu = 3 * num_vert + 3 * iv + j;
+                m_vert_deltas[ip] = (float)(vert_pos[iv](j) - m_vert_data[ip]);
+                m_vert_deltas[iu] = (float)(vert_vel[iv](j) - m_vert_data[iu]);
+                m_vert_data[ip] += m_vert_deltas[ip];
+                m_vert_data[iu] += m_vert_deltas[iu];
+            }
+        }
+        MPI_Isend(m_vert_deltas.data(), 2 * 3 * num_vert, MPI_FLOAT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+                  &request);
+    } else {
+        for (unsigned int iv = 0; iv < num_vert; iv++) {
+            m_vert_data[3 * iv + 0] = vert_pos[iv].x;
+            m_vert_data[3 * iv + 1] = vert_pos[iv].y;
+            m_vert_data[3 * iv + 2] = vert_pos[iv].z;
+        }
+        for (unsigned int iv = 0; iv < num_vert; iv++) {
+            m_vert_data[3 * num_vert + 3 * iv + 0] = vert_vel[iv].x;
+            m_vert_data[3 * num_vert + 3 * iv + 1] = vert_vel[iv].y;
+            m_vert_data[3 * num_vert + 3 * iv + 2] = vert_vel[iv].z;
+        }
+        MPI_Isend(m_vert_data.data(), 2 * 3 * num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD,
+                  &request);
+    }
+    m_sends.push_back(request);
+
     // Send tire force to the vehicle node
     TireForce tire_force = m_tire->GetTireForce(true);
-    double bufTF[9];
-    bufTF[0] = tire_force.force.x;
-    bufTF[1] = tire_force.force.y;
-    bufTF[2] = tire_force.force.z;
-    bufTF[3] = tire_force.moment.x;
-    bufTF[4] = tire_force.moment.y;
-    bufTF[5] = tire_force.moment.z;
-    bufTF[6] = tire_force.point.x;
-    bufTF[7] = tire_force.point.y;
-    bufTF[8] = tire_force.point.z;
-    MPI_Send(bufTF, 9, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
+    m_tire_force[0] = tire_force.force.x;
+    m_tire_force[1] = tire_force.force.y;
+    m_tire_force[2] = tire_force.force.z;
+    m_tire_force[3] = tire_force.moment.x;
+    m_tire_force[4] = tire_force.moment.y;
+    m_tire_force[5] = tire_force.moment.z;
+    m_tire_force[6] = tire_force.point.x;
+    m_tire_force[7] = tire_force.point.y;
+    m_tire_force[8] = tire_force.point.z;
+    MPI_Isend(m_tire_force, 9, MPI_DOUBLE, VEHICLE_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &request);
+    m_sends.push_back(request);
 
     // Receive wheel state from the vehicle node
     double bufWS[14];
@@ -104,62 +200,23 @@ void ChCosimTireNode::Synchronize(double time) {
     wheel_state.ang_vel = ChVector<>(bufWS[10], bufWS[11], bufWS[12]);
     wheel_state.omega = bufWS[13];
 
-    // Extract tire mesh vertex locations and velocities
-    std::vector<ChVector<>> vert_pos;
-    std::vector<ChVector<>> vert_vel;
-    std::vector<ChVector<int>> triangles;
-    m_contact_load->OutputSimpleMesh(vert_pos, vert_vel, triangles);
-    unsigned int num_vert = (unsigned int)vert_pos.size();
-    unsigned int num_tri = (unsigned int)triangles.size();
-
-    // Send tire mesh vertex locations and velocities to the terrain node
-    //// TODO: use custom derived MPI types?
-    double* vert_data = new double[2 * 3 * num_vert];
-    int* tri_data = new int[3 * num_tri];
-    for (unsigned int iv = 0; iv < num_vert; iv++) {
-        vert_data[3 * iv + 0] = vert_pos[iv].x;
-        vert_data[3 * iv + 1] = vert_pos[iv].y;
-        vert_data[3 * iv + 2] = vert_pos[iv].z;
-    }
-    for (unsigned int iv = 0; iv < num_vert; iv++) {
-        vert_data[3 * num_vert + 3 * iv + 0] = vert_vel[iv].x;
-        vert_data[3 * num_vert + 3 * iv + 1] = vert_vel[iv].y;
-        vert_data[3 * num_vert + 3 * iv + 2] = vert_vel[iv].z;
-    }
-    for (unsigned int it = 0; it < num_tri; it++) {
-        tri_data[3 * it + 0] = triangles[it].x;
-        tri_data[3 * it + 1] = triangles[it].y;
-        tri_data[3 * it + 2] = triangles[it].z;
-    }
-    MPI_Send(vert_data, 2 * 3 * num_vert, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
-    MPI_Send(tri_data, 3 * num_tri, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD);
-
-    delete[] vert_data;
-    delete[] tri_data;
-
-    // Receive terrain force(s) from the terrain node
-    // Note that we use MPI_Probe to figure out the number of indeces and forces received.
-    MPI_Status status;
+    // Complete the receives of the terrain force(s).
+    // Note that we use MPI_Get_count to figure out the number of indeces and forces received.
+    MPI_Status status[2];
     int count;
-    MPI_Probe(TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
-    MPI_Get_count(&status, MPI_INT, &count);
-    int* index_data = new int[count];
-    double* force_data = new double[3 * count];
-    MPI_Recv(index_data, count, MPI_INT, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
-    MPI_Recv(force_data, 3 * count, MPI_DOUBLE, TERRAIN_NODE_RANK, m_id.id(), MPI_COMM_WORLD, &status);
+    MPI_Waitall(2, recvs, status);
+    MPI_Get_count(&status[0], MPI_INT, &count);
 
     // Repack data and apply forces to the mesh vertices
     std::vector<ChVector<>> vert_forces;
     std::vector<int> vert_indeces;
     for (int iv = 0; iv < count; iv++) {
-        vert_forces.push_back(ChVector<>(force_data[3 * iv + 0], force_data[3 * iv + 1], force_data[3 * iv + 2]));
-        vert_indeces.push_back(index_data[iv]);
+        vert_forces.push_back(
+            ChVector<>(m_force_data[3 * iv + 0], m_force_data[3 * iv + 1], m_force_data[3 * iv + 2]));
+        vert_indeces.push_back(m_index_data[iv]);
     }
     m_contact_load->InputSimpleForces(vert_forces, vert_indeces);
 
-    delete[] index_data;
-    delete[] force_data;
-
     // Synchronize the ghost wheel and the tire
     m_wheel->SetPos(wheel_state.pos);
     m_wheel->SetRot(wheel_state.rot);
@@ -179,5 +236,12 @@ void ChCosimTireNode::Advance(double step) {
     m_tire->Advance(step);
 }
 
+void ChCosimTireNode::CompleteSends() {
+    if (m_sends.empty())
+        return;
+    MPI_Waitall((int)m_sends.size(), m_sends.data(), MPI_STATUSES_IGNORE);
+    m_sends.clear();
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
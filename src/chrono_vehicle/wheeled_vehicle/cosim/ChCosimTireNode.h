@@ -19,6 +19,7 @@
 #ifndef CH_COSIM_TIRE_NODE_H
 #define CH_COSIM_TIRE_NODE_H
 
+#include <vector>
 #include "mpi.h"
 
 #include "chrono/physics/ChSystem.h"
@@ -33,21 +34,45 @@ namespace vehicle {
 /// @addtogroup vehicle_wheeled_cosim
 /// @{
 
+/// Cosimulation node for a tire.
+/// The connectivity of the tire contact mesh is sent to the terrain node only once, at
+/// initialization; at each step, only the vertex positions and velocities are sent.
+/// Messages are sent with non-blocking MPI calls, completed at the next synchronization,
+/// so that the transfers overlap with the integration of the tire system.
 class CH_VEHICLE_API ChCosimTireNode : public ChCosimNode {
   public:
     ChCosimTireNode(int rank, ChSystem* system, ChDeformableTire* tire, WheelID id);
+    ~ChCosimTireNode();
+
+    /// Send the mesh vertex states as single-precision differences from the previously sent
+    /// states, instead of double-precision values (default: false).
+    /// Both nodes accumulate the same rounded differences, so that the error does not grow
+    /// over time. Must be called before Initialize().
+    void SetMeshDeltas(bool val) { m_mesh_deltas = val; }
 
     void Initialize();
     void Synchronize(double time);
     void Advance(double step);
 
   private:
+    /// Wait for the completion of the messages sent at the previous synchronization.
+    void CompleteSends();
+
     ChDeformableTire* m_tire;
     WheelID m_id;
     std::shared_ptr<ChBody> m_wheel;
     std::shared_ptr<ChTerrain> m_terrain;
 
     std::shared_ptr<fea::ChLoadContactSurfaceMesh> m_contact_load;
+
+    bool m_mesh_deltas;                  ///< send vertex states as single-precision differences
+    unsigned int m_num_vertices;         ///< number of contact mesh vertices
+    std::vector<double> m_vert_data;     ///< vertex states (positions, then velocities) as known by the terrain node
+    std::vector<float> m_vert_deltas;    ///< send buffer for the vertex state differences
+    double m_tire_force[9];              ///< send buffer for the tire force
+    std::vector<int> m_index_data;       ///< receive buffer for the indices of the loaded vertices
+    std::vector<double> m_force_data;    ///< receive buffer for the vertex forces
+    std::vector<MPI_Request> m_sends;    ///< pending send requests
 };
 
 /// @} vehicle_wheeled_cosim
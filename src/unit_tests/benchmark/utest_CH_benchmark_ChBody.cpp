@@ -1,5 +1,6 @@
 #include "../ChTestConfig.h"
 #include "physics/ChSystem.h"
+#include "physics/ChLightBodyContainer.h"
 #include <iostream>
 using namespace chrono;
 using namespace std;
@@ -13,6 +14,12 @@ using namespace std;
 
 #define TIMEBODY(X, Y) TIME(body_list->at(i)->X, Y)
 
+#define TIMECONTAINER(X, Y)  \
+    timer.start();           \
+    container->X;            \
+    timer.stop();            \
+    cout << Y << timer() << endl;
+
 int main() {
     ChTimer<double> timer, full;
     const int num_bodies = 1000000;
@@ -62,5 +69,29 @@ int main() {
     timer.stop();
     cout << "SIngle Loop " << timer() << endl;
 
+    // Same bodies in a light body container: data in contiguous arrays, one call per pass
+    auto container = std::make_shared<ChLightBodyContainer>();
+    container->Reserve(num_bodies);
+    for (int i = 0; i < num_bodies; i++) {
+        container->AddBody(ChCoordsys<>(body_list->at(i)->GetPos()));
+    }
+    dynamics_system.Add(container);
+
+    cout << endl << "Light body container" << endl;
+    timer.reset();
+    full.reset();
+    full.start();
+
+    TIMECONTAINER(Update(current_time), "Update ");
+
+    TIMECONTAINER(VariablesFbReset(), "VariablesFbReset ");
+    TIMECONTAINER(VariablesFbLoadForces(time_step), "VariablesFbLoadForces ");
+    TIMECONTAINER(VariablesQbLoadSpeed(), "VariablesQbLoadSpeed ");
+    TIMECONTAINER(VariablesQbIncrementPosition(time_step), "VariablesQbIncrementPosition ");
+    TIMECONTAINER(VariablesQbSetSpeed(time_step), "VariablesQbSetSpeed ");
+
+    full.stop();
+    cout << "Total: " << full() << endl;
+
     return 0;
 }
@@ -0,0 +1,247 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark comparing the pooled contact storage of ChContactContainerDVI with
+// the std::list<ChContactDVI*> storage used by earlier versions of the container.
+// Contacts are created between random pairs of bodies, then each storage is
+// refilled (recycling the contact objects) and traversed as in a typical step.
+//
+// =============================================================================
+
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <vector>
+
+#include "../ChTestConfig.h"
+#include "physics/ChContactContainerDVI.h"
+#include "physics/ChSystem.h"
+
+using namespace chrono;
+using namespace std;
+
+typedef ChContactContainerDVI::ChContactDVI_6_6 ChContactDVI_6_6;
+
+// List-based storage of 6_6 contacts, as used by earlier contact containers:
+// contact objects are heap-allocated one by one and reused through an iterator.
+class ListStorage {
+  public:
+    ListStorage(ChContactContainerBase* mcontainer) : container(mcontainer), n_added(0) {}
+
+    ~ListStorage() {
+        for (auto itercontact = contactlist.begin(); itercontact != contactlist.end(); ++itercontact)
+            delete (*itercontact);
+    }
+
+    void BeginAddContact() {
+        lastcontact = contactlist.begin();
+        n_added = 0;
+    }
+
+    void AddContact(const collision::ChCollisionInfo& cinfo) {
+        ChContactable_1vars<6>* mmboA = dynamic_cast<ChContactable_1vars<6>*>(cinfo.modelA->GetContactable());
+        ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(cinfo.modelB->GetContactable());
+        if (lastcontact != contactlist.end()) {
+            (*lastcontact)->Reset(mmboA, mmboB, cinfo);
+            lastcontact++;
+        } else {
+            contactlist.push_back(new ChContactDVI_6_6(container, mmboA, mmboB, cinfo));
+            lastcontact = contactlist.end();
+        }
+        n_added++;
+    }
+
+    void EndAddContact() {
+        while (lastcontact != contactlist.end()) {
+            delete (*lastcontact);
+            lastcontact = contactlist.erase(lastcontact);
+        }
+    }
+
+    void IntLoadResidual_CqL(ChVectorDynamic<>& R, const ChVectorDynamic<>& L) {
+        unsigned int coffset = 0;
+        for (auto itercontact = contactlist.begin(); itercontact != contactlist.end(); ++itercontact) {
+            (*itercontact)->ContIntLoadResidual_CqL(coffset, R, L, 1.0);
+            coffset += 3;
+        }
+    }
+
+    void IntLoadConstraint_C(ChVectorDynamic<>& Qc) {
+        unsigned int coffset = 0;
+        for (auto itercontact = contactlist.begin(); itercontact != contactlist.end(); ++itercontact) {
+            (*itercontact)->ContIntLoadConstraint_C(coffset, Qc, 1.0, false, 0);
+            coffset += 3;
+        }
+    }
+
+    void InjectConstraints(ChSystemDescriptor& mdescriptor) {
+        for (auto itercontact = contactlist.begin(); itercontact != contactlist.end(); ++itercontact)
+            (*itercontact)->InjectConstraints(mdescriptor);
+    }
+
+    void ReportAllContacts(ChReportContactCallback* mcallback) {
+        for (auto itercontact = contactlist.begin(); itercontact != contactlist.end(); ++itercontact) {
+            bool proceed = mcallback->ReportContactCallback(
+                (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), *(*itercontact)->GetContactPlane(),
+                (*itercontact)->GetContactDistance(), (*itercontact)->GetContactForce(), VNULL,
+                (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+            if (!proceed)
+                break;
+        }
+    }
+
+  private:
+    ChContactContainerBase* container;
+    std::list<ChContactDVI_6_6*> contactlist;
+    std::list<ChContactDVI_6_6*>::iterator lastcontact;
+    int n_added;
+};
+
+// Callback used to traverse all contacts through ReportAllContacts.
+class SumReporter : public ChReportContactCallback {
+  public:
+    SumReporter() : sum(0) {}
+    virtual bool ReportContactCallback(const ChVector<>& pA,
+                                       const ChVector<>& pB,
+                                       const ChMatrix33<>& plane_coord,
+                                       const double& distance,
+                                       const ChVector<>& react_forces,
+                                       const ChVector<>& react_torques,
+                                       ChContactable* contactobjA,
+                                       ChContactable* contactobjB) override {
+        sum += distance;
+        return true;
+    }
+    double sum;
+};
+
+template <class Tstorage>
+void RunPasses(Tstorage& storage,
+               const std::vector<collision::ChCollisionInfo>& cinfos,
+               int num_coords,
+               const char* label) {
+    ChTimer<double> timer;
+    int num_contacts = (int)cinfos.size();
+    ChVectorDynamic<> R(num_coords);
+    ChVectorDynamic<> L(3 * num_contacts);
+    ChVectorDynamic<> Qc(3 * num_contacts);
+    L.FillElem(1.0);
+    ChSystemDescriptor descriptor;
+
+    // First fill: contact objects are allocated.
+    timer.start();
+    storage.BeginAddContact();
+    for (int i = 0; i < num_contacts; i++)
+        storage.AddContact(cinfos[i]);
+    storage.EndAddContact();
+    timer.stop();
+    cout << label << " first fill:          " << timer() << endl;
+
+    // Second fill: contact objects are recycled.
+    timer.reset();
+    timer.start();
+    storage.BeginAddContact();
+    for (int i = 0; i < num_contacts; i++)
+        storage.AddContact(cinfos[i]);
+    storage.EndAddContact();
+    timer.stop();
+    cout << label << " refill:              " << timer() << endl;
+
+    timer.reset();
+    timer.start();
+    storage.IntLoadResidual_CqL(R, L);
+    timer.stop();
+    cout << label << " IntLoadResidual_CqL: " << timer() << endl;
+
+    timer.reset();
+    timer.start();
+    storage.IntLoadConstraint_C(Qc);
+    timer.stop();
+    cout << label << " IntLoadConstraint_C: " << timer() << endl;
+
+    timer.reset();
+    timer.start();
+    storage.InjectConstraints(descriptor);
+    timer.stop();
+    cout << label << " InjectConstraints:   " << timer() << endl;
+
+    SumReporter reporter;
+    timer.reset();
+    timer.start();
+    storage.ReportAllContacts(&reporter);
+    timer.stop();
+    cout << label << " ReportAllContacts:   " << timer() << endl;
+}
+
+// Adapter exposing the pooled container with the same interface as ListStorage.
+class PoolStorage {
+  public:
+    PoolStorage(ChContactContainerDVI* mcontainer) : container(mcontainer) {}
+
+    void BeginAddContact() { container->BeginAddContact(); }
+    void AddContact(const collision::ChCollisionInfo& cinfo) { container->AddContact(cinfo); }
+    void EndAddContact() { container->EndAddContact(); }
+    void IntLoadResidual_CqL(ChVectorDynamic<>& R, const ChVectorDynamic<>& L) {
+        container->IntLoadResidual_CqL(0, R, L, 1.0);
+    }
+    void IntLoadConstraint_C(ChVectorDynamic<>& Qc) { container->IntLoadConstraint_C(0, Qc, 1.0, false, 0); }
+    void InjectConstraints(ChSystemDescriptor& mdescriptor) { container->InjectConstraints(mdescriptor); }
+    void ReportAllContacts(ChReportContactCallback* mcallback) { container->ReportAllContacts(mcallback); }
+
+  private:
+    ChContactContainerDVI* container;
+};
+
+int main() {
+    const int num_bodies = 1000;
+    const int num_contacts[] = {10000, 100000, 1000000};
+
+    ChSystem dynamics_system;
+
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(rand() % 1000 / 1000.0, rand() % 1000 / 1000.0, rand() % 1000 / 1000.0));
+        dynamics_system.AddBody(body);
+    }
+    dynamics_system.Setup();
+
+    std::vector<std::shared_ptr<ChBody> >* body_list = dynamics_system.Get_bodylist();
+    int num_coords = dynamics_system.GetNcoords_w();
+
+    for (int k = 0; k < 3; k++) {
+        std::vector<collision::ChCollisionInfo> cinfos(num_contacts[k]);
+        for (int i = 0; i < num_contacts[k]; i++) {
+            int ia = rand() % num_bodies;
+            int ib = (ia + 1 + rand() % (num_bodies - 1)) % num_bodies;
+            cinfos[i].modelA = body_list->at(ia)->GetCollisionModel();
+            cinfos[i].modelB = body_list->at(ib)->GetCollisionModel();
+            cinfos[i].vpA = body_list->at(ia)->GetPos();
+            cinfos[i].vpB = body_list->at(ib)->GetPos();
+            cinfos[i].vN = (cinfos[i].vpB - cinfos[i].vpA).GetNormalized();
+            cinfos[i].distance = -0.001;
+        }
+
+        cout << "---- " << num_contacts[k] << " contacts ----" << endl;
+        {
+            ChContactContainerDVI container;
+            ListStorage storage(&container);
+            RunPasses(storage, cinfos, num_coords, "List");
+        }
+        {
+            ChContactContainerDVI container;
+            PoolStorage storage(&container);
+            RunPasses(storage, cinfos, num_coords, "Pool");
+        }
+    }
+
+    return 0;
+}
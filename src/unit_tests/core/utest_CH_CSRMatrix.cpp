@@ -0,0 +1,198 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the CSR sparse matrix with reusable sparsity pattern.
+// - mixed overwrite/accumulate assembly compared against a dense matrix;
+// - elements outside a locked pattern are merged into it;
+// - the system matrix of a set of pendulums assembled by ConvertToMatrixForm at
+//   every step must match the one assembled in a ChLinkedListMatrix, and the
+//   sparsity pattern must be reused across steps; the right-hand side alone
+//   must match the one assembled with the matrix.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChCSRMatrix.h"
+#include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystem.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_pendulums = 20;   // number of pendulums
+int num_steps = 10;       // number of simulation steps
+double time_step = 1e-3;  // integration step size
+
+// ====================================================================================
+
+bool CompareDense(ChCSRMatrix& A, ChMatrixDynamic<>& D, const char* label) {
+    for (int i = 0; i < D.GetRows(); i++) {
+        for (int j = 0; j < D.GetColumns(); j++) {
+            if (A.GetElement(i, j) != D(i, j)) {
+                GetLog() << label << ": element (" << i << "," << j << ") is " << A.GetElement(i, j) << " instead of "
+                         << D(i, j) << "\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TestAssembly() {
+    ChCSRMatrix A(6, 5);
+    ChMatrixDynamic<> D(6, 5);
+    ChMatrixDynamic<> block(2, 3);
+    block(0, 0) = 1;
+    block(0, 2) = 2;
+    block(1, 1) = 3;
+    block(1, 2) = 4;
+
+    bool passed = true;
+    for (int pass = 0; pass < 3; pass++) {
+        A.Reset(6, 5);
+        D.Reset(6, 5);
+        double s = 1.0 + pass;
+
+        A.SetElement(0, 0, 2 * s);
+        D(0, 0) = 2 * s;
+        A.SetElement(0, 0, 1, false);
+        D(0, 0) += 1;
+        A.PasteMatrix(&block, 1, 1);
+        D.PasteMatrix(&block, 1, 1);
+        A.PasteSumMatrix(&block, 2, 2);
+        D.PasteSumMatrix(&block, 2, 2);
+        A.PasteTranspMatrix(&block, 3, 0);
+        D.PasteTranspMatrix(&block, 3, 0);
+        A.SetElement(5, 4, s);
+        A.SetElement(5, 4, 0);  // overwritten with zero
+        A.Finalize();
+
+        passed &= CompareDense(A, D, "assembly");
+    }
+
+    if (A.GetNumSymbolicPasses() != 1 || A.GetNumNumericPasses() != 2) {
+        GetLog() << "assembly: " << A.GetNumSymbolicPasses() << " symbolic and " << A.GetNumNumericPasses()
+                 << " numeric passes\n";
+        passed = false;
+    }
+
+    // An element outside the locked pattern is merged into it.
+    int nnz = A.GetNNZ();
+    A.Reset(6, 5);
+    A.SetElement(4, 4, 7);
+    A.Finalize();
+    if (A.GetNNZ() != nnz + 1 || A.GetElement(4, 4) != 7 || A.GetNumSymbolicPasses() != 2) {
+        GetLog() << "overflow: element not merged in the sparsity pattern\n";
+        passed = false;
+    }
+
+    // Element() inserts a missing element.
+    A.Element(5, 3) += 3;
+    if (A.GetElement(5, 3) != 3 || A.GetNNZ() != nnz + 2) {
+        GetLog() << "Element: element not inserted\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool TestSystem() {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int i = 0; i < num_pendulums; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(1, 0, i));
+        body->SetMass(1 + 0.1 * i);
+        body->SetInertiaXX(ChVector<>(0.1, 0.2, 0.3));
+        system.AddBody(body);
+
+        auto rev = std::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(ground, body, ChCoordsys<>(ChVector<>(0, 0, i), QUNIT));
+        system.AddLink(rev);
+    }
+
+    ChCSRMatrix Z;
+    ChCSRMatrix Cq;
+    ChCSRMatrix M;
+    bool passed = true;
+
+    for (int is = 0; is < num_steps && passed; is++) {
+        system.DoStepDynamics(time_step);
+
+        ChSystemDescriptor* descriptor = system.GetSystemDescriptor();
+        ChLinkedListMatrix Z_ref;
+        ChLinkedListMatrix Cq_ref;
+        ChLinkedListMatrix M_ref;
+        ChMatrixDynamic<> rhs_Z;
+        ChMatrixDynamic<> rhs;
+        descriptor->ConvertToMatrixForm(&Z, &rhs_Z);
+        descriptor->ConvertToMatrixForm(&Z_ref, nullptr);
+        descriptor->ConvertToMatrixForm(nullptr, &rhs);
+        descriptor->ConvertToMatrixForm(&Cq, &M, nullptr, nullptr, nullptr, nullptr);
+        descriptor->ConvertToMatrixForm(&Cq_ref, &M_ref, nullptr, nullptr, nullptr, nullptr);
+
+        ChMatrixDynamic<> D;
+        Z_ref.CopyToMatrix(&D);
+        passed &= CompareDense(Z, D, "Z");
+        Cq_ref.CopyToMatrix(&D);
+        passed &= CompareDense(Cq, D, "Cq");
+        M_ref.CopyToMatrix(&D);
+        passed &= CompareDense(M, D, "M");
+
+        // The right-hand side alone (as requested by the direct solvers) is the
+        // same as the one assembled with the matrix.
+        if (rhs.GetRows() != Z.GetRows() || rhs.GetRows() != rhs_Z.GetRows()) {
+            GetLog() << "rhs: wrong size\n";
+            passed = false;
+        } else {
+            for (int i = 0; i < rhs.GetRows(); i++) {
+                if (rhs(i) != rhs_Z(i)) {
+                    GetLog() << "rhs: element " << i << " differs\n";
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Jacobian entries that are exactly zero in the initial configuration enter the
+    // pattern at the next step; after that, the pattern must be reused.
+    if (Z.GetNumSymbolicPasses() > 2 || Z.GetNumNumericPasses() != num_steps - 1) {
+        GetLog() << "Z: " << Z.GetNumSymbolicPasses() << " symbolic and " << Z.GetNumNumericPasses()
+                 << " numeric passes\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestAssembly();
+    passed &= TestSystem();
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
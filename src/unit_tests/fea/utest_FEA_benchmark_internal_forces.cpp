@@ -0,0 +1,224 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for the computation of the internal forces of FEA elements.
+// For each element type, a mesh of deformed elements is built and the internal
+// forces are loaded in the residual with ChMesh::IntLoadResidual_F, which runs
+// an OpenMP loop over the elements. The throughput (elements per second) is
+// printed for an increasing number of threads. The elements do not share nodes,
+// so the residual must be the same for any number of threads.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_fea/ChElementBeamEuler.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementHexa_20.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChElementTetra_10.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace fea;
+
+int num_elements = 20000;  // elements of each type
+int num_calls = 10;        // calls to IntLoadResidual_F for each thread count
+int max_threads = 8;       // largest number of threads
+
+enum ElementType { TETRA_4, TETRA_10, HEXA_8, HEXA_20, BEAM_EULER };
+const char* element_names[] = {"ChElementTetra_4", "ChElementTetra_10", "ChElementHexa_8", "ChElementHexa_20",
+                               "ChElementBeamEuler"};
+
+// Deformed position of a point of an element with the given origin: a small
+// rotation and a stretch, so that all the terms of the internal forces count.
+ChVector<> Deform(const ChVector<>& origin, const ChVector<>& p) {
+    ChQuaternion<> q = Q_from_AngAxis(0.1, ChVector<>(1, 2, 3).GetNormalized());
+    ChVector<> local = p - origin;
+    return origin + q.Rotate(ChVector<>(local.x * 1.01, local.y, local.z * 0.99));
+}
+
+std::shared_ptr<ChNodeFEAxyz> AddNode(std::shared_ptr<ChMesh> mesh, const ChVector<>& origin, const ChVector<>& p) {
+    auto node = std::make_shared<ChNodeFEAxyz>(origin + p);
+    node->SetPos(Deform(origin, origin + p));
+    node->SetPos_dt(ChVector<>(0.01 * p.y, -0.02 * p.x, 0.01));
+    mesh->AddNode(node);
+    return node;
+}
+
+void AddTetra4(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChContinuumElastic> material, const ChVector<>& o) {
+    auto n1 = AddNode(mesh, o, ChVector<>(0, 0, 0));
+    auto n2 = AddNode(mesh, o, ChVector<>(0, 0, 1));
+    auto n3 = AddNode(mesh, o, ChVector<>(0, 1, 0));
+    auto n4 = AddNode(mesh, o, ChVector<>(1, 0, 0));
+    auto element = std::make_shared<ChElementTetra_4>();
+    element->SetNodes(n1, n2, n3, n4);
+    element->SetMaterial(material);
+    mesh->AddElement(element);
+}
+
+void AddTetra10(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChContinuumElastic> material, const ChVector<>& o) {
+    ChVector<> p1(0, 0, 0);
+    ChVector<> p2(1, 0, 0);
+    ChVector<> p3(0, 1, 0);
+    ChVector<> p4(0, 0, 1);
+    auto n1 = AddNode(mesh, o, p1);
+    auto n2 = AddNode(mesh, o, p2);
+    auto n3 = AddNode(mesh, o, p3);
+    auto n4 = AddNode(mesh, o, p4);
+    auto n5 = AddNode(mesh, o, (p1 + p2) * 0.5);
+    auto n6 = AddNode(mesh, o, (p2 + p3) * 0.5);
+    auto n7 = AddNode(mesh, o, (p3 + p1) * 0.5);
+    auto n8 = AddNode(mesh, o, (p1 + p4) * 0.5);
+    auto n9 = AddNode(mesh, o, (p4 + p2) * 0.5);
+    auto n10 = AddNode(mesh, o, (p3 + p4) * 0.5);
+    auto element = std::make_shared<ChElementTetra_10>();
+    element->SetNodes(n1, n2, n3, n4, n5, n6, n7, n8, n9, n10);
+    element->SetMaterial(material);
+    mesh->AddElement(element);
+}
+
+// Corners of the unit cube, in the order used by the hexahedral elements
+ChVector<> HexaCorner(int i) {
+    const double corners[8][3] = {{0, 0, 0}, {0, 0, 1}, {1, 0, 1}, {1, 0, 0},
+                                  {0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {1, 1, 0}};
+    return ChVector<>(corners[i][0], corners[i][1], corners[i][2]);
+}
+
+void AddHexa8(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChContinuumElastic> material, const ChVector<>& o) {
+    std::shared_ptr<ChNodeFEAxyz> n[8];
+    for (int i = 0; i < 8; i++)
+        n[i] = AddNode(mesh, o, HexaCorner(i));
+    auto element = std::make_shared<ChElementHexa_8>();
+    element->SetNodes(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]);
+    element->SetMaterial(material);
+    mesh->AddElement(element);
+}
+
+void AddHexa20(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChContinuumElastic> material, const ChVector<>& o) {
+    // corners, then mid points of the front face, of the back face and of the side edges
+    const int edges[12][2] = {{0, 1}, {1, 2}, {2, 3}, {0, 3}, {4, 5}, {5, 6},
+                              {6, 7}, {7, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 4}};
+    std::shared_ptr<ChNodeFEAxyz> n[20];
+    for (int i = 0; i < 8; i++)
+        n[i] = AddNode(mesh, o, HexaCorner(i));
+    for (int i = 0; i < 12; i++)
+        n[8 + i] = AddNode(mesh, o, (HexaCorner(edges[i][0]) + HexaCorner(edges[i][1])) * 0.5);
+    auto element = std::make_shared<ChElementHexa_20>();
+    element->SetNodes(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10], n[11], n[12], n[13], n[14],
+                      n[15], n[16], n[17], n[18], n[19]);
+    element->SetMaterial(material);
+    element->SetReducedIntegrationRule();
+    mesh->AddElement(element);
+}
+
+void AddBeam(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChBeamSectionAdvanced> section, const ChVector<>& o) {
+    ChVector<> p1 = o;
+    ChVector<> p2 = o + ChVector<>(1, 0, 0);
+    auto n1 = std::make_shared<ChNodeFEAxyzrot>(ChFrame<>(p1));
+    auto n2 = std::make_shared<ChNodeFEAxyzrot>(ChFrame<>(p2));
+    n1->Frame().SetPos(Deform(o, p1));
+    n2->Frame().SetPos(Deform(o, p2));
+    n1->Frame().SetRot(Q_from_AngAxis(0.05, VECT_Y));
+    n2->Frame().SetRot(Q_from_AngAxis(0.1, VECT_Z));
+    n2->Frame().SetPos_dt(ChVector<>(0, 0.01, 0));
+    mesh->AddNode(n1);
+    mesh->AddNode(n2);
+    auto element = std::make_shared<ChElementBeamEuler>();
+    element->SetNodes(n1, n2);
+    element->SetSection(section);
+    mesh->AddElement(element);
+}
+
+void Benchmark(ElementType type) {
+    ChSystem system;
+    auto mesh = std::make_shared<ChMesh>();
+    mesh->SetAutomaticGravity(false);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(0.01e9);
+    material->Set_v(0.3);
+    material->Set_RayleighDampingK(0.001);
+    material->Set_RayleighDampingM(0.001);
+
+    auto section = std::make_shared<ChBeamSectionAdvanced>();
+    section->SetAsRectangularSection(0.012, 0.025);
+    section->SetYoungModulus(0.01e9);
+    section->SetGshearModulus(0.01e9 * 0.3);
+    section->SetBeamRaleyghDamping(0.001);
+
+    for (int i = 0; i < num_elements; i++) {
+        ChVector<> origin(2.0 * (i % 100), 2.0 * (i / 100), 0);
+        switch (type) {
+            case TETRA_4:
+                AddTetra4(mesh, material, origin);
+                break;
+            case TETRA_10:
+                AddTetra10(mesh, material, origin);
+                break;
+            case HEXA_8:
+                AddHexa8(mesh, material, origin);
+                break;
+            case HEXA_20:
+                AddHexa20(mesh, material, origin);
+                break;
+            case BEAM_EULER:
+                AddBeam(mesh, section, origin);
+                break;
+        }
+    }
+    system.Add(mesh);
+    system.SetupInitial();
+    system.Setup();
+    system.Update();
+
+    printf("%s (%d dofs)\n", element_names[type], mesh->GetElement(0)->GetNdofs());
+
+    ChVectorDynamic<> R_serial(system.GetNcoords_w());
+    ChVectorDynamic<> R(system.GetNcoords_w());
+    int threads_top = std::min(max_threads, std::max(1, CHOMPfunctions::GetNumProcs()));
+    double max_diff = 0;
+    for (int threads = 1; threads <= threads_top; threads *= 2) {
+        CHOMPfunctions::SetNumThreads(threads);
+        ChTimer<double> timer;
+        timer.start();
+        for (int i = 0; i < num_calls; i++) {
+            R.Reset();
+            mesh->IntLoadResidual_F(0, R, 1.0);
+        }
+        timer.stop();
+
+        if (threads == 1)
+            R_serial = R;
+        for (int i = 0; i < R.GetRows(); i++)
+            max_diff = std::max(max_diff, std::abs(R(i) - R_serial(i)));
+
+        printf("  threads %2d   time %8.4f s   %12.0f elements/s\n", threads, timer(),
+               num_calls * num_elements / timer());
+    }
+    printf("  residual norm %g, max difference with 1 thread %g\n", R_serial.NormTwo(), max_diff);
+}
+
+int main(int argc, char* argv[]) {
+    Benchmark(TETRA_4);
+    Benchmark(TETRA_10);
+    Benchmark(HEXA_8);
+    Benchmark(HEXA_20);
+    Benchmark(BEAM_EULER);
+    return 0;
+}
@@ -0,0 +1,222 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the jacobians of the loads on finite elements.
+// - A pressure load on a face of a tetrahedron provides its jacobians without
+//   finite differences; they must match the finite-difference ones.
+// - A load on the nodes of a contact surface mesh declares one block of
+//   coordinates per node, and its jacobians are block diagonal.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_fea/ChContactSurfaceMesh.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChFaceTetra_4.h"
+#include "chrono_fea/ChLoadContactSurfaceMesh.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Pressure loader that counts the evaluations of the load
+class CountingPressure : public ChLoaderPressure {
+  public:
+    CountingPressure(std::shared_ptr<ChLoadableUV> mloadable) : ChLoaderPressure(mloadable), num_evals(0) {}
+
+    virtual void ComputeQ(ChVectorDynamic<>* state_x, ChVectorDynamic<>* state_w) override {
+        num_evals++;
+        ChLoaderPressure::ComputeQ(state_x, state_w);
+    }
+
+    int num_evals;
+};
+
+// Pressure load that can also compute its jacobians by finite differences
+class PressureLoad : public ChLoad<CountingPressure> {
+  public:
+    PressureLoad(std::shared_ptr<ChLoadableUV> mloadable) : ChLoad<CountingPressure>(mloadable) {}
+
+    void ComputeJacobianNumerical(ChMatrix<>& mK, ChMatrix<>& mR) {
+        ChState mstate_x(LoadGet_ndof_x(), 0);
+        LoadGetStateBlock_x(mstate_x);
+        ChStateDelta mstate_w(LoadGet_ndof_w(), 0);
+        LoadGetStateBlock_w(mstate_w);
+        ComputeJacobianFD(&mstate_x, &mstate_w, mK, mR, loader.Q);
+    }
+};
+
+double MaxAbs(const ChMatrix<>& A) {
+    double val = 0;
+    for (int i = 0; i < A.GetRows(); i++)
+        for (int j = 0; j < A.GetColumns(); j++)
+            val = std::max(val, std::abs(A(i, j)));
+    return val;
+}
+
+std::shared_ptr<ChMesh> CreateTetrahedron(ChSystem& system) {
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(0.01e9);
+    material->Set_v(0.3);
+
+    auto node1 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 0));
+    auto node2 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 1));
+    auto node3 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 1, 0));
+    auto node4 = std::make_shared<ChNodeFEAxyz>(ChVector<>(1, 0, 0));
+    mesh->AddNode(node1);
+    mesh->AddNode(node2);
+    mesh->AddNode(node3);
+    mesh->AddNode(node4);
+
+    auto element = std::make_shared<ChElementTetra_4>();
+    element->SetNodes(node1, node2, node3, node4);
+    element->SetMaterial(material);
+    mesh->AddElement(element);
+
+    system.Add(mesh);
+    return mesh;
+}
+
+bool TestPressure() {
+    ChSystem system;
+    auto mesh = CreateTetrahedron(system);
+    auto element = std::static_pointer_cast<ChElementTetra_4>(mesh->GetElement(0));
+    auto face = std::make_shared<ChFaceTetra_4>(element, 1);
+
+    PressureLoad load(face);
+    load.loader.SetPressure(1e4);
+    load.loader.SetStiff(true);
+    load.Update();
+
+    int ndof = load.LoadGet_ndof_w();
+    ChMatrixDynamic<> K_num(ndof, ndof);
+    ChMatrixDynamic<> R_num(ndof, ndof);
+    int num_evals = load.loader.num_evals;
+    load.ComputeJacobianNumerical(K_num, R_num);
+
+    double scale = MaxAbs(load.loader.Q);
+    double diff_K = 0;
+    double diff_R = 0;
+    for (int i = 0; i < ndof; i++) {
+        for (int j = 0; j < ndof; j++) {
+            diff_K = std::max(diff_K, std::abs(K_num(i, j) - load.GetJacobians()->K(i, j)));
+            diff_R = std::max(diff_R, std::abs(R_num(i, j) - load.GetJacobians()->R(i, j)));
+        }
+    }
+
+    GetLog() << "Pressure load: |Q| = " << scale << "  diff K = " << diff_K << "  diff R = " << diff_R << "\n";
+    GetLog() << "  load evaluations: analytical = " << num_evals
+             << "  numerical = " << load.loader.num_evals - num_evals << "\n";
+
+    bool passed = true;
+    if (scale == 0 || diff_K > 1e-6 * scale || diff_R > 1e-6 * scale) {
+        GetLog() << "  jacobians differ\n";
+        passed = false;
+    }
+    if (num_evals != 1) {
+        GetLog() << "  finite differences used with analytical jacobians\n";
+        passed = false;
+    }
+    return passed;
+}
+
+bool TestContactSurfaceMesh() {
+    ChSystem system;
+    auto mesh = CreateTetrahedron(system);
+
+    auto surface = std::make_shared<ChContactSurfaceMesh>();
+    mesh->AddContactSurface(surface);
+    surface->AddFacesFromBoundary();
+
+    ChLoadContactSurfaceMesh load(surface);
+    std::vector<ChVector<> > vert_pos;
+    std::vector<ChVector<> > vert_vel;
+    std::vector<ChVector<int> > triangles;
+    load.OutputSimpleMesh(vert_pos, vert_vel, triangles);
+
+    std::vector<ChVector<> > vert_forces;
+    std::vector<int> vert_ind;
+    for (int i = 0; i < (int)vert_pos.size(); i++) {
+        vert_forces.push_back(ChVector<>(1.0 + i, -2.0 * i, 0.5));
+        vert_ind.push_back(i);
+    }
+    load.InputSimpleForces(vert_forces, vert_ind);
+
+    int nforces = (int)vert_forces.size();
+    int ndof_x = load.LoadGet_ndof_x();
+    int ndof_w = load.LoadGet_ndof_w();
+
+    bool passed = true;
+
+    // One block per node, each force depending only on its node
+    std::vector<int> offs_x, offs_w;
+    std::vector<std::vector<int> > deps;
+    if (!load.GetJacobianSparsity(offs_x, offs_w, deps) || (int)deps.size() != nforces ||
+        offs_x.back() != ndof_x || offs_w.back() != ndof_w) {
+        GetLog() << "  wrong blocks\n";
+        passed = false;
+    } else {
+        for (int i = 0; i < nforces; i++) {
+            if (offs_w[i + 1] - offs_w[i] != 3 || deps[i].size() != 1 || deps[i][0] != i) {
+                GetLog() << "  wrong block " << i << "\n";
+                passed = false;
+            }
+        }
+    }
+
+    // Each force is evaluated at its node
+    ChState mstate_x(ndof_x, 0);
+    load.LoadGetStateBlock_x(mstate_x);
+    ChStateDelta mstate_w(ndof_w, 0);
+    load.LoadGetStateBlock_w(mstate_w);
+    load.ComputeQ(&mstate_x, &mstate_w);
+    double diff_Q = 0;
+    for (int i = 0; i < nforces; i++) {
+        ChVector<> Q = load.GetForceList()[i]->loader.Q.ClipVector(0, 0);
+        diff_Q = std::max(diff_Q, (Q - vert_forces[i]).Length());
+    }
+
+    // Constant forces: null jacobians
+    ChMatrixDynamic<> K(ndof_w, ndof_w);
+    ChMatrixDynamic<> R(ndof_w, ndof_w);
+    ChMatrixDynamic<> M(ndof_w, ndof_w);
+    K.FillElem(1);
+    R.FillElem(1);
+    M.FillElem(1);
+    load.ComputeJacobian(&mstate_x, &mstate_w, K, R, M);
+
+    GetLog() << "Contact surface mesh load: " << nforces << " nodes, diff Q = " << diff_Q
+             << "  |K| = " << MaxAbs(K) << "  |R| = " << MaxAbs(R) << "  |M| = " << MaxAbs(M) << "\n";
+
+    if (nforces != 4 || diff_Q > 1e-12 || MaxAbs(K) != 0 || MaxAbs(R) != 0 || MaxAbs(M) != 0) {
+        GetLog() << "  wrong load or jacobians\n";
+        passed = false;
+    }
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestPressure();
+    passed &= TestContactSurfaceMesh();
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
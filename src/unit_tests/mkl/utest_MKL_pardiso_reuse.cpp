@@ -0,0 +1,155 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+// Test of the reuse of the Pardiso symbolic factorization in ChSolverMKL:
+//  - a refactorization with unchanged sparsity pattern (phase 22) must give the
+//    same solution as a full analysis (phase 12) of the same system;
+//  - a change of the sparsity pattern must force a new symbolic factorization.
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/solver/ChConstraintTwoGeneric.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+#include "chrono/solver/ChVariablesGeneric.h"
+#include "chrono_mkl/ChSolverMKL.h"
+
+using namespace chrono;
+
+// Fill the stiffness block with a nonzero, symmetric pattern scaled by 'scale'.
+void FillStiffness(ChKblockGeneric& kblock, double scale) {
+    ChMatrix<>& K = *kblock.Get_K();
+    for (int i = 0; i < K.GetRows(); i++)
+        for (int j = 0; j < K.GetColumns(); j++)
+            K(i, j) = scale * (i == j ? 3.0 : 0.1 * (1 + i + j));
+}
+
+// Load masses, forces and constraint data; 'step' changes the values but not the pattern.
+void LoadValues(ChVariablesGeneric& va, ChVariablesGeneric& vb, ChConstraintTwoGeneric& c, int step) {
+    va.GetMass().FillDiag(10.0 + step);
+    vb.GetMass().FillDiag(12.0 - step);
+    va.GetInvMass().FillDiag(1.0 / (10.0 + step));
+    vb.GetInvMass().FillDiag(1.0 / (12.0 - step));
+    for (int i = 0; i < 3; i++) {
+        va.Get_fb()(i) = 1.0 + i + step;
+        vb.Get_fb()(i) = -2.0 + 0.5 * i * step;
+    }
+    c.Get_Cq_a()->FillElem(0);
+    c.Get_Cq_b()->FillElem(0);
+    (*c.Get_Cq_a())(0) = 1.0;
+    (*c.Get_Cq_b())(0) = -1.0;
+    (*c.Get_Cq_a())(1) = 0.5 * step;
+    (*c.Get_Cq_b())(2) = 0.2 + step;
+    c.Set_b_i(0.1 * (step + 1));
+}
+
+// Collect the unknowns of the descriptor.
+void GetUnknowns(ChVariablesGeneric& va, ChVariablesGeneric& vb, ChConstraintTwoGeneric& c, double* x) {
+    for (int i = 0; i < 3; i++) {
+        x[i] = va.Get_qb()(i);
+        x[3 + i] = vb.Get_qb()(i);
+    }
+    x[6] = c.Get_l_i();
+}
+
+bool Compare(const double* x1, const double* x2, double tol) {
+    for (int i = 0; i < 7; i++) {
+        if (std::abs(x1[i] - x2[i]) > tol) {
+            std::cout << "  x[" << i << "]: " << x1[i] << " vs " << x2[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    const double tol = 1e-10;
+
+    ChVariablesGeneric va(3);
+    ChVariablesGeneric vb(3);
+    ChConstraintTwoGeneric c(&va, &vb);
+    ChKblockGeneric kab(&va, &vb);
+    ChKblockGeneric ka(std::vector<ChVariables*>(1, &va));
+
+    ChSystemDescriptor sysd;
+    sysd.BeginInsertion();
+    sysd.InsertVariables(&va);
+    sysd.InsertVariables(&vb);
+    sysd.InsertConstraint(&c);
+    sysd.InsertKblock(&kab);
+    sysd.EndInsertion();
+
+    ChSolverMKL solver;
+    solver.SetReuseSymbolicFactorization(true);
+
+    // First solve: no symbolic factorization yet.
+    LoadValues(va, vb, c, 0);
+    FillStiffness(kab, 1.0);
+    solver.Solve(sysd);
+    if (solver.GetPatternCacheMisses() != 1 || solver.GetPatternCacheHits() != 0) {
+        std::cout << "First solve did not perform a full analysis" << std::endl;
+        passed = false;
+    }
+
+    // Same pattern, new values: only the numeric factorization must be done.
+    LoadValues(va, vb, c, 1);
+    FillStiffness(kab, 2.0);
+    solver.Solve(sysd);
+    if (solver.GetPatternCacheMisses() != 1 || solver.GetPatternCacheHits() != 1) {
+        std::cout << "Unchanged pattern did not reuse the symbolic factorization" << std::endl;
+        passed = false;
+    }
+    double x_reuse[7];
+    GetUnknowns(va, vb, c, x_reuse);
+
+    // Reference: full analysis of the same system with a fresh solver.
+    ChSolverMKL solver_ref;
+    solver_ref.SetReuseSymbolicFactorization(false);
+    solver_ref.Solve(sysd);
+    double x_full[7];
+    GetUnknowns(va, vb, c, x_full);
+    if (!Compare(x_reuse, x_full, tol)) {
+        std::cout << "Phase 22 solution differs from full analysis" << std::endl;
+        passed = false;
+    }
+
+    // Change the sparsity pattern (same size): the coupling stiffness block is
+    // replaced by a block acting on the first variable only.
+    sysd.BeginInsertion();
+    sysd.InsertVariables(&va);
+    sysd.InsertVariables(&vb);
+    sysd.InsertConstraint(&c);
+    sysd.InsertKblock(&ka);
+    sysd.EndInsertion();
+
+    LoadValues(va, vb, c, 2);
+    FillStiffness(ka, 1.5);
+    solver.Solve(sysd);
+    if (solver.GetPatternCacheMisses() != 2 || solver.GetPatternCacheHits() != 1) {
+        std::cout << "Pattern change did not force a new symbolic factorization" << std::endl;
+        passed = false;
+    }
+    GetUnknowns(va, vb, c, x_reuse);
+
+    ChSolverMKL solver_ref2;
+    solver_ref2.SetReuseSymbolicFactorization(false);
+    solver_ref2.Solve(sysd);
+    GetUnknowns(va, vb, c, x_full);
+    if (!Compare(x_reuse, x_full, tol)) {
+        std::cout << "Solution after pattern change differs from full analysis" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "Test PASSED" : "Test FAILED") << std::endl;
+    return !passed;
+}
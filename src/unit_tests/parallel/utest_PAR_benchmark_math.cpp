@@ -0,0 +1,155 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel micro-benchmark for the vector math types.
+// Runs the per-contact kernels of the Jacobian computation (as in
+// ChConstraintRigidRigid::Build_D), of the narrowphase support mapping and of
+// the box AABB computation on real3/real4/M33. Build with USE_PARALLEL_AVX
+// ON and OFF to compare the AVX and the scalar double precision paths.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "unit_testing.h"
+
+#include "chrono/core/ChTimer.h"
+
+// Number of contacts (or shapes) and repetitions of each kernel
+int num_items = 100000;
+int num_reps = 50;
+
+// Same as chrono::Orthogonalize in ChConstraintRigidRigid.cpp
+static inline void BenchOrthogonalize(const real3& U, real3& V, real3& W) {
+  W = cross(U, R3(0, 1, 0));
+  real len = W.length();
+  if (len < real(0.0001)) {
+    W = cross(U, R3(1, 0, 0));
+    len = W.length();
+  }
+  W = W / len;
+  V = cross(W, U);
+}
+
+// Same as chrono::Compute_Jacobian in ChConstraintRigidRigid.cpp
+static inline void BenchJacobian(const real4& quat,
+                                 const real3& U,
+                                 const real3& V,
+                                 const real3& W,
+                                 const real3& point,
+                                 real3& T1,
+                                 real3& T2,
+                                 real3& T3) {
+  real4 quaternion_conjugate = ~quat;
+  real3 sbar = quatRotate(point, quaternion_conjugate);
+  T1 = cross(quatRotate(U, quaternion_conjugate), sbar);
+  T2 = cross(quatRotate(V, quaternion_conjugate), sbar);
+  T3 = cross(quatRotate(W, quaternion_conjugate), sbar);
+}
+
+// Support point of a rotated box, as in TransformSupportVert (ChCNarrowphaseUtils.h)
+static inline real3 BenchSupportBox(const real3& pos, const real4& rot, const real3& B, const real3& n) {
+  real3 nl = quatRotateT(n, rot);
+  return TransformLocalToParent(pos, rot, sign(nl) * B);
+}
+
+real3 RandomVector() {
+  return R3(real(rand()) / RAND_MAX - 0.5, real(rand()) / RAND_MAX - 0.5, real(rand()) / RAND_MAX - 0.5);
+}
+
+int main(int argc, char* argv[]) {
+#if defined(CHRONO_USE_AVX)
+  std::cout << "Math path: AVX (double)" << std::endl;
+#elif defined(CHRONO_USE_SIMD)
+  std::cout << "Math path: SSE (float)" << std::endl;
+#else
+  std::cout << "Math path: scalar" << std::endl;
+#endif
+
+  std::vector<real3> norm(num_items), pta(num_items), ptb(num_items), pos(num_items), dim(num_items);
+  std::vector<real4> rot(num_items);
+  for (int i = 0; i < num_items; i++) {
+    norm[i] = normalize(RandomVector());
+    pta[i] = RandomVector();
+    ptb[i] = RandomVector();
+    pos[i] = RandomVector();
+    dim[i] = absolute(RandomVector());
+    rot[i] = normalize(real4(rand(), rand(), rand(), rand()));
+  }
+  std::vector<real3> out(num_items * 6, R3(0));
+  real checksum = 0;
+
+  ChTimer<double> timer;
+
+  // Jacobian entries of a frictional contact between two bodies
+  timer.reset();
+  timer.start();
+  for (int r = 0; r < num_reps; r++) {
+    for (int i = 0; i < num_items; i++) {
+      // the outputs of the previous repetition perturb the contact points
+      real3 U = norm[i], V, W;
+      BenchOrthogonalize(U, V, W);
+      int j = (i + 1) % num_items;
+      real3 da = pta[i] - pos[i] + 1e-3 * out[6 * i + 0];
+      real3 db = ptb[i] - pos[j] + 1e-3 * out[6 * i + 3];
+      BenchJacobian(rot[i], U, V, W, da, out[6 * i + 0], out[6 * i + 1], out[6 * i + 2]);
+      BenchJacobian(rot[j], U, V, W, db, out[6 * i + 3], out[6 * i + 4], out[6 * i + 5]);
+    }
+  }
+  timer.stop();
+  double time_jacobian = timer();
+  for (int i = 0; i < num_items * 6; i++)
+    checksum += out[i].x + out[i].y + out[i].z;
+
+  // Support mapping of two boxes along the contact normal (one MPR iteration)
+  timer.reset();
+  timer.start();
+  for (int r = 0; r < num_reps; r++) {
+    for (int i = 0; i < num_items; i++) {
+      int j = (i + 1) % num_items;
+      real3 n = normalize(norm[i] + 1e-3 * out[i]);
+      real3 sa = BenchSupportBox(pos[i], rot[i], dim[i], -n);
+      real3 sb = BenchSupportBox(pos[j], rot[j], dim[j], n);
+      out[i] = sb - sa;
+    }
+  }
+  timer.stop();
+  double time_support = timer();
+  for (int i = 0; i < num_items; i++)
+    checksum += out[i].x + out[i].y + out[i].z;
+
+  // AABB of rotated boxes, as in ChCAABBGenerator
+  timer.reset();
+  timer.start();
+  for (int r = 0; r < num_reps; r++) {
+    for (int i = 0; i < num_items; i++) {
+      real3 temp = AbsMat(AMat(rot[i])) * (dim[i] + 1e-3 * out[2 * i + 1]);
+      out[2 * i + 0] = pos[i] - temp;
+      out[2 * i + 1] = pos[i] + temp;
+    }
+  }
+  timer.stop();
+  double time_aabb = timer();
+  for (int i = 0; i < num_items * 2; i++)
+    checksum += out[i].x + out[i].y + out[i].z;
+
+  double n = double(num_items) * num_reps;
+  std::cout << "Jacobian kernel:    " << time_jacobian << " s  (" << 1e9 * time_jacobian / n << " ns/contact)"
+            << std::endl;
+  std::cout << "Support kernel:     " << time_support << " s  (" << 1e9 * time_support / n << " ns/contact)"
+            << std::endl;
+  std::cout << "Box AABB kernel:    " << time_aabb << " s  (" << 1e9 * time_aabb / n << " ns/shape)" << std::endl;
+  std::cout << "Checksum:           " << checksum << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel benchmark for the warm starting of the contact impulses.
+// The model of demo_PAR_mixerDVI (balls falling in a bin, stirred by a rotating
+// mixer blade) is simulated with the APGD and APGDREF solvers, with and without
+// warm starting (ChSystem::SetSolverWarmStarting). The average number of solver
+// iterations per step needed to reach the tolerance, the fraction of the
+// contacts that were warm started and the solver time are reported.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Simulation parameters
+double time_step = 1e-3;
+int num_steps = 1000;
+int num_layers = 8;         // layers of 5x5 balls
+uint max_iteration = 1000;  // large enough for the solver to converge
+real tolerance = 1e-4;
+int threads = 8;
+
+// -----------------------------------------------------------------------------
+// Same bin, mixer and balls of demo_PAR_mixerDVI, with more layers of balls.
+// -----------------------------------------------------------------------------
+void CreateModel(ChSystemParallelDVI* sys) {
+  auto mat = std::make_shared<ChMaterialSurface>();
+  mat->SetFriction(0.4f);
+
+  auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  bin->SetMaterialSurface(mat);
+  bin->SetIdentifier(-200);
+  bin->SetMass(1);
+  bin->SetCollide(true);
+  bin->SetBodyFixed(true);
+
+  ChVector<> hdim(1, 1, 0.5);
+  double hthick = 0.1;
+
+  bin->GetCollisionModel()->ClearModel();
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hdim.y, hthick), ChVector<>(0, 0, -hthick));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(-hdim.x - hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(hdim.x + hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, -hdim.y - hthick, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, hdim.y + hthick, hdim.z));
+  bin->GetCollisionModel()->SetFamily(1);
+  bin->GetCollisionModel()->SetFamilyMaskNoCollisionWithFamily(2);
+  bin->GetCollisionModel()->BuildModel();
+  sys->AddBody(bin);
+
+  auto mixer = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  mixer->SetMaterialSurface(mat);
+  mixer->SetIdentifier(-201);
+  mixer->SetMass(10.0);
+  mixer->SetInertiaXX(ChVector<>(50, 50, 50));
+  mixer->SetPos(ChVector<>(0, 0, 0.205));
+  mixer->SetCollide(true);
+  mixer->GetCollisionModel()->ClearModel();
+  utils::AddBoxGeometry(mixer.get(), ChVector<>(0.8, 0.1, 0.2));
+  mixer->GetCollisionModel()->SetFamily(2);
+  mixer->GetCollisionModel()->BuildModel();
+  sys->AddBody(mixer);
+
+  auto motor = std::make_shared<ChLinkEngine>();
+  motor->Initialize(mixer, bin, ChCoordsys<>(ChVector<>(0, 0, 0), ChQuaternion<>(1, 0, 0, 0)));
+  motor->Set_eng_mode(ChLinkEngine::ENG_MODE_ROTATION);
+  motor->Set_rot_funct(std::make_shared<ChFunction_Ramp>(0, CH_C_PI / 2));
+  sys->AddLink(motor);
+
+  auto ballMat = std::make_shared<ChMaterialSurface>();
+  ballMat->SetFriction(0.4f);
+
+  double mass = 1;
+  double radius = 0.1;
+  ChVector<> inertia = (2.0 / 5.0) * mass * radius * radius * ChVector<>(1, 1, 1);
+  int ballId = 0;
+  for (int iz = 0; iz < num_layers; iz++) {
+    for (int ix = -2; ix < 3; ix++) {
+      for (int iy = -2; iy < 3; iy++) {
+        auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel);
+        ball->SetMaterialSurface(ballMat);
+        ball->SetIdentifier(ballId++);
+        ball->SetMass(mass);
+        ball->SetInertiaXX(inertia);
+        ball->SetPos(ChVector<>(0.4 * ix + 0.01 * iz, 0.4 * iy, 0.6 + 0.21 * iz));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+        sys->AddBody(ball);
+      }
+    }
+  }
+}
+
+void Run(SOLVERTYPE type, const char* name, bool warm_start) {
+  ChSystemParallelDVI msystem;
+  msystem.SetParallelThreadNumber(threads);
+  CHOMPfunctions::SetNumThreads(threads);
+  msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+  msystem.GetSettings()->solver.solver_mode = SLIDING;
+  msystem.GetSettings()->solver.max_iteration_normal = 0;
+  msystem.GetSettings()->solver.max_iteration_sliding = max_iteration;
+  msystem.GetSettings()->solver.max_iteration_spinning = 0;
+  msystem.GetSettings()->solver.max_iteration_bilateral = 0;
+  msystem.GetSettings()->solver.tolerance = tolerance;
+  msystem.GetSettings()->solver.tol_speed = tolerance;
+  msystem.GetSettings()->solver.alpha = 0;
+  msystem.GetSettings()->solver.contact_recovery_speed = 10000;
+  msystem.ChangeSolverType(type);
+  msystem.SetSolverWarmStarting(warm_start);
+  msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+  msystem.GetSettings()->collision.collision_envelope = 0.01;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+
+  CreateModel(&msystem);
+
+  ChIterativeSolver* solver = (ChIterativeSolver*)msystem.GetSolverSpeed();
+  double iterations = 0;
+  double contacts = 0;
+  double warm_started = 0;
+  double solver_time = 0;
+  for (int i = 0; i < num_steps; i++) {
+    msystem.DoStepDynamics(time_step);
+    iterations += solver->GetTotalIterations();
+    contacts += msystem.GetNcontacts();
+    warm_started += msystem.data_manager->measures.solver.num_warm_started;
+    solver_time += msystem.GetTimerSolver();
+  }
+
+  printf("%-8s warm start %-3s | iterations/step %8.1f | contacts/step %8.1f | warm started %5.1f%% | solver %.3f s\n",
+         name, warm_start ? "ON" : "OFF", iterations / num_steps, contacts / num_steps,
+         contacts > 0 ? 100 * warm_started / contacts : 0.0, solver_time);
+}
+
+int main(int argc, char* argv[]) {
+  int max_threads = CHOMPfunctions::GetNumProcs();
+  if (threads > max_threads)
+    threads = max_threads;
+
+  Run(APGD, "APGD", false);
+  Run(APGD, "APGD", true);
+  Run(APGDREF, "APGDREF", false);
+  Run(APGDREF, "APGDREF", true);
+
+  return 0;
+}
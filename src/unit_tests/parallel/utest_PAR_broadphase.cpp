@@ -0,0 +1,156 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the broadphase grids.
+// Small spheres and large boxes (the boxes added last, so that their shape
+// indices are the largest ones) are binned with the uniform grid and with the
+// two-level grid. Both must report the same set of AABB pairs, which must also
+// match a brute-force test of all the pairs of shapes.
+// =============================================================================
+
+#include <stdio.h>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/collision/ChCAABBGenerator.h"
+#include "chrono_parallel/collision/ChCBroadphase.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+int num_balls = 12;  // balls per side of the layer
+double radius = 0.05;
+
+// Run the broadphase on the current state of the system and return the sorted pair list
+std::vector<long long> DetectPairs(ChSystemParallelDVI& msystem, BROADPHASEGRIDTYPE grid_type) {
+  ChParallelDataManager* data_manager = msystem.data_manager;
+  data_manager->settings.collision.grid_type = grid_type;
+
+  ChCAABBGenerator aabb_generator;
+  aabb_generator.data_manager = data_manager;
+  aabb_generator.GenerateAABB();
+
+  ChCBroadphase broadphase;
+  broadphase.data_manager = data_manager;
+  broadphase.DetectPossibleCollisions();
+
+  const host_vector<long long>& pairs = data_manager->host_data.pair_rigid_rigid;
+  std::vector<long long> result(pairs.begin(), pairs.end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+// All the pairs of shapes of different, not both inactive, bodies with overlapping AABBs
+std::vector<long long> BruteForcePairs(ChSystemParallelDVI& msystem) {
+  ChParallelDataManager* data_manager = msystem.data_manager;
+
+  ChCAABBGenerator aabb_generator;
+  aabb_generator.data_manager = data_manager;
+  aabb_generator.GenerateAABB();
+
+  const host_vector<real3>& aabb_min = data_manager->host_data.aabb_min_rigid;
+  const host_vector<real3>& aabb_max = data_manager->host_data.aabb_max_rigid;
+  const host_vector<uint>& body_id = data_manager->host_data.id_rigid;
+  const host_vector<bool>& active = data_manager->host_data.active_rigid;
+
+  std::vector<long long> result;
+  for (uint a = 0; a < data_manager->num_rigid_shapes; a++) {
+    for (uint b = a + 1; b < data_manager->num_rigid_shapes; b++) {
+      if (body_id[a] == body_id[b] || (!active[body_id[a]] && !active[body_id[b]]))
+        continue;
+      if (aabb_min[a].x <= aabb_max[b].x && aabb_min[b].x <= aabb_max[a].x && aabb_min[a].y <= aabb_max[b].y &&
+          aabb_min[b].y <= aabb_max[a].y && aabb_min[a].z <= aabb_max[b].z && aabb_min[b].z <= aabb_max[a].z)
+        result.push_back((long long)a << 32 | (long long)b);
+    }
+  }
+  return result;
+}
+
+bool ComparePairs(const std::vector<long long>& pairs, const std::vector<long long>& ref, const char* name) {
+  if (pairs == ref)
+    return true;
+  std::vector<long long> missing;
+  std::vector<long long> extra;
+  std::set_difference(ref.begin(), ref.end(), pairs.begin(), pairs.end(), std::back_inserter(missing));
+  std::set_difference(pairs.begin(), pairs.end(), ref.begin(), ref.end(), std::back_inserter(extra));
+  printf("%s: %d pairs, %d expected (%d missing, %d extra)\n", name, (int)pairs.size(), (int)ref.size(),
+         (int)missing.size(), (int)extra.size());
+  return false;
+}
+
+int main(int argc, char* argv[]) {
+  ChSystemParallelDVI msystem;
+  msystem.Set_G_acc(ChVector<>(0, 0, 0));
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+  msystem.GetSettings()->collision.grid_level_ratio = 2;
+
+  auto mat = std::make_shared<ChMaterialSurface>();
+
+  // A layer of small balls
+  int id = 0;
+  for (int i = 0; i < num_balls; i++) {
+    for (int j = 0; j < num_balls; j++) {
+      auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel);
+      ball->SetMaterialSurface(mat);
+      ball->SetIdentifier(id++);
+      ball->SetMass(1);
+      ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+      ball->SetPos(ChVector<>(0.19 * i + 0.01 * (j % 3), 0.19 * j, 0.02 * ((i + j) % 4)));
+      ball->SetCollide(true);
+      ball->GetCollisionModel()->ClearModel();
+      ball->GetCollisionModel()->AddSphere(radius);
+      ball->GetCollisionModel()->BuildModel();
+      msystem.AddBody(ball);
+    }
+  }
+
+  // Large, overlapping boxes across the layer (added last)
+  for (int k = 0; k < 4; k++) {
+    auto box = std::make_shared<ChBody>(new ChCollisionModelParallel);
+    box->SetMaterialSurface(mat);
+    box->SetIdentifier(id++);
+    box->SetMass(10);
+    box->SetInertiaXX(ChVector<>(1, 1, 1));
+    box->SetPos(ChVector<>(0.4 + 0.5 * k, 0.3 + 0.45 * k, 0.05));
+    box->SetCollide(true);
+    box->GetCollisionModel()->ClearModel();
+    box->GetCollisionModel()->AddBox(0.5, 0.4, 0.05);
+    box->GetCollisionModel()->BuildModel();
+    msystem.AddBody(box);
+  }
+
+  // One step to load the state of the bodies in the data manager
+  msystem.DoStepDynamics(1e-4);
+
+  std::vector<long long> ref = BruteForcePairs(msystem);
+  std::vector<long long> uniform = DetectPairs(msystem, GRID_UNIFORM);
+  std::vector<long long> two_level = DetectPairs(msystem, GRID_TWO_LEVEL);
+
+  printf("Pairs: %d (large shapes on the coarse grid: %d)\n", (int)ref.size(),
+         (int)msystem.data_manager->measures.collision.num_shapes_coarse);
+
+  bool passed = msystem.data_manager->measures.collision.num_shapes_coarse > 0;
+  if (!passed)
+    printf("No shape on the coarse grid\n");
+  passed &= ComparePairs(uniform, ref, "Uniform grid");
+  passed &= ComparePairs(two_level, ref, "Two-level grid");
+  passed &= ComparePairs(two_level, uniform, "Two-level vs uniform grid");
+
+  printf("%s\n", passed ? "Test PASSED" : "Test FAILED");
+
+  return !passed;
+}
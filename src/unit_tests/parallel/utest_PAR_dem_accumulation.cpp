@@ -0,0 +1,128 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the accumulation of the DEM contact forces.
+// A pile of balls settles in a box with the sort-based accumulation and with the
+// binned accumulation (settings.solver.force_accumulation). The binned
+// accumulation must give the same trajectories as the sorted one, with one and
+// with several threads.
+// =============================================================================
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+double time_step = 1e-4;
+int num_steps = 2000;
+int num_layers = 6;  // layers of 8x8 balls
+double radius = 0.05;
+
+std::vector<ChVector<> > Simulate(DEMFORCEACCUMULATION accumulation, int threads, double& time) {
+  ChSystemParallelDEM msystem;
+  msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+  CHOMPfunctions::SetNumThreads(threads);
+  msystem.GetSettings()->max_threads = threads;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->solver.force_accumulation = accumulation;
+  msystem.GetSettings()->solver.contact_force_model = ChSystemDEM::Hertz;
+  msystem.GetSettings()->solver.tangential_displ_mode = ChSystemDEM::OneStep;
+  msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+
+  auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+  mat->SetYoungModulus(1e7f);
+  mat->SetFriction(0.4f);
+  mat->SetRestitution(0.1f);
+
+  auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+  bin->SetMaterialSurface(mat);
+  bin->SetIdentifier(-1);
+  bin->SetBodyFixed(true);
+  bin->SetCollide(true);
+  ChVector<> hdim(0.45, 0.45, 0.5);
+  double hthick = 0.05;
+  bin->GetCollisionModel()->ClearModel();
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hdim.y, hthick), ChVector<>(0, 0, -hthick));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(-hdim.x - hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(hdim.x + hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, -hdim.y - hthick, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, hdim.y + hthick, hdim.z));
+  bin->GetCollisionModel()->BuildModel();
+  msystem.AddBody(bin);
+
+  std::vector<std::shared_ptr<ChBody> > balls;
+  for (int iz = 0; iz < num_layers; iz++) {
+    for (int ix = 0; ix < 8; ix++) {
+      for (int iy = 0; iy < 8; iy++) {
+        auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+        ball->SetMaterialSurface(mat);
+        ball->SetIdentifier((int)balls.size());
+        ball->SetMass(1);
+        ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+        ball->SetPos(ChVector<>(-0.35 + 0.1 * ix + 0.005 * iz, -0.35 + 0.1 * iy, radius + 0.099 * iz));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+        msystem.AddBody(ball);
+        balls.push_back(ball);
+      }
+    }
+  }
+
+  time = 0;
+  for (int i = 0; i < num_steps; i++) {
+    msystem.DoStepDynamics(time_step);
+    time += msystem.GetTimerSolver();
+  }
+
+  std::vector<ChVector<> > pos;
+  for (size_t i = 0; i < balls.size(); i++) {
+    pos.push_back(balls[i]->GetPos());
+  }
+  return pos;
+}
+
+double MaxDifference(const std::vector<ChVector<> >& a, const std::vector<ChVector<> >& b) {
+  double diff = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    diff = std::max(diff, (a[i] - b[i]).Length());
+  }
+  return diff;
+}
+
+int main(int argc, char* argv[]) {
+  int threads = std::min(4, CHOMPfunctions::GetNumProcs());
+
+  double time_sort, time_binned_1, time_binned_n;
+  std::vector<ChVector<> > sorted = Simulate(ACCUMULATE_SORT, 1, time_sort);
+  std::vector<ChVector<> > binned_1 = Simulate(ACCUMULATE_BINNED, 1, time_binned_1);
+  std::vector<ChVector<> > binned_n = Simulate(ACCUMULATE_BINNED, threads, time_binned_n);
+
+  double diff_sort = MaxDifference(sorted, binned_1);
+  double diff_threads = MaxDifference(binned_1, binned_n);
+  printf("Solver time: sorted %.3f s, binned %.3f s (1 thread), %.3f s (%d threads)\n", time_sort, time_binned_1,
+         time_binned_n, threads);
+  printf("Max difference: sorted/binned %g, binned 1/%d threads %g\n", diff_sort, threads, diff_threads);
+
+  bool passed = diff_sort < 1e-6 && diff_threads < 1e-9;
+  printf("Test %s\n", passed ? "PASSED" : "FAILED");
+  return !passed;
+}
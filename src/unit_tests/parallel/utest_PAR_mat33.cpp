@@ -104,5 +104,36 @@ int main(int argc, char* argv[]) {
     WeakEqual(Res1, ToM33(Res2));
   }
 
+  {
+    std::cout << "Multiply Matrix Vector\n";
+    real3 v(rand(), rand(), rand());
+    v = v / RAND_MAX;
+    real3 Res1 = A1 * v;
+    ChVector<real> Res2 = B1.Matr_x_Vect(ToChVector(v));
+    WeakEqual(Res1, ToReal3(Res2));
+  }
+
+  {
+    std::cout << "Multiply T Matrix Vector\n";
+    real3 v(rand(), rand(), rand());
+    v = v / RAND_MAX;
+    real3 Res1 = MatTMult(A1, v);
+    ChVector<real> Res2 = B1.MatrT_x_Vect(ToChVector(v));
+    WeakEqual(Res1, ToReal3(Res2));
+  }
+
+  {
+    std::cout << "Multiply general Matrix\n";
+    // non-orthogonal matrices, with negative entries
+    M33 C1(real3(1, -2, 3), real3(-4, 5, -6), real3(7, -8, 9.5));
+    M33 C2 = XMatrix(real3(0.5, -1.5, 2.5));
+    M33 Res1 = C1 * C2;
+    ChMatrix33<real> Res2 = ToChMatrix33(C1) * ToChMatrix33(C2);
+    WeakEqual(Res1, ToM33(Res2));
+    WeakEqual(AbsMat(C1), M33(real3(1, 2, 3), real3(4, 5, 6), real3(7, 8, 9.5)));
+    WeakEqual(MatMultT(C1, C2), C1 * Transpose(C2));
+    WeakEqual(MatTMult(C1, C2), Transpose(C1) * C2);
+  }
+
   return 0;
 }
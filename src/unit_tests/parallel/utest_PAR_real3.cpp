@@ -241,6 +241,50 @@ int main(int argc, char* argv[]) {
     WeakEqual(c.y, 2.0 / sqrt(14.0), precision);
     WeakEqual(c.z, -3.0 / sqrt(14.0), precision);
   }
+  // =============================================================================
+
+  {  // float 3 absolute
+    real3 a(-1.0, 2.0, -3.0);
+    real3 c = absolute(a);
+    WeakEqual(c.x, 1.0, precision);
+    WeakEqual(c.y, 2.0, precision);
+    WeakEqual(c.z, 3.0, precision);
+  }
+  {  // float 3 sign
+    real3 a(-1.5, 0.0, 3.0);
+    real3 c = sign(a);
+    StrictEqual(c.x, -1.0);
+    StrictEqual(c.y, 0.0);
+    StrictEqual(c.z, 1.0);
+  }
+  {  // float 3 dot, length and normalize against ChVector
+    real3 a(rand() - RAND_MAX / 2.0, rand() - RAND_MAX / 2.0, rand() - RAND_MAX / 2.0);
+    real3 b(rand() - RAND_MAX / 2.0, rand() - RAND_MAX / 2.0, rand() - RAND_MAX / 2.0);
+    a = a / RAND_MAX;
+    b = b / RAND_MAX;
+    WeakEqual(dot(a, b), ToChVector(a).Dot(ToChVector(b)), precision);
+    WeakEqual(length(a), ToChVector(a).Length(), precision);
+    WeakEqual(normalize(a), ToReal3(ToChVector(a).GetNormalized()), precision);
+  }
+  {  // the unused fourth component of a vectorized real3 must not leak into the results
+    real3 a(1.0, 2.0, 3.0);
+    real3 b = a / real3(2.0, 4.0, 8.0) + a / 0.5;
+    WeakEqual(dot(b, b), b.x * b.x + b.y * b.y + b.z * b.z, precision);
+    WeakEqual(length(-b), sqrt(b.x * b.x + b.y * b.y + b.z * b.z), precision);
+    real3 c = cross(b, a) + absolute(-a);
+    WeakEqual(dot(c, a), c.x * a.x + c.y * a.y + c.z * a.z, precision);
+  }
+  {  // operations on vectors stored in a container (no 32 byte alignment)
+    std::vector<real3> v(5);
+    for (int i = 0; i < 5; i++) {
+      v[i] = real3(i, 2.0 * i, 3.0 * i);
+    }
+    for (int i = 1; i < 5; i++) {
+      v[i] += v[i - 1] * 2.0;
+    }
+    WeakEqual(v[4], real3(26.0, 52.0, 78.0), precision);
+    WeakEqual(cross(v[2], v[3]), real3(0.0, 0.0, 0.0), precision);
+  }
 
   return 0;
 }
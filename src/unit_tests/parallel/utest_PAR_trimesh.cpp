@@ -0,0 +1,148 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the triangle mesh shapes.
+// Spheres fall on a terrain made of a triangle mesh (a single shape with its
+// own BVH) and on a cube given as a convex mesh, in a ChSystemParallelDEM.
+// The spheres must come to rest on the surfaces.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "chrono/geometry/ChTriangleMeshSoup.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Terrain of num_cells x num_cells squares (two triangles each) at z = 0
+int num_cells = 40;
+double cell_size = 0.1;
+double radius = 0.05;
+double cube_size = 0.4;
+
+void AddTerrain(ChSystemParallelDEM* sys, std::shared_ptr<ChMaterialSurfaceDEM> mat) {
+  geometry::ChTriangleMeshSoup mesh;
+  double start = -0.5 * num_cells * cell_size;
+  for (int i = 0; i < num_cells; i++) {
+    for (int j = 0; j < num_cells; j++) {
+      ChVector<> p00(start + i * cell_size, start + j * cell_size, 0);
+      ChVector<> p10 = p00 + ChVector<>(cell_size, 0, 0);
+      ChVector<> p01 = p00 + ChVector<>(0, cell_size, 0);
+      ChVector<> p11 = p00 + ChVector<>(cell_size, cell_size, 0);
+      mesh.addTriangle(p00, p10, p11);
+      mesh.addTriangle(p00, p11, p01);
+    }
+  }
+
+  auto terrain = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+  terrain->SetMaterialSurface(mat);
+  terrain->SetIdentifier(-1);
+  terrain->SetBodyFixed(true);
+  terrain->SetCollide(true);
+  terrain->GetCollisionModel()->ClearModel();
+  terrain->GetCollisionModel()->AddTriangleMesh(mesh, true, false);
+  terrain->GetCollisionModel()->BuildModel();
+  sys->AddBody(terrain);
+}
+
+void AddCube(ChSystemParallelDEM* sys, std::shared_ptr<ChMaterialSurfaceDEM> mat) {
+  // The 12 triangles of a cube, used through their convex hull
+  geometry::ChTriangleMeshSoup mesh;
+  double h = 0.5 * cube_size;
+  ChVector<> v[8];
+  for (int i = 0; i < 8; i++) {
+    v[i] = ChVector<>((i & 1) ? h : -h, (i & 2) ? h : -h, (i & 4) ? h : -h);
+  }
+  int faces[6][4] = {{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3}};
+  for (int f = 0; f < 6; f++) {
+    mesh.addTriangle(v[faces[f][0]], v[faces[f][1]], v[faces[f][2]]);
+    mesh.addTriangle(v[faces[f][0]], v[faces[f][2]], v[faces[f][3]]);
+  }
+
+  auto cube = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+  cube->SetMaterialSurface(mat);
+  cube->SetIdentifier(-2);
+  cube->SetPos(ChVector<>(0, 0, h));
+  cube->SetBodyFixed(true);
+  cube->SetCollide(true);
+  cube->GetCollisionModel()->ClearModel();
+  cube->GetCollisionModel()->AddTriangleMesh(mesh, true, true);
+  cube->GetCollisionModel()->BuildModel();
+  sys->AddBody(cube);
+}
+
+int main(int argc, char* argv[]) {
+  ChSystemParallelDEM msystem;
+  msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+  msystem.GetSettings()->collision.collision_envelope = 0.01 * radius;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+
+  auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+  mat->SetYoungModulus(1e7f);
+  mat->SetFriction(0.4f);
+  mat->SetRestitution(0.1f);
+
+  AddTerrain(&msystem, mat);
+  AddCube(&msystem, mat);
+
+  // A row of spheres over the terrain and one sphere over the cube
+  std::vector<std::shared_ptr<ChBody> > balls;
+  std::vector<double> rest_height;
+  for (int i = 0; i < 6; i++) {
+    bool on_cube = (i == 0);
+    auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+    ball->SetMaterialSurface(mat);
+    ball->SetIdentifier(i);
+    ball->SetMass(1);
+    ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+    ball->SetPos(ChVector<>(on_cube ? 0.0 : 0.55 + 0.23 * i, 0.07 * i, cube_size + 0.2));
+    ball->SetCollide(true);
+    ball->GetCollisionModel()->ClearModel();
+    ball->GetCollisionModel()->AddSphere(radius);
+    ball->GetCollisionModel()->BuildModel();
+    msystem.AddBody(ball);
+    balls.push_back(ball);
+    rest_height.push_back(on_cube ? cube_size + radius : radius);
+  }
+
+  // The terrain and the cube are one shape each
+  bool passed = true;
+  if (msystem.data_manager->num_rigid_shapes != balls.size() + 2) {
+    printf("Wrong number of shapes: %d\n", msystem.data_manager->num_rigid_shapes);
+    passed = false;
+  }
+
+  double time_step = 1e-4;
+  for (int i = 0; i < 6000; i++) {
+    msystem.DoStepDynamics(time_step);
+  }
+
+  for (size_t i = 0; i < balls.size(); i++) {
+    double height = balls[i]->GetPos().z;
+    double speed = balls[i]->GetPos_dt().Length();
+    printf("Ball %d  height %f (rest height %f)  speed %f\n", (int)i, height, rest_height[i], speed);
+    if (std::abs(height - rest_height[i]) > 0.1 * radius || speed > 1e-2) {
+      passed = false;
+    }
+  }
+
+  printf("Test %s\n", passed ? "PASSED" : "FAILED");
+  return !passed;
+}
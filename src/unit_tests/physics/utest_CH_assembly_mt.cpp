@@ -0,0 +1,113 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded updates of bodies and links.
+// The same set of double pendulums (bodies connected by revolute joints, with
+// spring forces) is simulated twice, with serial and with multithreaded updates.
+// The states of all bodies must be identical at every step.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkSpring.h"
+#include "chrono/physics/ChSystem.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_pendulums = 300;  // number of double pendulums
+int num_steps = 200;      // number of simulation steps
+double time_step = 1e-3;  // integration step size
+int num_threads = 4;      // update threads in the second system
+
+// ====================================================================================
+
+void CreateScene(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int i = 0; i < num_pendulums; i++) {
+        double z = 0.5 * i;
+        double angle = 0.01 * (i % 50);
+
+        auto body1 = std::make_shared<ChBody>();
+        body1->SetPos(ChVector<>(std::cos(angle), -std::sin(angle), z));
+        body1->SetMass(1 + 0.01 * i);
+        body1->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        system.AddBody(body1);
+
+        auto body2 = std::make_shared<ChBody>();
+        body2->SetPos(ChVector<>(2 * std::cos(angle), 0, z));
+        body2->SetMass(1);
+        body2->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        system.AddBody(body2);
+
+        auto rev1 = std::make_shared<ChLinkLockRevolute>();
+        rev1->Initialize(ground, body1, ChCoordsys<>(ChVector<>(0, 0, z), QUNIT));
+        system.AddLink(rev1);
+
+        auto rev2 = std::make_shared<ChLinkLockRevolute>();
+        rev2->Initialize(body1, body2, ChCoordsys<>(body1->GetPos() + ChVector<>(0.5, 0, 0), QUNIT));
+        system.AddLink(rev2);
+
+        auto spring = std::make_shared<ChLinkSpring>();
+        spring->Initialize(ground, body2, false, ChVector<>(0, 0, z), body2->GetPos(), true);
+        spring->Set_SpringK(50);
+        spring->Set_SpringR(1);
+        system.AddLink(spring);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system_serial;
+    ChSystem system_mt;
+
+    CreateScene(system_serial);
+    CreateScene(system_mt);
+
+    system_mt.SetParallelUpdateThreadNumber(num_threads);
+
+    std::vector<std::shared_ptr<ChBody> >* bodies_serial = system_serial.Get_bodylist();
+    std::vector<std::shared_ptr<ChBody> >* bodies_mt = system_mt.Get_bodylist();
+
+    bool passed = true;
+
+    for (int is = 0; is < num_steps && passed; is++) {
+        system_serial.DoStepDynamics(time_step);
+        system_mt.DoStepDynamics(time_step);
+
+        for (size_t ib = 0; ib < bodies_serial->size(); ib++) {
+            const ChBody* bs = (*bodies_serial)[ib].get();
+            const ChBody* bm = (*bodies_mt)[ib].get();
+            if (!(bs->GetPos() == bm->GetPos()) || !(bs->GetRot() == bm->GetRot()) ||
+                !(bs->GetPos_dt() == bm->GetPos_dt()) || !(bs->GetWvel_loc() == bm->GetWvel_loc())) {
+                GetLog() << "Step " << is << ": states of body " << (int)ib << " differ\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,183 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the deferred batch removal of items from a ChAssembly.
+// Two copies of a pile of spheres are simulated for a few steps, then two thirds
+// of the spheres (and a link between two of them) are removed from the first
+// system with RemoveBatch() and from the second system one by one with Remove().
+// The remaining bodies must be the same and in the same order, the removed items
+// must be detached from the system, their collision models must be removed from
+// the collision system, and the next step must find the same contacts.
+//
+// =============================================================================
+
+#include <chrono>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChSystem.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_steps = 20;       // steps before the removal
+double time_step = 1e-3;  // integration step size
+int num_side = 12;        // spheres per side of the pile
+
+// ====================================================================================
+
+void CreateScene(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->SetMaterialSurface(material);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddBox(5, 0.1, 5, ChVector<>(0, -0.1, 0));
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+
+    // Spheres touching their neighbours, so that there are overlapping pairs to remove
+    for (int ix = 0; ix < num_side; ix++) {
+        for (int iy = 0; iy < num_side; iy++) {
+            for (int iz = 0; iz < num_side; iz++) {
+                auto body = std::make_shared<ChBody>();
+                body->SetMass(1);
+                body->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                body->SetPos(ChVector<>(0.2 * ix + 0.01 * iy, 0.1 + 0.199 * iy, 0.2 * iz));
+                body->SetCollide(true);
+                body->SetMaterialSurface(material);
+                body->GetCollisionModel()->ClearModel();
+                body->GetCollisionModel()->AddSphere(0.1);
+                body->GetCollisionModel()->BuildModel();
+                system.AddBody(body);
+            }
+        }
+    }
+
+    // A link between two of the bodies that will be removed
+    auto link = std::make_shared<ChLinkLockSpherical>();
+    link->Initialize(system.Get_bodylist()->at(2), system.Get_bodylist()->at(3),
+                     ChCoordsys<>(system.Get_bodylist()->at(2)->GetPos(), QUNIT));
+    system.AddLink(link);
+}
+
+// Items to remove: two bodies out of three (not the ground), and the link
+std::vector<std::shared_ptr<ChPhysicsItem> > ItemsToRemove(ChSystem& system) {
+    std::vector<std::shared_ptr<ChPhysicsItem> > items;
+    std::vector<std::shared_ptr<ChBody> >& bodies = *system.Get_bodylist();
+    for (size_t ib = 1; ib < bodies.size(); ib++) {
+        if (ib % 3 != 0)
+            items.push_back(bodies[ib]);
+    }
+    items.push_back(system.Get_linklist()->at(0));
+    return items;
+}
+
+int NumCollisionObjects(ChSystem& system) {
+    auto collision_system = static_cast<collision::ChCollisionSystemBullet*>(system.GetCollisionSystem());
+    return collision_system->GetBulletCollisionWorld()->getNumCollisionObjects();
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system_batch;
+    ChSystem system_single;
+
+    CreateScene(system_batch);
+    CreateScene(system_single);
+
+    for (int is = 0; is < num_steps; is++) {
+        system_batch.DoStepDynamics(time_step);
+        system_single.DoStepDynamics(time_step);
+    }
+
+    std::vector<std::shared_ptr<ChPhysicsItem> > removed_batch = ItemsToRemove(system_batch);
+    std::vector<std::shared_ptr<ChPhysicsItem> > removed_single = ItemsToRemove(system_single);
+
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < removed_batch.size(); i++)
+        system_batch.RemoveBatch(removed_batch[i]);
+    // duplicates and items that are not in the system are ignored
+    system_batch.RemoveBatch(removed_batch[0]);
+    system_batch.RemoveBatch(std::make_shared<ChBody>());
+    system_batch.FlushBatch();
+    double time_batch = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (size_t i = 0; i < removed_single.size(); i++)
+        system_single.Remove(removed_single[i]);
+    double time_single = std::chrono::duration<double>(Clock::now() - start).count();
+
+    GetLog() << "Removed " << (int)removed_batch.size() << " items:  batch " << time_batch * 1e3 << " ms,  one by one "
+             << time_single * 1e3 << " ms\n";
+
+    bool passed = true;
+
+    // Same remaining bodies, in the same order
+    std::vector<std::shared_ptr<ChBody> >& bodies_batch = *system_batch.Get_bodylist();
+    std::vector<std::shared_ptr<ChBody> >& bodies_single = *system_single.Get_bodylist();
+    if (bodies_batch.size() != bodies_single.size() || system_batch.Get_linklist()->size() != 0) {
+        GetLog() << "Wrong number of items: " << (int)bodies_batch.size() << " bodies, "
+                 << (int)system_batch.Get_linklist()->size() << " links\n";
+        passed = false;
+    } else {
+        for (size_t ib = 0; ib < bodies_batch.size(); ib++) {
+            if (!(bodies_batch[ib]->GetPos() == bodies_single[ib]->GetPos())) {
+                GetLog() << "Body " << (int)ib << " differs\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    // Removed items are detached from the system
+    for (size_t i = 0; i < removed_batch.size(); i++) {
+        if (removed_batch[i]->GetSystem()) {
+            GetLog() << "Removed item still attached to the system\n";
+            passed = false;
+            break;
+        }
+    }
+
+    // Collision models removed from the collision system
+    GetLog() << "Collision objects: batch " << NumCollisionObjects(system_batch) << ",  one by one "
+             << NumCollisionObjects(system_single) << "\n";
+    if (NumCollisionObjects(system_batch) != (int)bodies_batch.size() ||
+        NumCollisionObjects(system_single) != (int)bodies_single.size()) {
+        GetLog() << "Wrong number of collision objects\n";
+        passed = false;
+    }
+
+    // Same contacts at the next step
+    system_batch.DoStepDynamics(time_step);
+    system_single.DoStepDynamics(time_step);
+    GetLog() << "Contacts after removal: batch " << system_batch.GetNcontacts() << ",  one by one "
+             << system_single.GetNcontacts() << "\n";
+    if (system_batch.GetNcontacts() != system_single.GetNcontacts() || system_batch.GetNcontacts() == 0) {
+        GetLog() << "Contacts differ\n";
+        passed = false;
+    }
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,230 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batch runner.
+// A prototype system with a container and a few falling bodies is simulated
+// in several instances, on one and on several threads. Instances with the same
+// parameters must give the same results regardless of the number of threads,
+// the bodies must rest on the floor, the collision shapes must be shared with
+// the prototype, and no global state (object IDs, log) must be touched.
+//
+// =============================================================================
+
+#include <memory>
+#include <vector>
+
+#include "chrono/physics/ChBatchRunner.h"
+#include "chrono/physics/ChGlobal.h"
+#include "chrono/solver/ChSolverSOR.h"
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btCollisionObject.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_instances = 8;  // instances of the prototype; instance i uses gravity parameter i % 2
+int num_threads = 4;    // threads of the second run
+int num_bodies = 9;     // falling bodies
+
+// ====================================================================================
+
+// Log counting the characters written to it
+class CountingLog : public ChLog {
+  public:
+    CountingLog() : count(0) {}
+    virtual void Output(const char* data, size_t n) { count += n; }
+    size_t count;
+};
+
+// Results of each instance: final body positions, IDs of the bodies, and log size
+class BatchCallback : public ChBatchRunner::InstanceCallback {
+  public:
+    BatchCallback(const ChSystem& prototype) : prototype(prototype), logs(num_instances), shared(num_instances, 1) {
+        positions.resize(num_instances);
+        ids.resize(num_instances);
+    }
+
+    virtual void OnSetup(int instance, ChSystem& system) override {
+        GetLog() << "Setup of instance " << instance << "\n";
+
+        // Instance parameter: tilt the gravity
+        system.Set_G_acc(ChVector<>(0.5 * (instance % 2), -9.81, 0));
+
+        // The clones share the collision shapes of the prototype
+        for (size_t ib = 0; ib < system.Get_bodylist()->size(); ib++) {
+            ChModelBullet* model = (ChModelBullet*)(*system.Get_bodylist())[ib]->GetCollisionModel();
+            ChModelBullet* proto_model = (ChModelBullet*)(*prototype.Get_bodylist())[ib]->GetCollisionModel();
+            if (model->GetBulletModel()->getCollisionShape() != proto_model->GetBulletModel()->getCollisionShape())
+                shared[instance] = 0;
+        }
+    }
+
+    virtual void OnFinish(int instance, ChSystem& system) override {
+        for (auto body : *system.Get_bodylist()) {
+            positions[instance].push_back(body->GetPos());
+            ids[instance].push_back(body->GetIdentifier());
+        }
+    }
+
+    virtual void OnError(int instance, const std::string& message) override {
+        std::cout << "Instance " << instance << " failed: " << message << std::endl;
+    }
+
+    virtual ChLog* GetInstanceLog(int instance) override { return &logs[instance]; }
+
+    const ChSystem& prototype;
+    std::vector<std::vector<ChVector<> > > positions;
+    std::vector<std::vector<int> > ids;
+    std::vector<CountingLog> logs;
+    std::vector<int> shared;
+};
+
+void CreatePrototype(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetStep(2e-3);
+    system.SetEndTime(0.6);
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+
+    auto container = std::make_shared<ChBody>();
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->SetMaterialSurface(material);
+    container->GetCollisionModel()->ClearModel();
+    container->GetCollisionModel()->AddBox(1.0, 0.1, 1.0, ChVector<>(0, -0.1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.0, ChVector<>(-1.1, 1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.0, ChVector<>(1.1, 1, 0));
+    container->GetCollisionModel()->BuildModel();
+    system.AddBody(container);
+
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(1);
+        body->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+        body->SetPos(ChVector<>(-0.6 + 0.6 * (i % 3), 0.2 + 0.3 * (i / 3), -0.6 + 0.6 * (i / 3)));
+        body->SetCollide(true);
+        body->SetMaterialSurface(material);
+        body->GetCollisionModel()->ClearModel();
+        if (i % 2)
+            body->GetCollisionModel()->AddSphere(0.14);
+        else
+            body->GetCollisionModel()->AddBox(0.13, 0.13, 0.13);
+        body->GetCollisionModel()->BuildModel();
+        system.AddBody(body);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem prototype;
+    CreatePrototype(prototype);
+
+    CountingLog global_log;
+    SetLog(global_log);
+
+    BatchCallback callback_st(prototype);
+    BatchCallback callback_mt(prototype);
+
+    int id_before = GetUniqueIntID();
+
+    ChBatchRunner runner(prototype, 1);
+    int failed = runner.Run(num_instances, &callback_st);
+    runner.SetNumThreads(num_threads);
+    failed += runner.Run(num_instances, &callback_mt);
+
+    int id_after = GetUniqueIntID();
+
+    SetLogDefault();
+
+    bool passed = (failed == 0);
+    if (!passed)
+        GetLog() << failed << " instances failed\n";
+
+    // Same results for the same parameters, on one and on several threads
+    for (int i = 0; i < num_instances && passed; i++) {
+        const std::vector<ChVector<> >& ref = callback_st.positions[i % 2];
+        if (callback_st.positions[i] != ref || callback_mt.positions[i] != ref) {
+            GetLog() << "Instance " << i << ": results differ\n";
+            passed = false;
+        }
+    }
+
+    // Different parameters give different results
+    if (callback_st.positions[0] == callback_st.positions[1]) {
+        GetLog() << "Instance parameters are ignored\n";
+        passed = false;
+    }
+
+    // The falling bodies rest on the container floor
+    for (size_t ib = 1; ib < callback_mt.positions[0].size(); ib++) {
+        if (callback_mt.positions[0][ib].y < 0 || callback_mt.positions[0][ib].y > 0.5) {
+            GetLog() << "Body " << (int)ib << " is not on the container floor\n";
+            passed = false;
+        }
+    }
+
+    // The IDs of each instance come from its own sequence
+    for (int i = 0; i < num_instances; i++) {
+        if (callback_mt.ids[i] != callback_st.ids[0]) {
+            GetLog() << "Instance " << i << ": object IDs depend on the other instances\n";
+            passed = false;
+            break;
+        }
+    }
+    if (id_after != id_before + 1) {
+        GetLog() << "The instances used the global sequence of IDs\n";
+        passed = false;
+    }
+
+    // Messages go to the instance logs only
+    for (int i = 0; i < num_instances; i++) {
+        if (callback_mt.logs[i].count == 0) {
+            GetLog() << "Instance " << i << ": no messages in the instance log\n";
+            passed = false;
+        }
+    }
+    if (global_log.count != 0) {
+        GetLog() << "The instances wrote to the global log\n";
+        passed = false;
+    }
+
+    for (int i = 0; i < num_instances; i++) {
+        if (!callback_st.shared[i] || !callback_mt.shared[i]) {
+            GetLog() << "Instance " << i << ": collision shapes are not shared with the prototype\n";
+            passed = false;
+            break;
+        }
+    }
+
+    // A system with custom solvers cannot be cloned
+    ChSystem custom;
+    custom.ChangeSolverSpeed(new ChSolverSOR());
+    bool rejected = false;
+    try {
+        std::unique_ptr<ChSystem> copy(ChBatchRunner::CloneSystem(custom));
+    } catch (ChException&) {
+        rejected = true;
+    }
+    if (!rejected) {
+        GetLog() << "A system with custom solvers was cloned\n";
+        passed = false;
+    }
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
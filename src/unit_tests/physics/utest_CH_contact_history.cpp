@@ -0,0 +1,211 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the contact history of the penalty (DEM) contact container.
+// A box rests on a fixed plate while gravity has a tangential component below
+// the friction limit. With the MultiStep tangential displacement model, the
+// accumulated tangential displacement acts as a spring that holds the box in
+// place; the box must not creep once settled.
+// Then, the contact points of a pair are reported to the container in a different
+// order at each collision pass: each point must get back its own history.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChContactContainerDEM.h"
+#include "chrono/physics/ChSystemDEM.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+double end_time = 1.0;     // total simulation time
+double start_time = 0.5;   // start check after this period
+double time_step = 1e-4;   // integration step size
+double max_drift = 1e-4;   // maximum tangential displacement of the box after settling
+
+ChVector<> gravity(2.0, -9.81, 0);  // tangential component below mu * normal component
+
+// ---------------------------
+// Contact material properties
+// ---------------------------
+
+float friction = 0.5f;
+float kn = 2e5f;
+float gn = 40;
+float kt = 2e5f;
+float gt = 20;
+
+// ------------------------
+// Box and plate dimensions
+// ------------------------
+
+double box_hsize = 0.1;
+double box_mass = 1;
+double plate_hthick = 0.1;
+
+// ====================================================================================
+
+bool TestResting() {
+    ChSystemDEM system(false);
+    system.SetContactForceModel(ChSystemDEM::Hooke);
+    system.SetTangentialDisplacementModel(ChSystemDEM::MultiStep);
+    system.Set_G_acc(gravity);
+
+    auto material = std::make_shared<ChMaterialSurfaceDEM>();
+    material->SetFriction(friction);
+    material->SetRestitution(0);
+    material->SetKn(kn);
+    material->SetGn(gn);
+    material->SetKt(kt);
+    material->SetGt(gt);
+
+    auto plate = std::shared_ptr<ChBody>(system.NewBody());
+    plate->SetBodyFixed(true);
+    plate->SetCollide(true);
+    plate->SetMass(1000);
+    plate->SetPos(ChVector<>(0, -plate_hthick, 0));
+    plate->SetMaterialSurface(material);
+    plate->GetCollisionModel()->ClearModel();
+    plate->GetCollisionModel()->AddBox(2, plate_hthick, 2);
+    plate->GetCollisionModel()->BuildModel();
+    system.AddBody(plate);
+
+    auto box = std::shared_ptr<ChBody>(system.NewBody());
+    box->SetMass(box_mass);
+    box->SetInertiaXX((2.0 / 3) * box_mass * box_hsize * box_hsize * ChVector<>(1, 1, 1));
+    box->SetPos(ChVector<>(0, box_hsize, 0));
+    box->SetCollide(true);
+    box->SetMaterialSurface(material);
+    box->GetCollisionModel()->ClearModel();
+    box->GetCollisionModel()->AddBox(box_hsize, box_hsize, box_hsize);
+    box->GetCollisionModel()->BuildModel();
+    system.AddBody(box);
+
+    auto container = std::static_pointer_cast<ChContactContainerDEM>(system.GetContactContainer());
+
+    bool passed = true;
+    bool settled = false;
+    ChVector<> ref_pos;
+
+    while (system.GetChTime() < end_time) {
+        system.DoStepDynamics(time_step);
+
+        if (system.GetChTime() < start_time)
+            continue;
+
+        if (!settled) {
+            ref_pos = box->GetPos();
+            settled = true;
+            if (container->GetContactHistorySize() == 0) {
+                GetLog() << "No contact history recorded\n";
+                passed = false;
+                break;
+            }
+            continue;
+        }
+
+        double drift = std::abs(box->GetPos().x - ref_pos.x);
+        if (drift > max_drift) {
+            GetLog() << "t = " << system.GetChTime() << "  drift = " << drift << "\n";
+            passed = false;
+            break;
+        }
+    }
+
+    return passed;
+}
+
+// ====================================================================================
+
+std::shared_ptr<ChBody> AddCollidingBody(ChSystemDEM& system, const ChVector<>& pos) {
+    auto body = std::shared_ptr<ChBody>(system.NewBody());
+    body->SetPos(pos);
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    body->GetCollisionModel()->AddBox(0.5, 0.5, 0.5);
+    body->GetCollisionModel()->BuildModel();
+    system.AddBody(body);
+    return body;
+}
+
+bool TestMatching() {
+    ChSystemDEM system(false);
+    system.SetTangentialDisplacementModel(ChSystemDEM::MultiStep);
+    auto bodyA = AddCollidingBody(system, ChVector<>(0, 0, 0));
+    auto bodyB = AddCollidingBody(system, ChVector<>(0.2, 1, 0));
+    auto container = std::static_pointer_cast<ChContactContainerDEM>(system.GetContactContainer());
+
+    // Three contact points of the same pair, at the corners of the contact area
+    const int num_points = 3;
+    ChVector<> points[num_points] = {ChVector<>(-0.3, 0.5, -0.5), ChVector<>(0.5, 0.5, -0.5),
+                                     ChVector<>(0.5, 0.5, 0.5)};
+    collision::ChCollisionInfo cinfo[num_points];
+    for (int i = 0; i < num_points; i++) {
+        cinfo[i].modelA = bodyA->GetCollisionModel();
+        cinfo[i].modelB = bodyB->GetCollisionModel();
+        cinfo[i].vpA = points[i];
+        cinfo[i].vpB = points[i];
+        cinfo[i].vN = ChVector<>(0, 1, 0);
+    }
+
+    // First pass: store a different displacement for each point
+    container->BeginAddContact();
+    for (int i = 0; i < num_points; i++)
+        *container->GetContactHistory(cinfo[i]) = ChVector<>(i + 1.0, 0, 0);
+    container->EndAddContact();
+
+    // Second pass: the body moved a little, the points are reported in reverse order and
+    // one of them with the two models swapped
+    bool passed = true;
+    bodyA->SetPos(ChVector<>(0.001, 0, 0));
+    container->BeginAddContact();
+    for (int i = num_points - 1; i >= 0; i--) {
+        collision::ChCollisionInfo moved(cinfo[i], i == 1);
+        moved.vpA += ChVector<>(0.001, 0, 0);
+        moved.vpB += ChVector<>(0.001, 0, 0);
+        ChVector<> disp = *container->GetContactHistory(moved);
+        ChVector<> expected(i == 1 ? -(i + 1.0) : i + 1.0, 0, 0);
+        if (!(disp == expected)) {
+            GetLog() << "Point " << i << ": displacement " << disp.x << " instead of " << expected.x << "\n";
+            passed = false;
+        }
+    }
+    container->EndAddContact();
+
+    // Third pass: only one point, far from all the previous ones
+    container->BeginAddContact();
+    collision::ChCollisionInfo far(cinfo[0]);
+    far.vpA = far.vpB = ChVector<>(-0.5, 0.5, 0.5);
+    ChVector<> disp = *container->GetContactHistory(far);
+    container->EndAddContact();
+    if (!(disp == VNULL) || container->GetContactHistorySize() != 1) {
+        GetLog() << "New point: displacement " << disp.x << ", " << (int)container->GetContactHistorySize()
+                 << " points in the history\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = TestResting();
+    passed &= TestMatching();
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
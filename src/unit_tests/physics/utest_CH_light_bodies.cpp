@@ -0,0 +1,194 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the light body container.
+// The same pile of spinning spheres, with applied forces and torques, falls on
+// a fixed ground: in one system the spheres are ChBody objects, in the other one
+// they are stored in a ChLightBodyContainer. The contacts and the trajectories
+// of the spheres must be the same, with serial and with parallel updates.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChLightBodyContainer.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_steps = 300;      // number of steps
+double time_step = 1e-3;  // integration step size
+int num_side = 5;         // spheres per side of the pile
+double radius = 0.1;      // radius of the spheres
+double mass = 1;          // mass of the spheres
+
+// ====================================================================================
+
+// Initial state and applied loads of the n-th sphere
+ChVector<> InitialPos(int ix, int iy, int iz) {
+    return ChVector<>(0.21 * ix + 0.01 * iy, radius + 0.21 * iy, 0.21 * iz + 0.005 * iy);
+}
+ChVector<> InitialWvel(int n) {
+    return ChVector<>(0.5 * (n % 3), 1.0, -0.3 * (n % 2));
+}
+ChVector<> Force(int n) {
+    return ChVector<>(0.2 * (n % 4), 0, -0.1);
+}
+ChVector<> Torque(int n) {
+    return ChVector<>(0, 0.01 * (n % 5), 0);
+}
+ChVector<> Inertia() {
+    return ChVector<>(0.4, 0.5, 0.6) * mass * radius * radius;
+}
+
+void CreateGround(ChSystem& system, std::shared_ptr<ChMaterialSurface> material) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetMaxItersSolverSpeed(50);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->SetMaterialSurface(material);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddBox(5, 0.1, 5, ChVector<>(0, -0.1, 0));
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+}
+
+std::vector<ChCoordsys<> > SimulateBodies(int nthreads, int& num_contacts) {
+    ChSystem system;
+    system.SetParallelUpdateThreadNumber(nthreads);
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+    CreateGround(system, material);
+
+    std::vector<std::shared_ptr<ChBody> > spheres;
+    for (int ix = 0; ix < num_side; ix++) {
+        for (int iy = 0; iy < num_side; iy++) {
+            for (int iz = 0; iz < num_side; iz++) {
+                int n = (int)spheres.size();
+                auto body = std::make_shared<ChBody>();
+                body->SetMass(mass);
+                body->SetInertiaXX(Inertia());
+                body->SetPos(InitialPos(ix, iy, iz));
+                body->SetWvel_loc(InitialWvel(n));
+                body->SetCollide(true);
+                body->SetMaterialSurface(material);
+                body->GetCollisionModel()->ClearModel();
+                body->GetCollisionModel()->AddSphere(radius);
+                body->GetCollisionModel()->BuildModel();
+                system.AddBody(body);
+                spheres.push_back(body);
+            }
+        }
+    }
+
+    num_contacts = 0;
+    for (int is = 0; is < num_steps; is++) {
+        // the torque accumulator of a ChBody is in absolute coordinates: keep the torque fixed in the body
+        for (int n = 0; n < (int)spheres.size(); n++) {
+            spheres[n]->Empty_forces_accumulators();
+            spheres[n]->Accumulate_force(Force(n), spheres[n]->GetPos(), false);
+            spheres[n]->Accumulate_torque(Torque(n), true);
+        }
+        system.DoStepDynamics(time_step);
+        num_contacts += system.GetNcontacts();
+    }
+
+    std::vector<ChCoordsys<> > coords;
+    for (auto body : spheres)
+        coords.push_back(body->GetCoord());
+    return coords;
+}
+
+std::vector<ChCoordsys<> > SimulateContainer(int nthreads, int& num_contacts) {
+    ChSystem system;
+    system.SetParallelUpdateThreadNumber(nthreads);
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+    CreateGround(system, material);
+
+    auto container = std::make_shared<ChLightBodyContainer>();
+    container->SetMaterialSurface(material);
+    container->SetCollide(true);
+    for (int ix = 0; ix < num_side; ix++) {
+        for (int iy = 0; iy < num_side; iy++) {
+            for (int iz = 0; iz < num_side; iz++) {
+                unsigned int n = container->AddBody(ChCoordsys<>(InitialPos(ix, iy, iz)), mass, Inertia());
+                container->SetWvel_loc(n, InitialWvel(n));
+                container->SetForce(n, Force(n));
+                container->SetTorque(n, Torque(n));
+                container->GetCollisionModel(n)->ClearModel();
+                container->GetCollisionModel(n)->AddSphere(radius);
+                container->GetCollisionModel(n)->BuildModel();
+            }
+        }
+    }
+    system.Add(container);
+
+    num_contacts = 0;
+    for (int is = 0; is < num_steps; is++) {
+        system.DoStepDynamics(time_step);
+        num_contacts += system.GetNcontacts();
+    }
+
+    std::vector<ChCoordsys<> > coords;
+    for (unsigned int n = 0; n < container->GetNbodies(); n++)
+        coords.push_back(container->GetCoord(n));
+    return coords;
+}
+
+bool Compare(int nthreads) {
+    int contacts_bodies;
+    int contacts_container;
+    std::vector<ChCoordsys<> > bodies = SimulateBodies(nthreads, contacts_bodies);
+    std::vector<ChCoordsys<> > container = SimulateContainer(nthreads, contacts_container);
+
+    double max_diff = 0;
+    double max_fall = 0;
+    for (int n = 0; n < (int)bodies.size(); n++) {
+        max_diff = std::max(max_diff, (bodies[n].pos - container[n].pos).Length());
+        max_diff = std::max(max_diff, (bodies[n].rot - container[n].rot).Length());
+        max_fall = std::max(max_fall, InitialPos(n / (num_side * num_side), (n / num_side) % num_side, n % num_side).y -
+                                          bodies[n].pos.y);
+    }
+
+    GetLog() << "Threads: " << nthreads << "  contacts: bodies " << contacts_bodies << ",  container "
+             << contacts_container << "  max difference: " << max_diff << "  max fall: " << max_fall << "\n";
+
+    bool passed = true;
+    if (contacts_bodies != contacts_container || contacts_bodies == 0) {
+        GetLog() << "  contacts differ\n";
+        passed = false;
+    }
+    if (max_diff > 1e-9 || max_fall < 0.01) {
+        GetLog() << "  trajectories differ\n";
+        passed = false;
+    }
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= Compare(1);
+    passed &= Compare(4);
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
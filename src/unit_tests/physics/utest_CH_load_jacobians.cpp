@@ -0,0 +1,275 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the jacobians of the loads.
+// - A load on a chain of bodies, where the force on each body depends only on
+//   its neighbours, declares its sparsity: the colored finite differences must
+//   give the same jacobians of the dense finite differences, with much less
+//   evaluations of the load.
+// - A loader with analytical jacobians: no finite differences must be done, and
+//   the jacobians must match the numerical ones.
+// - A system with a load container is simulated with serial and parallel updates
+//   of the loads: the results must be the same.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_bodies = 10;      // bodies in the chain
+double stiffness = 1e4;   // linear stiffness of the springs
+double stiffness3 = 1e7;  // cubic stiffness of the springs
+double damping = 50;      // damping of the springs
+int num_threads = 4;      // threads for the parallel updates
+
+// ====================================================================================
+
+// Force of a nonlinear spring-damper, given the relative position and speed
+ChVector<> SpringForce(const ChVector<>& d, const ChVector<>& v) {
+    return -d * stiffness - ChVector<>(d.x * d.x * d.x, d.y * d.y * d.y, d.z * d.z * d.z) * stiffness3 - v * damping;
+}
+
+// Springs between successive bodies of a chain, and between the first body and the origin
+class ChainLoad : public ChLoadCustomMultiple {
+  public:
+    ChainLoad(std::vector<std::shared_ptr<ChLoadable> >& bodies, bool sparse)
+        : ChLoadCustomMultiple(bodies), sparse(sparse), num_evals(0) {}
+
+    virtual void ComputeQ(ChState* state_x, ChStateDelta* state_w) override {
+        num_evals++;
+        int n = (int)loadables.size();
+        std::vector<ChVector<> > pos(n), vel(n);
+        for (int i = 0; i < n; i++) {
+            auto body = std::static_pointer_cast<ChBody>(loadables[i]);
+            pos[i] = state_x ? state_x->ClipVector(7 * i, 0) : body->GetPos();
+            vel[i] = state_w ? state_w->ClipVector(6 * i, 0) : body->GetPos_dt();
+        }
+        load_Q.Reset();
+        load_Q.PasteVector(SpringForce(pos[0], vel[0]), 0, 0);
+        for (int i = 1; i < n; i++) {
+            ChVector<> F = SpringForce(pos[i] - pos[i - 1], vel[i] - vel[i - 1]);
+            load_Q.PasteSumVector(F, 6 * i, 0);
+            load_Q.PasteSumVector(-F, 6 * (i - 1), 0);
+        }
+    }
+
+    virtual bool GetJacobianSparsity(std::vector<int>& block_offsets_x,
+                                     std::vector<int>& block_offsets_w,
+                                     std::vector<std::vector<int> >& block_deps) override {
+        if (!sparse)
+            return ChLoadCustomMultiple::GetJacobianSparsity(block_offsets_x, block_offsets_w, block_deps);
+        int n = (int)loadables.size();
+        block_offsets_x.resize(n + 1);
+        block_offsets_w.resize(n + 1);
+        block_deps.resize(n);
+        for (int i = 0; i <= n; i++) {
+            block_offsets_x[i] = 7 * i;
+            block_offsets_w[i] = 6 * i;
+        }
+        for (int i = 0; i < n; i++) {
+            block_deps[i].clear();
+            for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); j++)
+                block_deps[i].push_back(j);
+        }
+        return true;
+    }
+
+    virtual bool IsStiff() override { return true; }
+
+    bool sparse;
+    int num_evals;
+};
+
+// Spring between a body and the origin, with optional analytical jacobians
+class SpringLoader : public ChLoaderUVWatomic {
+  public:
+    SpringLoader(std::shared_ptr<ChLoadableUVW> body) : ChLoaderUVWatomic(body, 0, 0, 0), analytic(false), num_evals(0) {}
+
+    virtual void ComputeF(const double U, const double V, const double W, ChVectorDynamic<>& F,
+                          ChVectorDynamic<>* state_x, ChVectorDynamic<>* state_w) override {}
+
+    virtual void ComputeQ(ChVectorDynamic<>* state_x, ChVectorDynamic<>* state_w) override {
+        num_evals++;
+        auto body = std::static_pointer_cast<ChBody>(loadable);
+        ChVector<> pos = state_x ? state_x->ClipVector(0, 0) : body->GetPos();
+        ChVector<> vel = state_w ? state_w->ClipVector(0, 0) : body->GetPos_dt();
+        Q.Reset(6);
+        Q.PasteVector(SpringForce(pos, vel), 0, 0);
+    }
+
+    virtual bool ComputeJacobian(ChVectorDynamic<>* state_x, ChVectorDynamic<>* state_w, ChMatrix<>& mK,
+                                 ChMatrix<>& mR, ChMatrix<>& mM) override {
+        if (!analytic)
+            return false;
+        mK.FillElem(0);
+        mR.FillElem(0);
+        for (int i = 0; i < 3; i++) {
+            double d = (*state_x)(i);
+            mK(i, i) = stiffness + 3 * stiffness3 * d * d;
+            mR(i, i) = damping;
+        }
+        return true;
+    }
+
+    virtual bool IsStiff() override { return true; }
+
+    bool analytic;
+    int num_evals;
+};
+
+typedef ChLoad<SpringLoader> SpringLoad;
+
+// ====================================================================================
+
+double MaxDifference(const ChMatrix<>& A, const ChMatrix<>& B) {
+    double diff = 0;
+    for (int i = 0; i < A.GetRows(); i++)
+        for (int j = 0; j < A.GetColumns(); j++)
+            diff = std::max(diff, std::abs(A(i, j) - B(i, j)));
+    return diff;
+}
+
+std::vector<std::shared_ptr<ChBody> > CreateChain(ChSystem& system, std::vector<std::shared_ptr<ChLoadable> >& loadables) {
+    std::vector<std::shared_ptr<ChBody> > bodies;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(1);
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        body->SetPos(ChVector<>(0.01 * i, -0.002 * i, 0.001 * (i % 3)));
+        body->SetPos_dt(ChVector<>(0.1, 0, -0.05 * i));
+        system.AddBody(body);
+        bodies.push_back(body);
+        loadables.push_back(body);
+    }
+    return bodies;
+}
+
+bool TestColoredJacobians() {
+    ChSystem system;
+    std::vector<std::shared_ptr<ChLoadable> > loadables;
+    CreateChain(system, loadables);
+
+    ChainLoad dense(loadables, false);
+    ChainLoad sparse(loadables, true);
+    dense.Update();
+    sparse.Update();
+
+    double scale = MaxDifference(dense.GetJacobians()->K, ChMatrixDynamic<>(6 * num_bodies, 6 * num_bodies));
+    double diff_K = MaxDifference(dense.GetJacobians()->K, sparse.GetJacobians()->K);
+    double diff_R = MaxDifference(dense.GetJacobians()->R, sparse.GetJacobians()->R);
+    double diff_Q = MaxDifference(dense.GetQ(), sparse.GetQ());
+
+    GetLog() << "Colored finite differences: |K| = " << scale << "  diff K = " << diff_K << "  diff R = " << diff_R
+             << "\n";
+    GetLog() << "  load evaluations: dense = " << dense.num_evals << "  colored = " << sparse.num_evals << "\n";
+
+    bool passed = true;
+    if (diff_K > 1e-6 * scale || diff_R > 1e-6 * scale || diff_Q > 1e-12) {
+        GetLog() << "  jacobians differ\n";
+        passed = false;
+    }
+    // Three colors (a body and its neighbours), instead of one column at a time
+    if (sparse.num_evals >= dense.num_evals / 3) {
+        GetLog() << "  too many evaluations\n";
+        passed = false;
+    }
+    return passed;
+}
+
+bool TestAnalyticJacobians() {
+    ChSystem system;
+    std::vector<std::shared_ptr<ChLoadable> > loadables;
+    auto bodies = CreateChain(system, loadables);
+
+    SpringLoad numeric(bodies[3]);
+    SpringLoad analytic(bodies[3]);
+    analytic.loader.analytic = true;
+    numeric.Update();
+    analytic.Update();
+
+    double scale = MaxDifference(analytic.GetJacobians()->K, ChMatrixDynamic<>(6, 6));
+    double diff_K = MaxDifference(numeric.GetJacobians()->K, analytic.GetJacobians()->K);
+    double diff_R = MaxDifference(numeric.GetJacobians()->R, analytic.GetJacobians()->R);
+
+    GetLog() << "Analytical jacobians: |K| = " << scale << "  diff K = " << diff_K << "  diff R = " << diff_R << "\n";
+    GetLog() << "  load evaluations: numerical = " << numeric.loader.num_evals
+             << "  analytical = " << analytic.loader.num_evals << "\n";
+
+    bool passed = true;
+    if (diff_K > 1e-5 * scale || diff_R > 1e-5 * damping) {
+        GetLog() << "  jacobians differ\n";
+        passed = false;
+    }
+    if (analytic.loader.num_evals != 1) {
+        GetLog() << "  finite differences used with analytical jacobians\n";
+        passed = false;
+    }
+    return passed;
+}
+
+std::vector<ChVector<> > Simulate(int nthreads) {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetSolverType(ChSystem::SOLVER_MINRES);
+    system.SetMaxItersSolverSpeed(200);
+    system.SetTolForce(1e-12);
+    system.SetParallelUpdateThreadNumber(nthreads);
+    system.SetIntegrationType(ChSystem::INT_HHT);
+
+    std::vector<std::shared_ptr<ChLoadable> > loadables;
+    auto bodies = CreateChain(system, loadables);
+
+    auto container = std::make_shared<ChLoadContainer>();
+    system.Add(container);
+    container->Add(std::make_shared<ChainLoad>(loadables, true));
+    for (int i = 0; i < num_bodies; i++)
+        container->Add(std::make_shared<SpringLoad>(bodies[i]));
+
+    for (int is = 0; is < 100; is++)
+        system.DoStepDynamics(1e-3);
+
+    std::vector<ChVector<> > positions;
+    for (auto body : bodies)
+        positions.push_back(body->GetPos());
+    return positions;
+}
+
+bool TestParallelContainer() {
+    std::vector<ChVector<> > serial = Simulate(1);
+    std::vector<ChVector<> > parallel = Simulate(num_threads);
+
+    bool passed = (serial == parallel);
+    GetLog() << "Parallel load container: " << (passed ? "same results" : "results differ") << "\n";
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestColoredJacobians();
+    passed &= TestAnalyticJacobians();
+    passed &= TestParallelContainer();
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
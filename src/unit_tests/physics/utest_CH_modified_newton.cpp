@@ -0,0 +1,172 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the modified Newton method of the implicit timesteppers.
+// A few bodies on prismatic joints are held by stiff nonlinear springs, whose
+// stiffness matrices enter the Newton iterations. The same model is simulated
+// with the full and with the modified Newton method, with the HHT and the Euler
+// implicit timesteppers: the results must agree, and the modified Newton method
+// must update the Jacobian fewer times.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_bodies = 4;       // bodies on prismatic joints
+double step = 1e-3;       // integration step
+int num_steps = 500;      // number of steps
+double stiffness = 1e5;   // linear stiffness of the springs
+double stiffness3 = 1e9;  // cubic stiffness of the springs
+double damping = 200;     // damping of the springs
+
+// ====================================================================================
+
+// Nonlinear spring along Z between a body and a fixed point (stiff load, numerical jacobians)
+class SpringLoad : public ChLoadCustom {
+  public:
+    SpringLoad(std::shared_ptr<ChBody> body, double rest_z) : ChLoadCustom(body), rest_z(rest_z) {}
+
+    virtual void ComputeQ(ChState* state_x, ChStateDelta* state_w) override {
+        auto body = std::static_pointer_cast<ChBody>(loadable);
+        double z = state_x ? (*state_x)(2) : body->GetPos().z;
+        double vz = state_w ? (*state_w)(2) : body->GetPos_dt().z;
+        double d = z - rest_z;
+        load_Q.Reset();
+        load_Q(2) = -stiffness * d - stiffness3 * d * d * d - damping * vz;
+    }
+
+    virtual bool IsStiff() override { return true; }
+
+  private:
+    double rest_z;
+};
+
+struct Results {
+    std::vector<double> z;       // final positions of the bodies
+    double avg_updates;          // average Jacobian updates per step
+    long long total_updates;     // total Jacobian updates
+    long long total_iterations;  // total Newton iterations (HHT only)
+};
+
+Results Simulate(ChSystem::eCh_integrationType type, bool modified_newton) {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSystem::SOLVER_MINRES);
+    system.SetMaxItersSolverSpeed(200);
+    system.SetTolForce(1e-12);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto loads = std::make_shared<ChLoadContainer>();
+    system.Add(loads);
+
+    std::vector<std::shared_ptr<ChBody> > bodies;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(1 + i);
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        body->SetPos(ChVector<>(i, 0, 0.01 * (i + 1)));
+        system.AddBody(body);
+        bodies.push_back(body);
+
+        auto prismatic = std::make_shared<ChLinkLockPrismatic>();
+        prismatic->Initialize(body, ground, ChCoordsys<>(ChVector<>(i, 0, 0), QUNIT));
+        system.AddLink(prismatic);
+
+        loads->Add(std::make_shared<SpringLoad>(body, 0.0));
+    }
+
+    system.SetIntegrationType(type);
+    auto integrator = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(system.GetTimestepper());
+    integrator->SetMaxiters(type == ChSystem::INT_HHT ? 20 : 6);
+    integrator->SetRelTolerance(1e-6);
+    integrator->SetAbsTolerances(1e-10);
+    integrator->SetModifiedNewton(modified_newton);
+    if (auto hht = std::dynamic_pointer_cast<ChTimestepperHHT>(system.GetTimestepper())) {
+        hht->SetAlpha(-0.2);
+        hht->SetMode(ChTimestepperHHT::POSITION);
+        hht->SetScaling(true);
+        hht->SetStepControl(true);
+    }
+
+    Results results;
+    results.total_iterations = 0;
+    for (int is = 0; is < num_steps; is++) {
+        system.DoStepDynamics(step);
+        if (auto hht = std::dynamic_pointer_cast<ChTimestepperHHT>(system.GetTimestepper()))
+            results.total_iterations += hht->GetNumIterations();
+    }
+
+    for (auto body : bodies)
+        results.z.push_back(body->GetPos().z);
+    results.avg_updates = integrator->GetAvgJacobianUpdates();
+    results.total_updates = integrator->GetTotalJacobianUpdates();
+
+    return results;
+}
+
+bool Compare(const char* name, ChSystem::eCh_integrationType type, double tol) {
+    Results full = Simulate(type, false);
+    Results modified = Simulate(type, true);
+
+    GetLog() << name << ": Jacobian updates per step  full = " << full.avg_updates
+             << "  modified = " << modified.avg_updates << "\n";
+
+    bool passed = true;
+
+    // Same final positions, up to the tolerance of the Newton iterations
+    for (int i = 0; i < num_bodies; i++) {
+        double diff = std::abs(full.z[i] - modified.z[i]);
+        GetLog() << "  body " << i << "  z full = " << full.z[i] << "  z modified = " << modified.z[i] << "\n";
+        if (diff > tol) {
+            GetLog() << "  results differ\n";
+            passed = false;
+        }
+    }
+
+    // Without modified Newton, the Jacobian is updated at each iteration
+    if (type == ChSystem::INT_HHT && full.total_updates != full.total_iterations) {
+        GetLog() << "  wrong count of Jacobian updates\n";
+        passed = false;
+    }
+
+    // With modified Newton, the Jacobian is updated less often
+    if (modified.avg_updates >= 0.5 * full.avg_updates || modified.total_updates == 0) {
+        GetLog() << "  the Jacobian is not reused\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= Compare("HHT", ChSystem::INT_HHT, 1e-7);
+    passed &= Compare("Euler implicit", ChSystem::INT_EULER_IMPLICIT, 1e-7);
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded narrow phase of the Bullet collision system.
+// The same granular pile (spheres, boxes and compound bodies falling into a box
+// container) is simulated twice, with a serial and with a multithreaded narrow
+// phase. The number of contacts and the states of all bodies must be identical
+// at every step.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChSystem.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_steps = 200;      // number of simulation steps
+double time_step = 1e-3;  // integration step size
+int num_layers = 6;       // layers of 8x8 falling bodies
+int num_threads = 4;      // narrow phase threads in the second system
+
+// ====================================================================================
+
+void CreateScene(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+
+    // Container: fixed body with a bottom plate and four walls
+    auto container = std::make_shared<ChBody>();
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->SetMaterialSurface(material);
+    container->GetCollisionModel()->ClearModel();
+    container->GetCollisionModel()->AddBox(1.2, 0.1, 1.2, ChVector<>(0, -0.1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.2, ChVector<>(-1.3, 1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.2, ChVector<>(1.3, 1, 0));
+    container->GetCollisionModel()->AddBox(1.2, 1, 0.1, ChVector<>(0, 1, -1.3));
+    container->GetCollisionModel()->AddBox(1.2, 1, 0.1, ChVector<>(0, 1, 1.3));
+    container->GetCollisionModel()->BuildModel();
+    system.AddBody(container);
+
+    // Falling bodies, packed so that they collide with each other and with the container
+    int id = 0;
+    for (int il = 0; il < num_layers; il++) {
+        for (int ix = 0; ix < 8; ix++) {
+            for (int iz = 0; iz < 8; iz++) {
+                ChVector<> pos(-1.05 + 0.3 * ix, 0.14 + 0.26 * il, -1.05 + 0.3 * iz + 0.02 * (il % 2));
+                auto body = std::make_shared<ChBody>();
+                body->SetMass(1);
+                body->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+                body->SetPos(pos);
+                body->SetRot(Q_from_AngAxis(0.1 * id, ChVector<>(1, 1, 0).GetNormalized()));
+                body->SetCollide(true);
+                body->SetMaterialSurface(material);
+                body->GetCollisionModel()->ClearModel();
+                switch (id % 3) {
+                    case 0:
+                        body->GetCollisionModel()->AddSphere(0.14);
+                        break;
+                    case 1:
+                        body->GetCollisionModel()->AddBox(0.12, 0.12, 0.12);
+                        break;
+                    case 2:
+                        body->GetCollisionModel()->AddSphere(0.08, ChVector<>(-0.06, 0, 0));
+                        body->GetCollisionModel()->AddCylinder(0.07, 0.07, 0.1, ChVector<>(0.06, 0, 0));
+                        break;
+                }
+                body->GetCollisionModel()->BuildModel();
+                system.AddBody(body);
+                id++;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system_serial;
+    ChSystem system_mt;
+
+    CreateScene(system_serial);
+    CreateScene(system_mt);
+
+    static_cast<collision::ChCollisionSystemBullet*>(system_mt.GetCollisionSystem())->SetNumThreads(num_threads);
+
+    std::vector<std::shared_ptr<ChBody> >* bodies_serial = system_serial.Get_bodylist();
+    std::vector<std::shared_ptr<ChBody> >* bodies_mt = system_mt.Get_bodylist();
+
+    bool passed = true;
+    int max_contacts = 0;
+
+    for (int is = 0; is < num_steps && passed; is++) {
+        system_serial.DoStepDynamics(time_step);
+        system_mt.DoStepDynamics(time_step);
+
+        int ncontacts = system_serial.GetNcontacts();
+        if (ncontacts != system_mt.GetNcontacts()) {
+            GetLog() << "Step " << is << ": " << ncontacts << " contacts (serial) vs. " << system_mt.GetNcontacts()
+                     << " (multithreaded)\n";
+            passed = false;
+            break;
+        }
+        if (ncontacts > max_contacts)
+            max_contacts = ncontacts;
+
+        for (size_t ib = 0; ib < bodies_serial->size(); ib++) {
+            const ChBody* bs = (*bodies_serial)[ib].get();
+            const ChBody* bm = (*bodies_mt)[ib].get();
+            if (!(bs->GetPos() == bm->GetPos()) || !(bs->GetRot() == bm->GetRot()) ||
+                !(bs->GetPos_dt() == bm->GetPos_dt())) {
+                GetLog() << "Step " << is << ": states of body " << (int)ib << " differ\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    if (max_contacts == 0) {
+        GetLog() << "No contacts generated\n";
+        passed = false;
+    }
+
+    GetLog() << "Max. number of contacts: " << max_contacts << "\n";
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
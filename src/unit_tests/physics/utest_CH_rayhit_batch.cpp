@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batched ray-hit tests of the Bullet collision system.
+// A grid of vertical rays is cast under a few bodies (spheres, boxes, and bodies
+// with several shapes). The results of RayHitBatch, on one and on several
+// threads, must be the same as those of RayHit for each ray.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int grid_size = 200;   // rays per side of the grid
+double extent = 4.0;   // side of the grid
+int num_threads = 4;   // threads of the second batch
+
+// ====================================================================================
+
+bool CompareResults(const std::vector<ChCollisionSystem::ChRayhitResult>& ref,
+                    const std::vector<ChCollisionSystem::ChRayhitResult>& batch) {
+    if (ref.size() != batch.size()) {
+        GetLog() << "Wrong number of results\n";
+        return false;
+    }
+    for (size_t i = 0; i < ref.size(); i++) {
+        if (ref[i].hit != batch[i].hit) {
+            GetLog() << "Ray " << (int)i << ": hit " << ref[i].hit << " vs " << batch[i].hit << "\n";
+            return false;
+        }
+        if (!ref[i].hit)
+            continue;
+        if (ref[i].hitModel != batch[i].hitModel || std::abs(ref[i].dist_factor - batch[i].dist_factor) > 1e-6 ||
+            (ref[i].abs_hitPoint - batch[i].abs_hitPoint).Length() > 1e-6) {
+            GetLog() << "Ray " << (int)i << ": different hit\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system;
+
+    // Bodies above the grid, one of them with several shapes and one out of the grid
+    for (int i = 0; i < 6; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(-1.5 + 0.6 * i, 0.1 + 0.05 * i, 0.3 * std::sin((double)i)));
+        body->SetRot(Q_from_AngAxis(0.3 * i, VECT_Z));
+        body->SetCollide(true);
+        body->GetCollisionModel()->ClearModel();
+        switch (i % 3) {
+            case 0:
+                body->GetCollisionModel()->AddSphere(0.25);
+                break;
+            case 1:
+                body->GetCollisionModel()->AddBox(0.2, 0.15, 0.3);
+                break;
+            case 2:
+                body->GetCollisionModel()->AddSphere(0.15, ChVector<>(-0.1, 0, 0));
+                body->GetCollisionModel()->AddBox(0.1, 0.2, 0.1, ChVector<>(0.15, 0, 0));
+                break;
+        }
+        body->GetCollisionModel()->BuildModel();
+        system.AddBody(body);
+    }
+    auto far_body = std::make_shared<ChBody>();
+    far_body->SetPos(ChVector<>(10, 0, 0));
+    far_body->SetCollide(true);
+    far_body->GetCollisionModel()->ClearModel();
+    far_body->GetCollisionModel()->AddSphere(0.5);
+    far_body->GetCollisionModel()->BuildModel();
+    system.AddBody(far_body);
+
+    // Update the collision models
+    system.DoStepDynamics(1e-4);
+
+    // Grid of vertical rays
+    std::vector<ChVector<> > from;
+    ChVector<> dir(0, 1, 0);
+    for (int iz = 0; iz < grid_size; iz++)
+        for (int ix = 0; ix < grid_size; ix++)
+            from.push_back(ChVector<>(extent * (ix / (grid_size - 1.0) - 0.5), -0.4, extent * (iz / (grid_size - 1.0) - 0.5)));
+
+    ChCollisionSystemBullet* collision_system = (ChCollisionSystemBullet*)system.GetCollisionSystem();
+
+    std::vector<ChCollisionSystem::ChRayhitResult> ref(from.size());
+    int num_hits = 0;
+    for (size_t i = 0; i < from.size(); i++) {
+        collision_system->RayHit(from[i], from[i] + dir, ref[i]);
+        if (ref[i].hit)
+            num_hits++;
+    }
+
+    std::vector<ChCollisionSystem::ChRayhitResult> batch;
+    collision_system->RayHitBatch(from, dir, batch);
+    bool passed = CompareResults(ref, batch);
+
+    collision_system->SetNumThreads(num_threads);
+    collision_system->RayHitBatch(from, dir, batch);
+    passed = passed && CompareResults(ref, batch);
+
+    if (num_hits == 0) {
+        GetLog() << "No ray hits the bodies\n";
+        passed = false;
+    }
+
+    GetLog() << num_hits << " hits out of " << (int)from.size() << " rays\n";
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,292 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the packed form of the system descriptor products.
+// First, ShurComplementProduct() and SystemProduct() of a descriptor with random
+// masses, jacobians and K blocks are computed with and without the packed form,
+// with one and several threads: the results must be the same up to roundoff (the
+// compiler may fuse multiplications and additions differently in the two forms),
+// and identical for any number of threads. The sparsity structure must be rebuilt
+// only when it changes.
+// Then, a set of chains of bodies is simulated with the MINRES solver, with and
+// without the packed form: the states of all bodies must be the same up to roundoff.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChConstraintTwoBodies.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+#include "chrono/solver/ChVariablesBodyOwnMass.h"
+
+using namespace chrono;
+
+// ---------------------
+// Test parameters
+// ---------------------
+
+int num_bodies = 200;     // variables in the descriptor
+int num_chains = 10;      // chains of bodies in the simulation
+int num_links = 10;       // bodies in each chain
+int num_steps = 100;      // number of simulation steps
+double time_step = 1e-3;  // integration step size
+int num_threads = 4;      // threads for the packed products
+
+double product_tolerance = 1e-13;  // relative difference of the products
+double state_tolerance = 1e-9;     // difference of the states in the simulation
+
+// ====================================================================================
+
+double MaxDifference(const ChMatrix<>& a, const ChMatrix<>& b) {
+    double diff = 0;
+    for (int i = 0; i < a.GetRows(); i++)
+        diff = std::max(diff, std::abs(a(i) - b(i)));
+    return diff;
+}
+
+void InsertItems(ChSystemDescriptor& descriptor,
+                 std::vector<ChVariablesBodyOwnMass>& variables,
+                 std::vector<ChConstraintTwoBodies>& constraints,
+                 std::vector<ChKblockGeneric>& kblocks) {
+    descriptor.BeginInsertion();
+    for (size_t i = 0; i < variables.size(); i++)
+        descriptor.InsertVariables(&variables[i]);
+    for (size_t i = 0; i < constraints.size(); i++)
+        descriptor.InsertConstraint(&constraints[i]);
+    for (size_t i = 0; i < kblocks.size(); i++)
+        descriptor.InsertKblock(&kblocks[i]);
+    descriptor.EndInsertion();
+
+    for (size_t i = 0; i < constraints.size(); i++)
+        constraints[i].Update_auxiliary();
+}
+
+// Compare the products with and without the packed form, with 1 and more threads.
+bool CompareProducts(ChSystemDescriptor& descriptor, bool shur) {
+    int n_q = descriptor.CountActiveVariables();
+    int n_c = descriptor.CountActiveConstraints();
+
+    ChMatrixDynamic<> x(shur ? n_c : n_q + n_c, 1);
+    x.FillRandom(1, -1);
+    std::vector<bool> enabled(n_c);
+    for (int i = 0; i < n_c; i++)
+        enabled[i] = (i % 7 != 3);
+
+    ChMatrixDynamic<> ref;
+    ChMatrixDynamic<> ref_enabled;
+    descriptor.SetUsePackedProducts(false);
+    if (shur) {
+        descriptor.ShurComplementProduct(ref, &x);
+        descriptor.ShurComplementProduct(ref_enabled, &x, &enabled);
+    } else {
+        descriptor.SystemProduct(ref, &x);
+    }
+
+    descriptor.SetUsePackedProducts(true);
+    descriptor.UpdatePackedProducts();
+    if (!descriptor.IsPacked()) {
+        GetLog() << "Products not packed\n";
+        return false;
+    }
+
+    bool passed = true;
+    ChMatrixDynamic<> res_serial;
+    ChMatrixDynamic<> res_serial_enabled;
+    for (int threads = 1; threads <= num_threads; threads *= 2) {
+        descriptor.SetNumThreads(threads);
+        ChMatrixDynamic<> res;
+        ChMatrixDynamic<> res_enabled;
+        double diff = 0;
+        if (shur) {
+            descriptor.ShurComplementProduct(res, &x);
+            descriptor.ShurComplementProduct(res_enabled, &x, &enabled);
+            diff = std::max(MaxDifference(res, ref), MaxDifference(res_enabled, ref_enabled));
+        } else {
+            descriptor.SystemProduct(res, &x);
+            diff = MaxDifference(res, ref);
+        }
+        GetLog() << (shur ? "  ShurComplementProduct" : "  SystemProduct") << ", " << threads
+                 << " threads: max difference " << diff << " (norm " << ref.NormInf() << ")\n";
+        if (diff > product_tolerance * ref.NormInf())
+            passed = false;
+
+        // The rows are computed independently: the results must not depend on the threads
+        if (threads == 1) {
+            res_serial = res;
+            res_serial_enabled = res_enabled;
+        } else if (MaxDifference(res, res_serial) != 0 ||
+                   (shur && MaxDifference(res_enabled, res_serial_enabled) != 0)) {
+            GetLog() << "  Results differ from those with 1 thread\n";
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+bool TestDescriptor() {
+    // Bodies with random masses; some of them are fixed (inactive variables)
+    std::vector<ChVariablesBodyOwnMass> variables(num_bodies);
+    for (int i = 0; i < num_bodies; i++) {
+        ChMatrix33<> A;
+        A.FillRandom(0.1, -0.1);
+        A.MatrInc(ChMatrix33<>(1.0 + 0.01 * i));
+        ChMatrix33<> inertia;
+        inertia.MatrTMultiply(A, A);
+        variables[i].SetBodyMass(1.0 + 0.1 * (i % 13));
+        variables[i].SetBodyInertia(inertia);
+        variables[i].SetDisabled(i % 17 == 5);
+    }
+
+    // Constraints between near bodies, with random jacobians; some are disabled
+    std::vector<ChConstraintTwoBodies> constraints(3 * num_bodies);
+    for (int i = 0; i < (int)constraints.size(); i++) {
+        int a = (i / 3) % num_bodies;
+        int b = (a + 1 + i % 5) % num_bodies;
+        constraints[i].SetVariables(&variables[a], &variables[b]);
+        constraints[i].Get_Cq_a()->FillRandom(1, -1);
+        constraints[i].Get_Cq_b()->FillRandom(1, -1);
+        constraints[i].Set_cfm_i(i % 4 == 0 ? 0.0 : 0.001 * (i % 9));
+        constraints[i].SetDisabled(i % 23 == 11);
+    }
+
+    // K blocks between pairs of bodies
+    std::vector<ChKblockGeneric> kblocks(num_bodies / 4);
+    for (int i = 0; i < (int)kblocks.size(); i++) {
+        std::vector<ChVariables*> vars;
+        vars.push_back(&variables[4 * i]);
+        vars.push_back(&variables[(4 * i + 9) % num_bodies]);
+        kblocks[i].SetVariables(vars);
+        kblocks[i].Get_K()->FillRandom(1, -1);
+    }
+    std::vector<ChKblockGeneric> no_kblocks;
+
+    ChSystemDescriptor descriptor;
+    descriptor.SetMassFactor(0.7);
+    bool passed = true;
+
+    GetLog() << "Descriptor with K blocks\n";
+    InsertItems(descriptor, variables, constraints, kblocks);
+    passed &= CompareProducts(descriptor, false);
+
+    GetLog() << "Descriptor without K blocks\n";
+    InsertItems(descriptor, variables, constraints, no_kblocks);
+    passed &= CompareProducts(descriptor, true);
+    passed &= CompareProducts(descriptor, false);
+    int builds = descriptor.GetPackedOperator().GetStructureBuilds();
+
+    // New values with the same structure: the structure must not be rebuilt
+    GetLog() << "New jacobians, same structure\n";
+    for (size_t i = 0; i < constraints.size(); i++)
+        constraints[i].Get_Cq_a()->FillRandom(1, -1);
+    InsertItems(descriptor, variables, constraints, no_kblocks);
+    passed &= CompareProducts(descriptor, true);
+    if (descriptor.GetPackedOperator().GetStructureBuilds() != builds) {
+        GetLog() << "Structure rebuilt with unchanged structure\n";
+        passed = false;
+    }
+
+    // A constraint between other bodies: the structure must be rebuilt
+    GetLog() << "Changed structure\n";
+    constraints[10].SetVariables(&variables[100], &variables[150]);
+    InsertItems(descriptor, variables, constraints, no_kblocks);
+    passed &= CompareProducts(descriptor, true);
+    if (descriptor.GetPackedOperator().GetStructureBuilds() != builds + 1) {
+        GetLog() << "Structure not rebuilt after a change\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+// ====================================================================================
+
+void CreateScene(ChSystem& system, bool packed) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetSolverType(ChSystem::SOLVER_MINRES);
+    system.SetMaxItersSolverSpeed(40);
+    system.GetSystemDescriptor()->SetUsePackedProducts(packed);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    // Chains of bodies connected by spherical joints, hanging from the ground
+    for (int ic = 0; ic < num_chains; ic++) {
+        std::shared_ptr<ChBody> prev = ground;
+        double z = 0.5 * ic;
+        for (int i = 0; i < num_links; i++) {
+            auto body = std::make_shared<ChBody>();
+            body->SetMass(0.5 + 0.05 * i);
+            body->SetInertiaXX(ChVector<>(0.01, 0.02, 0.01));
+            body->SetPos(ChVector<>(0.2 * (i + 1), 0.01 * ic * i, z));
+            system.AddBody(body);
+
+            auto joint = std::make_shared<ChLinkLockSpherical>();
+            joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(0.2 * i, 0.01 * ic * std::max(i - 1, 0), z), QUNIT));
+            system.AddLink(joint);
+            prev = body;
+        }
+    }
+}
+
+bool TestSimulation() {
+    ChSystem system_unpacked;
+    ChSystem system_packed;
+
+    CreateScene(system_unpacked, false);
+    CreateScene(system_packed, true);
+
+    std::vector<std::shared_ptr<ChBody> >* bodies_u = system_unpacked.Get_bodylist();
+    std::vector<std::shared_ptr<ChBody> >* bodies_p = system_packed.Get_bodylist();
+
+    double max_diff = 0;
+    for (int is = 0; is < num_steps; is++) {
+        system_unpacked.DoStepDynamics(time_step);
+        system_packed.DoStepDynamics(time_step);
+
+        for (size_t ib = 0; ib < bodies_u->size(); ib++) {
+            const ChBody* bu = (*bodies_u)[ib].get();
+            const ChBody* bp = (*bodies_p)[ib].get();
+            double diff = std::max((bu->GetPos() - bp->GetPos()).Length(), (bu->GetRot() - bp->GetRot()).Length());
+            diff = std::max(diff, (bu->GetPos_dt() - bp->GetPos_dt()).Length());
+            if (diff > state_tolerance) {
+                GetLog() << "Step " << is << ": states of body " << (int)ib << " differ by " << diff << "\n";
+                return false;
+            }
+            max_diff = std::max(max_diff, diff);
+        }
+    }
+
+    if (!system_packed.GetSystemDescriptor()->IsPacked()) {
+        GetLog() << "Products not packed in the simulation\n";
+        return false;
+    }
+
+    GetLog() << "Simulation: max difference of the states " << max_diff << " after " << num_steps
+             << " steps, structure built "
+             << system_packed.GetSystemDescriptor()->GetPackedOperator().GetStructureBuilds() << " times\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = TestDescriptor();
+    passed &= TestSimulation();
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
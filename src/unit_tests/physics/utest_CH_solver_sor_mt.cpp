@@ -0,0 +1,156 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded SOR solver.
+// A pile of boxes and spheres falls into a box container, next to a chain of
+// bodies connected by spherical joints. The same scene is simulated with the
+// multithreaded SOR solver using one and several threads: since the update
+// order only depends on the coloring of the constraints, the states of all
+// bodies must be identical at every step. The scene must also settle, i.e.
+// the solver must actually enforce the contacts.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverSORmultithread.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int num_steps = 300;      // number of simulation steps
+double time_step = 1e-3;  // integration step size
+int num_layers = 3;       // layers of 6x6 falling bodies
+int num_links = 20;       // bodies in the chain
+int num_threads = 4;      // solver threads in the second system
+
+// ====================================================================================
+
+void CreateScene(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetSolverType(ChSystem::SOLVER_SOR_MULTITHREAD);
+    system.SetMaxItersSolverSpeed(40);
+
+    auto material = std::make_shared<ChMaterialSurface>();
+    material->SetFriction(0.4f);
+
+    // Container: fixed body with a bottom plate and four walls
+    auto container = std::make_shared<ChBody>();
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->SetMaterialSurface(material);
+    container->GetCollisionModel()->ClearModel();
+    container->GetCollisionModel()->AddBox(1.0, 0.1, 1.0, ChVector<>(0, -0.1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.0, ChVector<>(-1.1, 1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, 1.0, ChVector<>(1.1, 1, 0));
+    container->GetCollisionModel()->AddBox(1.0, 1, 0.1, ChVector<>(0, 1, -1.1));
+    container->GetCollisionModel()->AddBox(1.0, 1, 0.1, ChVector<>(0, 1, 1.1));
+    container->GetCollisionModel()->BuildModel();
+    system.AddBody(container);
+
+    // Falling bodies
+    int id = 0;
+    for (int il = 0; il < num_layers; il++) {
+        for (int ix = 0; ix < 6; ix++) {
+            for (int iz = 0; iz < 6; iz++) {
+                auto body = std::make_shared<ChBody>();
+                body->SetMass(1);
+                body->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+                body->SetPos(ChVector<>(-0.8 + 0.32 * ix, 0.15 + 0.3 * il, -0.8 + 0.32 * iz + 0.02 * (il % 2)));
+                body->SetCollide(true);
+                body->SetMaterialSurface(material);
+                body->GetCollisionModel()->ClearModel();
+                if (id % 2)
+                    body->GetCollisionModel()->AddSphere(0.14);
+                else
+                    body->GetCollisionModel()->AddBox(0.13, 0.13, 0.13);
+                body->GetCollisionModel()->BuildModel();
+                system.AddBody(body);
+                id++;
+            }
+        }
+    }
+
+    // Chain of bodies connected by spherical joints, hanging from the ground
+    std::shared_ptr<ChBody> prev = container;
+    for (int i = 0; i < num_links; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(0.5);
+        body->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+        body->SetPos(ChVector<>(2 + 0.2 * (i + 1), 3, 0));
+        system.AddBody(body);
+
+        auto joint = std::make_shared<ChLinkLockSpherical>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(2 + 0.2 * i, 3, 0), QUNIT));
+        system.AddLink(joint);
+        prev = body;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system_st;
+    ChSystem system_mt;
+
+    CreateScene(system_st);
+    CreateScene(system_mt);
+
+    system_st.SetParallelThreadNumber(1);
+    system_mt.SetParallelThreadNumber(num_threads);
+
+    std::vector<std::shared_ptr<ChBody> >* bodies_st = system_st.Get_bodylist();
+    std::vector<std::shared_ptr<ChBody> >* bodies_mt = system_mt.Get_bodylist();
+
+    bool passed = true;
+
+    for (int is = 0; is < num_steps && passed; is++) {
+        system_st.DoStepDynamics(time_step);
+        system_mt.DoStepDynamics(time_step);
+
+        for (size_t ib = 0; ib < bodies_st->size(); ib++) {
+            const ChBody* bs = (*bodies_st)[ib].get();
+            const ChBody* bm = (*bodies_mt)[ib].get();
+            if (!(bs->GetPos() == bm->GetPos()) || !(bs->GetRot() == bm->GetRot()) ||
+                !(bs->GetPos_dt() == bm->GetPos_dt())) {
+                GetLog() << "Step " << is << ": states of body " << (int)ib << " differ\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    // The falling bodies must rest on the container, not fall through it.
+    for (size_t ib = 1; ib < bodies_mt->size() - num_links; ib++) {
+        if ((*bodies_mt)[ib]->GetPos().y < 0) {
+            GetLog() << "Body " << (int)ib << " below the container floor\n";
+            passed = false;
+            break;
+        }
+    }
+
+    ChSolverSORmultithread* solver = static_cast<ChSolverSORmultithread*>(system_mt.GetSolverSpeed());
+    GetLog() << "Number of contacts: " << system_mt.GetNcontacts() << "\n";
+    GetLog() << "Number of colors:   " << solver->GetNumColors() << "\n";
+    GetLog() << "Coloring builds:    " << solver->GetColoringBuilds() << " in " << num_steps << " steps\n";
+    if (solver->GetColoringBuilds() < 1 || solver->GetColoringBuilds() > num_steps) {
+        GetLog() << "Unexpected number of coloring builds\n";
+        passed = false;
+    }
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the step profiler.
+// A few bodies fall on a fixed box. Nothing must be recorded while the profiler
+// is disabled; when enabled, all phases of the steps must be measured, the
+// history must keep the last steps only, and the CSV and JSON output must
+// contain one record per step in the history.
+//
+// =============================================================================
+
+#include <sstream>
+#include <string>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChBodyEasy.h"
+
+using namespace chrono;
+
+// ---------------------
+// Simulation parameters
+// ---------------------
+
+int history_length = 20;  // steps kept in the profiler history
+int num_steps = 50;       // steps simulated with the profiler enabled
+
+// ====================================================================================
+
+int main(int argc, char* argv[]) {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto floor = std::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, true);
+    floor->SetBodyFixed(true);
+    system.AddBody(floor);
+
+    for (int i = 0; i < 4; i++) {
+        auto ball = std::make_shared<ChBodyEasySphere>(0.2, 1000, true);
+        ball->SetPos(ChVector<>(-0.9 + 0.6 * i, 0.3, 0));
+        system.AddBody(ball);
+    }
+
+    ChStepProfiler& profiler = system.GetProfiler();
+    bool passed = true;
+
+    // Disabled profiler: nothing recorded
+    for (int i = 0; i < 10; i++)
+        system.DoStepDynamics(1e-3);
+    if (profiler.GetNumSteps() != 0 || profiler.GetNumRecords() != 0) {
+        GetLog() << "Steps recorded by the disabled profiler\n";
+        passed = false;
+    }
+
+    // Enabled profiler
+    profiler.SetHistoryLength(history_length);
+    profiler.Enable(true);
+    for (int i = 0; i < num_steps; i++)
+        system.DoStepDynamics(1e-3);
+    profiler.Enable(false);
+    system.DoStepDynamics(1e-3);
+
+    if (profiler.GetNumSteps() != num_steps || profiler.GetNumRecords() != history_length) {
+        GetLog() << "Wrong number of steps: " << (int)profiler.GetNumSteps() << " recorded, "
+                 << profiler.GetNumRecords() << " in the history\n";
+        passed = false;
+    }
+
+    // The history keeps the last steps, oldest first
+    for (int i = 0; i < profiler.GetNumRecords(); i++) {
+        if (profiler.GetRecord(i).step != 10 + num_steps - history_length + i) {
+            GetLog() << "Wrong step in the history at " << i << "\n";
+            passed = false;
+            break;
+        }
+    }
+
+    // All phases are measured in each step, and nested in the whole step
+    for (int i = 0; i < profiler.GetNumRecords(); i++) {
+        const ChStepProfiler::StepRecord& rec = profiler.GetRecord(i);
+        for (int p = 0; p < ChStepProfiler::NUM_PHASES; p++) {
+            if (rec.phase_calls[p] == 0 || rec.phase_time[p] <= 0 ||
+                rec.phase_time[p] > rec.phase_time[ChStepProfiler::PHASE_STEP]) {
+                GetLog() << "Phase " << ChStepProfiler::GetPhaseName((ChStepProfiler::Phase)p)
+                         << " not measured in step " << (int)rec.step << "\n";
+                passed = false;
+            }
+        }
+    }
+
+    // CSV: header and one line per record
+    std::ostringstream csv;
+    profiler.WriteCSV(csv);
+    std::istringstream csv_in(csv.str());
+    std::string line;
+    int num_lines = 0;
+    while (std::getline(csv_in, line))
+        num_lines++;
+    if (num_lines != history_length + 1 || csv.str().compare(0, 10, "step,time,") != 0) {
+        GetLog() << "Wrong CSV output\n";
+        passed = false;
+    }
+
+    // JSON: totals and one object per record
+    std::ostringstream json;
+    profiler.WriteJSON(json);
+    std::string json_str = json.str();
+    int num_objects = 0;
+    for (size_t pos = json_str.find("\"phase_calls\""); pos != std::string::npos;
+         pos = json_str.find("\"phase_calls\"", pos + 1))
+        num_objects++;
+    if (num_objects != history_length || json_str.find("\"num_steps\": 50") == std::string::npos ||
+        json_str.find("\"collision_narrow\"") == std::string::npos) {
+        GetLog() << "Wrong JSON output\n";
+        passed = false;
+    }
+
+    // Reset
+    profiler.Reset();
+    if (profiler.GetNumSteps() != 0 || profiler.GetNumRecords() != 0 ||
+        profiler.GetTotalTime(ChStepProfiler::PHASE_STEP) != 0) {
+        GetLog() << "Profiler not cleared by Reset\n";
+        passed = false;
+    }
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
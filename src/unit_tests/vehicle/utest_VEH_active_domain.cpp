@@ -0,0 +1,166 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the active domain of DeformableTerrain.
+// A sphere is dragged along a fixed path through the soil, once updating only
+// the active domain and once updating the whole mesh. The soil heights and the
+// normals of the mesh must be the same. This is checked on the grid mesh built
+// by the terrain (with and without bulldozing) and on a mesh loaded from a
+// Wavefront file with one normal per face, whose normal indices are not the
+// vertex indices.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/terrain/DeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+double time_step = 0.01;
+int num_steps = 60;
+double radius = 0.3;
+double depth = 0.05;  // depth of the rut
+
+const char* mesh_file = "utest_VEH_active_domain.obj";
+
+// Write a grid of nx x nz cells on the X-Z plane, with one normal per face.
+void WriteMesh(double size_x, double size_z, int nx, int nz) {
+    FILE* file = fopen(mesh_file, "w");
+    for (int iz = 0; iz <= nz; iz++)
+        for (int ix = 0; ix <= nx; ix++)
+            fprintf(file, "v %f 0 %f\n", -0.5 * size_x + ix * size_x / nx, -0.5 * size_z + iz * size_z / nz);
+    for (int i = 0; i < 2 * nx * nz; i++)
+        fprintf(file, "vn 0 1 0\n");
+    int in = 1;
+    for (int iz = 0; iz < nz; iz++) {
+        for (int ix = 0; ix < nx; ix++) {
+            int v0 = 1 + iz * (nx + 1) + ix;
+            fprintf(file, "f %d//%d %d//%d %d//%d\n", v0, in, v0 + nx + 2, in, v0 + nx + 1, in);
+            in++;
+            fprintf(file, "f %d//%d %d//%d %d//%d\n", v0, in, v0 + 1, in, v0 + nx + 2, in);
+            in++;
+        }
+    }
+    fclose(file);
+}
+
+// Drag a sphere through the soil; return the vertices and the normals of the soil mesh.
+void CutRut(bool active_domain,
+            bool bulldozing,
+            bool from_file,
+            std::vector<ChVector<> >& vertices,
+            std::vector<ChVector<> >& normals) {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+
+    // The soil loads are applied to the sphere, so it cannot be a fixed body:
+    // its motion is imposed at each step instead.
+    auto sphere = std::make_shared<ChBody>();
+    sphere->SetMass(100);
+    sphere->SetInertiaXX(ChVector<>(4, 4, 4));
+    sphere->SetCollide(true);
+    sphere->GetCollisionModel()->ClearModel();
+    sphere->GetCollisionModel()->AddSphere(radius);
+    sphere->GetCollisionModel()->BuildModel();
+    system.AddBody(sphere);
+
+    DeformableTerrain terrain(&system);
+    if (from_file)
+        terrain.Initialize(mesh_file);
+    else
+        terrain.Initialize(0, 3, 1.5, 60, 30);
+    terrain.SetSoilParametersSCM(1.2e6, 0, 1.1, 0, 30, 0.01, 5e7);
+    terrain.SetBulldozingFlow(bulldozing);
+    terrain.SetBulldozingParameters(10, 1.6);
+    terrain.SetActiveDomainUpdate(active_domain);
+
+    // The sphere moves on a straight line, at constant depth
+    for (int is = 0; is < num_steps; is++) {
+        double x = -1.0 + 2.0 * is / num_steps;
+        sphere->SetPos(ChVector<>(x, radius - depth, 0));
+        sphere->SetRot(QUNIT);
+        sphere->SetPos_dt(ChVector<>(2.0 / (num_steps * time_step), 0, 0));
+        sphere->SetWvel_par(ChVector<>(0, 0, 0));
+        system.DoStepDynamics(time_step);
+    }
+
+    for (auto item : *system.Get_otherphysicslist()) {
+        for (auto asset : item->GetAssets()) {
+            if (auto trimesh = std::dynamic_pointer_cast<ChTriangleMeshShape>(asset)) {
+                vertices = trimesh->GetMesh().getCoordsVertices();
+                normals = trimesh->GetMesh().getCoordsNormals();
+            }
+        }
+    }
+}
+
+double MaxDifference(const std::vector<ChVector<> >& a, const std::vector<ChVector<> >& b) {
+    double diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff = std::max(diff, (a[i] - b[i]).Length());
+    return diff;
+}
+
+bool TestActiveDomain(bool bulldozing, bool from_file) {
+    std::vector<ChVector<> > vert_full, nrm_full, vert_active, nrm_active;
+    CutRut(false, bulldozing, from_file, vert_full, nrm_full);
+    CutRut(true, bulldozing, from_file, vert_active, nrm_active);
+
+    double max_depth = 0;
+    for (auto& v : vert_full)
+        max_depth = std::max(max_depth, -v.y);
+
+    GetLog() << (from_file ? "Mesh from file" : "Grid mesh") << (bulldozing ? ", bulldozing" : "") << ": "
+             << (int)vert_full.size() << " vertices, " << (int)nrm_full.size() << " normals, rut depth " << max_depth
+             << "\n";
+
+    if (vert_full.empty() || vert_active.size() != vert_full.size() || nrm_active.size() != nrm_full.size()) {
+        GetLog() << "  Soil mesh not found\n";
+        return false;
+    }
+    if (max_depth < 0.5 * depth) {
+        GetLog() << "  No rut\n";
+        return false;
+    }
+
+    double diff_vert = MaxDifference(vert_active, vert_full);
+    double diff_nrm = MaxDifference(nrm_active, nrm_full);
+    GetLog() << "  max difference: vertices " << diff_vert << ", normals " << diff_nrm << "\n";
+
+    return diff_vert == 0 && diff_nrm == 0;
+}
+
+int main(int argc, char* argv[]) {
+    WriteMesh(3, 1.5, 60, 30);
+
+    bool passed = true;
+    passed &= TestActiveDomain(false, false);
+    passed &= TestActiveDomain(true, false);
+    passed &= TestActiveDomain(false, true);
+
+    std::remove(mesh_file);
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}
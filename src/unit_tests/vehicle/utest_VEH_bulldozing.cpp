@@ -0,0 +1,156 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the bulldozing flow of DeformableTerrain.
+// A sphere is dragged along a fixed path through the soil, cutting a rut whose
+// displaced material is pushed to the sides and eroded. The soil profile across
+// the rut must match, within 1 mm, the profile given by the original
+// implementation of the bulldozing flow (std::set flood fill of the islands and
+// sequential erosion sweeps), recorded below. The parallel erosion sweeps are
+// also run; they give different berms, so they are only checked for a rut.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/terrain/DeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+double time_step = 0.01;
+int num_steps = 100;
+double radius = 0.3;
+double depth = 0.05;  // depth of the rut
+double tolerance = 1e-3;
+
+// Soil heights across the rut (at x = 0, for z = -0.75, -0.70, ..., 0.75) given by
+// the original implementation, for erosion angles of 10 and 3 degrees.
+double profile_10[] = {0.013585, 0.023213, 0.033400, 0.043883, 0.053885, 0.063562, 0.073076, 0.082270,
+                       0.079619, 0.070411, 0.060941, 0.051345, 0.041776, 0.032378, 0.023259, 0.029315,
+                       0.038496, 0.047989, 0.058069, 0.068346, 0.078968, 0.090097, 0.101019, 0.110205,
+                       0.101334, 0.092227, 0.082589, 0.072292, 0.060809, 0.048381, 0.036534};
+double profile_3[] = {0.045844, 0.049510, 0.053235, 0.056823, 0.060202, 0.063301, 0.066083, 0.063253,
+                      0.059997, 0.056478, 0.052955, 0.049638, 0.046655, 0.044425, 0.048191, 0.052505,
+                      0.056549, 0.061253, 0.066854, 0.070886, 0.074227, 0.079950, 0.084135, 0.089027,
+                      0.093321, 0.091391, 0.088342, 0.085337, 0.080842, 0.077441, 0.072570};
+size_t profile_size = 31;
+
+// Drag a sphere through the soil. Return the heights of all the soil mesh vertices
+// and, in 'profile', the heights across the rut.
+std::vector<double> CutRut(bool parallel_erosion, double erosion_angle, std::vector<double>& profile) {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+
+    // The soil loads are applied to the sphere, so it cannot be a fixed body:
+    // its motion is imposed at each step instead.
+    auto sphere = std::make_shared<ChBody>();
+    sphere->SetMass(100);
+    sphere->SetInertiaXX(ChVector<>(4, 4, 4));
+    sphere->SetCollide(true);
+    sphere->GetCollisionModel()->ClearModel();
+    sphere->GetCollisionModel()->AddSphere(radius);
+    sphere->GetCollisionModel()->BuildModel();
+    system.AddBody(sphere);
+
+    DeformableTerrain terrain(&system);
+    terrain.Initialize(0, 3, 1.5, 60, 30);
+    terrain.SetSoilParametersSCM(1.2e6, 0, 1.1, 0, 30, 0.01, 5e7);
+    terrain.SetBulldozingFlow(true);
+    terrain.SetBulldozingParameters(erosion_angle, 1.6);
+    if (parallel_erosion)
+        terrain.SetBulldozingParallelErosion(true);
+
+    // The sphere moves on a straight line, at constant depth
+    for (int is = 0; is < num_steps; is++) {
+        double x = -1.0 + 2.0 * is / num_steps;
+        sphere->SetPos(ChVector<>(x, radius - depth, 0));
+        sphere->SetRot(QUNIT);
+        sphere->SetPos_dt(ChVector<>(2.0 / (num_steps * time_step), 0, 0));
+        sphere->SetWvel_par(ChVector<>(0, 0, 0));
+        system.DoStepDynamics(time_step);
+    }
+
+    // Heights of the soil mesh (the soil plane is Y up)
+    std::vector<double> heights;
+    profile.clear();
+    for (auto item : *system.Get_otherphysicslist()) {
+        for (auto asset : item->GetAssets()) {
+            if (auto trimesh = std::dynamic_pointer_cast<ChTriangleMeshShape>(asset)) {
+                for (auto& v : trimesh->GetMesh().getCoordsVertices()) {
+                    heights.push_back(v.y);
+                    if (std::abs(v.x) < 1e-6)
+                        profile.push_back(v.y);
+                }
+            }
+        }
+    }
+    return heights;
+}
+
+// Check that there is a rut, and that the displaced material was raised at its sides.
+bool CheckRut(const std::vector<double>& heights) {
+    double max_raise = 0;
+    double max_depth = 0;
+    for (auto h : heights) {
+        max_raise = std::max(max_raise, h);
+        max_depth = std::max(max_depth, -h);
+    }
+
+    GetLog() << "  rut depth " << max_depth << ", max raise " << max_raise << "\n";
+
+    if (max_depth < 0.5 * depth || max_raise < 1e-3) {
+        GetLog() << "  No rut or no bulldozing\n";
+        return false;
+    }
+    return true;
+}
+
+bool TestErosion(double erosion_angle, const double* profile_ref) {
+    bool passed = true;
+    std::vector<double> profile;
+
+    GetLog() << "Erosion angle " << erosion_angle << ", sequential sweeps:\n";
+    passed &= CheckRut(CutRut(false, erosion_angle, profile));
+
+    if (profile.size() != profile_size) {
+        GetLog() << "  Soil profile not found\n";
+        return false;
+    }
+    double max_diff = 0;
+    for (size_t i = 0; i < profile_size; i++)
+        max_diff = std::max(max_diff, std::abs(profile[i] - profile_ref[i]));
+    GetLog() << "  max difference from the original profile " << max_diff << "\n";
+    passed &= max_diff < tolerance;
+
+    GetLog() << "Erosion angle " << erosion_angle << ", parallel sweeps:\n";
+    passed &= CheckRut(CutRut(true, erosion_angle, profile));
+
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestErosion(10, profile_10);
+    passed &= TestErosion(3, profile_3);
+
+    GetLog() << "Test " << (passed ? "PASSED" : "FAILED") << "\n";
+
+    // Return 0 if the test passed.
+    return !passed;
+}